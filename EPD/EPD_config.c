@@ -6,16 +6,63 @@
 
 #define CONFIG_FILE_ID 0x0000
 #define CONFIG_REC_KEY 0x0001
+#define LIST_REC_KEY   0x0002
+#define SLOTS_REC_KEY  0x0003
+
+// list and slot values are saved from a copy, FDS reads the data from here until the write event
+static struct
+{
+    uint16_t key;   // record being saved, 0 if none
+    uint32_t size;
+    bool     gc;    // the write failed, tried again once when garbage collection is done
+    union
+    {
+        epd_list_t  list;
+        epd_slots_t slots;
+    } data;
+} m_save;
+
+static epd_config_evt_handler_t m_evt_handler;
+
+static ret_code_t config_record_write(uint16_t key, void *data, uint32_t size);
+
+static void config_save_done(bool success)
+{
+    epd_config_evt_t evt = m_save.key == LIST_REC_KEY ? EPD_CONFIG_EVT_LIST_SAVED : EPD_CONFIG_EVT_SLOTS_SAVED;
+
+    m_save.key = 0;
+    if (m_evt_handler) m_evt_handler(evt, success);
+}
 
 static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
 {
     NRF_LOG_DEBUG("fds evt: id=%d result=%d\n", p_fds_evt->id, p_fds_evt->result);
+    if (m_save.key == 0) return;
+
+    switch (p_fds_evt->id)
+    {
+        case FDS_EVT_WRITE:
+        case FDS_EVT_UPDATE:
+            if (p_fds_evt->write.record_key == m_save.key)
+                config_save_done(p_fds_evt->result == NRF_SUCCESS);
+            break;
+        case FDS_EVT_GC:
+            if (!m_save.gc) break;
+            m_save.gc = false;
+            if (config_record_write(m_save.key, &m_save.data, m_save.size) != NRF_SUCCESS)
+                config_save_done(false);
+            break;
+        default:
+            break;
+    }
 }
 
-void epd_config_init(epd_config_t *cfg)
+void epd_config_init(epd_config_t *cfg, epd_config_evt_handler_t handler)
 {
     ret_code_t ret;
 
+    m_evt_handler = handler;
+    m_save.key = 0;
     ret = fds_register(fds_evt_handler);
     if (ret != NRF_SUCCESS) {
         NRF_LOG_ERROR("fds_register failed!\n");
@@ -28,33 +75,34 @@ void epd_config_init(epd_config_t *cfg)
     }
 }
 
-void epd_config_read(epd_config_t *cfg)
+// returns the record length in bytes, 0 if not found
+static uint32_t config_record_read(uint16_t key, void *data, uint32_t size)
 {
     fds_flash_record_t  flash_record;
     fds_record_desc_t   record_desc;
     fds_find_token_t    ftok;
 
-    memset(cfg, 0xFF, sizeof(epd_config_t));
     memset(&ftok, 0x00, sizeof(fds_find_token_t));
 
-    if (fds_record_find(CONFIG_FILE_ID, CONFIG_REC_KEY, &record_desc, &ftok) != NRF_SUCCESS) {
-        NRF_LOG_DEBUG("epd_config_load: record not found\n");
-        return;
+    if (fds_record_find(CONFIG_FILE_ID, key, &record_desc, &ftok) != NRF_SUCCESS) {
+        NRF_LOG_DEBUG("config_record_read: record %d not found\n", key);
+        return 0;
     }
     if (fds_record_open(&record_desc, &flash_record) != NRF_SUCCESS) {
-        NRF_LOG_ERROR("epd_config_load: record open failed!");
-        return;
+        NRF_LOG_ERROR("config_record_read: record open failed!");
+        return 0;
     }
 #ifdef S112
     uint32_t record_len = flash_record.p_header->length_words * sizeof(uint32_t);
 #else
     uint32_t record_len = flash_record.p_header->tl.length_words * sizeof(uint32_t);
 #endif
-    memcpy(cfg, flash_record.p_data, MIN(sizeof(epd_config_t), record_len));
+    memcpy(data, flash_record.p_data, MIN(size, record_len));
     fds_record_close(&record_desc);
+    return record_len;
 }
 
-void epd_config_write(epd_config_t *cfg)
+static ret_code_t config_record_write(uint16_t key, void *data, uint32_t size)
 {
     ret_code_t          ret;
     fds_record_t        record;
@@ -62,28 +110,63 @@ void epd_config_write(epd_config_t *cfg)
     fds_find_token_t    ftok;
 
     record.file_id = CONFIG_FILE_ID;
-    record.key = CONFIG_REC_KEY;
+    record.key = key;
 #ifdef S112
-    record.data.p_data = (void*)cfg;
-    record.data.length_words = BYTES_TO_WORDS(sizeof(epd_config_t));
+    record.data.p_data = data;
+    record.data.length_words = BYTES_TO_WORDS(size);
 #else
     fds_record_chunk_t record_chunk;
-    record_chunk.p_data = cfg;
-    record_chunk.length_words = BYTES_TO_WORDS(sizeof(epd_config_t));
+    record_chunk.p_data = data;
+    record_chunk.length_words = BYTES_TO_WORDS(size);
     record.data.p_chunks = &record_chunk;
     record.data.num_chunks = 1;
 #endif
 
     memset(&ftok, 0x00, sizeof(fds_find_token_t));
-    ret = fds_record_find(CONFIG_FILE_ID, CONFIG_REC_KEY, &record_desc, &ftok);
+    ret = fds_record_find(CONFIG_FILE_ID, key, &record_desc, &ftok);
     if (ret == NRF_SUCCESS)
         ret = fds_record_update(&record_desc, &record);
     else
         ret = fds_record_write(&record_desc, &record);
 
-    if (ret != NRF_SUCCESS) {
-        NRF_LOG_ERROR("epd_config_save: record write/update failed!\n");
+    if (ret != NRF_SUCCESS)
+        NRF_LOG_ERROR("config_record_write: record %d write/update failed!\n", key);
+    return ret;
+}
+
+// the result comes with the write event, or after garbage collection made room for it
+static bool config_save(uint16_t key, const void *data, uint32_t size)
+{
+    if (m_save.key != 0) {
+        NRF_LOG_ERROR("config_save: record %d still being saved\n", m_save.key);
+        return false;
     }
+    memcpy(&m_save.data, data, size);
+    m_save.key = key;
+    m_save.size = size;
+    m_save.gc = false;
+    if (config_record_write(key, &m_save.data, size) == NRF_SUCCESS)
+        return true;
+
+    // mostly a flash full of outdated records
+    m_save.gc = true;
+    if (fds_gc() == NRF_SUCCESS)
+        return true;
+    m_save.key = 0;
+    return false;
+}
+
+void epd_config_read(epd_config_t *cfg)
+{
+    memset(cfg, 0xFF, sizeof(epd_config_t));
+    config_record_read(CONFIG_REC_KEY, cfg, sizeof(epd_config_t));
+}
+
+void epd_config_write(epd_config_t *cfg)
+{
+    // mostly a flash full of outdated records, the next write finds the space
+    if (config_record_write(CONFIG_REC_KEY, cfg, sizeof(epd_config_t)) != NRF_SUCCESS)
+        fds_gc();
 }
 
 void epd_config_clear(epd_config_t *cfg)
@@ -108,3 +191,36 @@ bool epd_config_empty(epd_config_t *cfg)
     }
     return true;
 }
+
+void epd_list_read(epd_list_t *list)
+{
+    uint32_t record_len = config_record_read(LIST_REC_KEY, list, sizeof(epd_list_t));
+
+    if (record_len < sizeof(list->length) || list->length > MIN(EPD_LIST_SIZE, record_len - sizeof(list->length)))
+        list->length = 0;
+}
+
+bool epd_list_write(epd_list_t *list)
+{
+    return config_save(LIST_REC_KEY, list, sizeof(list->length) + list->length);
+}
+
+void epd_slots_read(epd_slots_t *slots)
+{
+    memset(slots, 0, sizeof(epd_slots_t));
+    config_record_read(SLOTS_REC_KEY, slots, sizeof(epd_slots_t));
+    for (uint8_t i = 0; i < EPD_SLOT_COUNT; i++) {
+        if (slots->data[i][0] >= EPD_SLOT_SIZE)
+            slots->data[i][0] = 0;
+    }
+}
+
+bool epd_slots_write(epd_slots_t *slots)
+{
+    return config_save(SLOTS_REC_KEY, slots, sizeof(epd_slots_t));
+}
+
+bool epd_config_saving(void)
+{
+    return m_save.key != 0;
+}
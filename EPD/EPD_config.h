@@ -19,11 +19,51 @@ typedef struct
 } epd_config_t;
 
 #define EPD_CONFIG_SIZE (sizeof(epd_config_t) / sizeof(uint8_t))
-    
-void epd_config_init(epd_config_t *cfg);
+
+#define EPD_LIST_SIZE 512
+
+// display list of MODE_LIST, see GUI.h, kept in a record of its own
+typedef struct
+{
+    uint32_t length;
+    uint8_t data[EPD_LIST_SIZE];
+} epd_list_t;
+
+#define EPD_SLOT_COUNT 8
+#define EPD_SLOT_SIZE  32
+
+// values of the display list slots, a length byte and the value each (LIST_SLOT_COUNT, LIST_SLOT_SIZE of GUI.h)
+typedef struct
+{
+    uint8_t data[EPD_SLOT_COUNT][EPD_SLOT_SIZE];
+} epd_slots_t;
+
+typedef enum
+{
+    EPD_CONFIG_EVT_LIST_SAVED,
+    EPD_CONFIG_EVT_SLOTS_SAVED,
+} epd_config_evt_t;
+
+/**@brief Config store event handler, called when a record saved with epd_list_write() or
+ *        epd_slots_write() is in flash or the save failed.
+ *
+ * @param[in] evt     Saved record.
+ * @param[in] success Result of the save.
+ */
+typedef void (*epd_config_evt_handler_t)(epd_config_evt_t evt, bool success);
+
+void epd_config_init(epd_config_t *cfg, epd_config_evt_handler_t handler);
 void epd_config_read(epd_config_t *cfg);
 void epd_config_write(epd_config_t *cfg);
 void epd_config_clear(epd_config_t *cfg);
 bool epd_config_empty(epd_config_t *cfg);
+void epd_list_read(epd_list_t *list);
+// the record is saved from a copy in the background, false if another save is still running
+bool epd_list_write(epd_list_t *list);
+void epd_slots_read(epd_slots_t *slots);
+// same as epd_list_write()
+bool epd_slots_write(epd_slots_t *slots);
+// true from epd_list_write() or epd_slots_write() until its event
+bool epd_config_saving(void);
 
 #endif
@@ -15,6 +15,7 @@
 #include "app_error.h"
 #include "nrf_drv_spi.h"
 #include "EPD_driver.h"
+#include "EPD_trace.h"
 #include "nrf_log.h"
 
 #define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
@@ -156,7 +157,11 @@ void EPD_SPI_WriteBytes(uint8_t *value, uint8_t len)
         pinMode(EPD_MOSI_PIN, OUTPUT);
         nrf_spi_pins_set(HAL_SPI_INSTANCE, EPD_SCLK_PIN, EPD_MOSI_PIN, NRF_SPI_PIN_NOT_CONNECTED);
     }
+    uint32_t start = epd_perf_now();
     APP_ERROR_CHECK(nrf_drv_spi_transfer(&spi, value, len, NULL, 0));
+    uint32_t us = epd_perf_since(start);
+    epd_perf_add(EPD_PERF_SPI, us);
+    EPD_TRACE_AT(start, EPD_TRACE_SPI_WRITE, len, us);
 }
 
 void EPD_SPI_ReadBytes(uint8_t *value, uint8_t len)
@@ -166,7 +171,11 @@ void EPD_SPI_ReadBytes(uint8_t *value, uint8_t len)
         pinMode(EPD_MOSI_PIN, INPUT);
         nrf_spi_pins_set(HAL_SPI_INSTANCE, EPD_SCLK_PIN, NRF_SPI_PIN_NOT_CONNECTED, EPD_MOSI_PIN);
     }
+    uint32_t start = epd_perf_now();
     APP_ERROR_CHECK(nrf_drv_spi_transfer(&spi, NULL, 0, value, len));
+    uint32_t us = epd_perf_since(start);
+    epd_perf_add(EPD_PERF_SPI, us);
+    EPD_TRACE_AT(start, EPD_TRACE_SPI_READ, len, us);
 }
 
 void EPD_SPI_WriteByte(uint8_t value)
@@ -200,6 +209,22 @@ void EPD_WriteData(uint8_t *Data, uint8_t Len)
     EPD_SPI_WriteBytes(Data, Len);
 }
 
+// Write a whole buffer in as few SPI transfers as possible (NULL writes 0xFF)
+void EPD_WriteBuffer(uint8_t *Data, uint16_t Len)
+{
+    digitalWrite(EPD_DC_PIN, HIGH);
+    if (Data == NULL) {
+        while (Len--) EPD_SPI_WriteByte(0xFF);
+        return;
+    }
+    while (Len > 0) {
+        uint8_t n = Len > 0xFF ? 0xFF : Len;
+        EPD_SPI_WriteBytes(Data, n);
+        Data += n;
+        Len -= n;
+    }
+}
+
 uint8_t EPD_ReadByte(void)
 {
     digitalWrite(EPD_DC_PIN, HIGH);
@@ -219,18 +244,17 @@ void EPD_Reset(uint32_t value, uint16_t duration)
 void EPD_WaitBusy(uint32_t value, uint16_t timeout)
 {
     uint32_t led_status = digitalRead(EPD_LED_PIN);
+    uint32_t start = epd_perf_now();
 
-    NRF_LOG_DEBUG("[EPD]: check busy\n");
     while (digitalRead(EPD_BUSY_PIN) == value) {
         if (timeout % 100 == 0) EPD_LED_Toggle();
         delay(1);
         timeout--;
-        if (timeout == 0) {
-            NRF_LOG_DEBUG("[EPD]: busy timeout!\n");
-            break;
-        }
+        if (timeout == 0) break;
     }
-    NRF_LOG_DEBUG("[EPD]: busy release\n");
+    uint32_t us = epd_perf_since(start);
+    epd_perf_add(EPD_PERF_BUSY, us);
+    EPD_TRACE_AT(start, EPD_TRACE_BUSY, timeout == 0, us / 1000);
 
     // restore led status
     if (led_status == LOW)
@@ -32,8 +32,12 @@ typedef struct
 {
     void (*init)();                                   /**< Initialize the e-Paper register */
     void (*clear)(void);                              /**< Clear screen */
-    void (*write_image)(uint8_t *black, uint8_t *color, uint16_t x, uint16_t y, uint16_t w, uint16_t h); /**< write image */
+    void (*write_begin)(uint16_t x, uint16_t y, uint16_t w, uint16_t h); /**< Set the RAM window for the rows written next */
+    void (*write_rows)(uint8_t *black, uint8_t *color, uint16_t h); /**< Write the next h rows of the window */
+    void (*write_end)(void);                          /**< Finish writing the window */
+    void (*write_ram)(uint8_t cmd, uint16_t x, uint16_t y, uint16_t w, uint16_t h); /**< Set the RAM window and start writing one RAM, finished with write_end */
     void (*refresh)(void);                            /**< Sends the image buffer in RAM to e-Paper and displays */
+    void (*refresh_region)(uint16_t x, uint16_t y, uint16_t w, uint16_t h); /**< Refresh a window only, NULL if the whole screen is always refreshed */
     void (*sleep)(void);                              /**< Enter sleep mode */
     int8_t (*read_temp)(void);                        /**< Read temperature from driver chip */
     void (*force_temp)(int8_t value);                 /**< Force temperature (will trigger OTP LUT switch) */
@@ -88,6 +92,7 @@ uint8_t EPD_SPI_ReadByte(void);
 void EPD_WriteCommand(uint8_t Reg);
 void EPD_WriteByte(uint8_t Data);
 void EPD_WriteData(uint8_t *Data, uint8_t Len);
+void EPD_WriteBuffer(uint8_t *Data, uint16_t Len);
 uint8_t EPD_ReadByte(void);
 void EPD_Reset(uint32_t value, uint16_t duration);
 void EPD_WaitBusy(uint32_t value, uint16_t timeout);
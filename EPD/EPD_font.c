@@ -0,0 +1,246 @@
+#include <string.h>
+#include "nordic_common.h"
+#include "sdk_config.h"
+#include "sdk_errors.h"
+#include "app_util.h"
+#include "crc32.h"
+#include "EPD_font.h"
+#include "nrf_log.h"
+#if defined(S112)
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_sd.h"
+#else
+#include "fstorage.h"
+#endif
+
+#if defined(S112)
+#define FONT_PAGE_SIZE 4096
+#define FONT_PAGES     4
+#else
+#define FONT_PAGE_SIZE 1024
+#define FONT_PAGES     32
+#endif
+
+#define FONT_REGION_SIZE (FONT_PAGE_SIZE * FONT_PAGES)
+#define FONT_WRITE_MAX   244
+
+static epd_font_evt_handler_t m_evt_handler;
+static bool m_busy;
+static uint32_t m_write_offset;
+static uint32_t m_buf[FONT_WRITE_MAX / sizeof(uint32_t)];
+
+static void font_evt(epd_font_evt_t evt, bool success)
+{
+    m_busy = false;
+    if (m_evt_handler) m_evt_handler(evt, m_write_offset, success);
+}
+
+#if defined(S112)
+static void fs_evt_handler(nrf_fstorage_evt_t * p_evt);
+
+NRF_FSTORAGE_DEF(nrf_fstorage_t m_fs) =
+{
+    .evt_handler = fs_evt_handler,
+};
+
+static void fs_evt_handler(nrf_fstorage_evt_t * p_evt)
+{
+    NRF_LOG_DEBUG("font fs evt: id=%d result=%d\n", p_evt->id, p_evt->result);
+    if (p_evt->id == NRF_FSTORAGE_EVT_ERASE_RESULT)
+        font_evt(EPD_FONT_EVT_ERASED, p_evt->result == NRF_SUCCESS);
+    else if (p_evt->id == NRF_FSTORAGE_EVT_WRITE_RESULT)
+        font_evt((epd_font_evt_t)(uint32_t)p_evt->p_param, p_evt->result == NRF_SUCCESS);
+}
+
+// same as fds.c, the font pages are placed right below the FDS pages
+static uint32_t font_end_addr(void)
+{
+    uint32_t const bootloader_addr = BOOTLOADER_ADDRESS;
+    uint32_t const page_sz         = NRF_FICR->CODEPAGESIZE;
+#if defined(NRF52810_XXAA) || defined(NRF52811_XXAA)
+    uint32_t const code_sz = 48;
+#else
+    uint32_t const code_sz = NRF_FICR->CODESIZE;
+#endif
+    uint32_t end_addr = (bootloader_addr != 0xFFFFFFFF) ? bootloader_addr : (code_sz * page_sz);
+
+    return end_addr - (FDS_VIRTUAL_PAGES * FDS_VIRTUAL_PAGE_SIZE * sizeof(uint32_t));
+}
+
+#define FONT_START_ADDR m_fs.start_addr
+
+static uint32_t font_flash_erase(void)
+{
+    return nrf_fstorage_erase(&m_fs, m_fs.start_addr, FONT_PAGES, NULL);
+}
+
+static uint32_t font_flash_write(uint32_t offset, void const * p_src, uint32_t len, epd_font_evt_t evt)
+{
+    return nrf_fstorage_write(&m_fs, m_fs.start_addr + offset, p_src, len, (void *)(uint32_t)evt);
+}
+#else
+static void fs_evt_handler(fs_evt_t const * const evt, fs_ret_t result);
+
+FS_REGISTER_CFG(fs_config_t m_fs_config) =
+{
+    .callback  = fs_evt_handler,
+    .num_pages = FONT_PAGES,
+    .priority  = 0xFE, // right below FDS
+};
+
+static void fs_evt_handler(fs_evt_t const * const evt, fs_ret_t result)
+{
+    NRF_LOG_DEBUG("font fs evt: id=%d result=%d\n", evt->id, result);
+    if (evt->id == FS_EVT_ERASE)
+        font_evt(EPD_FONT_EVT_ERASED, result == FS_SUCCESS);
+    else if (evt->id == FS_EVT_STORE)
+        font_evt((epd_font_evt_t)(uint32_t)evt->p_context, result == FS_SUCCESS);
+}
+
+#define FONT_START_ADDR ((uint32_t)m_fs_config.p_start_addr)
+
+// SDK 12 app_util.h has no CODE_END, the end of the image including the initial values of .data
+#if defined(__CC_ARM)
+extern char Load$$LR$$LR_IROM1$$Limit;
+#define CODE_END ((uint32_t)&Load$$LR$$LR_IROM1$$Limit)
+#elif defined(__GNUC__)
+extern uint32_t __etext, __data_start__, __data_end__;
+#define CODE_END ((uint32_t)&__etext + ((uint32_t)&__data_end__ - (uint32_t)&__data_start__))
+#endif
+
+static uint32_t font_flash_erase(void)
+{
+    return fs_erase(&m_fs_config, m_fs_config.p_start_addr, FONT_PAGES, NULL) == FS_SUCCESS ? NRF_SUCCESS : NRF_ERROR_BUSY;
+}
+
+static uint32_t font_flash_write(uint32_t offset, void const * p_src, uint32_t len, epd_font_evt_t evt)
+{
+    return fs_store(&m_fs_config, m_fs_config.p_start_addr + offset / sizeof(uint32_t), p_src,
+                    BYTES_TO_WORDS(len), (void *)(uint32_t)evt) == FS_SUCCESS ? NRF_SUCCESS : NRF_ERROR_BUSY;
+}
+#endif
+
+static const epd_font_header_t *font_header(void)
+{
+    const epd_font_header_t *header = (const epd_font_header_t *)FONT_START_ADDR;
+    if (FONT_START_ADDR == 0) return NULL;
+    if (header->size > FONT_REGION_SIZE || header->size < sizeof(epd_font_header_t) + header->count * sizeof(epd_font_entry_t))
+        return NULL;
+    return header;
+}
+
+/**@brief Function for initializing the font store.
+ *
+ * @details Must be called after fds_init(), which assigns the flash pages on SDK 12.
+ */
+void epd_font_init(epd_font_evt_handler_t handler)
+{
+    m_evt_handler = handler;
+    m_busy = false;
+#if defined(S112)
+    m_fs.end_addr   = font_end_addr();
+    m_fs.start_addr = m_fs.end_addr - FONT_REGION_SIZE;
+    if (nrf_fstorage_init(&m_fs, &nrf_fstorage_sd, NULL) != NRF_SUCCESS) {
+        NRF_LOG_ERROR("font fstorage init failed!\n");
+        m_fs.start_addr = 0;
+        return;
+    }
+    if (m_fs.start_addr < CODE_END) {
+        NRF_LOG_ERROR("font region overlaps code!\n");
+        m_fs.start_addr = 0;
+        return;
+    }
+#else
+    // fstorage places the pages below FDS without looking at the size of the image
+    if (FONT_START_ADDR != 0 && FONT_START_ADDR < CODE_END) {
+        NRF_LOG_ERROR("font region overlaps code!\n");
+        m_fs_config.p_start_addr = NULL;
+        return;
+    }
+#endif
+    NRF_LOG_DEBUG("font region: 0x%x, %d bytes\n", FONT_START_ADDR, FONT_REGION_SIZE);
+}
+
+uint32_t epd_font_size(void)
+{
+    return FONT_START_ADDR ? FONT_REGION_SIZE : 0;
+}
+
+/**@brief Function for erasing the font store, the result is reported with EPD_FONT_EVT_ERASED. */
+uint32_t epd_font_erase(void)
+{
+    if (FONT_START_ADDR == 0) return NRF_ERROR_INVALID_STATE;
+    if (m_busy) return NRF_ERROR_BUSY;
+
+    uint32_t err_code = font_flash_erase();
+    if (err_code == NRF_SUCCESS) m_busy = true;
+    return err_code;
+}
+
+/**@brief Function for writing font pack data, the result is reported with EPD_FONT_EVT_WRITTEN.
+ *
+ * @details The first word is reserved for the magic, so @p offset starts at 4.
+ *          @p offset must be word aligned, only the last write may have a length
+ *          which is not a multiple of 4 (it is padded with 0xFF).
+ */
+uint32_t epd_font_write(uint32_t offset, uint8_t *data, uint16_t length)
+{
+    if (FONT_START_ADDR == 0) return NRF_ERROR_INVALID_STATE;
+    if (m_busy) return NRF_ERROR_BUSY;
+    if (length == 0 || length > FONT_WRITE_MAX || offset < sizeof(uint32_t) || (offset & 3) ||
+        offset + length > FONT_REGION_SIZE)
+        return NRF_ERROR_INVALID_PARAM;
+
+    memset(m_buf, 0xFF, sizeof(m_buf));
+    memcpy(m_buf, data, length);
+    m_write_offset = offset;
+
+    uint32_t err_code = font_flash_write(offset, m_buf, ALIGN_NUM(sizeof(uint32_t), length), EPD_FONT_EVT_WRITTEN);
+    if (err_code == NRF_SUCCESS) m_busy = true;
+    return err_code;
+}
+
+/**@brief Function for enabling the uploaded font pack, the result is reported with EPD_FONT_EVT_COMMITTED.
+ *
+ * @param[in] crc  CRC32 of the pack, excluding the magic.
+ */
+uint32_t epd_font_commit(uint32_t crc)
+{
+    if (FONT_START_ADDR == 0) return NRF_ERROR_INVALID_STATE;
+    if (m_busy) return NRF_ERROR_BUSY;
+
+    const epd_font_header_t *header = font_header();
+    if (header == NULL || header->magic != 0xFFFFFFFF) return NRF_ERROR_INVALID_DATA;
+    if (crc32_compute((const uint8_t *)header + sizeof(uint32_t), header->size - sizeof(uint32_t), NULL) != crc) {
+        NRF_LOG_ERROR("font pack crc mismatch\n");
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    m_buf[0] = EPD_FONT_MAGIC;
+    m_write_offset = 0;
+
+    uint32_t err_code = font_flash_write(0, m_buf, sizeof(uint32_t), EPD_FONT_EVT_COMMITTED);
+    if (err_code == NRF_SUCCESS) m_busy = true;
+    return err_code;
+}
+
+/**@brief Function for looking up a font in the font pack.
+ *
+ * @param[in] id  Font ID.
+ *
+ * @retval Pointer to the u8g2 font data in flash, NULL if not found.
+ */
+const uint8_t *epd_font_get(uint8_t id)
+{
+    if (m_busy) return NULL;
+
+    const epd_font_header_t *header = font_header();
+    if (header == NULL || header->magic != EPD_FONT_MAGIC) return NULL;
+
+    const epd_font_entry_t *entry = (const epd_font_entry_t *)(header + 1);
+    for (uint16_t i = 0; i < header->count; i++, entry++) {
+        if (entry->id == id && entry->offset < header->size)
+            return (const uint8_t *)header + entry->offset;
+    }
+    return NULL;
+}
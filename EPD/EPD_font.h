@@ -0,0 +1,59 @@
+#ifndef __EPD_FONT_H
+#define __EPD_FONT_H
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Font pack stored in a reserved flash region (below the FDS pages).
+ *
+ * Layout (little endian, word aligned):
+ *   0: magic (written last by epd_font_commit)
+ *   4: font count
+ *   6: reserved
+ *   8: pack size in bytes, including this header
+ *  12: epd_font_entry_t[count]
+ *      u8g2 font data
+ *
+ * The pack is uploaded as a whole: erase, write from offset 4, then commit
+ * with the CRC32 of bytes [4, size). Fonts are used in place from flash.
+ */
+#define EPD_FONT_MAGIC 0x50464445 // "EDFP"
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t count;
+    uint16_t reserved;
+    uint32_t size;
+} epd_font_header_t;
+
+typedef struct
+{
+    uint8_t  id;
+    uint8_t  reserved[3];
+    uint32_t offset;      // from the start of the pack
+} epd_font_entry_t;
+
+typedef enum
+{
+    EPD_FONT_EVT_ERASED,
+    EPD_FONT_EVT_WRITTEN,
+    EPD_FONT_EVT_COMMITTED,
+} epd_font_evt_t;
+
+/**@brief Font store event handler, called when a flash operation finishes.
+ *
+ * @param[in] evt     Completed operation.
+ * @param[in] offset  Offset of the written data (EPD_FONT_EVT_WRITTEN only).
+ * @param[in] success Result of the operation.
+ */
+typedef void (*epd_font_evt_handler_t)(epd_font_evt_t evt, uint32_t offset, bool success);
+
+void epd_font_init(epd_font_evt_handler_t handler);
+uint32_t epd_font_size(void);
+uint32_t epd_font_erase(void);
+uint32_t epd_font_write(uint32_t offset, uint8_t *data, uint16_t length);
+uint32_t epd_font_commit(uint32_t crc);
+const uint8_t *epd_font_get(uint8_t id);
+
+#endif
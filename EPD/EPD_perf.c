@@ -0,0 +1,116 @@
+#include <string.h>
+#include "nrf.h"
+#include "app_util_platform.h"
+#include "EPD_perf.h"
+
+#define RTC_TICKS_TO_US(ticks) ((uint32_t)(((uint64_t)((ticks) & 0xFFFFFF) * 15625) >> 9)) // 32768 Hz, 24 bit
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} epd_perf_stat_t;
+
+static epd_perf_stat_t m_stats[EPD_PERF_COUNT];
+
+void epd_perf_init(void)
+{
+#if defined(S112)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    memset(m_stats, 0, sizeof(m_stats));
+    for (uint8_t i = 0; i < EPD_PERF_COUNT; i++)
+        m_stats[i].min = UINT32_MAX;
+}
+
+uint32_t epd_perf_now(void)
+{
+#if defined(S112)
+    return DWT->CYCCNT;
+#else
+    return NRF_RTC1->COUNTER;
+#endif
+}
+
+uint32_t epd_perf_since(uint32_t start)
+{
+#if defined(S112)
+    return (DWT->CYCCNT - start) / 64;
+#else
+    return RTC_TICKS_TO_US(NRF_RTC1->COUNTER - start);
+#endif
+}
+
+void epd_perf_add(epd_perf_id_t id, uint32_t us)
+{
+    epd_perf_stat_t *stat = &m_stats[id];
+
+    CRITICAL_REGION_ENTER();
+    stat->count++;
+    stat->total += us;
+    if (us < stat->min) stat->min = us;
+    if (us > stat->max) stat->max = us;
+    CRITICAL_REGION_EXIT();
+}
+
+void epd_perf_end(epd_perf_id_t id, uint32_t start)
+{
+    epd_perf_add(id, epd_perf_since(start));
+}
+
+uint64_t epd_perf_total(epd_perf_id_t id)
+{
+    return m_stats[id].total;
+}
+
+uint32_t epd_perf_idle_start(void)
+{
+    return NRF_RTC1->COUNTER;
+}
+
+void epd_perf_idle_end(uint32_t start)
+{
+    epd_perf_add(EPD_PERF_IDLE, RTC_TICKS_TO_US(NRF_RTC1->COUNTER - start));
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = value;
+    p[1] = value >> 8;
+    p[2] = value >> 16;
+    p[3] = value >> 24;
+    return p + 4;
+}
+
+uint16_t epd_perf_encode(uint8_t *buf, uint16_t size)
+{
+    epd_perf_stat_t stats[EPD_PERF_COUNT];
+    uint8_t *p = buf;
+
+    if (size < EPD_PERF_DATA_SIZE) return 0;
+
+    CRITICAL_REGION_ENTER();
+    memcpy(stats, m_stats, sizeof(stats));
+    CRITICAL_REGION_EXIT();
+
+    *p++ = EPD_PERF_VERSION;
+    *p++ = EPD_PERF_COUNT;
+#if defined(S112)
+    *p++ = 1;
+#else
+    *p++ = 0;
+#endif
+    *p++ = 0;
+    for (uint8_t i = 0; i < EPD_PERF_COUNT; i++) {
+        epd_perf_stat_t *stat = &stats[i];
+        p = put_u32(p, stat->count);
+        p = put_u32(p, stat->count ? stat->min : 0);
+        p = put_u32(p, stat->count ? (uint32_t)(stat->total / stat->count) : 0);
+        p = put_u32(p, stat->max);
+    }
+    return p - buf;
+}
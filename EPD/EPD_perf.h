@@ -0,0 +1,53 @@
+#ifndef __EPD_PERF_H
+#define __EPD_PERF_H
+#include <stdint.h>
+
+/**
+ * Phase timing of the EPD service, read through the perf characteristic.
+ *
+ * nRF52 uses the DWT cycle counter (1/64 us), nRF51 has none and uses the
+ * RTC1 counter of app_timer (30.5 us). Phases shorter than a tick are still
+ * counted right on average, the RTC is sampled at a random phase. IDLE is
+ * always timed with RTC1, the CPU clock and DWT stop while sleeping.
+ *
+ * Encoded value (little endian):
+ *   0: version
+ *   1: phase count
+ *   2: clock, 0 = RTC, 1 = DWT
+ *   3: reserved
+ *   4: per phase: count, min, avg, max (u32, us)
+ */
+#define EPD_PERF_VERSION 1
+
+typedef enum
+{
+    EPD_PERF_ON_WRITE,      // epd_service_on_write(), a whole command
+    EPD_PERF_WRITE_IMAGE,   // EPD_CMD_WRITE_IMAGE, WRITE_IMAGE_RLE, WRITE_REGION, UPLOAD_DATA, data characteristic
+    EPD_PERF_GUI_UPDATE,    // epd_gui_update(), a whole calendar or clock update
+    EPD_PERF_RENDER,        // DrawGUI() without the SPI transfers
+    EPD_PERF_SPI,           // one SPI transfer
+    EPD_PERF_BUSY,          // EPD_WaitBusy()
+    EPD_PERF_TEMP,          // read_temp()
+    EPD_PERF_REFRESH,       // refresh(), BUSY wait included
+    EPD_PERF_IDLE,          // sleeping in the main loop
+    EPD_PERF_COUNT,
+} epd_perf_id_t;
+
+#define EPD_PERF_DATA_SIZE (4 + EPD_PERF_COUNT * 16)
+
+void epd_perf_init(void);
+uint32_t epd_perf_now(void);
+// us since a timestamp of epd_perf_now()
+uint32_t epd_perf_since(uint32_t start);
+void epd_perf_add(epd_perf_id_t id, uint32_t us);
+void epd_perf_end(epd_perf_id_t id, uint32_t start);
+// sum of all samples of a phase in us
+uint64_t epd_perf_total(epd_perf_id_t id);
+
+uint32_t epd_perf_idle_start(void);
+void epd_perf_idle_end(uint32_t start);
+
+// snapshot for the perf characteristic, returns the encoded length
+uint16_t epd_perf_encode(uint8_t *buf, uint16_t size);
+
+#endif
@@ -17,7 +17,11 @@
 #include "nrf_gpio.h"
 #include "nrf_pwr_mgmt.h"
 #include "app_scheduler.h"
+#include "app_fifo.h"
+#include "app_util_platform.h"
+#include "crc32.h"
 #include "EPD_service.h"
+#include "EPD_trace.h"
 #include "nrf_log.h"
 
 #if defined(S112)
@@ -35,25 +39,198 @@
 extern uint32_t timestamp(void);
 extern void set_timestamp(uint32_t timestamp);
 extern void sleep_mode_enter(void);
+extern void link_bulk_mode(void);
+
+#define EPD_INGRESS_SIZE     1024 // bytes, a power of 2, also the credit window
+#define EPD_CREDIT_THRESHOLD 256  // freed bytes granted back in one notification, at most
+                                  // EPD_INGRESS_SIZE - the largest record, or the client stalls
+
+static ble_epd_t *m_epd = NULL;
+static uint8_t m_trace_data[EPD_TRACE_DATA_SIZE]; // value of the trace characteristic, kept here (BLE_GATTS_VLOC_USER)
+#if defined(S112)
+static uint8_t m_data_value[BLE_EPD_MAX_DATA_LEN]; // value of the data characteristic, not read, kept out of the attribute table
+#endif
+
+/**< Image write state, the PackBits decoder of EPD_CMD_WRITE_IMAGE_RLE and EPD_CMD_WRITE_REGION
+ *   keeps a run or literal across writes. */
+static struct
+{
+    uint8_t  literal;   // literal bytes still to come
+    uint8_t  run;       // repeat count waiting for its byte
+    uint16_t remaining; // bytes left in the ram plane or region, the rest is dropped
+    bool     region;    // a region window is open, closed with write_end
+} m_image;
+
+/**< Ingress buffer of the EPD and data characteristics: records of a length byte and the written data,
+ *   writes of the data characteristic start with an extra 0 byte. They are appended in the BLE event and
+ *   executed in order by epd_ingress_drain() from the scheduler, so SPI transfers, flash writes and BUSY
+ *   waits do not hold up the BLE events. */
+static app_fifo_t m_ingress;
+static uint8_t m_ingress_buf[EPD_INGRESS_SIZE];
+static volatile bool m_ingress_scheduled; // a drain is in the scheduler queue
+
+/**< Flow control of EPD_CMD_CREDIT. Every write after it costs the client its length + the record
+ *   header in credits, the space of executed records is granted back in batches. A grant
+ *   that finds no TX buffer stays pending and is sent again on the next TX complete event. */
+static struct
+{
+    bool     enabled;
+    bool     reply;     // EPD_CMD_CREDIT waits for its notification
+    uint16_t consumed;  // bytes freed since the last grant
+} m_credit;
+
+/**< Image upload session of EPD_CMD_UPLOAD_BEGIN. The stream (black plane, then red plane) goes to the
+ *   EPD ram as it arrives, the committed offset counts what is there. The session holds a reference
+ *   to the EPD pins, so the controller keeps its ram over a lost link until the client resumes or
+ *   EPD_UPLOAD_TIMEOUT passes without a connection. */
+static struct
+{
+    epd_upload_state_t state;
+    uint32_t id;
+    uint32_t length;
+    uint32_t crc;       // crc32 of the whole stream, from the client
+    uint32_t offset;    // committed offset
+    uint32_t value;     // crc32 of the stream up to the offset
+    uint8_t  flags;     // EPD_UPLOAD_FLAG_*
+    uint8_t  plane;     // 0 = black, 1 = red
+    uint16_t idle;      // seconds without a connection
+} m_upload;
+
+/**< Display list of MODE_LIST, written with EPD_CMD_LIST_WRITE, restored from flash on boot. */
+static epd_list_t m_list;
+
+/**< Slot values of the display list, written with EPD_CMD_SLOT_SET. */
+static epd_slots_t m_slots;
+
+#if EPD_SLOT_COUNT != LIST_SLOT_COUNT || EPD_SLOT_SIZE != LIST_SLOT_SIZE
+#error "slot store does not match GUI.h"
+#endif
+
+/**@brief Function for granting freed bytes as credits: EPD_CMD_CREDIT, credits (2 bytes).
+ *
+ * @details Called from the main loop and from the TX complete event.
+ */
+static void epd_credit_grant(ble_epd_t * p_epd, uint16_t freed, bool reply)
+{
+    CRITICAL_REGION_ENTER();
+    m_credit.consumed += freed;
+    m_credit.reply = m_credit.reply || reply;
+    uint16_t credits = m_credit.consumed;
+    uint8_t data[] = {EPD_CMD_CREDIT, credits >> 8, credits};
+    if (m_credit.enabled && (m_credit.reply || credits >= EPD_CREDIT_THRESHOLD) &&
+        ble_epd_string_send(p_epd, data, sizeof(data)) == NRF_SUCCESS)
+    {
+        m_credit.consumed = 0;
+        m_credit.reply = false;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+/**@brief Function for notifying the result of a display list command: cmd, status, list length (2 bytes). */
+static void epd_list_notify(ble_epd_t * p_epd, uint8_t cmd, bool success)
+{
+    uint8_t data[] = {cmd, success ? 0x00 : 0x01, m_list.length >> 8, m_list.length};
+    ble_epd_string_send(p_epd, data, sizeof(data));
+}
+
+/**@brief Function for notifying the result of a font command: cmd, status[, offset]. */
+static void epd_font_notify(uint8_t cmd, bool success, uint32_t offset)
+{
+    uint8_t data[] = {cmd, success ? 0x00 : 0x01, offset >> 24, offset >> 16, offset >> 8, offset};
+    if (m_epd == NULL) return;
+    ble_epd_string_send(m_epd, data, cmd == EPD_CMD_FONT_WRITE ? sizeof(data) : 2);
+}
+
+static void epd_font_evt_handler(epd_font_evt_t evt, uint32_t offset, bool success)
+{
+    EPD_TRACE(EPD_TRACE_FONT, evt, success);
+    switch (evt)
+    {
+        case EPD_FONT_EVT_ERASED:
+            // the items keep their font IDs, the fonts under them are gone
+            GUI_Invalidate();
+            epd_font_notify(EPD_CMD_FONT_ERASE, success, 0);
+            break;
+        case EPD_FONT_EVT_WRITTEN:
+            epd_font_notify(EPD_CMD_FONT_WRITE, success, offset);
+            break;
+        case EPD_FONT_EVT_COMMITTED:
+            if (success) GUI_Invalidate();
+            epd_font_notify(EPD_CMD_FONT_COMMIT, success, 0);
+            break;
+        default:
+            break;
+    }
+}
+
+// the save result of EPD_CMD_LIST_SHOW and EPD_CMD_SLOT_SET is notified once the record is in flash
+static void epd_config_evt_handler(epd_config_evt_t evt, bool success)
+{
+    if (m_epd == NULL) return;
+    epd_list_notify(m_epd, evt == EPD_CONFIG_EVT_LIST_SAVED ? EPD_CMD_LIST_SHOW : EPD_CMD_SLOT_SET, success);
+}
 
 static void epd_gui_update(void * p_event_data, uint16_t event_size)
 {
     epd_gui_update_event_t *event = (epd_gui_update_event_t *)p_event_data;
     ble_epd_t *p_epd = event->p_epd;
+    uint32_t start = epd_perf_now();
+
+    EPD_TRACE_AT(start, EPD_TRACE_GUI_BEGIN, p_epd->display_mode, 0);
+    // 屏幕断电后 RAM 内容丢失, 只能整屏重画
+    if (p_epd->config.en_pin != 0xFF)
+        GUI_Invalidate();
 
     EPD_GPIO_Init();
     epd_model_t *epd = epd_init((epd_model_id_t)p_epd->config.model_id);
+    uint32_t phase = epd_perf_now();
+    int8_t temperature = epd->drv->read_temp();
+    epd_perf_end(EPD_PERF_TEMP, phase);
+    EPD_TRACE(EPD_TRACE_TEMP, temperature, 0);
     gui_data_t data = {
         .bwr             = epd->bwr,
         .width           = epd->width,
         .height          = epd->height,
         .timestamp       = event->timestamp,
-        .temperature     = epd->drv->read_temp(),
+        .temperature     = temperature,
         .voltage         = EPD_ReadVoltage(),
+        .list            = m_list.data,
+        .list_len        = m_list.length,
+        .slots           = m_slots.data[0],
     };
-    DrawGUI(&data, epd->drv->write_image, p_epd->display_mode);
-    epd->drv->refresh();
+    gui_sink_t sink = {
+        .begin           = epd->drv->write_begin,
+        .write           = epd->drv->write_rows,
+        .end             = epd->drv->write_end,
+    };
+    // the pages are sent while drawing, render time is what is left without SPI
+    uint64_t spi_us = epd_perf_total(EPD_PERF_SPI);
+    phase = epd_perf_now();
+    bool dirty = DrawGUI(&data, &sink, p_epd->display_mode);
+    uint32_t render_us = epd_perf_since(phase);
+    spi_us = epd_perf_total(EPD_PERF_SPI) - spi_us;
+    epd_perf_add(EPD_PERF_RENDER, render_us > spi_us ? render_us - (uint32_t)spi_us : 0);
+    if (dirty) {
+        phase = epd_perf_now();
+        EPD_TRACE_AT(phase, EPD_TRACE_REFRESH_BEGIN, 0, 0);
+        epd->drv->refresh();
+        epd_perf_end(EPD_PERF_REFRESH, phase);
+        EPD_TRACE(EPD_TRACE_REFRESH_END, 0, 0);
+    }
     EPD_GPIO_Uninit();
+    epd_perf_end(EPD_PERF_GUI_UPDATE, start);
+    EPD_TRACE(EPD_TRACE_GUI_END, dirty, 0);
+}
+
+/**@brief Function for powering the EPD pins up or down from the scheduler, so the writes
+ *        buffered before a connection change are executed first.
+ */
+static void epd_gpio_update(void * p_event_data, uint16_t event_size)
+{
+    if (*(bool *)p_event_data)
+        EPD_GPIO_Init();
+    else
+        EPD_GPIO_Uninit();
 }
 
 /**@brief Function for handling the @ref BLE_GAP_EVT_CONNECTED event from the S110 SoftDevice.
@@ -63,8 +240,11 @@ static void epd_gui_update(void * p_event_data, uint16_t event_size)
  */
 static void on_connect(ble_epd_t * p_epd, ble_evt_t * p_ble_evt)
 {
+    bool connected = true;
+
     p_epd->conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
-    EPD_GPIO_Init();
+    EPD_TRACE(EPD_TRACE_CONNECT, 0, p_epd->conn_handle);
+    APP_ERROR_CHECK(app_sched_event_put(&connected, sizeof(connected), epd_gpio_update));
 }
 
 /**@brief Function for handling the @ref BLE_GAP_EVT_DISCONNECTED event from the S110 SoftDevice.
@@ -75,20 +255,193 @@ static void on_connect(ble_epd_t * p_epd, ble_evt_t * p_ble_evt)
 static void on_disconnect(ble_epd_t * p_epd, ble_evt_t * p_ble_evt)
 {
     UNUSED_PARAMETER(p_ble_evt);
+    bool connected = false;
+
     p_epd->conn_handle = BLE_CONN_HANDLE_INVALID;
+    memset(&m_credit, 0, sizeof(m_credit));
+    m_upload.idle = 0;
+    EPD_TRACE(EPD_TRACE_DISCONNECT, 0, 0);
+    APP_ERROR_CHECK(app_sched_event_put(&connected, sizeof(connected), epd_gpio_update));
+}
+
+/**@brief Function for decoding PackBits data straight to the EPD ram.
+ *
+ * @details Header n: 0..127 = n + 1 literal bytes follow, 129..255 = the next byte
+ *          repeated 257 - n times, 128 = no operation. Output goes through a small
+ *          buffer, so the RAM used does not depend on the image size.
+ *
+ * @return  Bytes of p_data decoded, the rest is past the end of the plane or region.
+ */
+static uint16_t epd_write_image_rle(uint8_t * p_data, uint16_t length)
+{
+    uint8_t buf[64];
+    uint8_t n = 0;
+    uint16_t size = length;
+
+    while (length > 0 && m_image.remaining > 0) {
+        uint8_t value = *p_data++;
+        length--;
+        if (m_image.literal > 0) {
+            m_image.literal--;
+            m_image.remaining--;
+            buf[n++] = value;
+        } else if (m_image.run > 0) {
+            uint8_t count = m_image.run < m_image.remaining ? m_image.run : m_image.remaining;
+            m_image.remaining -= count;
+            m_image.run = 0;
+            while (count > 0) {
+                uint8_t k = sizeof(buf) - n < count ? sizeof(buf) - n : count;
+                memset(&buf[n], value, k);
+                n += k;
+                count -= k;
+                if (n == sizeof(buf)) {
+                    EPD_WriteBuffer(buf, n);
+                    n = 0;
+                }
+            }
+        } else if (value < 128) {
+            m_image.literal = value + 1;
+        } else if (value > 128) {
+            m_image.run = 257 - value;
+        }
+        if (n == sizeof(buf)) {
+            EPD_WriteBuffer(buf, n);
+            n = 0;
+        }
+    }
+    if (n > 0) EPD_WriteBuffer(buf, n);
+    return size - length;
+}
+
+/**@brief Function for closing an open region window and resetting the decoder. */
+static void epd_image_end(ble_epd_t * p_epd)
+{
+    if (m_image.region && p_epd->epd->drv->write_end != NULL)
+        p_epd->epd->drv->write_end();
+    memset(&m_image, 0, sizeof(m_image));
+}
+
+/**@brief Function for reading a region: x, y, w, h (2 bytes each), x and w byte aligned. */
+static bool epd_region_parse(epd_model_t * epd, uint8_t * p_data, uint16_t length, uint16_t region[4])
+{
+    if (length < 8) return false;
+    for (uint8_t i = 0; i < 4; i++)
+        region[i] = (p_data[i * 2] << 8) | p_data[i * 2 + 1];
+    return region[0] % 8 == 0 && region[2] % 8 == 0 && region[2] > 0 && region[3] > 0 &&
+           region[0] + region[2] <= epd->width && region[1] + region[3] <= epd->height;
+}
+
+/**@brief Function for notifying the upload session: cmd, state, id (4 bytes), committed offset (4 bytes). */
+static void epd_upload_notify(ble_epd_t * p_epd, uint8_t cmd)
+{
+    uint32_t id = m_upload.id, offset = m_upload.offset;
+    uint8_t data[] = {cmd, m_upload.state, id >> 24, id >> 16, id >> 8, id, offset >> 24, offset >> 16, offset >> 8, offset};
+    ble_epd_string_send(p_epd, data, sizeof(data));
+}
+
+/**@brief Function for dropping the upload session and its reference to the EPD pins. */
+static void epd_upload_close(void)
+{
+    if (m_upload.state == EPD_UPLOAD_NONE) return;
+    memset(&m_upload, 0, sizeof(m_upload));
     EPD_GPIO_Uninit();
 }
 
+/**@brief Function for opening an upload session: id, length, crc32 (4 bytes each), flags.
+ *
+ * @details The session of the same id, length, crc32 and flags is kept, its committed offset
+ *          tells the client where to resume. Raw data must fill the planes exactly.
+ */
+static void epd_upload_begin(ble_epd_t * p_epd, uint8_t * p_data, uint16_t length)
+{
+    uint32_t id = ((uint32_t)p_data[0] << 24) | (p_data[1] << 16) | (p_data[2] << 8) | p_data[3];
+    uint32_t size = ((uint32_t)p_data[4] << 24) | (p_data[5] << 16) | (p_data[6] << 8) | p_data[7];
+    uint32_t crc = ((uint32_t)p_data[8] << 24) | (p_data[9] << 16) | (p_data[10] << 8) | p_data[11];
+    uint8_t flags = length > 12 ? p_data[12] : 0;
+    uint16_t plane = p_epd->epd->width / 8 * p_epd->epd->height;
+
+    if ((m_upload.state == EPD_UPLOAD_OPEN || m_upload.state == EPD_UPLOAD_DONE) && m_upload.id == id &&
+        m_upload.length == size && m_upload.crc == crc && m_upload.flags == flags)
+        return;
+
+    epd_upload_close();
+    epd_image_end(p_epd);
+    if (size == 0 || (!(flags & EPD_UPLOAD_FLAG_RLE) && size != plane * ((flags & EPD_UPLOAD_FLAG_RED) ? 2u : 1u)))
+        return;
+
+    EPD_GPIO_Init();
+    GUI_Invalidate();
+    p_epd->display_mode = MODE_NONE; // no GUI update in between, it would reset the controller
+    EPD_WriteCommand(p_epd->epd->drv->cmd_write_ram1);
+    m_image.remaining = plane;
+    m_upload.state = EPD_UPLOAD_OPEN;
+    m_upload.id = id;
+    m_upload.length = size;
+    m_upload.crc = crc;
+    m_upload.flags = flags;
+}
+
+/**@brief Function for writing session data at the committed offset, the red plane follows the black one. */
+static void epd_upload_write(ble_epd_t * p_epd, uint8_t * p_data, uint16_t length)
+{
+    m_upload.value = crc32_compute(p_data, length, m_upload.offset > 0 ? &m_upload.value : NULL);
+    m_upload.offset += length;
+
+    while (length > 0) {
+        uint16_t n;
+        if (m_image.remaining == 0) {
+            if (m_upload.plane > 0 || !(m_upload.flags & EPD_UPLOAD_FLAG_RED)) break;
+            m_upload.plane++;
+            EPD_WriteCommand(p_epd->epd->drv->cmd_write_ram2);
+            m_image.remaining = p_epd->epd->width / 8 * p_epd->epd->height;
+        }
+        if (m_upload.flags & EPD_UPLOAD_FLAG_RLE) {
+            n = epd_write_image_rle(p_data, length);
+        } else {
+            n = length < m_image.remaining ? length : m_image.remaining;
+            EPD_WriteBuffer(p_data, n);
+            m_image.remaining -= n;
+        }
+        p_data += n;
+        length -= n;
+    }
+    if (m_upload.offset == m_upload.length)
+        m_upload.state = m_upload.value == m_upload.crc ? EPD_UPLOAD_DONE : EPD_UPLOAD_CRC_ERROR;
+}
+
+/**@brief Function for writing a write of the data characteristic to the open upload session,
+ *        at the committed offset. Data without an open session or past its length is dropped.
+ */
+static void epd_upload_stream(ble_epd_t * p_epd, uint8_t * p_data, uint16_t length)
+{
+    link_bulk_mode();
+    if (m_upload.state != EPD_UPLOAD_OPEN || length > m_upload.length - m_upload.offset) return;
+
+    uint32_t start = epd_perf_now();
+    epd_upload_write(p_epd, p_data, length);
+    epd_perf_end(EPD_PERF_WRITE_IMAGE, start);
+}
+
 static void epd_service_on_write(ble_epd_t * p_epd, uint8_t * p_data, uint16_t length)
 {
-    NRF_LOG_DEBUG("[EPD]: on_write LEN=%d\n", length);
-    NRF_LOG_HEXDUMP_DEBUG(p_data, length);
     if (p_data == NULL || length <= 0) return;
 
+    // uploads run with the bulk transfer link parameters
+    if (p_data[0] == EPD_CMD_SEND_DATA || p_data[0] == EPD_CMD_WRITE_IMAGE || p_data[0] == EPD_CMD_WRITE_IMAGE_RLE ||
+        p_data[0] == EPD_CMD_WRITE_REGION || p_data[0] == EPD_CMD_UPLOAD_DATA || p_data[0] == EPD_CMD_FONT_WRITE)
+        link_bulk_mode();
+
+    // anything else may use the controller, an open upload session is given up
+    if (m_upload.state != EPD_UPLOAD_NONE && p_data[0] != EPD_CMD_UPLOAD_BEGIN && p_data[0] != EPD_CMD_UPLOAD_DATA &&
+        p_data[0] != EPD_CMD_UPLOAD_STATUS && p_data[0] != EPD_CMD_LINK_INFO && p_data[0] != EPD_CMD_CREDIT &&
+        p_data[0] != EPD_CMD_BATCH)
+        epd_upload_close();
+
     switch (p_data[0])
     {
       case EPD_CMD_SET_PINS:
           if (length < 8) return;
+          GUI_Invalidate();
 
           p_epd->config.mosi_pin = p_data[1];
           p_epd->config.sclk_pin = p_data[2];
@@ -113,31 +466,77 @@ static void epd_service_on_write(ble_epd_t * p_epd, uint8_t * p_data, uint16_t l
               epd_config_write(&p_epd->config);
           }
           p_epd->epd = epd_init((epd_model_id_t)id);
+          GUI_Invalidate();
         } break;
 
       case EPD_CMD_CLEAR:
+          if (p_epd->epd == NULL) return; // EPD_CMD_INIT not received yet
+          GUI_Invalidate();
           p_epd->display_mode = MODE_NONE;
           p_epd->epd->drv->clear();
           break;
 
       case EPD_CMD_SEND_COMMAND:
           if (length < 2) return;
+          GUI_Invalidate();
           EPD_WriteCommand(p_data[1]);
           break;
 
       case EPD_CMD_SEND_DATA:
+          GUI_Invalidate();
           EPD_WriteData(&p_data[1], length - 1);
           break;
 
       case EPD_CMD_REFRESH:
+      case EPD_CMD_REFRESH_REGION: { // x, y, w, h (2 bytes each)
+          uint16_t region[4];
+          if (p_epd->epd == NULL) return;
+          bool partial = p_data[0] == EPD_CMD_REFRESH_REGION;
+          if (partial && !epd_region_parse(p_epd->epd, &p_data[1], length - 1, region)) return;
+          epd_image_end(p_epd);
           p_epd->display_mode = MODE_NONE;
-          p_epd->epd->drv->refresh();
-          break;
+          uint32_t start = epd_perf_now();
+          EPD_TRACE_AT(start, EPD_TRACE_REFRESH_BEGIN, 0, 0);
+          if (partial && p_epd->epd->drv->refresh_region != NULL)
+              p_epd->epd->drv->refresh_region(region[0], region[1], region[2], region[3]);
+          else
+              p_epd->epd->drv->refresh();
+          epd_perf_end(EPD_PERF_REFRESH, start);
+          EPD_TRACE(EPD_TRACE_REFRESH_END, 0, 0);
+        } break;
 
       case EPD_CMD_SLEEP:
+          if (p_epd->epd == NULL) return;
+          GUI_Invalidate();
           p_epd->epd->drv->sleep();
           break;
 
+      case EPD_CMD_LINK_INFO:
+          ble_epd_link_notify(p_epd);
+          break;
+
+      case EPD_CMD_CREDIT:
+          // the first reply grants the whole buffer, later ones what is freed so far
+          if (!m_credit.enabled)
+          {
+              m_credit.enabled = true;
+              m_credit.consumed = EPD_INGRESS_SIZE;
+          }
+          epd_credit_grant(p_epd, 0, true);
+          break;
+
+      case EPD_CMD_BATCH: { // length (1 byte) + command, repeated
+          uint16_t i;
+          // a command past the end of the write, a nested batch or a credit request drops the whole batch
+          for (i = 1; i < length; i += 1 + p_data[i]) {
+              if (p_data[i] == 0 || i + 1 + p_data[i] > length || p_data[i + 1] == EPD_CMD_BATCH ||
+                  p_data[i + 1] == EPD_CMD_CREDIT)
+                  return;
+          }
+          for (i = 1; i < length; i += 1 + p_data[i])
+              epd_service_on_write(p_epd, &p_data[i + 1], p_data[i]);
+        } break;
+
       case EPD_CMD_SET_TIME: {
           if (length < 5) return;
 
@@ -148,20 +547,137 @@ static void epd_service_on_write(ble_epd_t * p_epd, uint8_t * p_data, uint16_t l
           timestamp += (length > 5 ? (int8_t)p_data[5] : 8) * 60 * 60; // timezone
           set_timestamp(timestamp);
           p_epd->display_mode = length > 6 ? (display_mode_t)p_data[6] : MODE_CALENDAR;
+          GUI_Invalidate(); // 同步时间时整屏重画一次
           ble_epd_on_timer(p_epd, timestamp, true);
       } break;
 
-      case EPD_CMD_WRITE_IMAGE: // MSB=0000: ram begin, LSB=1111: black
+      case EPD_CMD_LIST_WRITE: { // offset (2 bytes) + data, the list ends after it
           if (length < 3) return;
+          uint16_t offset = (p_data[1] << 8) | p_data[2];
+          if (offset > m_list.length || offset + length - 3 > EPD_LIST_SIZE) {
+              epd_list_notify(p_epd, EPD_CMD_LIST_WRITE, false);
+              return;
+          }
+          memcpy(&m_list.data[offset], &p_data[3], length - 3);
+          m_list.length = offset + length - 3;
+      } break;
+
+      case EPD_CMD_LIST_SHOW: { // flags, only the changed items are redrawn
+          if (length < 2 || !(p_data[1] & EPD_LIST_FLAG_SAVE))
+              epd_list_notify(p_epd, EPD_CMD_LIST_SHOW, true);
+          else if (!epd_list_write(&m_list))
+              epd_list_notify(p_epd, EPD_CMD_LIST_SHOW, false);
+          p_epd->display_mode = MODE_LIST;
+          ble_epd_on_timer(p_epd, timestamp(), true);
+      } break;
+
+      case EPD_CMD_SLOT_SET: { // flags + (slot + length + value)..., all or none are set
+          if (length < 2) return;
+          uint16_t i = 2;
+          while (i + 2 <= length && p_data[i] < EPD_SLOT_COUNT && p_data[i + 1] < EPD_SLOT_SIZE &&
+                 i + 2 + p_data[i + 1] <= length)
+              i += 2 + p_data[i + 1];
+          // a save still running refuses the values as well, they are set and saved together
+          bool save = p_data[1] & EPD_LIST_FLAG_SAVE;
+          if (i != length || (save && epd_config_saving())) {
+              epd_list_notify(p_epd, EPD_CMD_SLOT_SET, false);
+              return;
+          }
+          for (i = 2; i < length; i += 2 + p_data[i + 1])
+              memcpy(m_slots.data[p_data[i]], &p_data[i + 1], 1 + p_data[i + 1]);
+          if (!save)
+              epd_list_notify(p_epd, EPD_CMD_SLOT_SET, true);
+          else if (!epd_slots_write(&m_slots))
+              epd_list_notify(p_epd, EPD_CMD_SLOT_SET, false);
+          p_epd->display_mode = MODE_LIST;
+          ble_epd_on_timer(p_epd, timestamp(), true);
+      } break;
+
+      case EPD_CMD_WRITE_IMAGE:       // MSB=0000: ram begin, LSB=1111: black
+      case EPD_CMD_WRITE_IMAGE_RLE: { // same flag, data is PackBits compressed
+          if (length < 3 || p_epd->epd == NULL) return;
+          uint32_t start = epd_perf_now();
+          GUI_Invalidate();
           if ((p_data[1] >> 4) == 0x00) {
               bool black = (p_data[1] & 0x0F) == 0x0F;
+              epd_image_end(p_epd);
               EPD_WriteCommand(black ? p_epd->epd->drv->cmd_write_ram1 : p_epd->epd->drv->cmd_write_ram2);
+              m_image.remaining = p_epd->epd->width / 8 * p_epd->epd->height;
+          }
+          if (p_data[0] == EPD_CMD_WRITE_IMAGE_RLE)
+              epd_write_image_rle(&p_data[2], length - 2);
+          else
+              EPD_WriteData(&p_data[2], length - 2);
+          epd_perf_end(EPD_PERF_WRITE_IMAGE, start);
+        } break;
+
+      case EPD_CMD_WRITE_REGION: { // flag as WRITE_IMAGE, x, y, w, h (2 bytes each) on ram begin, PackBits data
+          uint16_t region[4];
+          uint16_t offset = 2;
+          if (length < 3 || p_epd->epd == NULL || p_epd->epd->drv->write_ram == NULL) return;
+          uint32_t start = epd_perf_now();
+          GUI_Invalidate();
+          if ((p_data[1] >> 4) == 0x00) {
+              bool black = (p_data[1] & 0x0F) == 0x0F;
+              epd_image_end(p_epd);
+              if (!epd_region_parse(p_epd->epd, &p_data[2], length - 2, region)) return;
+              p_epd->epd->drv->write_ram(black ? p_epd->epd->drv->cmd_write_ram1 : p_epd->epd->drv->cmd_write_ram2,
+                                         region[0], region[1], region[2], region[3]);
+              m_image.remaining = region[2] / 8 * region[3];
+              m_image.region = true;
+              offset += 8;
+          }
+          epd_write_image_rle(&p_data[offset], length - offset);
+          if (m_image.region && m_image.remaining == 0) epd_image_end(p_epd);
+          epd_perf_end(EPD_PERF_WRITE_IMAGE, start);
+        } break;
+
+      case EPD_CMD_UPLOAD_BEGIN: // id, length, crc32 (4 bytes each), flags
+          if (length < 13 || p_epd->epd == NULL) return;
+          epd_upload_begin(p_epd, &p_data[1], length - 1);
+          m_upload.idle = 0;
+          epd_upload_notify(p_epd, EPD_CMD_UPLOAD_BEGIN);
+          break;
+
+      case EPD_CMD_UPLOAD_DATA: { // offset (4 bytes) + data, refused with a notification off the committed offset
+          if (length < 6) return;
+          uint32_t offset = (p_data[1] << 24) | (p_data[2] << 16) | (p_data[3] << 8) | p_data[4];
+          if (m_upload.state != EPD_UPLOAD_OPEN || offset != m_upload.offset ||
+              length - 5u > m_upload.length - m_upload.offset) {
+              epd_upload_notify(p_epd, EPD_CMD_UPLOAD_DATA);
+              return;
           }
-          EPD_WriteData(&p_data[2], length - 2);
+          uint32_t start = epd_perf_now();
+          epd_upload_write(p_epd, &p_data[5], length - 5);
+          epd_perf_end(EPD_PERF_WRITE_IMAGE, start);
+        } break;
+
+      case EPD_CMD_UPLOAD_STATUS:
+          epd_upload_notify(p_epd, EPD_CMD_UPLOAD_STATUS);
+          break;
+
+      case EPD_CMD_FONT_ERASE:
+          if (epd_font_erase() != NRF_SUCCESS)
+              epd_font_notify(EPD_CMD_FONT_ERASE, false, 0);
           break;
 
+      case EPD_CMD_FONT_WRITE: { // offset (4 bytes) + data
+          if (length < 6) return;
+          uint32_t offset = (p_data[1] << 24) | (p_data[2] << 16) | (p_data[3] << 8) | p_data[4];
+          if (epd_font_write(offset, &p_data[5], length - 5) != NRF_SUCCESS)
+              epd_font_notify(EPD_CMD_FONT_WRITE, false, offset);
+      } break;
+
+      case EPD_CMD_FONT_COMMIT: { // crc32 (4 bytes)
+          if (length < 5) return;
+          uint32_t crc = ((uint32_t)p_data[1] << 24) | (p_data[2] << 16) | (p_data[3] << 8) | p_data[4];
+          if (epd_font_commit(crc) != NRF_SUCCESS)
+              epd_font_notify(EPD_CMD_FONT_COMMIT, false, 0);
+      } break;
+
       case EPD_CMD_SET_CONFIG:
           if (length < 2) return;
+          GUI_Invalidate();
           memcpy(&p_epd->config, &p_data[1], (length - 1 > EPD_CONFIG_SIZE) ? EPD_CONFIG_SIZE : length - 1);
           epd_config_write(&p_epd->config);
           break;
@@ -189,6 +705,72 @@ static void epd_service_on_write(ble_epd_t * p_epd, uint8_t * p_data, uint16_t l
     }
 }
 
+/**@brief Function for executing the buffered writes in order, from the scheduler. */
+static void epd_ingress_drain(void * p_event_data, uint16_t event_size)
+{
+    ble_epd_t * p_epd = *(ble_epd_t **)p_event_data;
+    uint8_t data[UINT8_MAX];
+    uint8_t length;
+    uint32_t size = sizeof(length);
+
+    m_ingress_scheduled = false; // writes from now on schedule another drain
+    while (app_fifo_read(&m_ingress, &length, &size) == NRF_SUCCESS)
+    {
+        bool raw = length == 0;
+        if (raw)
+            app_fifo_read(&m_ingress, &length, &size);
+        size = length;
+        app_fifo_read(&m_ingress, data, &size);
+
+        uint8_t cmd = raw ? 0 : data[0];
+        if (raw)
+        {
+            EPD_TRACE(EPD_TRACE_DATA, 0, length);
+            epd_upload_stream(p_epd, data, length);
+        }
+        else
+        {
+            uint32_t start = epd_perf_now();
+            EPD_TRACE_AT(start, EPD_TRACE_WRITE, cmd, length);
+            epd_service_on_write(p_epd, data, length);
+            epd_perf_end(EPD_PERF_ON_WRITE, start);
+            EPD_TRACE(EPD_TRACE_WRITE_END, cmd, 0);
+        }
+        if (m_credit.enabled && (raw || cmd != EPD_CMD_CREDIT))
+            epd_credit_grant(p_epd, length + (raw ? 2 : 1), false);
+        size = sizeof(length);
+    }
+}
+
+/**@brief Function for appending a write to the ingress buffer, from the BLE event.
+ *
+ * @details A client without flow control can outrun a long command, its write is dropped
+ *          when the buffer is full. The drain is scheduled before the write is buffered, a
+ *          write that finds the scheduler queue full is dropped the same way instead of
+ *          waiting in the buffer for a later write that may never come.
+ *
+ * @param[in] raw  The write is from the data characteristic.
+ */
+static void epd_ingress_put(ble_epd_t * p_epd, uint8_t * p_data, uint16_t length, bool raw)
+{
+    uint8_t header[] = {0, length};
+    uint32_t size = 0;
+
+    if (length == 0 || length > UINT8_MAX) return;
+    if (app_fifo_write(&m_ingress, NULL, &size) != NRF_SUCCESS || size < length + (raw ? 2u : 1u) ||
+        (!m_ingress_scheduled && app_sched_event_put(&p_epd, sizeof(p_epd), epd_ingress_drain) != NRF_SUCCESS))
+    {
+        NRF_LOG_WARNING("ingress full, %d bytes dropped\n", length);
+        EPD_TRACE(EPD_TRACE_OVERRUN, raw ? 0 : p_data[0], length);
+        return;
+    }
+    m_ingress_scheduled = true;
+    size = raw ? 2 : 1;
+    app_fifo_write(&m_ingress, raw ? header : &header[1], &size);
+    size = length;
+    app_fifo_write(&m_ingress, p_data, &size);
+}
+
 /**@brief Function for handling the @ref BLE_GATTS_EVT_WRITE event from the S110 SoftDevice.
  *
  * @param[in] p_epd     EPD Service structure.
@@ -213,6 +795,7 @@ static void on_write(ble_epd_t * p_epd, ble_evt_t * p_ble_evt)
             uint32_t err_code = ble_epd_string_send(p_epd, (uint8_t *)&p_epd->config, length);
             if (err_code != NRF_ERROR_INVALID_STATE)
                 APP_ERROR_CHECK(err_code);
+            ble_epd_link_notify(p_epd);
         }
         else
         {
@@ -221,7 +804,11 @@ static void on_write(ble_epd_t * p_epd, ble_evt_t * p_ble_evt)
     }
     else if (p_evt_write->handle == p_epd->char_handles.value_handle)
     {
-        epd_service_on_write(p_epd, p_evt_write->data, p_evt_write->len);
+        epd_ingress_put(p_epd, p_evt_write->data, p_evt_write->len, false);
+    }
+    else if (p_evt_write->handle == p_epd->data_handles.value_handle)
+    {
+        epd_ingress_put(p_epd, p_evt_write->data, p_evt_write->len, true);
     }
     else
     {
@@ -229,6 +816,47 @@ static void on_write(ble_epd_t * p_epd, ble_evt_t * p_ble_evt)
     }
 }
 
+/**@brief Function for handling the @ref BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST event from the S110 SoftDevice.
+ *
+ * @details The perf and trace characteristics are read with authorization, a read at offset 0
+ *          takes a new snapshot. Long reads continue from the stored value.
+ *
+ * @param[in] p_epd     EPD Service structure.
+ * @param[in] p_ble_evt Pointer to the event received from BLE stack.
+ */
+static void on_rw_authorize_request(ble_epd_t * p_epd, ble_evt_t * p_ble_evt)
+{
+    ble_gatts_evt_rw_authorize_request_t * p_req = &p_ble_evt->evt.gatts_evt.params.authorize_request;
+    ble_gatts_rw_authorize_reply_params_t reply;
+    static uint8_t data[EPD_PERF_DATA_SIZE];
+
+    if (p_req->type != BLE_GATTS_AUTHORIZE_TYPE_READ) return;
+
+    memset(&reply, 0, sizeof(reply));
+    reply.type = BLE_GATTS_AUTHORIZE_TYPE_READ;
+    reply.params.read.gatt_status = BLE_GATT_STATUS_SUCCESS;
+    if (p_req->request.read.handle == p_epd->perf_handles.value_handle)
+    {
+        if (p_req->request.read.offset == 0)
+        {
+            reply.params.read.update = 1;
+            reply.params.read.len    = epd_perf_encode(data, sizeof(data));
+            reply.params.read.p_data = data;
+        }
+    }
+    else if (p_req->request.read.handle == p_epd->trace_handles.value_handle)
+    {
+        // the value is in m_trace_data, updated in place
+        if (p_req->request.read.offset == 0)
+            epd_trace_encode(m_trace_data, sizeof(m_trace_data));
+    }
+    else
+    {
+        return;
+    }
+    APP_ERROR_CHECK(sd_ble_gatts_rw_authorize_reply(p_ble_evt->evt.gatts_evt.conn_handle, &reply));
+}
+
 #if defined(S112)
 void ble_epd_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 {
@@ -260,6 +888,18 @@ void ble_epd_on_ble_evt(ble_epd_t * p_epd, ble_evt_t * p_ble_evt)
             on_write(p_epd, p_ble_evt);
             break;
 
+        case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
+            on_rw_authorize_request(p_epd, p_ble_evt);
+            break;
+
+#if defined(S112)
+        case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+#else
+        case BLE_EVT_TX_COMPLETE:
+#endif
+            epd_credit_grant(p_epd, 0, false);
+            break;
+
         default:
             // No implementation needed.
             break;
@@ -306,7 +946,47 @@ static uint32_t epd_service_init(ble_epd_t * p_epd)
     add_char_params.char_props.read          = 1;
     add_char_params.read_access              = SEC_OPEN;
 
-    return characteristic_add(p_epd->service_handle, &add_char_params, &p_epd->app_ver_handles);
+    VERIFY_SUCCESS(characteristic_add(p_epd->service_handle, &add_char_params, &p_epd->app_ver_handles));
+
+    memset(&add_char_params, 0, sizeof(add_char_params));
+    add_char_params.uuid                     = BLE_UUID_EPD_PERF;
+    add_char_params.uuid_type                = ble_uuid.type;
+    add_char_params.max_len                  = EPD_PERF_DATA_SIZE;
+    add_char_params.init_len                 = 0;
+    add_char_params.is_var_len               = true;
+    add_char_params.is_defered_read          = true;
+    add_char_params.char_props.read          = 1;
+    add_char_params.read_access              = SEC_OPEN;
+
+    VERIFY_SUCCESS(characteristic_add(p_epd->service_handle, &add_char_params, &p_epd->perf_handles));
+
+    memset(&add_char_params, 0, sizeof(add_char_params));
+    add_char_params.uuid                     = BLE_UUID_EPD_TRACE;
+    add_char_params.uuid_type                = ble_uuid.type;
+    add_char_params.max_len                  = EPD_TRACE_DATA_SIZE;
+    add_char_params.init_len                 = EPD_TRACE_DATA_SIZE;
+    add_char_params.p_init_value             = m_trace_data;
+    add_char_params.is_value_user            = true;
+    add_char_params.is_defered_read          = true;
+    add_char_params.char_props.read          = 1;
+    add_char_params.read_access              = SEC_OPEN;
+
+    VERIFY_SUCCESS(characteristic_add(p_epd->service_handle, &add_char_params, &p_epd->trace_handles));
+
+    memset(&add_char_params, 0, sizeof(add_char_params));
+    add_char_params.uuid                     = BLE_UUID_EPD_DATA;
+    add_char_params.uuid_type                = ble_uuid.type;
+    add_char_params.max_len                  = BLE_EPD_MAX_DATA_LEN;
+    add_char_params.init_len                 = 0;
+    add_char_params.is_var_len               = true;
+#if defined(S112)
+    add_char_params.p_init_value             = m_data_value;
+    add_char_params.is_value_user            = true;
+#endif
+    add_char_params.char_props.write_wo_resp = 1;
+    add_char_params.write_access             = SEC_OPEN;
+
+    return characteristic_add(p_epd->service_handle, &add_char_params, &p_epd->data_handles);
 }
 
 void ble_epd_sleep_prepare(ble_epd_t * p_epd)
@@ -328,9 +1008,22 @@ uint32_t ble_epd_init(ble_epd_t * p_epd)
     p_epd->max_data_len = BLE_EPD_MAX_DATA_LEN;
     p_epd->conn_handle             = BLE_CONN_HANDLE_INVALID;
     p_epd->is_notification_enabled = false;
+    memset(&m_credit, 0, sizeof(m_credit));
+    memset(&m_upload, 0, sizeof(m_upload));
+    m_ingress_scheduled = false;
+    VERIFY_SUCCESS(app_fifo_init(&m_ingress, m_ingress_buf, sizeof(m_ingress_buf)));
+    epd_perf_init();
+    epd_trace_init();
 
-    epd_config_init(&p_epd->config);
+    m_epd = p_epd;
+    epd_config_init(&p_epd->config, epd_config_evt_handler);
     epd_config_read(&p_epd->config);
+    epd_list_read(&m_list);
+    epd_slots_read(&m_slots);
+
+    // font pack, the flash pages are assigned by fds_init() on SDK 12
+    epd_font_init(epd_font_evt_handler);
+    GUI_SetFontLoader(epd_font_get);
     
     // write default config
     if (epd_config_empty(&p_epd->config))
@@ -369,13 +1062,34 @@ uint32_t ble_epd_string_send(ble_epd_t * p_epd, uint8_t * p_string, uint16_t len
     return sd_ble_gatts_hvx(p_epd->conn_handle, &hvx_params);
 }
 
+uint32_t ble_epd_link_notify(ble_epd_t * p_epd)
+{
+    uint16_t mtu = p_epd->max_data_len + 3;
+    uint8_t data[] = {EPD_CMD_LINK_INFO, mtu >> 8, mtu};
+    return ble_epd_string_send(p_epd, data, sizeof(data));
+}
+
+/**@brief Function for dropping an upload session the client did not come back for, from the scheduler. */
+static void epd_upload_expire(void * p_event_data, uint16_t event_size)
+{
+    ble_epd_t * p_epd = *(ble_epd_t **)p_event_data;
+
+    if (p_epd->conn_handle == BLE_CONN_HANDLE_INVALID)
+        epd_upload_close();
+}
+
 void ble_epd_on_timer(ble_epd_t * p_epd, uint32_t timestamp, bool force_update)
 {
+    if (!force_update && m_upload.state != EPD_UPLOAD_NONE && p_epd->conn_handle == BLE_CONN_HANDLE_INVALID &&
+        ++m_upload.idle == EPD_UPLOAD_TIMEOUT)
+        app_sched_event_put(&p_epd, sizeof(p_epd), epd_upload_expire);
+
     // Update calendar on 00:00:00, clock on every minute
     if (force_update || 
         (p_epd->display_mode == MODE_CALENDAR && timestamp % 86400 == 0) ||
         (p_epd->display_mode == MODE_CLOCK && timestamp % 60 == 0)) {
         epd_gui_update_event_t event = { p_epd, timestamp };
+        EPD_TRACE(EPD_TRACE_SCHED, p_epd->display_mode, 0);
         app_sched_event_put(&event, sizeof(epd_gui_update_event_t), epd_gui_update);
     }
 }
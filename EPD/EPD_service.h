@@ -23,6 +23,7 @@
 #include "sdk_config.h"
 #include "EPD_driver.h"
 #include "EPD_config.h"
+#include "EPD_font.h"
 #include "GUI.h"
 
 /**@brief   Macro for defining a ble_hts instance.
@@ -43,13 +44,16 @@ void ble_epd_evt_handler(ble_evt_t const * p_ble_evt, void * p_context);
 #define BLE_EPD_DEF(_name) static ble_epd_t _name;
 #endif
 
-#define APP_VERSION 0x16
+#define APP_VERSION 0x24
 
 #define BLE_UUID_EPD_SVC_BASE              {{0XEC, 0X5A, 0X67, 0X1C, 0XC1, 0XB6, 0X46, 0XFB, \
                                              0X8D, 0X91, 0X28, 0XD8, 0X22, 0X36, 0X75, 0X62}}
 #define BLE_UUID_EPD_SVC                   0x0001
 #define BLE_UUID_EPD_CHAR                  0x0002
 #define BLE_UUID_APP_VER                   0x0003
+#define BLE_UUID_EPD_PERF                  0x0004
+#define BLE_UUID_EPD_TRACE                 0x0005
+#define BLE_UUID_EPD_DATA                  0x0006
 
 #define EPD_SVC_UUID_TYPE BLE_UUID_TYPE_VENDOR_BEGIN
 
@@ -69,10 +73,26 @@ enum EPD_CMDS
     EPD_CMD_SEND_DATA    = 0x04,                        /**< send data to EPD */
     EPD_CMD_REFRESH      = 0x05,                        /**< diaplay EPD ram on screen */
     EPD_CMD_SLEEP        = 0x06,                        /**< EPD enter sleep mode */
+    EPD_CMD_LINK_INFO    = 0x07,                        /**< notify the ATT MTU of the link */
+    EPD_CMD_CREDIT       = 0x08,                        /**< start flow control, credits are notified */
+    EPD_CMD_BATCH        = 0x09,                        /**< execute length prefixed commands in order */
 
 	EPD_CMD_SET_TIME     = 0x20,                        /** < set time with unix timestamp */
+    EPD_CMD_LIST_WRITE   = 0x21,                        /** < write display list data at offset */
+    EPD_CMD_LIST_SHOW    = 0x22,                        /** < draw the display list, optionally save it to flash */
+    EPD_CMD_SLOT_SET     = 0x23,                        /** < set slot values of the display list and draw it */
 
     EPD_CMD_WRITE_IMAGE  = 0x30,                        /** < write image data to EPD ram */
+    EPD_CMD_WRITE_IMAGE_RLE = 0x31,                     /** < write PackBits compressed image data to EPD ram */
+    EPD_CMD_WRITE_REGION = 0x32,                        /** < write PackBits compressed image data to a window of EPD ram */
+    EPD_CMD_REFRESH_REGION = 0x33,                      /** < display a window of EPD ram on screen */
+    EPD_CMD_UPLOAD_BEGIN = 0x34,                        /** < open or resume an image upload session */
+    EPD_CMD_UPLOAD_DATA  = 0x35,                        /** < write session data at the committed offset */
+    EPD_CMD_UPLOAD_STATUS = 0x36,                       /** < notify the session state and committed offset */
+
+    EPD_CMD_FONT_ERASE   = 0x40,                        /**< erase font pack */
+    EPD_CMD_FONT_WRITE   = 0x41,                        /**< write font pack data at offset */
+    EPD_CMD_FONT_COMMIT  = 0x42,                        /**< verify font pack crc and enable it */
 
     EPD_CMD_SET_CONFIG   = 0x90,                        /**< set full EPD config */
     EPD_CMD_SYS_RESET    = 0x91,                        /**< MCU reset */
@@ -80,6 +100,22 @@ enum EPD_CMDS
     EPD_CMD_CFG_ERASE    = 0x99,                        /**< Erase config and reset */
 };
 
+/**< Image upload session states, notified by the EPD_CMD_UPLOAD_* commands. */
+typedef enum
+{
+    EPD_UPLOAD_NONE,                                    /**< no session, or the begin was refused */
+    EPD_UPLOAD_OPEN,                                    /**< data expected at the committed offset */
+    EPD_UPLOAD_DONE,                                    /**< all data in the EPD ram, crc matches */
+    EPD_UPLOAD_CRC_ERROR,                               /**< all data received, crc does not match */
+} epd_upload_state_t;
+
+#define EPD_UPLOAD_FLAG_RLE  0x01                       /**< the stream is PackBits compressed, per plane */
+#define EPD_UPLOAD_FLAG_RED  0x02                       /**< the red plane follows the black one */
+#define EPD_UPLOAD_TIMEOUT   60                         /**< seconds without a connection before a session is dropped */
+
+#define EPD_LIST_FLAG_SAVE   0x01                       /**< EPD_CMD_LIST_SHOW: keep the display list over a reset */
+                                                        /**< EPD_CMD_SLOT_SET: keep the slot values over a reset */
+
 /**@brief EPD Service structure.
  *
  * @details This structure contains status information related to the service.
@@ -89,6 +125,9 @@ typedef struct
     uint16_t                 service_handle;          /**< Handle of EPD Service (as provided by the S110 SoftDevice). */
     ble_gatts_char_handles_t char_handles;            /**< Handles related to the EPD characteristic (as provided by the SoftDevice). */
     ble_gatts_char_handles_t app_ver_handles;         /**< Handles related to the APP version characteristic (as provided by the SoftDevice). */
+    ble_gatts_char_handles_t perf_handles;            /**< Handles related to the phase timing characteristic (as provided by the SoftDevice). */
+    ble_gatts_char_handles_t trace_handles;           /**< Handles related to the event trace characteristic (as provided by the SoftDevice). */
+    ble_gatts_char_handles_t data_handles;            /**< Handles related to the raw data characteristic (as provided by the SoftDevice). */
     uint16_t                 conn_handle;             /**< Handle of the current connection (as provided by the SoftDevice). BLE_CONN_HANDLE_INVALID if not in a connection. */
     uint16_t                 max_data_len;            /**< Maximum length of data (in bytes) that can be transmitted to the peer */
     bool                     is_notification_enabled; /**< Variable to indicate if the peer has enabled notification of the RX characteristic.*/
@@ -147,6 +186,15 @@ void ble_epd_on_ble_evt(ble_epd_t * p_epd, ble_evt_t * p_ble_evt);
  */
 uint32_t ble_epd_string_send(ble_epd_t * p_epd, uint8_t * p_string, uint16_t length);
 
+/**@brief Function for notifying the link info: EPD_CMD_LINK_INFO, ATT MTU (2 bytes).
+ *
+ * @details Sent when notifications are enabled, when the ATT MTU changes and on request,
+ *          so the client can size its writes.
+ *
+ * @param[in] p_epd       Pointer to the EPD Service structure.
+ */
+uint32_t ble_epd_link_notify(ble_epd_t * p_epd);
+
 void ble_epd_on_timer(ble_epd_t * p_epd, uint32_t timestamp, bool force_update);
 
 #endif // EPD_BLE_H__
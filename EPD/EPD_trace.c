@@ -0,0 +1,104 @@
+#include <stdbool.h>
+#include <string.h>
+#include "app_util_platform.h"
+#include "SEGGER_RTT.h"
+#include "EPD_trace.h"
+
+#define TRACE_RTT_CHANNEL 1
+#define TRACE_RTT_SIZE    256
+#define TRACE_INDEX(n)    ((n) & (EPD_TRACE_SIZE - 1))
+
+static epd_trace_record_t m_ring[EPD_TRACE_SIZE];
+static uint32_t m_total; // records written since boot
+static uint32_t m_sent;  // records written to RTT, or skipped
+static uint8_t m_rtt_buf[TRACE_RTT_SIZE];
+
+static void put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = value;
+    p[1] = value >> 8;
+    p[2] = value >> 16;
+    p[3] = value >> 24;
+}
+
+static void trace_header(uint8_t *p, uint8_t flags, uint32_t total, uint16_t count)
+{
+    put_u32(p, EPD_TRACE_MAGIC);
+    p[4] = 0;
+    p[5] = EPD_TRACE_VERSION;
+#if defined(S112)
+    p[6] = 1;
+#else
+    p[6] = 0;
+#endif
+    p[7] = flags;
+    put_u32(p + 8, total);
+    p[12] = count;
+    p[13] = count >> 8;
+    p[14] = 0;
+    p[15] = 0;
+}
+
+void epd_trace_init(void)
+{
+    uint8_t header[16];
+
+    m_total = 0;
+    m_sent = 0;
+    SEGGER_RTT_ConfigUpBuffer(TRACE_RTT_CHANNEL, "EPDTrace", m_rtt_buf, sizeof(m_rtt_buf),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    trace_header(header, EPD_TRACE_FLAG_STREAM, 0, 0);
+    SEGGER_RTT_Write(TRACE_RTT_CHANNEL, header, sizeof(header));
+}
+
+void epd_trace_add(uint32_t time, epd_trace_id_t id, uint8_t a, uint32_t b)
+{
+    CRITICAL_REGION_ENTER();
+    epd_trace_record_t *r = &m_ring[TRACE_INDEX(m_total)];
+    r->time = time;
+    r->id = id;
+    r->a = a;
+    r->b = b > 0xFFFF ? 0xFFFF : b;
+    m_total++;
+    CRITICAL_REGION_EXIT();
+
+    // a burst of SPI records in one scheduler event would overrun the ring before the idle loop
+    if (m_total - m_sent >= EPD_TRACE_SIZE / 2 && current_int_priority_get() == APP_IRQ_PRIORITY_THREAD)
+        epd_trace_flush();
+}
+
+void epd_trace_flush(void)
+{
+    epd_trace_record_t r;
+    bool pending;
+
+    for (;;)
+    {
+        // copy one record at a time, interrupts may add records while RTT is written
+        CRITICAL_REGION_ENTER();
+        pending = m_sent != m_total;
+        if (m_total - m_sent > EPD_TRACE_SIZE)
+            m_sent = m_total - EPD_TRACE_SIZE; // overwritten before they were sent
+        r = m_ring[TRACE_INDEX(m_sent)];
+        CRITICAL_REGION_EXIT();
+
+        if (!pending) return;
+        SEGGER_RTT_Write(TRACE_RTT_CHANNEL, &r, sizeof(r));
+        m_sent++;
+    }
+}
+
+uint16_t epd_trace_encode(uint8_t *buf, uint16_t size)
+{
+    if (size < EPD_TRACE_DATA_SIZE) return 0;
+
+    memset(buf, 0, EPD_TRACE_DATA_SIZE);
+    CRITICAL_REGION_ENTER();
+    uint32_t count = m_total < EPD_TRACE_READ_MAX ? m_total : EPD_TRACE_READ_MAX;
+    trace_header(buf, 0, m_total, count);
+    for (uint32_t i = 0; i < count; i++)
+        memcpy(buf + 16 + i * sizeof(epd_trace_record_t), &m_ring[TRACE_INDEX(m_total - count + i)],
+               sizeof(epd_trace_record_t));
+    CRITICAL_REGION_EXIT();
+    return EPD_TRACE_DATA_SIZE;
+}
@@ -0,0 +1,86 @@
+#ifndef __EPD_TRACE_H
+#define __EPD_TRACE_H
+#include <stdint.h>
+#include "EPD_perf.h"
+
+/**
+ * Binary event trace, a RAM ring of fixed size records.
+ *
+ * Records are copied to RTT up buffer 1 ("EPDTrace") by epd_trace_flush()
+ * from the main loop, or from thread mode once half of the ring is waiting;
+ * adding one only masks interrupts for the ring update. Records are skipped
+ * when the RTT buffer is full, no debugger reads it, or interrupts add more
+ * than EPD_TRACE_SIZE between two flushes. The last records can be read
+ * through the trace characteristic, tools/trace_decode.py turns both into a
+ * timeline. Timestamps use the clock of EPD_perf.h: DWT cycles on
+ * nRF52, RTC1 ticks (24 bit) on nRF51.
+ *
+ * Header (16 bytes, little endian), starts with "EPDT" and event id 0 so it
+ * can be found in the RTT stream after a reset:
+ *   0: "EPDT"
+ *   4: 0
+ *   5: version
+ *   6: clock, 0 = RTC, 1 = DWT
+ *   7: flags, bit 0 = stream (records follow until the next header)
+ *   8: records written since boot, including the ones that follow
+ *  12: record count (u16), 0 for the RTT stream
+ *  14: reserved
+ *
+ * Record (8 bytes): time (u32), event id (u8), a (u8), b (u16)
+ */
+#ifndef EPD_TRACE_ENABLED
+#define EPD_TRACE_ENABLED 1
+#endif
+
+#define EPD_TRACE_MAGIC       0x54445045 // "EPDT"
+#define EPD_TRACE_VERSION     1
+#define EPD_TRACE_SIZE        64                             // records in the ring, a power of 2
+#define EPD_TRACE_READ_MAX    (EPD_TRACE_SIZE - 2)           // records in a snapshot
+#define EPD_TRACE_DATA_SIZE   (16 + EPD_TRACE_READ_MAX * 8)  // header + records, 512 bytes at most for ATT
+#define EPD_TRACE_FLAG_STREAM 0x01
+
+typedef enum
+{
+    EPD_TRACE_CONNECT = 1,      // b: connection handle
+    EPD_TRACE_DISCONNECT,
+    EPD_TRACE_WRITE,            // a: command, b: length
+    EPD_TRACE_WRITE_END,        // a: command
+    EPD_TRACE_SCHED,            // GUI update queued, a: display mode
+    EPD_TRACE_GUI_BEGIN,        // a: display mode
+    EPD_TRACE_GUI_END,          // a: 1 if the screen was redrawn
+    EPD_TRACE_SPI_WRITE,        // at the start, a: length, b: us
+    EPD_TRACE_SPI_READ,         // at the start, a: length, b: us
+    EPD_TRACE_BUSY,             // at the start, a: 1 on timeout, b: ms
+    EPD_TRACE_REFRESH_BEGIN,
+    EPD_TRACE_REFRESH_END,
+    EPD_TRACE_TEMP,             // a: temperature
+    EPD_TRACE_FONT,             // a: epd_font_evt_t, b: success
+    EPD_TRACE_OVERRUN,          // write dropped, ingress buffer full, a: command (0 for data), b: length
+    EPD_TRACE_DATA,             // write of the data characteristic, b: length
+} epd_trace_id_t;
+
+typedef struct
+{
+    uint32_t time;
+    uint8_t  id;
+    uint8_t  a;
+    uint16_t b;
+} epd_trace_record_t;
+
+#if EPD_TRACE_ENABLED
+#define EPD_TRACE(id, a, b)          epd_trace_add(epd_perf_now(), id, a, b)
+#define EPD_TRACE_AT(time, id, a, b) epd_trace_add(time, id, a, b)
+#else
+#define EPD_TRACE(id, a, b)          ((void)0)
+#define EPD_TRACE_AT(time, id, a, b) ((void)0)
+#endif
+
+void epd_trace_init(void);
+// b saturates at 0xFFFF
+void epd_trace_add(uint32_t time, epd_trace_id_t id, uint8_t a, uint32_t b);
+// writes the records added since the last call to RTT, from thread mode only
+void epd_trace_flush(void);
+// snapshot for the trace characteristic, oldest record first, returns the encoded length
+uint16_t epd_trace_encode(uint8_t *buf, uint16_t size);
+
+#endif
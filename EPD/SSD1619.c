@@ -116,6 +116,7 @@ static void SSD1619_Refresh(void)
 
     _setPartialRamArea(0, 0, EPD->width, EPD->height); // DO NOT REMOVE!
     SSD1619_Update(0x83); // power off
+    SSD1619_WaitBusy(200);
 }
 
 void SSD1619_Clear(void)
@@ -141,31 +142,53 @@ void SSD1619_Clear(void)
     SSD1619_Refresh();
 }
 
-void SSD1619_Write_Image(uint8_t *black, uint8_t *color, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+static uint16_t m_window_x, m_window_y, m_window_w; // window being written, rows advance m_window_y
+
+static void _setRamCounter(uint16_t x, uint16_t y)
 {
-    epd_model_t *EPD = epd_get();
-    uint16_t wb = (w + 7) / 8; // width bytes, bitmaps are padded
-    x -= x % 8; // byte boundary
-    w = wb * 8; // byte boundary
-    if (x + w > EPD->width || y + h > EPD->height) return;
+    EPD_WriteCommand(CMD_RAM_XCOUNT);
+    EPD_WriteByte(x / 8);
+    EPD_WriteCommand(CMD_RAM_YCOUNT);
+    EPD_WriteByte(y % 256);
+    EPD_WriteByte(y / 256);
+}
 
+void SSD1619_Write_Begin(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    w = (w + x % 8 + 7) / 8 * 8; // byte boundary
+    x -= x % 8; // byte boundary
+    m_window_x = x;
+    m_window_y = y;
+    m_window_w = w;
     _setPartialRamArea(x, y, w, h);
+}
+
+void SSD1619_Write_Rows(uint8_t *black, uint8_t *color, uint16_t h)
+{
+    epd_model_t *EPD = epd_get();
+    uint16_t size = m_window_w / 8 * h;
+
+    // the window stays set, only the address counter is moved back to the band for each RAM
+    _setRamCounter(m_window_x, m_window_y);
     EPD_WriteCommand(CMD_WRITE_RAM1);
-    for (uint16_t i = 0; i < h; i++) {
-        for (uint16_t j = 0; j < w / 8; j++) {
-            EPD_WriteByte(black ? black[j + i * wb] : 0xFF);
-        }
-    }
+    EPD_WriteBuffer(black, size);
+    _setRamCounter(m_window_x, m_window_y);
     EPD_WriteCommand(CMD_WRITE_RAM2);
-    for (uint16_t i = 0; i < h; i++) {
-        for (uint16_t j = 0; j < w / 8; j++) {
-            if (EPD->bwr) {
-                EPD_WriteByte(color ? color[j + i * wb] : 0xFF);
-            } else {
-                EPD_WriteByte(black[j + i * wb]);
-            }
-        }
-    }
+    EPD_WriteBuffer(EPD->bwr ? color : black, size);
+    m_window_y += h;
+}
+
+void SSD1619_Write_Ram(uint8_t cmd, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    _setPartialRamArea(x, y, w, h);
+    EPD_WriteCommand(cmd);
+}
+
+// back to the full window, EPD_CMD_WRITE_IMAGE relies on it
+void SSD1619_Write_End(void)
+{
+    epd_model_t *EPD = epd_get();
+    _setPartialRamArea(0, 0, EPD->width, EPD->height);
 }
 
 void SSD1619_Sleep(void)
@@ -178,8 +201,12 @@ void SSD1619_Sleep(void)
 static epd_driver_t epd_drv_ssd1619 = {
     .init = SSD1619_Init,
     .clear = SSD1619_Clear,
-    .write_image = SSD1619_Write_Image,
+    .write_begin = SSD1619_Write_Begin,
+    .write_rows = SSD1619_Write_Rows,
+    .write_end = SSD1619_Write_End,
+    .write_ram = SSD1619_Write_Ram,
     .refresh = SSD1619_Refresh,
+    .refresh_region = NULL,
     .sleep = SSD1619_Sleep,
     .read_temp = SSD1619_Read_Temp,
     .force_temp = SSD1619_Force_Temp,
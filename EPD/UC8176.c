@@ -178,34 +178,61 @@ static void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
     EPD_WriteByte(0x01);
 }
 
-void UC8176_Write_Image(uint8_t *black, uint8_t *color, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+static uint16_t m_window_x, m_window_y, m_window_w; // window being written, rows advance m_window_y
+
+void UC8176_Write_Begin(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
 {
     epd_model_t *EPD = epd_get();
-    uint16_t wb = (w + 7) / 8; // width bytes, bitmaps are padded
+    w = (w + x % 8 + 7) / 8 * 8; // byte boundary
     x -= x % 8; // byte boundary
-    w = wb * 8; // byte boundary
-    if (x + w > EPD->width || y + h > EPD->height) return;
+    m_window_x = x;
+    m_window_y = y;
+    m_window_w = w;
 
     EPD_WriteCommand(CMD_PTIN); // partial in
-    _setPartialRamArea(x, y, w, h);
+    if (!EPD->bwr) {
+        // single plane: the address pointer runs through the whole window
+        _setPartialRamArea(x, y, w, h);
+        EPD_WriteCommand(CMD_DTM2);
+    }
+}
+
+void UC8176_Write_Rows(uint8_t *black, uint8_t *color, uint16_t h)
+{
+    epd_model_t *EPD = epd_get();
+    uint16_t size = m_window_w / 8 * h;
+
     if (EPD->bwr) {
+        // DTM1/DTM2 restart at the window origin, so each band gets its own window
+        _setPartialRamArea(m_window_x, m_window_y, m_window_w, h);
         EPD_WriteCommand(CMD_DTM1);
-        for (uint16_t i = 0; i < h; i++) {
-            for (uint16_t j = 0; j < w / 8; j++) {
-                EPD_WriteByte(black ? black[j + i * wb] : 0xFF);
-            }
-        }
-    }
-    EPD_WriteCommand(CMD_DTM2);
-    for (uint16_t i = 0; i < h; i++) {
-        for (uint16_t j = 0; j < w / 8; j++) {
-            if (EPD->bwr) {
-                EPD_WriteByte(color ? color[j + i * wb] : 0xFF);
-            } else {
-                EPD_WriteByte(black[j + i * wb]);
-            }
-        }
+        EPD_WriteBuffer(black, size);
+        EPD_WriteCommand(CMD_DTM2);
+        EPD_WriteBuffer(color, size);
+    } else {
+        EPD_WriteBuffer(black, size);
     }
+    m_window_y += h;
+}
+
+void UC8176_Write_End(void)
+{
+    EPD_WriteCommand(CMD_PTOUT); // partial out
+}
+
+void UC8176_Write_Ram(uint8_t cmd, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    EPD_WriteCommand(CMD_PTIN); // partial in
+    _setPartialRamArea(x, y, w, h);
+    EPD_WriteCommand(cmd);
+}
+
+// refresh the partial window only, the rest of the screen is left as it is
+void UC8176_Refresh_Region(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    EPD_WriteCommand(CMD_PTIN); // partial in
+    _setPartialRamArea(x, y, w, h);
+    UC8176_Refresh();
     EPD_WriteCommand(CMD_PTOUT); // partial out
 }
 
@@ -225,8 +252,12 @@ void UC8176_Sleep(void)
 static epd_driver_t epd_drv_uc8176 = {
     .init = UC8176_Init,
     .clear = UC8176_Clear,
-    .write_image = UC8176_Write_Image,
+    .write_begin = UC8176_Write_Begin,
+    .write_rows = UC8176_Write_Rows,
+    .write_end = UC8176_Write_End,
+    .write_ram = UC8176_Write_Ram,
     .refresh = UC8176_Refresh,
+    .refresh_region = UC8176_Refresh_Region,
     .sleep = UC8176_Sleep,
     .read_temp = UC8176_Read_Temp,
     .force_temp = UC8176_Force_Temp,
@@ -234,10 +265,27 @@ static epd_driver_t epd_drv_uc8176 = {
     .cmd_write_ram2 = CMD_DTM2,
 };
 
+// KW mode shows the new data of DTM2, DTM1 only holds the old data
+static epd_driver_t epd_drv_uc8176_bw = {
+    .init = UC8176_Init,
+    .clear = UC8176_Clear,
+    .write_begin = UC8176_Write_Begin,
+    .write_rows = UC8176_Write_Rows,
+    .write_end = UC8176_Write_End,
+    .write_ram = UC8176_Write_Ram,
+    .refresh = UC8176_Refresh,
+    .refresh_region = UC8176_Refresh_Region,
+    .sleep = UC8176_Sleep,
+    .read_temp = UC8176_Read_Temp,
+    .force_temp = UC8176_Force_Temp,
+    .cmd_write_ram1 = CMD_DTM2,
+    .cmd_write_ram2 = CMD_DTM1,
+};
+
 // UC8176 400x300 Black/White
 const epd_model_t epd_uc8176_420_bw = {
     .id = EPD_UC8176_420_BW,
-    .drv = &epd_drv_uc8176,
+    .drv = &epd_drv_uc8176_bw,
     .width = 400,
     .height = 300,
     .bwr = false,
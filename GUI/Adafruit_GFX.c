@@ -37,6 +37,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include <string.h>
 #include "Adafruit_GFX.h"
+#include "counters.h"
 
 #ifndef ABS
 #define ABS(x) ((x) > 0 ? (x) : -(x))
@@ -44,6 +45,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #ifndef MIN
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
 #endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
 #ifndef SWAP
 #define SWAP(a, b, T) do { T t = a; a = b; b = t; } while (0)
 #endif
@@ -55,6 +59,7 @@ static void GFX_u8g2_draw_hv_line(u8g2_font_t *u8g2, int16_t x, int16_t y,
                                   int16_t len, uint8_t dir, uint16_t color)
 {
   Adafruit_GFX *gfx = CONTAINER_OF(u8g2, Adafruit_GFX, u8g2);
+  GUI_COUNT(hv_line);
   switch(dir) {
     case 0:
       GFX_drawFastHLine(gfx, x, y, len, color);
@@ -71,6 +76,45 @@ static void GFX_u8g2_draw_hv_line(u8g2_font_t *u8g2, int16_t x, int16_t y,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Check if a rectangle touches the clip rectangle of the current
+             page, drawing outside of it has no effect
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    w   Width in pixels
+    @param    h   Height in pixels
+*/
+/**************************************************************************/
+bool GFX_isVisible(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h) {
+  int16_t x0 = x, y0 = y, x1 = x + w, y1 = y + h, t;
+  switch (gfx->rotation) {
+    case GFX_ROTATE_0:
+      break;
+    case GFX_ROTATE_90:
+      t = x0; x0 = gfx->WIDTH - y1; y1 = x1; x1 = gfx->WIDTH - y0; y0 = t;
+      break;
+    case GFX_ROTATE_180:
+      t = x0; x0 = gfx->WIDTH - x1; x1 = gfx->WIDTH - t;
+      t = y0; y0 = gfx->HEIGHT - y1; y1 = gfx->HEIGHT - t;
+      break;
+    case GFX_ROTATE_270:
+      t = x0; x0 = y0; y0 = gfx->HEIGHT - x1; x1 = y1; y1 = gfx->HEIGHT - t;
+      break;
+  }
+
+  int16_t page_y = gfx->window_y + gfx->current_page * gfx->page_height;
+  return x0 < gfx->window_x + gfx->window_width && x1 > gfx->window_x &&
+         y0 < page_y + gfx->page_height && y1 > page_y;
+}
+
+static uint8_t GFX_u8g2_is_intersection(u8g2_font_t *u8g2, int16_t x0, int16_t y0,
+                                        int16_t x1, int16_t y1)
+{
+  Adafruit_GFX *gfx = CONTAINER_OF(u8g2, Adafruit_GFX, u8g2);
+  return GFX_isVisible(gfx, x0, y0, x1 - x0, y1 - y0);
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX context for graphics
@@ -85,9 +129,10 @@ void GFX_begin(Adafruit_GFX *gfx, int16_t w, int16_t h, int16_t buffer_height) {
   gfx->WIDTH = gfx->_width = w;
   gfx->HEIGHT = gfx->_height = h;
   gfx->u8g2.draw_hv_line = GFX_u8g2_draw_hv_line;
-  gfx->buffer = malloc(((gfx->WIDTH + 7) / 8) * buffer_height);
-  gfx->page_height = buffer_height;
-  gfx->total_pages = (gfx->HEIGHT / gfx->page_height) + (gfx->HEIGHT % gfx->page_height > 0);
+  gfx->u8g2.is_intersection = GFX_u8g2_is_intersection;
+  gfx->buffer_size = ((gfx->WIDTH + 7) / 8) * buffer_height;
+  gfx->buffer = malloc(gfx->buffer_size);
+  GFX_setWindow(gfx, 0, 0, gfx->WIDTH, gfx->HEIGHT);
 }
 
 /**************************************************************************/
@@ -100,9 +145,38 @@ void GFX_begin(Adafruit_GFX *gfx, int16_t w, int16_t h, int16_t buffer_height) {
 /**************************************************************************/
 void GFX_begin_3c(Adafruit_GFX *gfx, int16_t w, int16_t h, int16_t buffer_height) {
   GFX_begin(gfx, w, h, buffer_height);
-  gfx->page_height = buffer_height / 2;
-  gfx->color = gfx->buffer + ((gfx->WIDTH + 7) / 8) * gfx->page_height;
-  gfx->total_pages = (gfx->HEIGHT / gfx->page_height) + (gfx->HEIGHT % gfx->page_height > 0);
+  gfx->color = gfx->buffer; // split by GFX_setWindow
+  GFX_setWindow(gfx, 0, 0, gfx->WIDTH, gfx->HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Render only a rectangle of raw display pixels, call before
+             firstPage. The pages cover the rectangle, so smaller rectangles
+             need fewer pages and the callback gets (x, page_y, w, height).
+   @param    x   Left edge, rounded down to a byte boundary
+   @param    y   Top edge
+   @param    w   Width, rounded up to a byte boundary
+   @param    h   Height
+*/
+/**************************************************************************/
+void GFX_setWindow(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h) {
+  w += x & 7;
+  x &= ~7;
+  w = MIN((w + 7) & ~7, gfx->WIDTH - x);
+  gfx->window_x = x;
+  gfx->window_y = y;
+  gfx->window_width = w;
+  gfx->window_height = h;
+
+  uint16_t stride = (w + 7) / 8;
+  if (gfx->color != NULL) {
+    gfx->page_height = MIN(gfx->buffer_size / 2 / stride, h);
+    gfx->color = gfx->buffer + stride * gfx->page_height;
+  } else {
+    gfx->page_height = MIN(gfx->buffer_size / stride, h);
+  }
+  gfx->total_pages = (h / gfx->page_height) + (h % gfx->page_height > 0);
 }
 
 void GFX_end(Adafruit_GFX *gfx) {
@@ -115,10 +189,10 @@ void GFX_firstPage(Adafruit_GFX *gfx) {
 }
 
 bool GFX_nextPage(Adafruit_GFX *gfx, buffer_callback callback) {
-  int16_t page_y = gfx->current_page * gfx->page_height;
-  int16_t height = MIN(gfx->page_height, gfx->HEIGHT - page_y);
+  int16_t page_y = gfx->window_y + gfx->current_page * gfx->page_height;
+  int16_t height = MIN(gfx->page_height, gfx->window_y + gfx->window_height - page_y);
   if (callback)
-    callback(gfx->buffer, gfx->color, 0, page_y, gfx->WIDTH, height);
+    callback(gfx->buffer, gfx->color, gfx->window_x, page_y, gfx->window_width, height);
 
   gfx->current_page++;
   GFX_fillScreen(gfx, GFX_WHITE);
@@ -158,6 +232,7 @@ void GFX_setRotation(Adafruit_GFX *gfx, GFX_Rotate r) {
 */
 /**************************************************************************/
 void GFX_drawPixel(Adafruit_GFX *gfx, int16_t x, int16_t y, uint16_t color) {
+  GUI_COUNT(draw_pixel);
   if (x < 0 || x >= gfx->_width || y < 0 || y >= gfx->_height) return;
   
   switch (gfx->rotation) {
@@ -177,10 +252,11 @@ void GFX_drawPixel(Adafruit_GFX *gfx, int16_t x, int16_t y, uint16_t color) {
       break;
   }
 
-  y -= gfx->current_page * gfx->page_height;
-  if (y < 0 || y >= gfx->page_height) return;
+  x -= gfx->window_x;
+  y -= gfx->window_y + gfx->current_page * gfx->page_height;
+  if (x < 0 || x >= gfx->window_width || y < 0 || y >= gfx->page_height) return;
 
-  uint16_t i = x / 8 + y * (gfx->WIDTH / 8);
+  uint16_t i = x / 8 + y * ((gfx->window_width + 7) / 8);
   if (gfx->color != NULL) {
     gfx->buffer[i] |= 0x80 >> (x & 7); // white
     gfx->color[i] |= 0x80 >> (x & 7);
@@ -257,6 +333,7 @@ void GFX_drawLine(Adafruit_GFX *gfx, int16_t x0, int16_t y0, int16_t x1, int16_t
 /**************************************************************************/
 void GFX_drawFastVLine(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t h,
                        uint16_t color) {
+  if (!GFX_isVisible(gfx, x, y, 1, h)) return;
   GFX_drawLine(gfx, x, y, x, y + h - 1, color);
 }
 
@@ -271,9 +348,53 @@ void GFX_drawFastVLine(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void GFX_drawFastHLine(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w,
                        uint16_t color) {
+  if (!GFX_isVisible(gfx, x, y, w, 1)) return;
   GFX_drawLine(gfx, x, y, x + w - 1, y, color);
 }
 
+// the pixels of mask in byte i of the page, same colors as GFX_drawPixel
+static void GFX_fillByte(Adafruit_GFX *gfx, uint16_t i, uint8_t mask, uint16_t color) {
+  if (gfx->color != NULL) {
+    gfx->buffer[i] |= mask; // white
+    gfx->color[i] |= mask;
+    if (color == GFX_BLACK)
+      gfx->buffer[i] &= ~mask;
+    else if (color == GFX_RED)
+      gfx->color[i] &= ~mask;
+  } else {
+    if (color == GFX_WHITE)
+      gfx->buffer[i] |= mask;
+    else
+      gfx->buffer[i] &= ~mask;
+  }
+}
+
+// rows of a rectangle clipped to the page, a byte at a time, only without rotation
+static void GFX_fillSpans(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  int16_t page_y = gfx->window_y + gfx->current_page * gfx->page_height;
+  int16_t x0 = MAX(MAX(x, 0), gfx->window_x) - gfx->window_x;
+  int16_t x1 = MIN(MIN(x + w, gfx->_width), gfx->window_x + gfx->window_width) - gfx->window_x;
+  int16_t y0 = MAX(MAX(y, 0), page_y) - page_y;
+  int16_t y1 = MIN(MIN(y + h, gfx->_height), page_y + gfx->page_height) - page_y;
+  if (x0 >= x1 || y0 >= y1) return;
+
+  uint16_t stride = (gfx->window_width + 7) / 8;
+  uint16_t first = x0 / 8, last = (x1 - 1) / 8;
+  uint8_t left = 0xFF >> (x0 & 7), right = 0xFF << (7 - ((x1 - 1) & 7));
+  for (int16_t j = y0; j < y1; j++) {
+    uint16_t row = j * stride;
+    if (first == last) {
+      GFX_fillByte(gfx, row + first, left & right, color);
+      continue;
+    }
+    GFX_fillByte(gfx, row + first, left, color);
+    for (uint16_t i = first + 1; i < last; i++)
+      GFX_fillByte(gfx, row + i, 0xFF, color);
+    GFX_fillByte(gfx, row + last, right, color);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Fill a rectangle completely with one color.
@@ -286,6 +407,11 @@ void GFX_drawFastHLine(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w,
 /**************************************************************************/
 void GFX_fillRect(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h,
                   uint16_t color) {
+  if (!GFX_isVisible(gfx, x, y, w, h)) return;
+  if (gfx->rotation == GFX_ROTATE_0) {
+    GFX_fillSpans(gfx, x, y, w, h, color);
+    return;
+  }
   for (int16_t i = x; i < x + w; i++) {
     GFX_drawFastVLine(gfx, i, y, h, color);
   }
@@ -298,7 +424,7 @@ void GFX_fillRect(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h,
 */
 /**************************************************************************/
 void GFX_fillScreen(Adafruit_GFX *gfx, uint16_t color) {
-  uint32_t size = ((gfx->WIDTH + 7) / 8) * gfx->page_height;
+  uint32_t size = ((gfx->window_width + 7) / 8) * gfx->page_height;
   memset(gfx->buffer, color == GFX_WHITE ? 0xFF : 0x00, size);
   if (gfx->color != NULL)
     memset(gfx->color, color == GFX_RED ? 0x00 : 0xFF, size);
@@ -657,6 +783,7 @@ void GFX_fillTriangle(Adafruit_GFX *gfx, int16_t x0, int16_t y0, int16_t x1,
 /**************************************************************************/
 void GFX_drawBitmap(Adafruit_GFX *gfx, int16_t x, int16_t y, const uint8_t bitmap[],
                     int16_t w, int16_t h, uint16_t color, bool invert) {
+  if (!GFX_isVisible(gfx, x, y, w, h)) return;
 
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t byte = 0;
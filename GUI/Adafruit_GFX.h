@@ -34,18 +34,25 @@ typedef struct {
 
   uint8_t *buffer;      // black pixel buffer
   uint8_t *color;       // color pixel buffer
+  uint16_t buffer_size; // bytes allocated for both pixel buffers
   int16_t page_height;
   int16_t current_page;
   int16_t total_pages;
+  int16_t window_x;     // raw clip rectangle rendered by the pages, x and width are byte aligned
+  int16_t window_y;
+  int16_t window_width;
+  int16_t window_height;
 } Adafruit_GFX;
 
 // CONTROL API
 void GFX_begin(Adafruit_GFX *gfx, int16_t w, int16_t h, int16_t buffer_height);
 void GFX_begin_3c(Adafruit_GFX *gfx, int16_t w, int16_t h, int16_t buffer_height);
 void GFX_setRotation(Adafruit_GFX *gfx, GFX_Rotate r);
+void GFX_setWindow(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h);
 void GFX_firstPage(Adafruit_GFX *gfx);
 bool GFX_nextPage(Adafruit_GFX *gfx, buffer_callback callback);
 void GFX_end(Adafruit_GFX *gfx);
+bool GFX_isVisible(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w, int16_t h);
 
 // DRAW API
 void GFX_drawPixel(Adafruit_GFX *gfx, int16_t x, int16_t y, uint16_t color);
@@ -1,7 +1,16 @@
 #include "fonts.h"
 #include "Lunar.h"
 #include "GUI.h"
+#include "barcode.h"
 #include <stdio.h>
+#include <string.h>
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
 
 #define GFX_printf_styled(gfx, fg, bg, font, ...) \
             GFX_setTextColor(gfx, fg, bg);        \
@@ -38,18 +47,20 @@ static void DrawDate(Adafruit_GFX *gfx, int16_t x, int16_t y, tm_t *tm)
     GFX_printf_styled(gfx, GFX_BLACK, GFX_WHITE, u8g2_font_wqy12_t_lunar, "日 ");
 }
 
-static void DrawDateHeader(Adafruit_GFX *gfx, int16_t x, int16_t y, tm_t *tm, struct Lunar_Date *Lunar, gui_data_t *data)
+static void DrawDateHeader(Adafruit_GFX *gfx, int16_t x, int16_t y, tm_t *tm)
 {
     DrawDate(gfx, x, y, tm);
     GFX_setFont(gfx, u8g2_font_wqy9_t_lunar);
     GFX_printf(gfx, "星期%s", Lunar_DayString[tm->tm_wday]);
+}
 
-    DrawBattery(gfx, 365, 4, data->voltage);
-
-    GFX_setCursor(gfx, x + 270, y);
-    GFX_printf(gfx, "%s%s%s %s%s", Lunar_MonthLeapString[Lunar->IsLeap], Lunar_MonthString[Lunar->Month],
-                     Lunar_DateString[Lunar->Date], Lunar_StemStrig[LUNAR_GetStem(Lunar)],
-                     Lunar_BranchStrig[LUNAR_GetBranch(Lunar)]);
+static void DrawLunarHeader(Adafruit_GFX *gfx, int16_t x, int16_t y, struct Lunar_Date *Lunar)
+{
+    GFX_setCursor(gfx, x, y);
+    GFX_printf_styled(gfx, GFX_BLACK, GFX_WHITE, u8g2_font_wqy9_t_lunar, "%s%s%s %s%s",
+                      Lunar_MonthLeapString[Lunar->IsLeap], Lunar_MonthString[Lunar->Month],
+                      Lunar_DateString[Lunar->Date], Lunar_StemStrig[LUNAR_GetStem(Lunar)],
+                      Lunar_BranchStrig[LUNAR_GetBranch(Lunar)]);
     GFX_setTextColor(gfx, GFX_RED, GFX_WHITE);
     GFX_printf(gfx, "%s", Lunar_ZodiacString[LUNAR_GetZodiac(Lunar)]);
     GFX_setTextColor(gfx, GFX_BLACK, GFX_WHITE);
@@ -68,55 +79,51 @@ static void DrawWeekHeader(Adafruit_GFX *gfx, int16_t x, int16_t y)
     }
 }
 
-static void DrawMonthDays(Adafruit_GFX *gfx, tm_t *tm, struct Lunar_Date *Lunar)
+static uint8_t MonthDayRows(const struct Lunar_Month *month)
 {
-    uint8_t firstDayWeek = get_first_day_week(tm->tm_year + YEAR0, tm->tm_mon + 1);
-    uint8_t monthMaxDays = thisMonthMaxDays(tm->tm_year + YEAR0, tm->tm_mon + 1);
-    uint8_t monthDayRows = 1 + (monthMaxDays - (7 - firstDayWeek) + 6) / 7;
+    return 1 + (month->Days - (7 - month->FirstWeek) + 6) / 7;
+}
 
-    for (uint8_t i = 0; i < monthMaxDays; i++) {
-        uint8_t day = i + 1;
+static void MonthDayPos(const struct Lunar_Month *month, uint8_t i, int16_t *x, int16_t *y)
+{
+    uint8_t monthDayRows = MonthDayRows(month);
+    *x = 22 + (month->FirstWeek + i) % 7 * 55;
+    *y = (monthDayRows > 5 ? 69 : 72) + (month->FirstWeek + i) / 7 * (monthDayRows > 5 ? 39 : 48);
+}
 
-        int16_t w = (firstDayWeek + i) % 7;
-        bool weekend = (w  == 0) || (w == 6);
+static void DrawMonthDay(Adafruit_GFX *gfx, tm_t *tm, const struct Lunar_Month *month, uint8_t i)
+{
+    uint8_t day = i + 1;
+    const struct Lunar_Day *lunar = &month->Day[i];
 
-        int16_t x = 22 + w * 55;
-        int16_t y = (monthDayRows > 5 ? 69 : 72) + (firstDayWeek + i) / 7 * (monthDayRows > 5 ? 39 : 48);
+    int16_t w = (month->FirstWeek + i) % 7;
+    bool weekend = (w  == 0) || (w == 6);
 
-        if (day == tm->tm_mday) {
-            GFX_fillCircle(gfx, x + 11, y + (monthDayRows > 5 ? 10 : 12), 20, GFX_RED);
-            GFX_setTextColor(gfx, GFX_WHITE, GFX_RED);
-        } else {
-            GFX_setTextColor(gfx, weekend ? GFX_RED : GFX_BLACK, GFX_WHITE);
-        }
+    int16_t x, y;
+    MonthDayPos(month, i, &x, &y);
 
-        GFX_setFont(gfx, u8g2_font_helvB14_tn);
-        GFX_setCursor(gfx, x + (day < 10 ? 6 : 2), y + 10);
-        GFX_printf(gfx, "%d", day);
-
-        GFX_setFont(gfx, u8g2_font_wqy9_t_lunar);
-        GFX_setCursor(gfx, x, y + 24);
-        uint8_t JQdate;
-        if (GetJieQi(tm->tm_year + YEAR0, tm->tm_mon + 1, day, &JQdate) && JQdate == day) {
-            uint8_t JQ = (tm->tm_mon + 1 - 1) * 2;
-            if (day >= 15) JQ++;
-            if (day != tm->tm_mday) GFX_setTextColor(gfx, GFX_RED, GFX_WHITE);
-            GFX_printf(gfx, "%s", JieQiStr[JQ]);
-        } else {
-            LUNAR_SolarToLunar(Lunar, tm->tm_year + YEAR0, tm->tm_mon + 1, day);
-            if (Lunar->Date == 1)
-                GFX_printf(gfx, "%s", Lunar_MonthString[Lunar->Month]);
-            else
-                GFX_printf(gfx, "%s", Lunar_DateString[Lunar->Date]);
-        }
+    if (day == tm->tm_mday) {
+        GFX_fillCircle(gfx, x + 11, y + (MonthDayRows(month) > 5 ? 10 : 12), 20, GFX_RED);
+        GFX_setTextColor(gfx, GFX_WHITE, GFX_RED);
+    } else {
+        GFX_setTextColor(gfx, weekend ? GFX_RED : GFX_BLACK, GFX_WHITE);
     }
-}
 
-static void DrawCalendar(Adafruit_GFX *gfx, tm_t *tm, struct Lunar_Date *Lunar, gui_data_t *data)
-{
-    DrawDateHeader(gfx, 10, 28, tm, Lunar, data);
-    DrawWeekHeader(gfx, 10, 32);
-    DrawMonthDays(gfx, tm, Lunar);
+    GFX_setFont(gfx, u8g2_font_helvB14_tn);
+    GFX_setCursor(gfx, x + (day < 10 ? 6 : 2), y + 10);
+    GFX_printf(gfx, "%d", day);
+
+    GFX_setFont(gfx, u8g2_font_wqy9_t_lunar);
+    GFX_setCursor(gfx, x, y + 24);
+    if (lunar->JieQi != LUNAR_DAY_NO_JIEQI) {
+        if (day != tm->tm_mday) GFX_setTextColor(gfx, GFX_RED, GFX_WHITE);
+        GFX_printf(gfx, "%s", JieQiStr[lunar->JieQi]);
+    } else {
+        if (lunar->Date == 1)
+            GFX_printf(gfx, "%s", Lunar_MonthString[lunar->Month & 0x0F]);
+        else
+            GFX_printf(gfx, "%s", Lunar_DateString[lunar->Date]);
+    }
 }
 
 /* Routine to Draw Large 7-Segment formated number
@@ -149,40 +156,43 @@ static void Draw7Number(Adafruit_GFX *gfx, int n, unsigned int xLoc, unsigned in
     }
 }
 
-static void DrawTime(Adafruit_GFX *gfx, tm_t *tm, int16_t x, int16_t y, uint16_t cS, uint16_t nD)
+// 时钟的 "时:分" 拆成三部分, 每分钟通常只有分钟的数字需要重画
+#define TIME_X      70
+#define TIME_Y      98
+#define TIME_CS     5
+#define TIME_ND     2
+#define TIME_W      (TIME_ND*(11*TIME_CS+2)-2*TIME_CS)
+#define TIME_H      (20*TIME_CS+4)
+#define COLON_X     (TIME_X + TIME_W + 2*TIME_CS)
+#define MINUTE_X    (COLON_X + 4*TIME_CS)
+
+static void DrawColon(Adafruit_GFX *gfx, int16_t x, int16_t y, uint16_t cS)
 {
-    Draw7Number(gfx, tm->tm_hour, x, y, cS, GFX_BLACK, GFX_WHITE, nD);
-    x += (nD*(11*cS+2)-2*cS) + 2*cS;
     GFX_fillRect(gfx, x, y + 4.5*cS+1, 2*cS, 2*cS, GFX_BLACK);
     GFX_fillRect(gfx, x, y + 13.5*cS+3, 2*cS, 2*cS, GFX_BLACK);
-    x += 4*cS;
-    Draw7Number(gfx, tm->tm_min, x, y, cS, GFX_BLACK, GFX_WHITE, nD);
 }
 
-static void DrawClock(Adafruit_GFX *gfx, tm_t *tm, struct Lunar_Date *Lunar, gui_data_t *data)
+static void DrawClockWeek(Adafruit_GFX *gfx, tm_t *tm, struct Lunar_Date *Lunar)
 {
-    DrawDate(gfx, 40, 36, tm);
     GFX_setCursor(gfx, 40, 58);
-    GFX_setFont(gfx, u8g2_font_wqy9_t_lunar);
-    GFX_printf(gfx, "星期%s", Lunar_DayString[tm->tm_wday]);
+    GFX_printf_styled(gfx, GFX_BLACK, GFX_WHITE, u8g2_font_wqy9_t_lunar, "星期%s", Lunar_DayString[tm->tm_wday]);
     GFX_setCursor(gfx, 138, 58);
     GFX_printf(gfx, "%s%s%s", Lunar_MonthLeapString[Lunar->IsLeap], Lunar_MonthString[Lunar->Month],
         Lunar_DateString[Lunar->Date]);
+}
 
-    DrawBattery(gfx, 330, 25, data->voltage);
-    DrawTemperature(gfx, 330, 58, data->temperature);
-
-    GFX_drawFastHLine(gfx, 30, 68, 330, GFX_BLACK);
-    DrawTime(gfx, tm, 70, 98, 5, 2);
-    GFX_drawFastHLine(gfx, 30, 232, 330, GFX_BLACK);
-
+static void DrawLunarYear(Adafruit_GFX *gfx, struct Lunar_Date *Lunar)
+{
     GFX_setCursor(gfx, 40, 275);
-    GFX_setFont(gfx, u8g2_font_wqy12_t_lunar);
-    GFX_printf(gfx, "%s%s%s年", Lunar_StemStrig[LUNAR_GetStem(Lunar)], Lunar_BranchStrig[LUNAR_GetBranch(Lunar)],
+    GFX_printf_styled(gfx, GFX_BLACK, GFX_WHITE, u8g2_font_wqy12_t_lunar, "%s%s%s年",
+        Lunar_StemStrig[LUNAR_GetStem(Lunar)], Lunar_BranchStrig[LUNAR_GetBranch(Lunar)],
         Lunar_ZodiacString[LUNAR_GetZodiac(Lunar)]);
+}
 
-    uint8_t day = 0;
-    uint8_t JQday = GetJieQiStr(tm->tm_year + YEAR0, tm->tm_mon + 1, tm->tm_mday, &day);
+static void DrawJieQi(Adafruit_GFX *gfx, uint8_t JQday, uint8_t day)
+{
+    GFX_setTextColor(gfx, GFX_BLACK, GFX_WHITE);
+    GFX_setFont(gfx, u8g2_font_wqy12_t_lunar);
     if (day == 0) {
         GFX_setCursor(gfx, 320, 275);
         GFX_printf(gfx, "%s", JieQiStr[JQday % 24]);
@@ -194,12 +204,638 @@ static void DrawClock(Adafruit_GFX *gfx, tm_t *tm, struct Lunar_Date *Lunar, gui
     }
 }
 
-void DrawGUI(gui_data_t *data, buffer_callback draw, display_mode_t mode)
-{
-    tm_t tm = {0};
+/*
+ * 界面由一组位置固定的控件组成, 每个控件记下包围盒和内容哈希 (由决定其像素的几个值算出).
+ * 每次更新都重新生成控件列表并与上一帧比较, 只重画包围盒或哈希变了的区域,
+ * 屏幕 RAM 中其余部分保留上一帧的内容. 区域内所有相交的控件都按原顺序重画, 包围盒可以重叠.
+ */
+#define GUI_MAX_WIDGETS  36     // 日历: 4 + 31 天
+#define GUI_MERGE_AREA   2048   // 合并后多出的面积不超过这么多像素的两个脏区域合并为一次写入
+
+typedef enum {
+    WIDGET_DATE_HEADER,
+    WIDGET_LUNAR_HEADER,
+    WIDGET_WEEK_HEADER,
+    WIDGET_MONTH_DAY,
+    WIDGET_BATTERY,
+    WIDGET_TEMPERATURE,
+    WIDGET_CLOCK_DATE,
+    WIDGET_CLOCK_WEEK,
+    WIDGET_CLOCK_LINE,
+    WIDGET_CLOCK_HOUR,
+    WIDGET_CLOCK_COLON,
+    WIDGET_CLOCK_MINUTE,
+    WIDGET_LUNAR_YEAR,
+    WIDGET_JIEQI,
+    WIDGET_LIST_ITEM,
+    WIDGET_LIST_REST,
+} widget_type_t;
+
+typedef struct {
+    int16_t x, y, w, h;     // 包围盒
+    uint32_t hash;          // 内容哈希
+    uint8_t type;           // widget_type_t
+    uint16_t arg;           // 日期格序号, 分隔线的 y, 显示列表项的偏移
+} gui_widget_t;
+
+typedef struct {
+    int16_t x0, y0, x1, y1; // [x0, x1) x [y0, y1)
+} gui_rect_t;
+
+typedef struct {
+    tm_t tm;
     struct Lunar_Date Lunar;
+    const struct Lunar_Month *month;
+    gui_data_t *data;
+    uint8_t count;          // 已生成的控件数
+    uint8_t dirty;          // 脏区域数
+    gui_rect_t rects[GUI_MAX_WIDGETS + 1];
+} gui_ctx_t;
+
+// 上一帧的控件, 与屏幕 RAM 中的内容对应
+static struct {
+    bool valid;
+    bool bwr;
+    uint16_t width;
+    uint16_t height;
+    display_mode_t mode;
+    uint8_t count;
+    gui_widget_t widgets[GUI_MAX_WIDGETS];
+} m_frame;
+
+static uint32_t Hash(uint32_t hash, uint32_t value)
+{
+    for (uint8_t i = 0; i < 4; i++, value >>= 8)
+        hash = (hash ^ (value & 0xFF)) * 16777619UL; // FNV-1a
+    return hash;
+}
+
+static uint32_t HashLunar(uint32_t hash, struct Lunar_Date *Lunar)
+{
+    hash = Hash(hash, Lunar->Year);
+    return Hash(hash, Lunar->Month | Lunar->Date << 8 | Lunar->IsLeap << 16);
+}
+
+static void MarkDirty(gui_ctx_t *ctx, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    gui_rect_t *rect = &ctx->rects[ctx->dirty++];
+    rect->x0 = x0;
+    rect->y0 = y0;
+    rect->x1 = x1;
+    rect->y1 = y1;
+}
+
+static void AddWidget(gui_ctx_t *ctx, widget_type_t type, uint16_t arg,
+                      int16_t x, int16_t y, int16_t w, int16_t h, uint32_t hash)
+{
+    if (ctx->count >= GUI_MAX_WIDGETS) return;
+
+    gui_widget_t *widget = &m_frame.widgets[ctx->count];
+    hash = Hash(Hash(2166136261UL, type), hash);
+    if (ctx->count >= m_frame.count)
+        MarkDirty(ctx, x, y, x + w, y + h);
+    else if (widget->type != type || widget->x != x || widget->y != y ||
+             widget->w != w || widget->h != h || widget->hash != hash)
+        MarkDirty(ctx, MIN(widget->x, x), MIN(widget->y, y), // 旧包围盒也要擦掉
+                  MAX(widget->x + widget->w, x + w), MAX(widget->y + widget->h, y + h));
+
+    widget->x = x;
+    widget->y = y;
+    widget->w = w;
+    widget->h = h;
+    widget->hash = hash;
+    widget->type = type;
+    widget->arg = arg;
+    ctx->count++;
+}
+
+static void AddBattery(gui_ctx_t *ctx, int16_t x, int16_t y)
+{
+    // 按显示出来的文字计算哈希, 电压的微小波动不会触发重画
+    char text[8];
+    uint32_t hash = (uint8_t)(ctx->data->voltage * 100 / 4.2);
+    snprintf(text, sizeof(text), "%.1fV", ctx->data->voltage);
+    for (char *p = text; *p; p++)
+        hash = Hash(hash, *p);
+    AddWidget(ctx, WIDGET_BATTERY, 0, x - 26, y - 1, 49, 13, hash);
+}
+
+static void AddCalendar(gui_ctx_t *ctx)
+{
+    tm_t *tm = &ctx->tm;
+    const struct Lunar_Month *month = ctx->month;
+    uint8_t rows = MonthDayRows(month);
+
+    AddWidget(ctx, WIDGET_DATE_HEADER, 0, 10, 8, 260, 24,
+              Hash(Hash(tm->tm_year, tm->tm_mon), tm->tm_mday | tm->tm_wday << 8));
+    AddBattery(ctx, 365, 4);
+    AddWidget(ctx, WIDGET_LUNAR_HEADER, 0, 280, 16, 120, 16, HashLunar(0, &ctx->Lunar));
+    AddWidget(ctx, WIDGET_WEEK_HEADER, 0, 10, 32, 380, 24, 0);
+
+    for (uint8_t i = 0; i < month->Days; i++) {
+        const struct Lunar_Day *lunar = &month->Day[i];
+        int16_t x, y;
+        MonthDayPos(month, i, &x, &y);
+        y += rows > 5 ? 10 : 12; // 今天的圆圈中心
+        AddWidget(ctx, WIDGET_MONTH_DAY, i, x - 9, y - 20, 41, 41,
+                  Hash(lunar->Date | lunar->Month << 8 | lunar->JieQi << 16 | (i + 1 == tm->tm_mday) << 24, rows));
+    }
+}
+
+static void AddClock(gui_ctx_t *ctx)
+{
+    tm_t *tm = &ctx->tm;
+    uint8_t day = 0;
+    uint8_t JQday = GetJieQiStr(tm->tm_year + YEAR0, tm->tm_mon + 1, tm->tm_mday, &day);
+
+    AddWidget(ctx, WIDGET_CLOCK_DATE, 0, 40, 16, 220, 24, Hash(Hash(tm->tm_year, tm->tm_mon), tm->tm_mday));
+    AddWidget(ctx, WIDGET_CLOCK_WEEK, 0, 40, 48, 170, 14, HashLunar(tm->tm_wday, &ctx->Lunar));
+    AddBattery(ctx, 330, 25);
+    AddWidget(ctx, WIDGET_TEMPERATURE, 0, 330, 48, 40, 14, ctx->data->temperature);
+    AddWidget(ctx, WIDGET_CLOCK_LINE, 68, 30, 68, 330, 1, 0);
+    AddWidget(ctx, WIDGET_CLOCK_HOUR, 0, TIME_X, TIME_Y, TIME_W, TIME_H, tm->tm_hour);
+    AddWidget(ctx, WIDGET_CLOCK_COLON, 0, COLON_X, TIME_Y, 2*TIME_CS, TIME_H, 0);
+    AddWidget(ctx, WIDGET_CLOCK_MINUTE, 0, MINUTE_X, TIME_Y, TIME_W, TIME_H, tm->tm_min);
+    AddWidget(ctx, WIDGET_CLOCK_LINE, 232, 30, 232, 330, 1, 0);
+    AddWidget(ctx, WIDGET_LUNAR_YEAR, 0, 40, 260, 100, 20, HashLunar(0, &ctx->Lunar));
+    AddWidget(ctx, WIDGET_JIEQI, 0, 286, 250, 114, 40, JQday | day << 8);
+}
+
+/*
+ * 显示列表的每项是一个控件, 哈希就是项的内容, 只改了一项时只重画它的包围盒.
+ * 控件数不够时, 剩下的项合成最后一个控件, 其中任一项变了都一起重画.
+ * 槽的哈希还包括槽的值, 包围盒为方框和文字的并集, 值变长变短时旧文字也能擦掉.
+ * 二维码和条码的包围盒随内容变化, 内容变了时新旧两个包围盒都重画.
+ */
+typedef struct {
+    uint8_t op;             // list_op_t
+    uint8_t style;
+    int16_t v[5];           // 参数里的坐标和尺寸
+    const uint8_t *font;    // 文字
+    const uint8_t *data;    // 文字, 位图数据或槽的值
+    uint8_t len;            // 文字长度
+    uint8_t format;         // 槽的格式, 二维码的纠错等级
+    uint8_t module;         // 二维码和条码的模块大小
+} list_item_t;
+
+// 下一个绘图项, 列表结束时返回 NULL
+static const uint8_t *ListNext(gui_data_t *data, uint16_t *offset)
+{
+    uint16_t i = *offset;
+    if (i + 2 > data->list_len || data->list[i] == LIST_END || i + 2 + data->list[i + 1] > data->list_len)
+        return NULL;
+    *offset = i + 2 + data->list[i + 1];
+    return &data->list[i];
+}
+
+// 槽的值, 槽号为 LIST_NO_SLOT 时为项里 text 开始的文字
+static bool ListContent(gui_data_t *data, const uint8_t *p, uint8_t slot, uint8_t text, list_item_t *item)
+{
+    if (slot == LIST_NO_SLOT) {
+        item->data = &p[text];
+        item->len = p[1] + 2 - text;
+        return true;
+    }
+    if (slot >= LIST_SLOT_COUNT || data->slots == NULL) return false;
+    item->data = &data->slots[slot * LIST_SLOT_SIZE + 1];
+    item->len = MIN(data->slots[slot * LIST_SLOT_SIZE], LIST_SLOT_SIZE - 1);
+    return true;
+}
+
+// 解析一项, 画不出来的项返回 false
+static bool ListParse(gui_data_t *data, const uint8_t *p, list_item_t *item)
+{
+    static const uint8_t params[] = {0, 9, 9, 7, 6, 11, 12, 8, 9}; // 各操作码参数的最短长度
+    static const uint8_t values[] = {0, 4, 4, 3, 2, 5, 4, 2, 3};   // 其中的坐标和尺寸个数
+    uint8_t op = p[0], len = p[1];
+
+    if (op == LIST_END || op >= sizeof(params) || len < params[op]) return false;
+    item->op = op;
+    item->style = p[2];
+    for (uint8_t i = 0; i < values[op]; i++)
+        item->v[i] = (int16_t)(p[3 + i * 2] << 8 | p[4 + i * 2]);
+
+    switch (op) {
+        case LIST_RECT:
+            return item->v[2] > 0 && item->v[3] > 0;
+        case LIST_CIRCLE:
+            return item->v[2] >= 0;
+        case LIST_TEXT:
+            item->font = GUI_GetFont(p[7]);
+            item->data = &p[8];
+            item->len = len - 6;
+            return item->font != NULL;
+        case LIST_BITMAP: {
+            uint16_t offset = (uint16_t)item->v[4];
+            if (item->v[2] <= 0 || item->v[3] <= 0) return false;
+            item->data = &data->list[offset];
+            return offset + (uint32_t)(item->v[2] + 7) / 8 * item->v[3] <= data->list_len;
+        }
+        case LIST_SLOT:
+            if (item->v[2] <= 0 || item->v[3] <= 0 || p[13] == LIST_NO_SLOT) return false;
+            if (!ListContent(data, p, p[13], 0, item)) return false;
+            item->font = GUI_GetFont(p[11]);
+            item->format = p[12];
+            return item->font != NULL;
+        case LIST_QRCODE:
+            item->module = p[7];
+            item->format = p[8];
+            if (item->module == 0 || item->format > QR_ECC_M || !ListContent(data, p, p[9], 10, item)) return false;
+            return QR_Version(item->len, (qr_ecc_t)item->format) != 0;
+        case LIST_BARCODE: {
+            uint8_t symbols[CODE128_MAX_SYMBOLS];
+            item->module = p[9];
+            if (item->v[2] <= 0 || item->module == 0 || !ListContent(data, p, p[10], 11, item)) return false;
+            return CODE128_Encode(item->data, item->len, symbols) != 0;
+        }
+        default:
+            return true;
+    }
+}
+
+// text 至少 UINT8_MAX 字节
+static void ListText(const list_item_t *item, char *text)
+{
+    if (item->op == LIST_SLOT && (item->format & LIST_NUMBER)) {
+        const uint8_t *p = item->data;
+        uint8_t decimals = LIST_DECIMALS(item->format);
+        int32_t value = (int32_t)((uint32_t)p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3]);
+        uint32_t abs = value < 0 ? -(uint32_t)value : (uint32_t)value, div = 1;
+
+        text[0] = '\0';
+        if (item->len != 4) return; // 不是数字的值不显示
+        for (uint8_t i = 0; i < decimals; i++)
+            div *= 10;
+        if (decimals > 0)
+            snprintf(text, UINT8_MAX, "%s%lu.%0*lu", value < 0 ? "-" : "", (unsigned long)(abs / div),
+                     decimals, (unsigned long)(abs % div));
+        else
+            snprintf(text, UINT8_MAX, "%ld", (long)value);
+        return;
+    }
+    memcpy(text, item->data, item->len);
+    text[item->len] = '\0';
+}
 
-    transformTime(data->timestamp, &tm);
+static uint16_t ListColor(uint8_t style)
+{
+    static const uint16_t colors[] = {GFX_BLACK, GFX_WHITE, GFX_RED, GFX_BLACK};
+    return colors[style & LIST_COLOR_MASK];
+}
+
+// 文字的包围盒为字库的高度和文字的像素宽度, 槽的文字按格式放进方框. 返回文字的起点 (基线)
+static void ListTextPos(const list_item_t *item, const char *text, int16_t *x, int16_t *y, gui_rect_t *box)
+{
+    const int16_t *v = item->v;
+    Adafruit_GFX gfx;
+    memset(&gfx, 0, sizeof(gfx));
+    GFX_setFont(&gfx, item->font);
+    u8g2_font_info_t *info = &gfx.u8g2.font_info;
+    int16_t width = GFX_getUTF8Width(&gfx, text);
+
+    *x = v[0];
+    *y = v[1];
+    if (item->op == LIST_SLOT) {
+        uint8_t align = item->format & LIST_ALIGN_MASK;
+        if (align == LIST_ALIGN_CENTER)
+            *x += (v[2] - width) / 2;
+        else if (align == LIST_ALIGN_RIGHT)
+            *x += v[2] - width;
+        *y += (v[3] - info->max_char_height) / 2 + info->max_char_height + info->y_offset;
+    }
+    box->x0 = *x + MIN(info->x_offset, 0);
+    box->y0 = *y - info->max_char_height - info->y_offset;
+    box->x1 = *x + width;
+    box->y1 = *y - info->y_offset;
+}
+
+static void ListBox(const list_item_t *item, gui_rect_t *box)
+{
+    const int16_t *v = item->v;
+    char text[UINT8_MAX];
+    int16_t x, y;
+
+    switch (item->op) {
+        case LIST_LINE:
+            *box = (gui_rect_t){MIN(v[0], v[2]), MIN(v[1], v[3]), MAX(v[0], v[2]) + 1, MAX(v[1], v[3]) + 1};
+            break;
+        case LIST_CIRCLE:
+            *box = (gui_rect_t){v[0] - v[2], v[1] - v[2], v[0] + v[2] + 1, v[1] + v[2] + 1};
+            break;
+        case LIST_TEXT:
+            ListText(item, text);
+            ListTextPos(item, text, &x, &y, box);
+            break;
+        case LIST_SLOT:
+            ListText(item, text);
+            ListTextPos(item, text, &x, &y, box);
+            box->x0 = MIN(box->x0, v[0]);
+            box->y0 = MIN(box->y0, v[1]);
+            box->x1 = MAX(box->x1, v[0] + v[2]);
+            box->y1 = MAX(box->y1, v[1] + v[3]);
+            break;
+        case LIST_QRCODE: {
+            int16_t size = QR_SIZE(QR_Version(item->len, (qr_ecc_t)item->format)) * item->module;
+            *box = (gui_rect_t){v[0], v[1], v[0] + size, v[1] + size};
+        } break;
+        case LIST_BARCODE: {
+            uint8_t symbols[CODE128_MAX_SYMBOLS];
+            int16_t width = CODE128_MODULES(CODE128_Encode(item->data, item->len, symbols)) * item->module;
+            *box = (gui_rect_t){v[0], v[1], v[0] + width, v[1] + v[2]};
+        } break;
+        default: // 矩形, 位图
+            *box = (gui_rect_t){v[0], v[1], v[0] + v[2], v[1] + v[3]};
+            break;
+    }
+}
+
+static uint32_t ListHash(const list_item_t *item, const uint8_t *p)
+{
+    uint32_t hash = 0;
+    for (uint16_t i = 0; i < 2 + p[1]; i++)
+        hash = Hash(hash, p[i]);
+    if (item->op == LIST_BITMAP) {
+        for (uint16_t i = 0; i < (item->v[2] + 7) / 8 * item->v[3]; i++)
+            hash = Hash(hash, item->data[i]);
+    } else if (item->op == LIST_SLOT || item->op == LIST_QRCODE || item->op == LIST_BARCODE) {
+        hash = Hash(hash, item->len);
+        for (uint8_t i = 0; i < item->len; i++)
+            hash = Hash(hash, item->data[i]);
+    }
+    return hash;
+}
+
+static void AddList(gui_ctx_t *ctx)
+{
+    gui_rect_t rest = {INT16_MAX, INT16_MAX, INT16_MIN, INT16_MIN};
+    uint32_t hash = 0;
+    uint16_t offset = 0, first = 0;
+    const uint8_t *p;
+    list_item_t item;
+
+    for (uint16_t start = 0; (p = ListNext(ctx->data, &offset)) != NULL; start = offset) {
+        gui_rect_t box;
+        if (!ListParse(ctx->data, p, &item)) continue;
+        ListBox(&item, &box);
+        if (ctx->count < GUI_MAX_WIDGETS - 1) {
+            AddWidget(ctx, WIDGET_LIST_ITEM, start, box.x0, box.y0, box.x1 - box.x0, box.y1 - box.y0,
+                      ListHash(&item, p));
+            continue;
+        }
+        if (rest.x0 > rest.x1) first = start;
+        rest.x0 = MIN(rest.x0, box.x0);
+        rest.y0 = MIN(rest.y0, box.y0);
+        rest.x1 = MAX(rest.x1, box.x1);
+        rest.y1 = MAX(rest.y1, box.y1);
+        hash = Hash(hash, ListHash(&item, p));
+    }
+    if (rest.x0 <= rest.x1)
+        AddWidget(ctx, WIDGET_LIST_REST, first, rest.x0, rest.y0, rest.x1 - rest.x0, rest.y1 - rest.y0, hash);
+}
+
+static void DrawListItem(Adafruit_GFX *gfx, gui_data_t *data, const uint8_t *p)
+{
+    list_item_t item;
+    int16_t *v = item.v;
+
+    if (!ListParse(data, p, &item)) return;
+    uint16_t color = ListColor(item.style);
+    bool fill = item.style & LIST_FILL;
+
+    switch (item.op) {
+        case LIST_RECT:
+            if (fill)
+                GFX_fillRect(gfx, v[0], v[1], v[2], v[3], color);
+            else
+                GFX_drawRect(gfx, v[0], v[1], v[2], v[3], color);
+            break;
+        case LIST_LINE:
+            GFX_drawLine(gfx, v[0], v[1], v[2], v[3], color);
+            break;
+        case LIST_CIRCLE:
+            if (fill)
+                GFX_fillCircle(gfx, v[0], v[1], v[2], color);
+            else
+                GFX_drawCircle(gfx, v[0], v[1], v[2], color);
+            break;
+        case LIST_TEXT:
+        case LIST_SLOT: {
+            char text[UINT8_MAX];
+            gui_rect_t box;
+            int16_t x, y;
+            ListText(&item, text);
+            ListTextPos(&item, text, &x, &y, &box);
+            GFX_setFont(gfx, item.font);
+            GFX_setFontMode(gfx, 1); // 透明, 可以写在填充的矩形上
+            GFX_setTextColor(gfx, color, GFX_WHITE);
+            GFX_drawUTF8(gfx, x, y, text);
+        } break;
+        case LIST_BITMAP:
+            GFX_drawBitmap(gfx, v[0], v[1], item.data, v[2], v[3], color, false);
+            break;
+        case LIST_QRCODE:
+            GFX_drawQRCode(gfx, v[0], v[1], item.module, item.data, item.len, (qr_ecc_t)item.format, color);
+            break;
+        case LIST_BARCODE:
+            GFX_drawCode128(gfx, v[0], v[1], item.module, v[2], item.data, item.len, color);
+            break;
+        default:
+            break;
+    }
+}
+
+static void DrawWidget(Adafruit_GFX *gfx, gui_ctx_t *ctx, gui_widget_t *widget)
+{
+    tm_t *tm = &ctx->tm;
+
+    switch (widget->type) {
+        case WIDGET_DATE_HEADER:
+            DrawDateHeader(gfx, 10, 28, tm);
+            break;
+        case WIDGET_LUNAR_HEADER:
+            DrawLunarHeader(gfx, 280, 28, &ctx->Lunar);
+            break;
+        case WIDGET_WEEK_HEADER:
+            DrawWeekHeader(gfx, 10, 32);
+            break;
+        case WIDGET_MONTH_DAY:
+            DrawMonthDay(gfx, tm, ctx->month, widget->arg);
+            break;
+        case WIDGET_BATTERY:
+            GFX_setTextColor(gfx, GFX_BLACK, GFX_WHITE);
+            DrawBattery(gfx, widget->x + 26, widget->y + 1, ctx->data->voltage);
+            break;
+        case WIDGET_TEMPERATURE:
+            GFX_setTextColor(gfx, GFX_BLACK, GFX_WHITE);
+            DrawTemperature(gfx, 330, 58, ctx->data->temperature);
+            break;
+        case WIDGET_CLOCK_DATE:
+            DrawDate(gfx, 40, 36, tm);
+            break;
+        case WIDGET_CLOCK_WEEK:
+            DrawClockWeek(gfx, tm, &ctx->Lunar);
+            break;
+        case WIDGET_CLOCK_LINE:
+            GFX_drawFastHLine(gfx, 30, widget->arg, 330, GFX_BLACK);
+            break;
+        case WIDGET_CLOCK_HOUR:
+            Draw7Number(gfx, tm->tm_hour, TIME_X, TIME_Y, TIME_CS, GFX_BLACK, GFX_WHITE, TIME_ND);
+            break;
+        case WIDGET_CLOCK_COLON:
+            DrawColon(gfx, COLON_X, TIME_Y, TIME_CS);
+            break;
+        case WIDGET_CLOCK_MINUTE:
+            Draw7Number(gfx, tm->tm_min, MINUTE_X, TIME_Y, TIME_CS, GFX_BLACK, GFX_WHITE, TIME_ND);
+            break;
+        case WIDGET_LUNAR_YEAR:
+            DrawLunarYear(gfx, &ctx->Lunar);
+            break;
+        case WIDGET_JIEQI: {
+            uint8_t day = 0;
+            uint8_t JQday = GetJieQiStr(tm->tm_year + YEAR0, tm->tm_mon + 1, tm->tm_mday, &day);
+            DrawJieQi(gfx, JQday, day);
+        } break;
+        case WIDGET_LIST_ITEM:
+            DrawListItem(gfx, ctx->data, &ctx->data->list[widget->arg]);
+            break;
+        case WIDGET_LIST_REST: {
+            uint16_t offset = widget->arg;
+            const uint8_t *p;
+            while ((p = ListNext(ctx->data, &offset)) != NULL)
+                DrawListItem(gfx, ctx->data, p);
+        } break;
+        default:
+            break;
+    }
+}
+
+static int32_t RectArea(const gui_rect_t *rect)
+{
+    return (int32_t)(rect->x1 - rect->x0) * (rect->y1 - rect->y0);
+}
+
+// 脏区域裁剪到屏幕内并按字节对齐, 合并后多出的面积不大的两个区域合并为一个
+static void MergeRects(gui_ctx_t *ctx, int16_t width, int16_t height)
+{
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < ctx->dirty; i++) {
+        gui_rect_t rect = ctx->rects[i];
+        rect.x0 = MAX(rect.x0, 0) & ~7;
+        rect.y0 = MAX(rect.y0, 0);
+        rect.x1 = MIN((rect.x1 + 7) & ~7, width);
+        rect.y1 = MIN(rect.y1, height);
+        if (rect.x0 < rect.x1 && rect.y0 < rect.y1)
+            ctx->rects[n++] = rect;
+    }
+
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = i + 1; j < n; j++) {
+            gui_rect_t *a = &ctx->rects[i], *b = &ctx->rects[j];
+            gui_rect_t u = {MIN(a->x0, b->x0), MIN(a->y0, b->y0), MAX(a->x1, b->x1), MAX(a->y1, b->y1)};
+            if (RectArea(&u) <= RectArea(a) + RectArea(b) + GUI_MERGE_AREA) {
+                *a = u;
+                ctx->rects[j] = ctx->rects[--n];
+                j = i; // a 变大了, 重新和其余区域比较
+            }
+        }
+    }
+    ctx->dirty = n;
+}
+
+static font_loader_t m_font_loader = NULL;
+
+void GUI_SetFontLoader(font_loader_t loader)
+{
+    m_font_loader = loader;
+}
+
+const uint8_t *GUI_GetFont(uint8_t id)
+{
+    switch (id) {
+        case FONT_WQY9:
+            return u8g2_font_wqy9_t_lunar;
+        case FONT_WQY12:
+            return u8g2_font_wqy12_t_lunar;
+        case FONT_HELVB14:
+            return u8g2_font_helvB14_tn;
+        case FONT_HELVB18:
+            return u8g2_font_helvB18_tn;
+        default:
+            break;
+    }
+    if (id >= FONT_USER && m_font_loader != NULL)
+        return m_font_loader(id);
+    return NULL;
+}
+
+void GUI_Invalidate(void)
+{
+    m_frame.valid = false;
+}
+
+static const gui_sink_t *m_sink;
+
+static void WritePage(uint8_t *black, uint8_t *color, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    m_sink->write(black, color, h);
+}
+
+bool DrawGUI(gui_data_t *data, const gui_sink_t *sink, display_mode_t mode)
+{
+    gui_ctx_t ctx = {0};
+
+    transformTime(data->timestamp, &ctx.tm);
+    ctx.data = data;
+
+    // 农历只与日期有关, 在分页循环外算好, 整月的结果在同一个月内一直有效
+    ctx.month = LUNAR_GetMonth(ctx.tm.tm_year + YEAR0, ctx.tm.tm_mon + 1);
+    LUNAR_GetDate(ctx.month, ctx.tm.tm_mday, &ctx.Lunar);
+
+    // 屏幕 RAM 里不是上一帧 (首次绘制, 换了模式或屏幕) 时整屏重画
+    bool full = !m_frame.valid || m_frame.mode != mode || m_frame.bwr != data->bwr ||
+                m_frame.width != data->width || m_frame.height != data->height;
+    if (full) m_frame.count = 0;
+
+    switch (mode) {
+        case MODE_CALENDAR:
+            AddCalendar(&ctx);
+            break;
+        case MODE_CLOCK:
+            AddClock(&ctx);
+            break;
+        case MODE_LIST:
+            AddList(&ctx);
+            break;
+        default:
+            break;
+    }
+    if (ctx.count < m_frame.count) { // 上一帧多出来的控件
+        gui_rect_t rect = {data->width, data->height, 0, 0};
+        for (uint8_t i = ctx.count; i < m_frame.count; i++) {
+            gui_widget_t *widget = &m_frame.widgets[i];
+            rect.x0 = MIN(rect.x0, widget->x);
+            rect.y0 = MIN(rect.y0, widget->y);
+            rect.x1 = MAX(rect.x1, widget->x + widget->w);
+            rect.y1 = MAX(rect.y1, widget->y + widget->h);
+        }
+        MarkDirty(&ctx, rect.x0, rect.y0, rect.x1, rect.y1);
+    }
+
+    m_frame.valid = true;
+    m_frame.bwr = data->bwr;
+    m_frame.width = data->width;
+    m_frame.height = data->height;
+    m_frame.mode = mode;
+    m_frame.count = ctx.count;
+
+    if (full) {
+        ctx.dirty = 0;
+        MarkDirty(&ctx, 0, 0, data->width, data->height);
+    } else {
+        MergeRects(&ctx, data->width, data->height);
+        if (ctx.dirty == 0) return false;
+    }
 
     Adafruit_GFX gfx;
 
@@ -208,23 +844,24 @@ void DrawGUI(gui_data_t *data, buffer_callback draw, display_mode_t mode)
     else
       GFX_begin(&gfx, data->width, data->height, PAGE_HEIGHT);
 
-    GFX_firstPage(&gfx);
-    do {
-        GFX_fillScreen(&gfx, GFX_WHITE);
-
-        LUNAR_SolarToLunar(&Lunar, tm.tm_year + YEAR0, tm.tm_mon + 1, tm.tm_mday);
-
-        switch (mode) {
-            case MODE_CALENDAR:
-                DrawCalendar(&gfx, &tm, &Lunar, data);
-                break;
-            case MODE_CLOCK:
-                DrawClock(&gfx, &tm, &Lunar, data);
-                break;
-            default:
-                break;
-        }
-    } while(GFX_nextPage(&gfx, draw));
+    m_sink = sink;
+    for (uint8_t i = 0; i < ctx.dirty; i++) {
+        gui_rect_t *rect = &ctx.rects[i];
+        GFX_setWindow(&gfx, rect->x0, rect->y0, rect->x1 - rect->x0, rect->y1 - rect->y0);
+        // 窗口按字节对齐后整个区域只设置一次, 各页的行连续写入
+        sink->begin(gfx.window_x, gfx.window_y, gfx.window_width, gfx.window_height);
+        GFX_firstPage(&gfx);
+        do {
+            GFX_fillScreen(&gfx, GFX_WHITE);
+            for (uint8_t j = 0; j < ctx.count; j++) {
+                gui_widget_t *widget = &m_frame.widgets[j];
+                if (GFX_isVisible(&gfx, widget->x, widget->y, widget->w, widget->h))
+                    DrawWidget(&gfx, &ctx, widget);
+            }
+        } while(GFX_nextPage(&gfx, WritePage));
+        if (sink->end) sink->end();
+    }
 
     GFX_end(&gfx);
+    return true;
 }
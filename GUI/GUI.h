@@ -11,6 +11,7 @@ typedef enum {
     MODE_NONE = 0,
     MODE_CALENDAR = 1,
     MODE_CLOCK = 2,
+    MODE_LIST = 3,      // 显示列表 (gui_data_t.list)
 } display_mode_t;
 
 typedef struct {
@@ -20,8 +21,81 @@ typedef struct {
     uint32_t timestamp;
     int8_t temperature;
     float voltage;
+    const uint8_t *list;    // MODE_LIST 的显示列表
+    uint16_t list_len;
+    const uint8_t *slots;   // 显示列表中槽的值, LIST_SLOT_COUNT 个, 每个 LIST_SLOT_SIZE 字节: 长度 + 值
 } gui_data_t;
 
-void DrawGUI(gui_data_t *data, buffer_callback draw, display_mode_t mode);
+/*
+ * 显示列表: 一串绘图项, 每项为 操作码 (1 字节) + 参数长度 (1 字节) + 参数, 按顺序画在白色背景上.
+ * 多字节数值为大端, 坐标和尺寸为有符号 16 位. 操作码 0 (或列表结束) 结束绘图项, 其后是位图数据区.
+ * 样式字节: 位 0-1 颜色 (0 黑, 1 白, 2 红, 黑白屏上红色画成黑色), 位 2 填充 (矩形和圆).
+ *   01 矩形: 样式, x, y, w, h
+ *   02 直线: 样式, x0, y0, x1, y1
+ *   03 圆:   样式, x, y, r
+ *   04 文字: 样式, x, y (基线), 字库 ID, UTF-8 文字 (不带结尾的 0)
+ *   05 位图: 样式, x, y, w, h, 数据偏移 (从列表开头算起, 1bpp 每行按字节对齐, 高位在左, 1 画成样式的颜色)
+ *   06 槽:   样式, x, y, w, h (方框), 字库 ID, 格式, 槽号
+ *   07 二维码: 样式, x, y (左上角), 模块大小 (1 字节, 像素), 纠错等级 (0 L, 1 M), 槽号, 文字
+ *   08 条码: 样式, x, y (左上角), h, 模块宽度 (1 字节, 像素), 槽号, 文字 (Code 128, ASCII 32-127)
+ * 参数比上面短的项, 未知的操作码, 找不到的字库和超出列表的位图数据都跳过.
+ *
+ * 槽是模板里可以单独更新的文字, 值另外保存, 只改槽的值时列表不变, 只重画值变了的槽.
+ * 格式字节: 位 0-1 对齐 (0 左, 1 居中, 2 右), 文字在方框里垂直居中, 超出方框的部分照样画出;
+ * 位 2 数字, 值为 4 字节有符号整数, 位 4-6 为小数位数 (值 1299, 2 位小数显示为 12.99), 否则值为 UTF-8 文字.
+ *
+ * 二维码 (版本 1-6, 最多 134 字节) 和条码 (最多 48 个字符) 的内容是槽的值, 槽号为 LIST_NO_SLOT 时是项里的文字.
+ * 内容放不下或有条码不支持的字符时不画. 两者都不画静区, 周围要留白 (二维码 4 个模块, 条码 10 个模块).
+ */
+typedef enum {
+    LIST_END = 0x00,
+    LIST_RECT = 0x01,
+    LIST_LINE = 0x02,
+    LIST_CIRCLE = 0x03,
+    LIST_TEXT = 0x04,
+    LIST_BITMAP = 0x05,
+    LIST_SLOT = 0x06,
+    LIST_QRCODE = 0x07,
+    LIST_BARCODE = 0x08,
+} list_op_t;
+
+#define LIST_COLOR_MASK    0x03
+#define LIST_FILL          0x04
+
+#define LIST_ALIGN_MASK    0x03
+#define LIST_ALIGN_LEFT    0x00
+#define LIST_ALIGN_CENTER  0x01
+#define LIST_ALIGN_RIGHT   0x02
+#define LIST_NUMBER        0x04
+#define LIST_DECIMALS(fmt) (((fmt) >> 4) & 0x07)
+
+#define LIST_SLOT_COUNT    8
+#define LIST_SLOT_SIZE     32   // 长度 (1 字节) + 最多 31 字节的值
+#define LIST_NO_SLOT       0xFF
+
+// 内置字库 ID，0x10 及以上的 ID 由字库加载器（蓝牙上传的字库包）提供
+typedef enum {
+    FONT_WQY9 = 0x00,
+    FONT_WQY12 = 0x01,
+    FONT_HELVB14 = 0x02,
+    FONT_HELVB18 = 0x03,
+    FONT_USER = 0x10,
+} font_id_t;
+
+typedef const uint8_t *(*font_loader_t)(uint8_t id);
+
+// 屏幕写入接口: 每个重画区域先 begin 一次设置窗口, 再从上到下依次写入各页的行, 最后 end (可为 NULL)
+typedef struct {
+    void (*begin)(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void (*write)(uint8_t *black, uint8_t *color, uint16_t h);
+    void (*end)(void);
+} gui_sink_t;
+
+void GUI_SetFontLoader(font_loader_t loader);
+const uint8_t *GUI_GetFont(uint8_t id);
+// 只重画与上一帧相比有变化的区域, 没有变化时返回 false.
+// 屏幕 RAM 不再是上一帧的内容时 (清屏, 写入图片, 断电等) 先调用 GUI_Invalidate 强制整屏重画.
+void GUI_Invalidate(void);
+bool DrawGUI(gui_data_t *data, const gui_sink_t *sink, display_mode_t mode);
 
 #endif
@@ -27,6 +27,29 @@ struct Lunar_Date
     uint16_t Year;
 };
 
+#define LUNAR_DAY_LEAP      0x10 // 闰月
+#define LUNAR_DAY_NEXT_YEAR 0x20 // 农历年比1日的农历年大1 (春节在本月)
+#define LUNAR_DAY_NO_JIEQI  0xFF
+
+// 月历中一天的农历信息
+struct Lunar_Day
+{
+    uint8_t Date;  // 农历日, 0 表示超出范围
+    uint8_t Month; // 低4位为农历月, 高位为 LUNAR_DAY_* 标志
+    uint8_t JieQi; // 节气序号, 无节气为 LUNAR_DAY_NO_JIEQI
+};
+
+// 公历一个月的农历信息, 由 LUNAR_GetMonth 算出并缓存
+struct Lunar_Month
+{
+    uint16_t Year;      // 公历年
+    uint8_t Month;      // 公历月
+    uint8_t Days;       // 本月天数
+    uint8_t FirstWeek;  // 1日是星期几
+    uint16_t LunarYear; // 1日的农历年
+    struct Lunar_Day Day[31];
+};
+
 extern const char Lunar_MonthString[13][7];
 extern const char Lunar_MonthLeapString[2][4];
 extern const char Lunar_DateString[31][7];
@@ -36,18 +59,24 @@ extern const char Lunar_StemStrig[10][4];
 extern const char Lunar_BranchStrig[12][4];
 extern const char JieQiStr[24][7];
 
+uint8_t LUNAR_GetDay(int32_t days, struct Lunar_Date *lunar);
 void LUNAR_SolarToLunar(struct Lunar_Date *lunar, uint16_t solar_year, uint8_t solar_month, uint8_t solar_date);
 uint8_t LUNAR_GetZodiac(const struct Lunar_Date *lunar);
 uint8_t LUNAR_GetStem(const struct Lunar_Date *lunar);
 uint8_t LUNAR_GetBranch(const struct Lunar_Date *lunar);
 uint8_t GetJieQiStr(uint16_t myear, uint8_t mmonth, uint8_t mday, uint8_t *day);
 uint8_t GetJieQi(uint16_t myear, uint8_t mmonth, uint8_t mday, uint8_t *JQdate);
+const struct Lunar_Month *LUNAR_GetMonth(uint16_t solar_year, uint8_t solar_month);
+void LUNAR_GetDate(const struct Lunar_Month *month, uint8_t solar_date, struct Lunar_Date *lunar);
 
-void transformTime(uint32_t unix_time, struct devtm *result);
-uint32_t transformTimeStruct(struct devtm *result);
+int32_t days_from_civil(int32_t year, uint8_t month, uint8_t day);
+void civil_from_days(int32_t days, int32_t *year, uint8_t *month, uint8_t *day);
+void transformTime(int64_t unix_time, struct devtm *result);
+int64_t transformTimeStruct(struct devtm *result);
 uint8_t get_first_day_week(uint16_t year, uint8_t month);
 uint8_t get_last_day(uint16_t year, uint8_t month);
 unsigned char day_of_week_get(unsigned char month, unsigned char day, unsigned short year);
-uint8_t thisMonthMaxDays(uint8_t year, uint8_t month);
+int is_leap(int yr);
+uint8_t thisMonthMaxDays(uint16_t year, uint8_t month);
 
 #endif
@@ -0,0 +1,208 @@
+// Generated by tools/almanac.py, do not edit.
+#include "almanac.h"
+
+const uint8_t almanac_jieqi_base[24] = {4, 19, 3, 18, 4, 19, 4, 19, 4, 20, 4, 20, 6, 22, 6, 22, 6, 22, 7, 22, 6, 21, 6, 21};
+
+const almanac_year_t almanac[ALMANAC_LAST_YEAR - ALMANAC_FIRST_YEAR + 1] = {
+    {0x125C,  0, 46, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x5A}}, // 1999
+    {0x192C,  0, 35, {0x5A, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2000
+    {0x1A95,  4, 23, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2001
+    {0x1A94,  0, 42, {0x55, 0x5A, 0x66, 0x65, 0x56, 0x55}}, // 2002
+    {0x1B4A,  0, 31, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x5A}}, // 2003
+    {0x0B55,  2, 21, {0x5A, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2004
+    {0x0AD4,  0, 39, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2005
+    {0x155B,  7, 28, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2006
+    {0x04BA,  0, 48, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x5A}}, // 2007
+    {0x125A,  0, 37, {0x5A, 0x45, 0x55, 0x51, 0x51, 0x15}}, // 2008
+    {0x192B,  5, 25, {0x15, 0x45, 0x55, 0x55, 0x55, 0x55}}, // 2009
+    {0x152A,  0, 44, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2010
+    {0x1694,  0, 33, {0x56, 0x5A, 0xA6, 0x65, 0x96, 0x5A}}, // 2011
+    {0x16AA,  4, 22, {0x5A, 0x45, 0x51, 0x51, 0x51, 0x15}}, // 2012
+    {0x15AA,  0, 40, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2013
+    {0x0AB5,  9, 30, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2014
+    {0x0974,  0, 49, {0x56, 0x5A, 0xA6, 0x65, 0x96, 0x56}}, // 2015
+    {0x14B6,  0, 38, {0x56, 0x05, 0x51, 0x51, 0x51, 0x15}}, // 2016
+    {0x0A57,  6, 27, {0x05, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2017
+    {0x0A56,  0, 46, {0x55, 0x59, 0x65, 0x55, 0x56, 0x55}}, // 2018
+    {0x1526,  0, 35, {0x55, 0x5A, 0x66, 0x65, 0x96, 0x56}}, // 2019
+    {0x0E95,  4, 24, {0x56, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2020
+    {0x0D54,  0, 42, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2021
+    {0x15AA,  0, 31, {0x55, 0x55, 0x65, 0x55, 0x55, 0x55}}, // 2022
+    {0x09B5,  2, 21, {0x55, 0x5A, 0x66, 0x65, 0x96, 0x56}}, // 2023
+    {0x096C,  0, 40, {0x56, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2024
+    {0x14AE,  6, 28, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2025
+    {0x149C,  0, 47, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2026
+    {0x1A4C,  0, 36, {0x55, 0x5A, 0x66, 0x65, 0x56, 0x55}}, // 2027
+    {0x1D26,  5, 25, {0x56, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2028
+    {0x1AA6,  0, 43, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2029
+    {0x0B54,  0, 33, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2030
+    {0x0D6A,  3, 22, {0x55, 0x5A, 0x66, 0x65, 0x56, 0x55}}, // 2031
+    {0x12DA,  0, 41, {0x56, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2032
+    {0x095D, 11, 30, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2033
+    {0x095A,  0, 49, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2034
+    {0x149A,  0, 38, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2035
+    {0x1A4B,  6, 27, {0x56, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2036
+    {0x1A4A,  0, 45, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2037
+    {0x1AA4,  0, 34, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2038
+    {0x1B54,  5, 23, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2039
+    {0x16B4,  0, 42, {0x56, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2040
+    {0x0ADA,  0, 31, {0x05, 0x45, 0x51, 0x51, 0x51, 0x15}}, // 2041
+    {0x095B,  2, 21, {0x15, 0x45, 0x55, 0x55, 0x55, 0x55}}, // 2042
+    {0x0936,  0, 40, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2043
+    {0x1497,  7, 29, {0x56, 0x05, 0x51, 0x10, 0x41, 0x05}}, // 2044
+    {0x1496,  0, 47, {0x05, 0x05, 0x51, 0x51, 0x51, 0x15}}, // 2045
+    {0x154A,  0, 36, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2046
+    {0x16A5,  5, 25, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2047
+    {0x0DA4,  0, 44, {0x56, 0x05, 0x11, 0x10, 0x41, 0x01}}, // 2048
+    {0x15B4,  0, 32, {0x01, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2049
+    {0x0AB6,  3, 22, {0x05, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2050
+    {0x126E,  0, 41, {0x55, 0x55, 0x65, 0x55, 0x55, 0x55}}, // 2051
+    {0x092F,  8, 31, {0x55, 0x05, 0x11, 0x10, 0x41, 0x01}}, // 2052
+    {0x092E,  0, 49, {0x01, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2053
+    {0x0C96,  0, 38, {0x05, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2054
+    {0x0D4A,  6, 27, {0x55, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2055
+    {0x1D4A,  0, 45, {0x55, 0x05, 0x11, 0x10, 0x41, 0x01}}, // 2056
+    {0x0D64,  0, 34, {0x01, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2057
+    {0x156C,  4, 23, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2058
+    {0x155C,  0, 42, {0x55, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2059
+    {0x125C,  0, 32, {0x55, 0x05, 0x11, 0x10, 0x01, 0x00}}, // 2060
+    {0x192E,  3, 20, {0x01, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2061
+    {0x192C,  0, 39, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2062
+    {0x1A95,  7, 28, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2063
+    {0x1A94,  0, 47, {0x55, 0x05, 0x11, 0x10, 0x01, 0x00}}, // 2064
+    {0x1B4A,  0, 35, {0x01, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2065
+    {0x0B55,  5, 25, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2066
+    {0x0AD4,  0, 44, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2067
+    {0x14DA,  0, 33, {0x55, 0x05, 0x10, 0x00, 0x01, 0x00}}, // 2068
+    {0x0A5D,  4, 22, {0x01, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2069
+    {0x0A5A,  0, 41, {0x05, 0x45, 0x51, 0x51, 0x51, 0x15}}, // 2070
+    {0x152B,  8, 30, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2071
+    {0x152A,  0, 49, {0x55, 0x05, 0x10, 0x00, 0x01, 0x00}}, // 2072
+    {0x1694,  0, 37, {0x01, 0x05, 0x51, 0x10, 0x41, 0x05}}, // 2073
+    {0x16AA,  6, 26, {0x05, 0x45, 0x51, 0x51, 0x51, 0x15}}, // 2074
+    {0x15AA,  0, 45, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2075
+    {0x0AB4,  0, 35, {0x55, 0x05, 0x10, 0x00, 0x01, 0x00}}, // 2076
+    {0x14BA,  4, 23, {0x01, 0x05, 0x51, 0x10, 0x41, 0x05}}, // 2077
+    {0x14B6,  0, 42, {0x05, 0x05, 0x51, 0x50, 0x51, 0x15}}, // 2078
+    {0x0A56,  0, 32, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2079
+    {0x1527,  3, 21, {0x55, 0x05, 0x10, 0x00, 0x01, 0x00}}, // 2080
+    {0x0D26,  0, 39, {0x01, 0x05, 0x11, 0x10, 0x41, 0x01}}, // 2081
+    {0x0E53,  7, 28, {0x05, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2082
+    {0x0D54,  0, 47, {0x05, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2083
+    {0x15AA,  0, 36, {0x55, 0x00, 0x10, 0x00, 0x00, 0x00}}, // 2084
+    {0x09B5,  5, 25, {0x00, 0x05, 0x11, 0x10, 0x41, 0x01}}, // 2085
+    {0x096C,  0, 44, {0x01, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2086
+    {0x14AE,  0, 33, {0x05, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2087
+    {0x0A4E,  4, 23, {0x55, 0x00, 0x00, 0x00, 0x00, 0x00}}, // 2088
+    {0x1A4C,  0, 40, {0x00, 0x05, 0x11, 0x10, 0x41, 0x01}}, // 2089
+    {0x1D26,  8, 29, {0x01, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2090
+    {0x1AA4,  0, 48, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2091
+    {0x1B54,  0, 37, {0x55, 0x00, 0x00, 0x00, 0x00, 0x00}}, // 2092
+    {0x0D6A,  6, 26, {0x00, 0x05, 0x11, 0x10, 0x01, 0x00}}, // 2093
+    {0x0ADA,  0, 45, {0x01, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2094
+    {0x095C,  0, 35, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2095
+    {0x149D,  4, 24, {0x15, 0x00, 0x00, 0x00, 0x00, 0x00}}, // 2096
+    {0x149A,  0, 42, {0x00, 0x05, 0x11, 0x00, 0x01, 0x00}}, // 2097
+    {0x1A2A,  0, 31, {0x01, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2098
+    {0x1B25,  2, 20, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2099
+    {0x1AA4,  0, 39, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2100
+    {0x1B52,  7, 28, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2101
+    {0x16B4,  0, 47, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x5A}}, // 2102
+    {0x0ABA,  0, 37, {0x5A, 0x9A, 0xA6, 0xA6, 0xA6, 0x6A}}, // 2103
+    {0x095B,  5, 27, {0x6A, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2104
+    {0x0936,  0, 45, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2105
+    {0x1496,  0, 34, {0x56, 0x5A, 0xA6, 0x65, 0x96, 0x5A}}, // 2106
+    {0x1A4B,  4, 23, {0x5A, 0x9A, 0xA6, 0xA5, 0xA6, 0x6A}}, // 2107
+    {0x154A,  0, 42, {0x6A, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2108
+    {0x16A5,  9, 30, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2109
+    {0x0DA4,  0, 49, {0x56, 0x5A, 0x66, 0x65, 0x96, 0x5A}}, // 2110
+    {0x15AC,  0, 38, {0x5A, 0x5A, 0xA6, 0x65, 0xA6, 0x6A}}, // 2111
+    {0x0AB6,  6, 28, {0x6A, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2112
+    {0x126E,  0, 46, {0x55, 0x5A, 0x65, 0x55, 0x55, 0x55}}, // 2113
+    {0x092E,  0, 36, {0x56, 0x5A, 0x66, 0x65, 0x96, 0x56}}, // 2114
+    {0x0C97,  4, 25, {0x5A, 0x5A, 0xA6, 0x65, 0xA6, 0x6A}}, // 2115
+    {0x0A96,  0, 44, {0x6A, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2116
+    {0x0D4A,  0, 32, {0x55, 0x59, 0x55, 0x55, 0x55, 0x55}}, // 2117
+    {0x0DA5,  3, 21, {0x56, 0x5A, 0x66, 0x65, 0x96, 0x56}}, // 2118
+    {0x0D54,  0, 40, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x6A}}, // 2119
+    {0x156A,  7, 29, {0x5A, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2120
+    {0x155A,  0, 47, {0x55, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2121
+    {0x0A5C,  0, 37, {0x55, 0x5A, 0x66, 0x65, 0x56, 0x56}}, // 2122
+    {0x192E,  5, 26, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x5A}}, // 2123
+    {0x152C,  0, 45, {0x5A, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2124
+    {0x1A94,  0, 33, {0x55, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2125
+    {0x1D4A,  4, 22, {0x55, 0x5A, 0x66, 0x55, 0x56, 0x55}}, // 2126
+    {0x1B2A,  0, 41, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x5A}}, // 2127
+    {0x0B55, 11, 31, {0x5A, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2128
+    {0x0AD4,  0, 49, {0x15, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2129
+    {0x14DA,  0, 38, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2130
+    {0x0A5D,  6, 28, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x5A}}, // 2131
+    {0x0A5A,  0, 47, {0x5A, 0x45, 0x51, 0x51, 0x51, 0x15}}, // 2132
+    {0x151A,  0, 35, {0x15, 0x55, 0x55, 0x51, 0x55, 0x55}}, // 2133
+    {0x1A95,  5, 24, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2134
+    {0x1654,  0, 43, {0x56, 0x5A, 0xA6, 0x65, 0xA6, 0x5A}}, // 2135
+    {0x16AA,  0, 32, {0x5A, 0x45, 0x51, 0x50, 0x51, 0x15}}, // 2136
+    {0x0AD5,  2, 21, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2137
+    {0x0AB4,  0, 40, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2138
+    {0x14BA,  7, 29, {0x56, 0x5A, 0x66, 0x65, 0x96, 0x5A}}, // 2139
+    {0x14B6,  0, 48, {0x5A, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2140
+    {0x0A56,  0, 37, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2141
+    {0x1517,  5, 26, {0x55, 0x5A, 0x65, 0x55, 0x55, 0x55}}, // 2142
+    {0x0D16,  0, 45, {0x56, 0x5A, 0x66, 0x65, 0x96, 0x5A}}, // 2143
+    {0x0E52,  0, 34, {0x5A, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2144
+    {0x16AA,  4, 22, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2145
+    {0x0D6A,  0, 41, {0x55, 0x5A, 0x55, 0x55, 0x55, 0x55}}, // 2146
+    {0x05B5, 11, 31, {0x56, 0x5A, 0x66, 0x65, 0x96, 0x56}}, // 2147
+    {0x096C,  0, 50, {0x5A, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2148
+    {0x14AE,  0, 38, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2149
+    {0x0A2E,  6, 28, {0x55, 0x59, 0x55, 0x55, 0x55, 0x55}}, // 2150
+    {0x1A2C,  0, 46, {0x56, 0x5A, 0x66, 0x65, 0x96, 0x56}}, // 2151
+    {0x1D16,  0, 35, {0x56, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2152
+    {0x0D52,  5, 24, {0x05, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2153
+    {0x1B52,  0, 42, {0x55, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2154
+    {0x0B6A,  0, 32, {0x55, 0x5A, 0x66, 0x55, 0x56, 0x56}}, // 2155
+    {0x056D,  3, 22, {0x56, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2156
+    {0x055C,  0, 40, {0x05, 0x45, 0x55, 0x51, 0x55, 0x15}}, // 2157
+    {0x145D,  7, 29, {0x55, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2158
+    {0x145A,  0, 48, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2159
+    {0x1A2A,  0, 37, {0x56, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2160
+    {0x1A95,  6, 25, {0x05, 0x45, 0x51, 0x51, 0x55, 0x15}}, // 2161
+    {0x16A4,  0, 44, {0x15, 0x55, 0x55, 0x51, 0x55, 0x55}}, // 2162
+    {0x1AD2,  0, 33, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2163
+    {0x0B5A,  4, 23, {0x56, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2164
+    {0x0AB6,  0, 41, {0x05, 0x45, 0x51, 0x50, 0x51, 0x15}}, // 2165
+    {0x055B, 10, 31, {0x15, 0x55, 0x55, 0x51, 0x55, 0x55}}, // 2166
+    {0x08B6,  0, 50, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2167
+    {0x1456,  0, 39, {0x56, 0x05, 0x51, 0x10, 0x41, 0x05}}, // 2168
+    {0x152B,  6, 27, {0x05, 0x45, 0x51, 0x50, 0x51, 0x15}}, // 2169
+    {0x152A,  0, 46, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2170
+    {0x1694,  0, 35, {0x55, 0x5A, 0x65, 0x55, 0x56, 0x55}}, // 2171
+    {0x16AA,  5, 24, {0x56, 0x05, 0x11, 0x10, 0x41, 0x05}}, // 2172
+    {0x15AA,  0, 42, {0x05, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2173
+    {0x0AB6,  0, 32, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2174
+    {0x04B7,  3, 22, {0x55, 0x5A, 0x55, 0x55, 0x55, 0x55}}, // 2175
+    {0x08AE,  0, 41, {0x56, 0x05, 0x11, 0x10, 0x41, 0x05}}, // 2176
+    {0x0C57,  7, 29, {0x05, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2177
+    {0x0A56,  0, 48, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2178
+    {0x0D2A,  0, 37, {0x55, 0x5A, 0x55, 0x55, 0x55, 0x55}}, // 2179
+    {0x0D95,  6, 26, {0x56, 0x05, 0x11, 0x10, 0x41, 0x01}}, // 2180
+    {0x0B54,  0, 44, {0x05, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2181
+    {0x156A,  0, 33, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2182
+    {0x0A6D,  4, 23, {0x55, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2183
+    {0x095C,  0, 42, {0x56, 0x05, 0x11, 0x10, 0x41, 0x01}}, // 2184
+    {0x14AE,  0, 30, {0x05, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2185
+    {0x0A56,  2, 20, {0x05, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2186
+    {0x1A54,  0, 38, {0x55, 0x55, 0x55, 0x55, 0x55, 0x55}}, // 2187
+    {0x1D2A,  6, 27, {0x56, 0x05, 0x11, 0x00, 0x01, 0x01}}, // 2188
+    {0x1AAA,  0, 45, {0x01, 0x05, 0x51, 0x10, 0x51, 0x15}}, // 2189
+    {0x0B54,  0, 35, {0x05, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2190
+    {0x156A,  5, 24, {0x55, 0x55, 0x55, 0x51, 0x55, 0x55}}, // 2191
+    {0x14DA,  0, 43, {0x55, 0x05, 0x10, 0x00, 0x01, 0x00}}, // 2192
+    {0x095C,  0, 32, {0x01, 0x05, 0x51, 0x10, 0x51, 0x05}}, // 2193
+    {0x14AB,  3, 21, {0x05, 0x45, 0x51, 0x50, 0x51, 0x15}}, // 2194
+    {0x149A,  0, 40, {0x15, 0x55, 0x55, 0x51, 0x55, 0x55}}, // 2195
+    {0x1A4B,  7, 29, {0x55, 0x05, 0x10, 0x00, 0x01, 0x00}}, // 2196
+    {0x1652,  0, 47, {0x01, 0x05, 0x11, 0x10, 0x51, 0x05}}, // 2197
+    {0x16AA,  0, 36, {0x05, 0x45, 0x51, 0x50, 0x51, 0x15}}, // 2198
+    {0x0AD5,  6, 26, {0x15, 0x45, 0x55, 0x51, 0x55, 0x55}}, // 2199
+};
@@ -0,0 +1,30 @@
+// Generated by tools/almanac.py, do not edit.
+#ifndef __ALMANAC_H
+#define __ALMANAC_H
+
+#include <stdint.h>
+
+#define ALMANAC_FIRST_YEAR 1999
+#define ALMANAC_LAST_YEAR  2199
+
+/**
+ * 一个公历年的农历和节气数据
+ *
+ * months:   春节在本年的农历年各月大小, bit12 为正月, 1 为大月(30天), 闰月紧跟在同名月之后
+ * leap:     闰月月份, 0 为无闰月
+ * new_year: 春节是本年的第几天, 1月1日为 0
+ * jieqi:    24节气的日期, 第 i 个节气(小寒为 0)在 i / 2 + 1 月的
+ *           almanac_jieqi_base[i] + ((jieqi[i / 4] >> (i % 4 * 2)) & 3) 日
+ */
+typedef struct
+{
+    uint16_t months;
+    uint8_t leap;
+    uint8_t new_year;
+    uint8_t jieqi[6];
+} almanac_year_t;
+
+extern const uint8_t almanac_jieqi_base[24];
+extern const almanac_year_t almanac[ALMANAC_LAST_YEAR - ALMANAC_FIRST_YEAR + 1];
+
+#endif
@@ -0,0 +1,456 @@
+#include <string.h>
+#include "barcode.h"
+
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+#ifndef ABS
+#define ABS(x) ((x) > 0 ? (x) : -(x))
+#endif
+
+/*
+ * 二维码编码参考 ISO/IEC 18004. 版本 1-6 的 L/M 等级每块的数据码字数都相同, 不用处理长短块,
+ * 也没有版本信息块, 只有右下角的一个校正图形.
+ */
+typedef struct {
+    uint8_t total;  // 码字总数
+    uint8_t ec[2];  // 每块的纠错码字数, L/M
+    uint8_t blocks[2];
+} qr_version_t;
+
+static const qr_version_t qr_versions[QR_VERSION_MAX] = {
+    {26,  {7, 10},  {1, 1}},
+    {44,  {10, 16}, {1, 1}},
+    {70,  {15, 26}, {1, 1}},
+    {100, {20, 18}, {1, 2}},
+    {134, {26, 24}, {1, 2}},
+    {172, {18, 16}, {2, 4}},
+};
+
+#define QR_TOTAL_MAX 172
+#define QR_EC_MAX    26
+
+static uint8_t QR_DataCodewords(uint8_t version, qr_ecc_t ecc)
+{
+    const qr_version_t *v = &qr_versions[version - 1];
+    return v->total - v->ec[ecc] * v->blocks[ecc];
+}
+
+uint8_t QR_Version(uint16_t len, qr_ecc_t ecc)
+{
+    for (uint8_t version = 1; version <= QR_VERSION_MAX; version++) {
+        // 模式 (4 位) + 长度 (8 位) + 数据
+        if (len * 8 + 12 <= QR_DataCodewords(version, ecc) * 8)
+            return version;
+    }
+    return 0;
+}
+
+bool QR_GetModule(const qr_code_t *qr, uint8_t x, uint8_t y)
+{
+    uint16_t i = y * qr->size + x;
+    return (qr->modules[i / 8] >> (i & 7)) & 1;
+}
+
+static void QR_SetModule(qr_code_t *qr, uint8_t x, uint8_t y, bool dark)
+{
+    uint16_t i = y * qr->size + x;
+    if (dark)
+        qr->modules[i / 8] |= 1 << (i & 7);
+    else
+        qr->modules[i / 8] &= ~(1 << (i & 7));
+}
+
+// 定位图形 (含分隔符和格式信息), 定时图形, 校正图形和深色模块, 不放数据
+static bool QR_IsFunction(const qr_code_t *qr, uint8_t x, uint8_t y)
+{
+    uint8_t size = qr->size, c = size - 7;
+    if ((x < 9 && y < 9) || (x >= size - 8 && y < 9) || (x < 9 && y >= size - 8))
+        return true;
+    if (x == 6 || y == 6)
+        return true;
+    return size > QR_SIZE(1) && x + 2 >= c && x <= c + 2 && y + 2 >= c && y <= c + 2;
+}
+
+static void QR_DrawPattern(qr_code_t *qr, uint8_t cx, uint8_t cy, uint8_t radius)
+{
+    for (int8_t dy = -radius; dy <= radius; dy++) {
+        for (int8_t dx = -radius; dx <= radius; dx++) {
+            int16_t x = cx + dx, y = cy + dy;
+            uint8_t dist = MAX(ABS(dx), ABS(dy));
+            if (x < 0 || y < 0 || x >= qr->size || y >= qr->size) continue;
+            // 定位图形 7x7 加一圈分隔符, 校正图形 5x5
+            QR_SetModule(qr, x, y, radius == 4 ? (dist != 2 && dist != 4) : dist != 1);
+        }
+    }
+}
+
+static void QR_DrawFunctions(qr_code_t *qr)
+{
+    uint8_t size = qr->size;
+
+    for (uint8_t i = 0; i < size; i++) {
+        QR_SetModule(qr, 6, i, i % 2 == 0);
+        QR_SetModule(qr, i, 6, i % 2 == 0);
+    }
+    QR_DrawPattern(qr, 3, 3, 4);
+    QR_DrawPattern(qr, size - 4, 3, 4);
+    QR_DrawPattern(qr, 3, size - 4, 4);
+    if (size > QR_SIZE(1))
+        QR_DrawPattern(qr, size - 7, size - 7, 2);
+}
+
+static void QR_DrawFormat(qr_code_t *qr, qr_ecc_t ecc, uint8_t mask)
+{
+    uint8_t size = qr->size;
+    uint16_t data = (ecc == QR_ECC_L ? 1 : 0) << 3 | mask, rem = data;
+
+    for (uint8_t i = 0; i < 10; i++)
+        rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+    uint16_t bits = (data << 10 | rem) ^ 0x5412;
+
+    for (uint8_t i = 0; i < 15; i++) {
+        bool dark = (bits >> i) & 1;
+        // 左上角
+        if (i < 6)
+            QR_SetModule(qr, 8, i, dark);
+        else if (i < 8)
+            QR_SetModule(qr, 8, i + 1, dark);
+        else if (i == 8)
+            QR_SetModule(qr, 7, 8, dark);
+        else
+            QR_SetModule(qr, 14 - i, 8, dark);
+        // 右上角和左下角
+        if (i < 8)
+            QR_SetModule(qr, size - 1 - i, 8, dark);
+        else
+            QR_SetModule(qr, 8, size - 15 + i, dark);
+    }
+    QR_SetModule(qr, 8, size - 8, true);
+}
+
+static bool QR_Mask(uint8_t mask, uint8_t x, uint8_t y)
+{
+    switch (mask) {
+        case 0: return (x + y) % 2 == 0;
+        case 1: return y % 2 == 0;
+        case 2: return x % 3 == 0;
+        case 3: return (x + y) % 3 == 0;
+        case 4: return (x / 3 + y / 2) % 2 == 0;
+        case 5: return x * y % 2 + x * y % 3 == 0;
+        case 6: return (x * y % 2 + x * y % 3) % 2 == 0;
+        default: return ((x + y) % 2 + x * y % 3) % 2 == 0;
+    }
+}
+
+static void QR_ApplyMask(qr_code_t *qr, uint8_t mask)
+{
+    for (uint8_t y = 0; y < qr->size; y++) {
+        for (uint8_t x = 0; x < qr->size; x++) {
+            if (!QR_IsFunction(qr, x, y) && QR_Mask(mask, x, y))
+                QR_SetModule(qr, x, y, !QR_GetModule(qr, x, y));
+        }
+    }
+}
+
+// 行 (transpose 为列) 中的扣分: 连续同色, 类似定位图形的 1:1:3:1:1
+static uint32_t QR_LinePenalty(const qr_code_t *qr, uint8_t n, bool transpose)
+{
+    uint32_t penalty = 0;
+    uint16_t bits = 0;  // 最近的 11 个模块
+    uint8_t run = 0;
+    bool last = false;
+
+    for (uint8_t i = 0; i < qr->size; i++) {
+        bool dark = transpose ? QR_GetModule(qr, n, i) : QR_GetModule(qr, i, n);
+        if (i > 0 && dark == last) {
+            if (++run == 5)
+                penalty += 3;
+            else if (run > 5)
+                penalty++;
+        } else {
+            run = 1;
+        }
+        last = dark;
+        bits = ((bits << 1) | dark) & 0x7FF;
+        if (i >= 10 && (bits == 0x5D0 || bits == 0x05D)) // 1011101 加 4 个浅色模块
+            penalty += 40;
+    }
+    return penalty;
+}
+
+static uint32_t QR_Penalty(const qr_code_t *qr)
+{
+    uint8_t size = qr->size;
+    uint32_t penalty = 0;
+    uint16_t dark = 0;
+
+    for (uint8_t i = 0; i < size; i++)
+        penalty += QR_LinePenalty(qr, i, false) + QR_LinePenalty(qr, i, true);
+    for (uint8_t y = 0; y < size; y++) {
+        for (uint8_t x = 0; x < size; x++) {
+            bool color = QR_GetModule(qr, x, y);
+            dark += color;
+            if (x + 1 < size && y + 1 < size && color == QR_GetModule(qr, x + 1, y) &&
+                color == QR_GetModule(qr, x, y + 1) && color == QR_GetModule(qr, x + 1, y + 1))
+                penalty += 3;
+        }
+    }
+    uint16_t total = size * size;
+    uint16_t percent = dark * 100 / total;
+    penalty += (percent > 50 ? percent - 50 : 50 - percent) / 5 * 10;
+    return penalty;
+}
+
+static uint8_t GF_Multiply(uint8_t a, uint8_t b)
+{
+    uint8_t r = 0;
+    while (b) {
+        if (b & 1) r ^= a;
+        a = (a << 1) ^ (a & 0x80 ? 0x1D : 0); // x^8 + x^4 + x^3 + x^2 + 1
+        b >>= 1;
+    }
+    return r;
+}
+
+// 里德-所罗门纠错码, 生成多项式的根为 2^0 ... 2^(n-1)
+static void QR_ReedSolomon(const uint8_t *data, uint8_t len, uint8_t *ec, uint8_t n)
+{
+    uint8_t divisor[QR_EC_MAX];
+    uint8_t root = 1;
+
+    memset(divisor, 0, n);
+    divisor[n - 1] = 1;
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            divisor[j] = GF_Multiply(divisor[j], root);
+            if (j + 1 < n)
+                divisor[j] ^= divisor[j + 1];
+        }
+        root = GF_Multiply(root, 2);
+    }
+
+    memset(ec, 0, n);
+    for (uint8_t i = 0; i < len; i++) {
+        uint8_t factor = data[i] ^ ec[0];
+        memmove(ec, ec + 1, n - 1);
+        ec[n - 1] = 0;
+        for (uint8_t j = 0; j < n; j++)
+            ec[j] ^= GF_Multiply(divisor[j], factor);
+    }
+}
+
+bool QR_Encode(qr_code_t *qr, const uint8_t *data, uint16_t len, qr_ecc_t ecc)
+{
+    uint8_t version = QR_Version(len, ecc);
+    if (version == 0) return false;
+
+    const qr_version_t *v = &qr_versions[version - 1];
+    uint8_t dc = QR_DataCodewords(version, ecc), ec = v->ec[ecc], blocks = v->blocks[ecc];
+    uint8_t codewords[QR_TOTAL_MAX], stream[QR_TOTAL_MAX - QR_EC_MAX];
+
+    // 字节模式 0100, 8 位长度, 数据, 结束符和填充 0xEC 0x11
+    memset(stream, 0, sizeof(stream));
+    stream[0] = 0x40 | len >> 4;
+    stream[1] = len << 4;
+    for (uint16_t i = 0; i < len; i++) {
+        stream[i + 1] |= data[i] >> 4;
+        stream[i + 2] = data[i] << 4;
+    }
+    for (uint8_t i = len + 2; i < dc; i++)
+        stream[i] = (i - len) % 2 ? 0x11 : 0xEC;
+
+    // 各块的数据码字和纠错码字交错排列
+    for (uint8_t b = 0; b < blocks; b++) {
+        uint8_t per = dc / blocks, rs[QR_EC_MAX];
+        QR_ReedSolomon(&stream[b * per], per, rs, ec);
+        for (uint8_t i = 0; i < per; i++)
+            codewords[i * blocks + b] = stream[b * per + i];
+        for (uint8_t i = 0; i < ec; i++)
+            codewords[dc + i * blocks + b] = rs[i];
+    }
+
+    memset(qr, 0, sizeof(qr_code_t));
+    qr->size = QR_SIZE(version);
+    QR_DrawFunctions(qr);
+
+    // 从右下角起每两列一组之字形放置, 跳过定时图形所在的列
+    uint16_t bit = 0;
+    for (int16_t right = qr->size - 1; right >= 1; right -= 2) {
+        if (right == 6) right = 5;
+        bool upward = ((right + 1) & 2) == 0;
+        for (uint8_t vert = 0; vert < qr->size; vert++) {
+            uint8_t y = upward ? qr->size - 1 - vert : vert;
+            for (uint8_t j = 0; j < 2; j++) {
+                uint8_t x = right - j;
+                if (QR_IsFunction(qr, x, y) || bit >= v->total * 8) continue;
+                QR_SetModule(qr, x, y, (codewords[bit / 8] >> (7 - bit % 8)) & 1);
+                bit++;
+            }
+        }
+    }
+
+    // 选扣分最少的掩模
+    uint8_t best = 0;
+    uint32_t best_penalty = UINT32_MAX;
+    for (uint8_t mask = 0; mask < 8; mask++) {
+        QR_ApplyMask(qr, mask);
+        QR_DrawFormat(qr, ecc, mask);
+        uint32_t penalty = QR_Penalty(qr);
+        if (penalty < best_penalty) {
+            best = mask;
+            best_penalty = penalty;
+        }
+        QR_ApplyMask(qr, mask);
+    }
+    QR_ApplyMask(qr, best);
+    QR_DrawFormat(qr, ecc, best);
+    return true;
+}
+
+static uint32_t Hash(const uint8_t *data, uint16_t len, uint32_t hash)
+{
+    for (uint16_t i = 0; i < len; i++)
+        hash = (hash ^ data[i]) * 16777619UL; // FNV-1a
+    return hash;
+}
+
+void GFX_drawQRCode(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t scale, const uint8_t *data,
+                    uint16_t len, qr_ecc_t ecc, uint16_t color)
+{
+    // 每页都会画一次, 只缓存最后一个
+    static qr_code_t qr;
+    static uint32_t key;
+    uint32_t hash = Hash(data, len, 2166136261UL) ^ (len << 8 | ecc);
+
+    uint8_t version = QR_Version(len, ecc);
+    if (version == 0 || !GFX_isVisible(gfx, x, y, QR_SIZE(version) * scale, QR_SIZE(version) * scale))
+        return;
+    if (qr.size == 0 || hash != key) {
+        if (!QR_Encode(&qr, data, len, ecc)) return;
+        key = hash;
+    }
+
+    for (uint8_t j = 0; j < qr.size; j++) {
+        int16_t row = y + j * scale;
+        if (!GFX_isVisible(gfx, x, row, qr.size * scale, scale)) continue;
+        // 同一行中连续的深色模块画成一个矩形
+        for (uint8_t i = 0; i < qr.size; i++) {
+            if (!QR_GetModule(&qr, i, j)) continue;
+            uint8_t start = i;
+            while (i + 1 < qr.size && QR_GetModule(&qr, i + 1, j))
+                i++;
+            GFX_fillRect(gfx, x + start * scale, row, (i + 1 - start) * scale, scale, color);
+        }
+    }
+}
+
+/*
+ * Code 128 的 107 个符号 (0-102 为数据, 103-105 为起始符 A/B/C, 106 为终止符),
+ * 每个符号 3 条 3 空共 11 个模块.
+ */
+static const uint16_t code128_patterns[107] = {
+    0x06CC, 0x066C, 0x0666, 0x0498, 0x048C, 0x044C, 0x04C8, 0x04C4,
+    0x0464, 0x0648, 0x0644, 0x0624, 0x059C, 0x04DC, 0x04CE, 0x05CC,
+    0x04EC, 0x04E6, 0x0672, 0x065C, 0x064E, 0x06E4, 0x0674, 0x076E,
+    0x074C, 0x072C, 0x0726, 0x0764, 0x0734, 0x0732, 0x06D8, 0x06C6,
+    0x0636, 0x0518, 0x0458, 0x0446, 0x0588, 0x0468, 0x0462, 0x0688,
+    0x0628, 0x0622, 0x05B8, 0x058E, 0x046E, 0x05D8, 0x05C6, 0x0476,
+    0x0776, 0x068E, 0x062E, 0x06E8, 0x06E2, 0x06EE, 0x0758, 0x0746,
+    0x0716, 0x0768, 0x0762, 0x071A, 0x077A, 0x0642, 0x078A, 0x0530,
+    0x050C, 0x04B0, 0x0486, 0x042C, 0x0426, 0x0590, 0x0584, 0x04D0,
+    0x04C2, 0x0434, 0x0432, 0x0612, 0x0650, 0x07BA, 0x0614, 0x047A,
+    0x053C, 0x04BC, 0x049E, 0x05E4, 0x04F4, 0x04F2, 0x07A4, 0x0794,
+    0x0792, 0x06DE, 0x06F6, 0x07B6, 0x0578, 0x051E, 0x045E, 0x05E8,
+    0x05E2, 0x07A8, 0x07A2, 0x05DE, 0x05EE, 0x075E, 0x07AE, 0x0684,
+    0x0690, 0x069C, 0x18EB,
+};
+
+#define CODE128_CODE_C  99
+#define CODE128_CODE_B  100
+#define CODE128_START_B 104
+#define CODE128_START_C 105
+#define CODE128_STOP    106
+
+static uint8_t CountDigits(const uint8_t *text, uint8_t len)
+{
+    uint8_t n = 0;
+    while (n < len && text[n] >= '0' && text[n] <= '9')
+        n++;
+    return n;
+}
+
+uint8_t CODE128_Encode(const uint8_t *text, uint8_t len, uint8_t *symbols)
+{
+    uint8_t count = 0, i = 0;
+    bool c = false;
+
+    if (len == 0 || len > CODE128_MAX_TEXT) return 0;
+    for (uint8_t j = 0; j < len; j++) {
+        if (text[j] < 32 || text[j] > 127) return 0;
+    }
+
+    // 开头至少 4 个数字 (全是数字时至少 2 个且为偶数) 用字符集 C 开始
+    uint8_t digits = CountDigits(text, len);
+    c = digits >= 4 || (digits == len && digits % 2 == 0);
+    symbols[count++] = c ? CODE128_START_C : CODE128_START_B;
+
+    while (i < len) {
+        digits = CountDigits(&text[i], len - i);
+        if (c) {
+            if (digits >= 2) {
+                symbols[count++] = (text[i] - '0') * 10 + text[i + 1] - '0';
+                i += 2;
+                continue;
+            }
+            symbols[count++] = CODE128_CODE_B;
+            c = false;
+        }
+        // 中间至少 6 个, 结尾至少 4 个数字时切换到字符集 C, 奇数个时先用 B 写一个
+        if (digits >= 6 || (digits >= 4 && i + digits == len)) {
+            if (digits % 2)
+                symbols[count++] = text[i++] - 32;
+            symbols[count++] = CODE128_CODE_C;
+            c = true;
+            continue;
+        }
+        symbols[count++] = text[i++] - 32;
+    }
+
+    uint32_t sum = symbols[0];
+    for (uint8_t j = 1; j < count; j++)
+        sum += (uint32_t)j * symbols[j];
+    symbols[count++] = sum % 103;
+    symbols[count++] = CODE128_STOP;
+    return count;
+}
+
+uint16_t CODE128_Pattern(uint8_t symbol)
+{
+    return code128_patterns[symbol];
+}
+
+void GFX_drawCode128(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t module, int16_t h,
+                     const uint8_t *text, uint8_t len, uint16_t color)
+{
+    uint8_t symbols[CODE128_MAX_SYMBOLS];
+    uint8_t count = CODE128_Encode(text, len, symbols);
+
+    if (count == 0 || !GFX_isVisible(gfx, x, y, CODE128_MODULES(count) * module, h)) return;
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t pattern = code128_patterns[symbols[i]];
+        int8_t b = (symbols[i] == CODE128_STOP ? 13 : 11) - 1;
+        // 每条画成一个矩形
+        while (b >= 0) {
+            bool bar = (pattern >> b) & 1;
+            uint8_t width = 0;
+            while (b >= 0 && ((pattern >> b) & 1) == bar) {
+                width++;
+                b--;
+            }
+            if (bar)
+                GFX_fillRect(gfx, x, y, width * module, h, color);
+            x += width * module;
+        }
+    }
+}
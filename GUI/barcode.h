@@ -0,0 +1,47 @@
+#ifndef __BARCODE_H
+#define __BARCODE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Adafruit_GFX.h"
+
+/**
+ * 二维码 (QR Code, 字节模式, 版本 1-6, 纠错等级 L/M) 和 Code 128 条码.
+ * 画的时候每个模块或条都是 GFX_fillRect 的一个矩形, 按字节填充页缓冲区.
+ * 不画静区 (二维码四周 4 个模块, 条码两侧 10 个模块), 需要在周围留白.
+ */
+#define QR_VERSION_MAX 6                        // 没有版本信息块的最大版本
+#define QR_SIZE(version) (17 + 4 * (version))   // 每边的模块数
+#define QR_SIZE_MAX QR_SIZE(QR_VERSION_MAX)
+
+typedef enum {
+    QR_ECC_L = 0,   // 可恢复约 7%
+    QR_ECC_M = 1,   // 可恢复约 15%
+} qr_ecc_t;
+
+typedef struct {
+    uint8_t size;   // 每边的模块数
+    uint8_t modules[(QR_SIZE_MAX * QR_SIZE_MAX + 7) / 8]; // 按行排列, 1 为深色
+} qr_code_t;
+
+// 放得下 len 字节的最小版本, 放不下时返回 0
+uint8_t QR_Version(uint16_t len, qr_ecc_t ecc);
+bool QR_Encode(qr_code_t *qr, const uint8_t *data, uint16_t len, qr_ecc_t ecc);
+bool QR_GetModule(const qr_code_t *qr, uint8_t x, uint8_t y);
+// 左上角在 (x, y), 每个模块 scale 像素. 分页绘制时只在内容变化后编码一次
+void GFX_drawQRCode(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t scale, const uint8_t *data,
+                    uint16_t len, qr_ecc_t ecc, uint16_t color);
+
+#define CODE128_MAX_TEXT    48  // 更长的条码在屏幕上也放不下
+#define CODE128_MAX_SYMBOLS (CODE128_MAX_TEXT + 8)
+#define CODE128_MODULES(symbols) ((symbols) * 11 + 2) // 终止符多 2 个模块
+
+// 字符集 B (ASCII 32-127), 连续的数字用字符集 C 压缩. 返回符号数 (含起始符, 校验符和终止符), 有不支持的字符时返回 0
+uint8_t CODE128_Encode(const uint8_t *text, uint8_t len, uint8_t *symbols);
+// 一个符号的条空图案, 从高位起 1 为条, 11 位 (终止符 13 位)
+uint16_t CODE128_Pattern(uint8_t symbol);
+// 左上角在 (x, y), 每个模块 module 像素宽, 宽度为 CODE128_MODULES(符号数) * module
+void GFX_drawCode128(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t module, int16_t h,
+                     const uint8_t *text, uint8_t len, uint16_t color);
+
+#endif
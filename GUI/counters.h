@@ -0,0 +1,23 @@
+#ifndef __COUNTERS_H
+#define __COUNTERS_H
+
+#include <stdint.h>
+
+// 渲染热点计数, 只在主机上的基准测试 (tools/gui_bench.c) 中定义 GUI_COUNTERS 时启用, 固件中为空
+#ifdef GUI_COUNTERS
+typedef struct {
+    uint32_t draw_pixel;    // GFX_drawPixel
+    uint32_t hv_line;       // 字形解码输出的水平/垂直线段
+    uint32_t glyph_lookup;  // u8g2_font_get_glyph_data
+    uint32_t glyph_decode;  // u8g2_font_decode_glyph
+    uint32_t lunar_day;     // LUNAR_GetDay 农历换算
+    uint32_t lunar_month;   // LUNAR_GetMonth 月历缓存未命中
+} gui_counters_t;
+
+extern gui_counters_t gui_counters;
+#define GUI_COUNT(counter) (gui_counters.counter++)
+#else
+#define GUI_COUNT(counter) ((void)0)
+#endif
+
+#endif
@@ -1,268 +1,263 @@
+// Generated by tools/fontgen.py, do not edit.
 #include "fonts.h"
 
+
 /*
   Fontname: -wenquanyi-wenquanyi bitmap song-medium-r-normal--12-120-75-75-P-119-ISO10646-1
   Copyright: (null)
-  Glyphs: 186/30503
+  Glyphs: 181/30503
+  Unicode: ℃一丁七三丑丙乙九二五亥兔八六冬分初十午卯四壬处夏大天子寅寒小已巳年庚廿惊戊戌日
+           明星春暑月有期未正水清满牛狗猪猴甲申癸白离秋种立羊腊至芒虎蛇蛰谷辛辰还酉闰降雨雪
+           霜露马鸡鼠龙
   BBX Build Mode: 0
 */
-const uint8_t u8g2_font_wqy9_t_lunar[3333] U8G2_FONT_SECTION("u8g2_font_wqy9_t_lunar") = 
-  "\272\0\3\2\4\4\3\4\5\13\15\0\376\10\376\12\377\1a\2\317\4\30 \5\0L\13!\7\221F"
-  "\213S\0\42\7\64}\213\310\24#\16\226\304\233\250eX\242^\206%j\1$\17\245<\253l\251("
-  "\231\250%Je\213\0%\20\226<\233(\351\242%a\232DI\27-\1&\16\205D\253,\211\222\254"
-  "\62%Q\244\4'\6\61\376\212\1(\13\263=\253$J\242nQ\26)\14\263=\213,\312\242.Q"
-  "\22\1*\14uD\253J\345\240,M\21\0+\13wD\274\270\66\14Y\134\3,\7\62>\13E\1"
-  "-\6\25d\213A.\6!\306\12\1/\14\304<\273\246\254\224\225\262\32\0\60\12\205D\233%\363-"
-  "Y\0\61\11\205D\213\261O\203\0\62\13\205D\233%\13km\203\0\63\14\205D\213!\15\223\65\14"
-  "\7\5\64\16\206\304;-\211\272d\311\60\246\11\0\65\15\205D\213!\11\303!\15\303A\1\66\15\205"
-  "D\233%\14\207$\263%\13\0\67\13\205D\213A\254\205YX\2\70\15\205D\233%\323\222%\263%"
-  "\13\0\71\15\205D\233%\263%C\250%\13\0:\6aD\11I;\11\202>\213!V\24\0<\10"
-  "\225D\313\254k\7=\10\65\134\213A\35\4>\11\225D\213\264[G\0\77\15\225D\233%\323\302H"
-  "\313\241\60\2@\24\247<\254\255\222HZ\42)JE\251H\211\222e\23\0A\16\207D\274\70M\302"
-  "$+\15J\252\6B\15\206\304\213A\11\305a\11\215\303\2C\14\206\304\233!\11\325\216\311\220\0D"
-  "\15\207D\214A\12\223\324c\62H\0E\12\205D\213c\70\214\305AF\13\205D\213c\70$a#"
-  "\0G\15\206\304\233!\11\325\332(&\203\0H\13\206\304\213\320\70\14\242c\0I\10\203D\212%\352"
-  "eJ\10\243\64\252\376\264\0K\15\205D\213LJJ\232\226D\225,L\11\205D\213\260\217\203\0M"
-  "\20\207D\14m\310\226\212R\221\42)R\325\0N\15\206\304\213pS\42)\321Fc\0O\14\207D"
-  "\254\255\222\272&Y\66\1P\14\205D\213!\311l\203\22\26\1Q\16\227<\254\255\222\272&Y\266\3"
-  "\11\0R\20\206\304\213!\312\222,\311\222!jK\302\0S\14\205D\233AL\327\60\34\24\0T\11"
-  "\207D\214C\26\367\15U\12\206\304\213\320\217\311\220\0V\17\207D\214TM\262(\253\204I\32g\0"
-  "W\21\211D\215,\323\62\255\322)iJ\332\212Y\4X\15\206\304\213PL\242L\213ZB\61Y\13"
-  "\207D\214\64\311*i\334\15Z\12\207D\214C\332\347a\10[\11\263>\213!\352O\3\134\14\245<"
-  "\213\60\15\323\60\15\323\60]\11\263=\213\251\77\15\1^\10\65t\253,\251\5_\6\25<\213A`"
-  "\7\62\375\212$\12a\14eD\233%K\6MK\206\0b\14\205D\213\60\34\222\314mP\0c\10"
-  "d\304\232!k\34d\13\205D\313\312\240\271%C\0e\13eD\233%\33\206\60\35\2f\11\203D"
-  "\232i\210:\1g\14\205\64\233AsK\206\60Y\0h\13\205D\213\60\34\222\314[\0i\7\201D"
-  "\211d\30j\10\242\264\231,\351ek\15\205D\213\260\224\224\264$\252d\1l\7\201D\211\203\0m"
-  "\16gD\214E\211\42)\222\42)\222\12n\11eD\213!\311\274\5o\12eD\233%sK\26\0"
-  "p\14\205\64\213!\311\334\6%\14\1q\13\205\64\233AsK\206\260\0r\10cD\212!\352\4s"
-  "\14eD\233%K\324$K\26\0t\12\203D\212(\32\242\66\1u\11eD\213\314[\62\4v\14"
-  "eD\213LKJI\26F\0w\16gD\214(\222\42\245\242t\213\262\4x\13eD\213,\251U"
-  "jZ\0y\15\205\64\213LKJI\26fa\6z\12eD\213A\314\332\6\1{\13\243<\252$"
-  "\252dQ[\0|\7\261\276\212\7\1}\13\243<\212,\252%QK\4~\7&\334\33\311\2\200\17"
-  "\225D+\251\222\15Q\66Da\24)\0\0\0\0\4\377\377!\3\27\252D\36m\211\222,\221r$"
-  "\207r(\207r,\207\262x\1N\0\12+d~(\31\16\2N\1\25\252=\216\207\64\207r(\207"
-  "r(\207r(\207r`\4N\3\26\272=\316\34\312\241\34\312\304!\32t(\207r(l\35\4N"
-  "\11\17\253<\236\341\316\313\60\344|\34\16\2N\21\27\253<\236a\220\263\70\213\263l\30\324\60\15\323"
-  "\60\15\243\341 N\31\32\273<\216\7\65\307\342\341\224\225\62\251K\224\244Q\16D\71\20\245\13\0N"
-  "Y\30\272=\216w$Gr$Gr$Gr$GrDG\222\341\0N]\27\272=\276\34\312\241"
-  "x\30\342(\216\342(\315\322,J\302H\36N\214\14\213D\236\341\316\77\16\7\1N\224\26\253<\236"
-  "\341\234c\71\226\3\207\70\213\263\70\213\263h\70\10N\245\27\272=\316\34\13\207C\226#Y\70Hi"
-  "\24J\231Y\212V\1QT\32\273<\276\34\33\324,\35.\245,\33\6\71\207\222r\322\26e\211\70"
-  "\4Qk\30\253D\356\34\210r \312\201(\7\262\70K\213i\226\3I\16\5Qm\24\273<\316\34"
-  "\314I\303Ag\314\342\260\34\345\210\16\5Q\234\33\273<\336x\70$Y\250ia\224\3QMJ\262"
-  "$+%Q*jq\0Q\254\30\273<\276\34\33T-\214\222\34\312\21\333\24\315\71\240\203\71\30\2"
-  "R\6\30\273<\276r\226\26\323,\7\222d\30\222\60\213\263\64\254F\242\6R\35\33\273<\236\34\214"
-  "\206\203T+\25\243D\211\42E\213*Q[\251\30%\231\2SA\27\273<\336\34\313\261\34K\207\203"
-  "\232c\71\226c\71\226c)\0SH\27\272=\256\34\32\206(\13\353P\70\34\322\34\312\241\34\312\241"
-  "\20So\33\272=\276x\32\306LJ\62)\311\244$S\224l\351\226DY\24j!\0S\206\32\273"
-  "<\256\341\224c\345,N\206!\312JY\251\230da\22\245R\250\0V\333\30\251=\216\207(\211\244"
-  "$\222\222HJ\42%\32f\35x\320\201\0X\354\30\273<~ \207\266A\307r\254\62\34\324\34\313"
-  "\261\34\213\262\341\2Y\4\32\273<\256\60\15\323!I\243D\253\364\324\22\305Y\232Da&\306C\0"
-  "Y\17\31\273<\216\7\65G\206\65L\247\64\31\322\60\34\206,\252\205\362\64\4Y'\30\273<\336\34"
-  "\313\261t\70\250\71\226CI\216\324\201,-\351\200\0Y)\30\273<\236\341\234c\71\226\16\7\65\207"
-  "\222\34\251\3YZ\322\1\1[P\30\273<\256a\310\241\34\312\241\34K\207\203\232c\71\226#u("
-  "\6[\305\31\273<\336tx\207\224aH\322\34\70\204Qq\30\302\250\70\14\321:[\322\33\273<\336"
-  "tx\213\42e\30\222\60\312\206\203\30\305I\24m\212\250\203\32\0\134\17\30\273<\336\34\313\261\34\210"
-  "\212Q\26e\245,\24\253\71R\207b\0]\362\26\252=\216\203\16\345P\71\32\6)\207rDGt"
-  "$\31\16]\363\30\272=\216\203\24Gq\24G\303 \345P\16\345\210\216\350H\62\34^t\27\273<"
-  "\256\34\33.a\65\36\6\255\234\205\303A\316\261\34\13\1^\232\33\273<\356x\70eq\62l\245l"
-  "\70eQ\226\14[\224\204Q\26%\252\0^\377\30\273<\276\60\15\323\60\32\16Z\230\206i\230\206i"
-  "\230\16k\30\1`\312\36\273<\256\60M\206A\321\201$\31\226R\226\224\6-L\243\244\226D%\245"
-  "T\13\1b\12\31\273<\356$G\242l\70eq\26e\245,\24KI\230\264e\223\32b\14\33\273"
-  "<\356$G\242l\70eq\26e\203\224U\302j&%Y\224H\242\0e\345\15\247>\216\203j\35"
-  "\256\326\341\32e\366\34\273<~$\32\302(\32NaT\211\242!J\242\226\250\30\25\243!\314\221\11"
-  "f\16\31\273<\356\341\224I\65)\32N\231T\223\242\341\224\245a-\211\324\4f\37\33\273<\256a"
-  "\10\323p\30\302\64\34\206\60\212\207K\230\3\207\34H\207\203\0f%\32\273<\336x\70\244\71pP"
-  "\343\341 \211\212\62%Y\62\244a:L\0f\221\33\273<\256a\10\323p\30\302\64\33\316I\66\34"
-  "\304,\34\206H\11\323a\2g\10\31\271=\256a\210\322(\215\206!J\243\64\32\206(\215\322$L"
-  "\344\4g\11\30\273<\316x\70h\71\66\214b\226\14S\61\35\326\60\15\323L\2g\37 \273<\236"
-  "(\32\16I\224D-C\64$Q\313\20U\242h\70$Q\16DIT\22%\1g*\27\273<\336"
-  "\34\213\207s:\34\324\34\332\201\244\32\225\264LM\1kc\32\253<\216\7\65\307r \312\201h\320"
-  "\242\34\210r \312\201(\35\16\2l\64\30\273<\336\34\313\261\312\220(iRN\252Q\61\252\265D"
-  "IX\6n\5\36\273<\236\264\62\14\71\220E\311 %Y\232\14CTK\264%\312\222)+e\221"
-  "\2n\341 \273<\236\60\11\223a\310\242$\212\206A\11\223\60\31\206(i\231\222NJ\242D-Q"
-  "(r[\27\272=\336\70\212\243t\30\224\60\207\302\341\220\346P\16\345P\10r\327\35\273<\216\250\232"
-  "Dq\64,\215\222\262DR\322)I\244h\311\342\244\226di\4s* \273<\216,\252T\206$"
-  "\12\223(I\206!\312RiP*\232\244\14Z\224%\245A\312\12s\64 \273<\216\244\62D\305\244"
-  "\62\14\321\22'\311\240\230*\265\60\31\206(\311\242\244\224D\225,u\62\26\271=\216\207,\323\262\341"
-  "\240eZ\66\34\264b\216\344H\10u\63\26\271=\316\34\11\207C\226\15\7-\323\262\341\240\25s$"
-  "\4vx\32\273<\236a\211\243\226(\11[\206$\312B\61\36\16i\222\3Y\266\12v}\20\270>"
-  "\276\70\35\316\362p\210\315\303!\16y\273\33\273<\336t\70HIcTL\32\207!\7\342\341\324\22"
-  "%\203\22\305\12\0y\313\35\273<>)\33\323\60I\206\245\26%\332RT\242,\311\222\60K\302("
-  "\253\244\1y\315\33\273<>)\33\323hx\211Z\242H)%\312\60(a\32\246a\32f\0y\322"
-  "\33\273<\276\332\230FIeHJ-Q\262\24\225(R\342,\15\63\65Q\1z\313\30\273<\336\34"
-  "L\207CN\10\323\60\216r \312\201$\307\302\341 \177\212\27\273<\256\264\26\16\347\34\313\201C\16"
-  "\344X:\34\324\34K\1\201J#\273<\236)\311\222(\311\222d\220\246$K\206A\251#\7)\251"
-  "EI\62(Q\222%\211\62(\0\201\363\27\273<\236\341\232CYZ\33\316\71\226\3\207\34\310\261t"
-  "\70\10\202\222\30\273<\276\332p\320\352H\16\206\303A\312\261\34\313\261\34\33\6\5\206N\34\273<\336"
-  "A\216\207C\22\205\321\60hQ\232D\303\220\344X\64\204QI\21\7\206\307\32\273<\256\60-F\303"
-  "\243\322\230\64%\203\62fqR\213\226l\212\206\0\206\360\36\273<\256\60\33\222A\13\223d\210\224\254"
-  "\42Ia\64\14Z\224e\303 g\311p\11\214\67\32\273<\316(\16KY\224ia\24\207\341\60("
-  "J\230da:\254a\4\217\233\27\273<\336x\270\245\251\224\3I\70\34\324x\70\347X\216\245\0\217"
-  "\260\34\273<\256\341\224c\311\260\345\330pJ\312I)K\42-\312JI\224db\0\217\330\33\273<"
-  "\236h\30\242\64\254c\331\246dQ\22U\242\306\64\254\344@\66\14\1\221I\33\273<\216\7\61\311\221"
-  "\352p\252D-Q\264M\71\20\15\247\34\210\206\13\0\225\360\33\273<\256h\30\242X\207\244A\22C"
-  "\61\224\6I\14\305P\31\206D\7\6\226M\36\273<\216!\12\243hX\42)Q\245$\222\246\254\224"
-  "\14\203\322\226$\303 gq\6\226\350\30\273<\216\7\65\307\342\341\224\225\222N\221\247J\247\254\224E"
-  "\12\0\226\352\31\273<\236\341\234\16\217\241\242$J\216\16w,\33\6\35\213\206\13\0\227\34\35\273<"
-  "\236\341\234\16OI\251\66$\203\22e\331\220I%%\31\222NY\66$\0\227\62\36\273<\236\341\234"
-  "\16OIi\220\206$J\244d\310\304HZ\16I-J\206hH\0\232l\30\273<\236a\320\261\64"
-  "L\263\64L\207;\226c\303)\307rD\1\236!\35\273<~ \33\222AL\262$J\232\222nQ"
-  "\61\32\226r\22\15\212\16\345\210\2\237 \36\272=\216!\31\222\34H\206dHr \31\356\240\244D"
-  "IE\262$J\313\240L\1\237\231\32\273<\316(\7\262\70\36\16b\222#\245\60J\322H\315*\231"
-  "I\32\2\0";
+const uint8_t u8g2_font_wqy9_t_lunar[3250] U8G2_FONT_SECTION("u8g2_font_wqy9_t_lunar") = 
+  "\265\0\3\2\4\4\3\4\5\13\15\0\376\10\376\12\377\1a\2\317\4\11 \5\0L\13!\7\221F"
+  "\213S\0\42\7\64}\213\310\24#\16\226\304\233\250eX\242^\206%j\1$\17\245<\253l\251"
+  "(\231\250%Je\213\0%\20\226<\233(\351\242%a\232DI\27-\1&\16\205D\253,\211\222\254"
+  "\62%Q\244\4'\6\61\376\212\1(\13\263=\253$J\242nQ\26)\14\263=\213,\312\242.Q\22\1"
+  "*\14uD\253J\345\240,M\21\0+\13wD\274\270\66\14Y\134\3,\7\62>\13E\1-\6\25d\213A."
+  "\6!\306\12\1/\14\304<\273\246\254\224\225\262\32\0\60\12\205D\233%\363-Y\0\61\11"
+  "\205D\213\261O\203\0\62\13\205D\233%\13km\203\0\63\14\205D\213!\15\223\65\14\7\5"
+  "\64\16\206\304;-\211\272d\311\60\246\11\0\65\15\205D\213!\11\303!\15\303A\1\66"
+  "\15\205D\233%\14\207$\263%\13\0\67\13\205D\213A\254\205YX\2\70\15\205D\233%\323"
+  "\222%\263%\13\0\71\15\205D\233%\263%C\250%\13\0:\6aD\11I;\11\202>\213!V\24\0<\10"
+  "\225D\313\254k\7=\10\65\134\213A\35\4>\11\225D\213\264[G\0\77\15\225D\233%\323"
+  "\302H\313\241\60\2@\24\247<\254\255\222HZ\42)JE\251H\211\222e\23\0A\16\207D\274"
+  "\70M\302$+\15J\252\6B\15\206\304\213A\11\305a\11\215\303\2C\14\206\304\233!\11"
+  "\325\216\311\220\0D\15\207D\214A\12\223\324c2H\0E\12\205D\213c8\214\305AF\13\205"
+  "D\213c8$a#\0G\15\206\304\233!\11\325\332(&\203\0H\13\206\304\213\320\70\14\242c"
+  "\0I\10\203D\212%\352eJ\10\243\64\252\376\264\0K\15\205D\213LJJ\232\226D\225,L\11"
+  "\205D\213\260\217\203\0M\20\207D\14m\310\226\212R\221\42)R\325\0N\15\206\304\213"
+  "pS\42)\321Fc\0O\14\207D\254\255\222\272&Y6\1P\14\205D\213!\311l\203\22\26\1Q\16"
+  "\227<\254\255\222\272&Y\266\3\11\0R\20\206\304\213!\312\222,\311\222!jK\302\0S"
+  "\14\205D\233AL\327\60\34\24\0T\11\207D\214C\26\367\15U\12\206\304\213\320\217"
+  "\311\220\0V\17\207D\214TM\262(\253\204I\32g\0W\21\211D\215,\323\62\255\322)iJ"
+  "\332\212Y\4X\15\206\304\213PL\242L\213ZB1Y\13\207D\214\64\311*i\334\15Z\12\207D"
+  "\214C\332\347a\10[\11\263>\213!\352O\3\134\14\245<\213\60\15\323\60\15\323\60]"
+  "\11\263=\213\251\77\15\1^\10\65t\253,\251\5_\6\25<\213A`\7\62\375\212$\12a\14eD"
+  "\233%K\6MK\206\0b\14\205D\213\60\34\222\314mP\0c\10d\304\232!k\34d\13\205D\313"
+  "\312\240\271%C\0e\13eD\233%\33\206\60\35\2f\11\203D\232i\210:\1g\14\205\64\233As"
+  "K\206\60Y\0h\13\205D\213\60\34\222\314[\0i\7\201D\211d\30j\10\242\264\231,\351ek"
+  "\15\205D\213\260\224\224\264$\252d\1l\7\201D\211\203\0m\16gD\214E\211\42)\222\42"
+  ")\222\12n\11eD\213!\311\274\5o\12eD\233%sK\26\0p\14\205\64\213!\311\334\6%\14\1q"
+  "\13\205\64\233AsK\206\260\0r\10cD\212!\352\4s\14eD\233%K\324$K\26\0t\12\203D\212"
+  "(\32\242\66\1u\11eD\213\314[2\4v\14eD\213LKJI\26F\0w\16gD\214(\222\42\245\242t"
+  "\213\262\4x\13eD\213,\251UjZ\0y\15\205\64\213LKJI\26fa\6z\12eD\213A\314\332\6\1{"
+  "\13\243<\252$\252dQ[\0|\7\261\276\212\7\1}\13\243<\212,\252%QK\4~\7&\334\33\311"
+  "\2\0\0\0,NY\0\244Q\254\0\256Y\4\0\306]\362\0\303e\345\0\301g*\0\321s4\0\344z\313"
+  "\0\301\214\67\0\327\226\352\0\323\377\377!\3\27\252D\36m\211\222,\221r$\207r("
+  "\207r,\207\262x\1N\0\12+d~(\31\16\2N\1\25\252=\216\207\64\207r(\207r(\207r(\207r"
+  "`\4N\3\26\272=\316\34\312\241\34\312\304!\32t(\207r(l\35\4N\11\17\253<\236\341"
+  "\316\313\60\344|\34\16\2N\21\27\253<\236a\220\263\70\213\263l\30\324\60\15\323"
+  "\60\15\243\341 N\31\32\273<\216\7\65\307\342\341\224\225\62\251K\224\244Q\16D9"
+  "\20\245\13\0NY\30\272=\216w$Gr$Gr$Gr$GrDG\222\341\0N]\27\272=\276\34\312\241x\30"
+  "\342(\216\342(\315\322,J\302H\36N\214\14\213D\236\341\316\77\16\7\1N\224\26\253<"
+  "\236\341\234c9\226\3\207\70\213\263\70\213\263h8\10N\245\27\272=\316\34\13\207C"
+  "\226#Y8Hi\24J\231Y\212V\1QT\32\273<\276\34\33\324,\35.\245,\33\6\71\207\222r\322"
+  "\26e\211\70\4Qk\30\253D\356\34\210r \312\201(\7\262\70K\213i\226\3I\16\5Qm\24"
+  "\273<\316\34\314I\303Ag\314\342\260\34\345\210\16\5Q\254\30\273<\276\34\33T-\214"
+  "\222\34\312\21\333\24\315\71\240\203\71\30\2R\6\30\273<\276r\226\26\323,\7\222d"
+  "\30\222\60\213\263\64\254F\242\6R\35\33\273<\236\34\214\206\203T+\25\243D\211\42"
+  "E\213*Q[\251\30%\231\2SA\27\273<\336\34\313\261\34K\207\203\232c9\226c9\226c)\0S"
+  "H\27\272=\256\34\32\206(\13\353P8\34\322\34\312\241\34\312\241\20So\33\272=\276x"
+  "\32\306LJ2)\311\244$S\224l\351\226DY\24j!\0V\333\30\251=\216\207(\211\244$\222"
+  "\222HJ\42%\32f\35x\320\201\0X\354\30\273<~ \207\266A\307r\254\62\34\324\34\313"
+  "\261\34\213\262\341\2Y\4\32\273<\256\60\15\323!I\243D\253\364\324\22\305Y\232Da&"
+  "\306C\0Y\17\31\273<\216\7\65G\206\65L\247\64\31\322\60\34\206,\252\205\362\64\4Y"
+  "'\30\273<\336\34\313\261t8\250\71\226CI\216\324\201,-\351\200\0Y)\30\273<\236"
+  "\341\234c9\226\16\7\65\207\222\34\251\3YZ\322\1\1[P\30\273<\256a\310\241\34\312"
+  "\241\34K\207\203\232c9\226#u(\6[\305\31\273<\336tx\207\224aH\322\34\70\204Qq\30"
+  "\302\250\70\14\321:[\322\33\273<\336tx\213\42e\30\222\60\312\206\203\30\305I\24m"
+  "\212\250\203\32\0\134\17\30\273<\336\34\313\261\34\210\212Q\26e\245,\24\253\71R"
+  "\207b\0]\362\26\252=\216\203\16\345P9\32\6)\207rDGt$\31\16]\363\30\272=\216\203"
+  "\24Gq\24G\303 \345P\16\345\210\216\350H2\34^t\27\273<\256\34\33.a5\36\6\255\234"
+  "\205\303A\316\261\34\13\1^\232\33\273<\356x8eq2l\245l8eQ\226\14[\224\204Q\26%"
+  "\252\0^\377\30\273<\276\60\15\323\60\32\16Z\230\206i\230\206i\230\16k\30\1`\312"
+  "\36\273<\256\60M\206A\321\201$\31\226R\226\224\6-L\243\244\226D%\245T\13\1b\12"
+  "\31\273<\356$G\242l8eq\26e\245,\24KI\230\264e\223\32b\14\33\273<\356$G\242l8eq"
+  "\26e\203\224U\302j&%Y\224H\242\0e\345\15\247>\216\203j\35\256\326\341\32f\16\31"
+  "\273<\356\341\224I5)\32N\231T\223\242\341\224\245a-\211\324\4f\37\33\273<\256a"
+  "\10\323p\30\302\64\34\206\60\212\207K\230\3\207\34H\207\203\0f%\32\273<\336x8"
+  "\244\71pP\343\341 \211\212\62%Y2\244a:L\0f\221\33\273<\256a\10\323p\30\302\64\33"
+  "\316I6\34\304,\34\206H\11\323a\2g\10\31\271=\256a\210\322(\215\206!J\243\64\32"
+  "\206(\215\322$L\344\4g\11\30\273<\316x8h96\214b\226\14S1\35\326\60\15\323L\2g\37"
+  " \273<\236(\32\16I\224D-C4$Q\313\20U\242h8$Q\16DIT\22%\1g*\27\273<\336\34\213"
+  "\207s:\34\324\34\332\201\244\32\225\264LM\1kc\32\253<\216\7\65\307r \312\201h"
+  "\320\242\34\210r \312\201(\35\16\2l4\30\273<\336\34\313\261\312\220(iRN\252Q1"
+  "\252\265DIX\6n\5\36\273<\236\264\62\14\71\220E\311 %Y\232\14CTK\264%\312\222)+e"
+  "\221\2n\341 \273<\236\60\11\223a\310\242$\212\206A\11\223\60\31\206(i\231\222NJ"
+  "\242D-Q(r[\27\272=\336\70\212\243t\30\224\60\207\302\341\220\346P\16\345P\10r"
+  "\327\35\273<\216\250\232Dq4,\215\222\262DR\322)I\244h\311\342\244\226di\4s* \273"
+  "<\216,\252T\206$\12\223(I\206!\312RiP*\232\244\14Z\224%\245A\312\12s4 \273<\216"
+  "\244\62D\305\244\62\14\321\22'\311\240\230*\265\60\31\206(\311\242\244\224D\225,"
+  "u2\26\271=\216\207,\323\262\341\240eZ6\34\264b\216\344H\10u3\26\271=\316\34\11"
+  "\207C\226\15\7-\323\262\341\240\25s$\4vx\32\273<\236a\211\243\226(\11[\206$\312B"
+  "1\36\16i\222\3Y\266\12v}\20\270>\276\70\35\316\362p\210\315\303!\16y\273\33\273<"
+  "\336t8HIcTL\32\207!\7\342\341\324\22%\203\22\305\12\0y\313\35\273<>)\33\323\60I"
+  "\206\245\26%\332RT\242,\311\222\60K\302(\253\244\1y\315\33\273<>)\33\323hx\211Z"
+  "\242H)%\312\60(a\32\246a\32f\0z\313\30\273<\336\34L\207CN\10\323\60\216r \312"
+  "\201$\307\302\341 \177\212\27\273<\256\264\26\16\347\34\313\201C\16\344X:\34\324"
+  "\34K\1\201J#\273<\236)\311\222(\311\222d\220\246$K\206A\251#\7)\251EI2(Q\222%"
+  "\211\62(\0\201\363\27\273<\236\341\232CYZ\33\316\71\226\3\207\34\310\261t8\10"
+  "\202\222\30\273<\276\332p\320\352H\16\206\303A\312\261\34\313\261\34\33\6\5\206N"
+  "\34\273<\336A\216\207C\22\205\321\60hQ\232D\303\220\344X4\204QI\21\7\206\307\32"
+  "\273<\256\60-F\303\243\322\230\64%\203\62fqR\213\226l\212\206\0\206\360\36\273<"
+  "\256\60\33\222A\13\223d\210\224\254\42Ia4\14Z\224e\303 g\311p\11\214\67\32\273<"
+  "\316(\16KY\224ia\24\207\341\60(J\230da:\254a\4\217\233\27\273<\336x\270\245\251"
+  "\224\3I8\34\324x8\347X\216\245\0\217\260\34\273<\256\341\224c\311\260\345\330pJ"
+  "\312I)K\42-\312JI\224db\0\217\330\33\273<\236h\30\242\64\254c\331\246dQ\22U\242"
+  "\306\64\254\344@6\14\1\221I\33\273<\216\7\61\311\221\352p\252D-Q\264M9\20\15\247"
+  "\34\210\206\13\0\225\360\33\273<\256h\30\242X\207\244A\22C1\224\6I\14\305P\31"
+  "\206D\7\6\226M\36\273<\216!\12\243hX\42)Q\245$\222\246\254\224\14\203\322\226$"
+  "\303 gq\6\226\350\30\273<\216\7\65\307\342\341\224\225\222N\221\247J\247\254\224"
+  "E\12\0\226\352\31\273<\236\341\234\16\217\241\242$J\216\16w,\33\6\35\213\206\13"
+  "\0\227\34\35\273<\236\341\234\16OI\251\66$\203\22e\331\220I%%\31\222NY6$\0\227"
+  "\62\36\273<\236\341\234\16OIi\220\206$J\244d\310\304HZ\16I-J\206hH\0\232l\30\273"
+  "<\236a\320\261\64L\263\64L\207;\226c\303)\307rD\1\236!\35\273<~ \33\222AL\262$J"
+  "\232\222nQ1\32\226r\22\15\212\16\345\210\2\237 \36\272=\216!\31\222\34H\206dHr "
+  "\31\356\240\244DIE\262$J\313\240L\1\237\231\32\273<\316(\7\262\70\36\16b\222#"
+  "\245\60J\322H\315*\231I\32\2\0";
 
 /*
   Fontname: -wenquanyi-wenquanyi bitmap song-bold-r-normal--16-160-75-75-P-80-iso10646-1
   Copyright: (null)
-  Glyphs: 186/29889
+  Glyphs: 181/29889
+  Unicode: ℃一丁七三丑丙乙九二五亥兔八六冬分初十午卯四壬处夏大天子寅寒小已巳年庚廿惊戊戌日
+           明星春暑月有期未正水清满牛狗猪猴甲申癸白离秋种立羊腊至芒虎蛇蛰谷辛辰还酉闰降雨雪
+           霜露马鸡鼠龙
   BBX Build Mode: 0
 */
-const uint8_t u8g2_font_wqy12_t_lunar[4560] U8G2_FONT_SECTION("u8g2_font_wqy12_t_lunar") = 
-  "\272\0\4\3\5\5\3\5\6\21\22\377\374\13\375\14\374\1\367\3\367\5\231 \6\0\60\246\0!\11\302"
-  "\375\245\360\300\210\0\42\11\305\270\246 \301\27\2#\36\211\21\246#!$!$!r\20\42!$!"
-  "$!$!r\20\42!$!$!\3$\25\250\361\245#Ec\241\202B\210\212\221\4\205\12\33*"
-  "\31\0%$\214\25\272\61$\42!#\42!\42#\241HB\325\204\250\304\224\204\32\21\11\31\21\11\21"
-  "\31\11\21\241\11\0&\33\213\25\266\63'!&!&!F\67\70#B#!\42\61!R\42\63T"
-  "A'\7\302\270\226pP(\16\5\226\235#\242FDF\77\222\21R)\17\5\226\235 \244FHF"
-  "\77\221\21Q\3*\21(Q\246#&#\241\302\206\306B\33\61\31\0+\15l\25\272%\252\253\203*"
-  "Q]\1,\10\203\330\245`A\1-\6%p\232P.\6C\370\245`/\22\7\226\245\245HJ\221"
-  "\224\42)ER\212\244\244\0\60\16g\25\246\62#\241\206\337H\250\31\1\61\13f\25\246\42\63B\244"
-  "\237\30\62\15g\25\246Q!C#\245H\257\16\63\22h\21\246Q\42#'&%C\247\214F\244\4"
-  "\0\64\25h\21\246%\65D#!\242BFBF\342 JL\5\0\65\22h\21\246p!\246\314d"
-  "DNL\214F\244\4\0\66\25h\21\246B#\42!&f\62\42!\304HBD\206\4\0\67\22h"
-  "\21\246p\20&%&%&%\246JL\10\0\70\23h\21\246B#\242\67\64\42\22B\214$Dd"
-  "H\0\71\24h\21\246B#\42!\304HBd\304L\205\210\14\11\0:\7\342\30\226 *;\7\2"
-  "\371\225 J<\15J\371\265(\66\265\335\344\244\344\2=\12\213T\266p@\17w@>\13K\365\265"
-  " \272\313\261\35\2\77\17f\25\246A!\42\244F\221z\10\21\0@\31i\25\262b\42#\42q!"
-  "B!B!B!B!\42!A\42h\1A\30k\21\262\64\70'!&!%#$#$#s"
-  " \42%!G'B\22h\31\262p!\304\215\204\211\214\204\20\243\3\11\0C\20i\25\256c\42#"
-  "!&\247C\65\62\25\0D\22i\31\266p\42$!$!\305G\22B\22'\0E\16h\31\256p"
-  "\60\246\331\205\230f\7\1F\15g\31\252p \245\325\201\224\256\0G\23i\25\262c\42#!&\247"
-  "\215\225\204\220\210\214\214\1H\14h\31\262 \304\243\203\42\36\11I\10b\31\226\360A\0J\13\206\365"
-  "\245\244\377F\202\4\0K\27i\31\262 E$!#\242FB\210\252HDF\211\220\204\224\0L\11"
-  "g\31\252 \245\177uM\26k\31\276\60eus\20c\241\202B\5\311\10\311\10\35;\1N\22h"
-  "\31\262\60ScbrA!Aq\342\246f\0O\24j\25\266C%\42#$!\306\63\11!\31\21"
-  ")\32\0P\20h\31\256`\42#!\304\215\204\211\230f\0Q\23\252\325\265C%\42#$!\306\63"
-  "\11m$\246*\25R\22h\31\256p!\304\321\201\204\210n$d$\204\4S\22h\25\252B#\42"
-  "!&'G\247\214F\244\4\0T\13j\25\262p\60$\250\177\4U\15h\31\262 \304\77\222\20\221"
-  "!\1V\31k\21\262 G'!%\42%\243HFHFJBLBnp\10\0W\36n\25\302"
-  " $D$D\244B\204D\11\211\22\22\31\22\42\22\42\22*!\61!\31\0X\26K\21\262 '"
-  "!%\243JBnpNBJF\225\204\234\0Y\21j\21\262 F&!$#\42E'\250G\0"
-  "Z\21i\25\256p &'\246NL\235\230\330\201\0[\12\4\226\231`\242\377'\4\134\22\7\226\245"
-  " %&\245LJ\231\224\62)eR\2]\12\4\222\231@\242\377'\6^\11f\370\256\42C!\42"
-  "_\7+\224\265p@`\7C\34\247 \42a\16\347\24\246Q!#%q\20C#ab\17g\25"
-  "\246 \245\225\305\10\15\67\7\21\0c\15\347\24\246Q!C\245\215D\5\0d\15g\25\246\245\213\203"
-  "\220\32N&\14e\16\347\20\242Q!Cs@%#Q\1f\15f\25\232B!\244\246DHo\0"
-  "g\21h\261\245\65R\242OJ\344\16\204\210$,\0h\15g\25\246 \245\225\305\10\15o\4i\10"
-  "b\25\226 vpj\13\305\255\225#\17\243\277\261\0k\21g\25\246 \245\23\11%\64\64\22\42*"
-  "d\4l\10b\25\226\360A\0m\24\353\24\272`\261d\202F\204F\204F\204F\204FD\0n\13"
-  "\347\24\246`\61B\303\33\1o\14\347\24\246Q!\303\33\211\12\0p\17G\265\245`\61B\303\315A"
-  "\204\224*\0q\15G\265\245q\20R\303\311\204\225\6r\13\345\24\232p\20\42\243\33\0s\13\346\20"
-  "\236q$E%t\1t\14%\25\236!#R!\243\243\1u\12\347\24\246 \303'\23\6v\17\350"
-  "\20\242 D$!\242\15\21\225\14\0w\25\352\20\262 \42B\242\342 \344 \344 FDHD\4"
-  "\0x\20\350\20\242 $!\42C%E#\42!$y\21H\261\241 $!\242\15\21\225\230*\241"
-  ")\0z\11\347\20\242p\244W\7{\16\7\226\245C\42\245G\63bSzF|\10\2\232\225\360\3"
-  "\2}\20\7\226\245\60&\245gb#CR\272\31\2~\11H\64\257\301d\2\0\200\24\210\21\246C"
-  "#\42!&e#e#\246ND\206\2\0\0\0\0\4\377\377!\3\27\256\65\306\61*!b\241\311"
-  "\12!)a\275\226\22\223\21,\1N\0\11\60\320\306\360@\0N\1\16\356\325\305\360LX\377SZ"
-  "\71\0N\3\25\357\361\305&\255'UF\7\321\272\22\223\22\223\222;\10N\11\20\220\21\306qp\217"
-  "\273\203z\274;\70\20N\21#\320\361\305r@)#)#)#)#)#u@($($("
-  "$($($($sp N\31'\360\321\305\360@N\134\341\301\211\220\22!%\62\64\42\62\22"
-  "\42\332H\210H\10I\210\210\212\210\212\10\222H\212\0NY\23\316\365\305pP\253\77\226\225\224\220\224"
-  "\220\24\71(N]\42\20\322\305%\256\351\1\245\214\244\214\244\214\240\220\240\220\240\220\234\224\210\214\224\210"
-  "\62\21\11\301s\0N\214\15P\61\306rP\217\77=\70\20N\224\36\320\361\305qp'\256\351\1\241"
-  "\220\240\220\240\220\240\220\234\224\234\224\234\224\314\301\201\0N\245\42\16\326\305%-\17up%\253HJ"
-  "H\352 DNDlDjFh\210pDjJ\202P\0QT(\20\322\305$.~\20'%&"
-  "%v`B\243HF\221\214\242\203\42\21\22\71\11B\21\11\61\31\11%BBe\7Qk#\357\325"
-  "\305()\42)\42)\42)\42)\42)#'$'$'\245LJNFPFRBV\0Qm"
-  "!\360\361\305&\17 \17 .\17wp \217NDTFPJNLJNHRDT\2\0Q"
-  "\234$\20\322\305'\256\360\340DFJBH\35\61\215\230\210\204\330\10\31\215\230\204\220\22)\71\42\261"
-  "E\242\0Q\254!\20\322\305%.} \246\212HJD-\351\310\330\222\321)z\200y\0Az\200"
-  "y\0)\0R\6(\20\322\305)*\42*#($'&%(#*!q \42%#)#)"
-  "#($($'%&C&%\6R\35*\17\322\305\42.\17rp\20\242HFDFHDF"
-  "HD\244DE\215\10\5\211\32\22\65\372\211\220\214\204\10\21\221\10\0SA\20\20\322\305'\256w\7"
-  "\7r\342\372;\0SH\30\20\322\305$\256\372\200JDRFPH\134\335\301\201\234\270\336\1So"
-  "\60\16\326\305\63Hs \42!C\42!C\42!C\42!C\42!C\42!C\42!C\61!s"
-  "\20a%\241JDPDNFLH\12\0S\206)\360\321\305rp\42.$($($x`#"
-  "$\243HF#\31E\62\42R\62\42R\42\312D$\204H$\304d\0V\333\37\256\365\305\360@D"
-  "\11\211\22\22%$JH\224P\310\210P\10\35\10V\222\36\34\220\12X\354\23\360\361\305+kt\256"
-  "\273\203\3\71q\275<(\1Y\4,\20\322\305#$($($X!(!\61&\42A%\42\241"
-  "\206B\211\204\4\211\42\22I\31I\31A\22\71\221A\251\203q\0Y\17!\20\322\305qp'{\60"
-  "\246\354`L\331\301\230\262\203\71\351\203)\42)\21\265\224$\64\204\4Y'\34\20\322\305'\256\273\203"
-  "\3\71qibZ\21Q\21I!\71\61)A\221\321\1Y)\35\360\321\305rP)\256\335\301\201\234"
-  "\64\61\255\210\250\210\244\220\234\230\224\240\310\350\0[P\24\360\321\305q`\255\361\264\334\301\201\234\270\36"
-  "S\13\2[\305'\20\322\305&\17 xp\20!KqP(z\60&\242LD\331\301\230\210\62\21"
-  "e\7\203\42\222Brb\62\0[\322+\20\322\305&\17 xp\20!\242\206\342\240LD\356\240N"
-  "D\352\340@H\235\304\210\224\220\210\310\230\310\324<\300<\200\24\0\134\17\36\20\322\305'\256S\21e"
-  "\42\62R\42B\62\212dTI\10IQ\251\23\27\246\26\4]\362\26\315\371\305p@\253\211\234\210\234"
-  "\310\1\211\254\226,%\16\12]\363\33\315\371\305p@\42'\42'\42'\42'\42'r@\42\253%"
-  "K\211\203\2^t\37\20\322\305#.~P#$($'%y@%#)#)#vp ("
-  "\256\63\0^\232'\20\322\305'\17 xp\42.$xP\244DH\211\320\301\211\220\210\220\22\241\203"
-  "\32!\62\31\21!\221\241\205\3^\377(\20\322\305$%'%'%'%'%sp $%'"
-  "%'%'%'%'%'%'%w '%\3`\312.\20\322\305#$(%'q\60#"
-  ">{pB\42$B\42$\241\344 HJND\202JDB\221\204\210\32\32\21\31\31:!)\0"
-  "b\12+\20\322\305(!+\42*xp\42$($($\243JDFJBHJBHlJL"
-  "D\25\205*\21\12\231\241\222\71\1b\14*\20\322\305I,!+wp\42%'%'%\42#%"
-  "\42c!\42#F$F$'!\42\66\241L\202BJ\246J\1e\345\20\352\335\305pP\306\263\203"
-  "\63>;\70\23e\366&\17\326\305+-b%\242JD\344\300DJD\225\210\225\210\12\21]\210h"
-  "!\242J\304JD\225,\261\14\0f\16,\356\325\305w`!C\42!C\42!C\42q`!C"
-  "\42!C\42!C\42q`!C\42!#&$&$%C$%\1f\37\37\316\365\305r\60$"
-  "&t\60$&t\60\250D\360\200DFLH\360`PX\354\340\0f%%\20\322\305'.xp"
-  "(yP(xp \244NL\352\240dBHbH\341A\240\220\240\220\340A\20\0f\221&\20\322"
-  "\305s\60\246\354`L\331\301\244\354\301\244\210\320\301\201\330\354\201\24\225\314\304\201\234\224\334\201\234\224\14"
-  "\0g\10&\15\332\305s\60#&#&#&#&s\60#&#&#&s\60#&#&\42"
-  "'\42'!f(\1g\11&\20\322\305&.xp %.} '%\66%u@$!%#"
-  "\42%w '%'%'C'$\4g\37.\17\322\305\242RD\302\342`D\13\21-DD,"
-  "LT\210h!\42b!\242\205\211\12\221\3\23)\11\31\21\21\32\11!\21#\25\0g*\36\20\322"
-  "\305'\256\362\240R\134\335\301\201\30\255\245\204:\21U\62J\206\204\346\304\345\0kc\36\320\361\305q"
-  "p(\256\251\210\250\310\225\210\250\210\250\210\250\210\250\210\250\210\334\301\201\0l\64!\20\322\305'\256\215"
-  "\244\214\314\201\204\340\241\4\245\4\241\210\204\234\210*\31\215\204\252\204\251\5\1n\5+\20\322\305)'"
-  "%xP\244J\350 FL\311\1\215\270\304A\220\210\220\10\311A\220\210\220\222\203 \21!%\42\204"
-  "\62\62\0n\341\61\20\322\305'#$\243\352\300FDFD\36@\344\200BJBLFB\354\300D"
-  "B\13\13\235H\34\220HL\210\214H\310\211HHQ\211I\0r[\33\20\322\305'*\42*\42*"
-  "\42z@$#($\256\356\340@N\134\357\0r\327,\17\322\305(&\42!G!)r\20b%"
-  "!\61F\42Q!$\241\315\204&\24zQA\42\241\221\234\220\234\4\25\215\234\10\0s*\60\20\322"
-  "\305)%\42#\42Bq #%!CD#q`#$(#\70rC\61#\42a#%r%"
-  "\42#%\42#Bs#$#\2s\64\61\20\322\305\247D\342\206DFHDH\206\342\240\242B\260"
-  "BPB\302f\202B\210BF\205\304\301\214\204\214\230\204\10\225\204\10\23\11\21\65D\2u\62\34\354"
-  "\331\305\360F\206F\206F\346\340@F\206F\206F\346\340@F\225\250\256\0u\63\37\14\332\305%\252"
-  "\352\340F\206F\206F\346\340@F\206F\206F\346\340@F\225\250*\0vx%\20\322\305(!t"
-  "@*!\242\13!\242\61U\202\42\23\7\21s\342\202\7\207\322\245\62rSB\203\42\0v}\24\14"
-  "\332\305%\251\356\340\220\303\203\3A\36\36\34\10\12y\273)\20\322\305&\17 wp \17DB&"
-  "A!FBv\60*xp\42#%\242\27\7\21\42j$D\4I$E\0y\313/\20\322\305$"
-  "#H\42U$($(B\42q@\42$B!\64!AE#fAeA$!#!&\242L"
-  "DFJBJ\210N\0y\315,\17\322\305\244\214F\246JLJL\344\340`B\215\210\204\222\21\11"
-  "%\24Z\34\134\34DHPH\211I\211I\211I\211I\311\0y\322.\20\322\305\244\216F\250JN"
-  "\306J\206B\342\202DFDBDdDB\314DB\304FB\304\206DBNJL\225\234\314\240\304"
-  "\34\0z\313\37\360\361\305&\17 .\17yp\17-\246NHPHRDTDTB\36\356\340@"
-  "\0\177\212\32\20\322\305\244RFRD\354\340P\134\345A\245\270\272\203\3\71q\355\0\201J\67\20\322"
-  "\305(\42S\242FBD\215\304A\205\22\65%j$\16*\324JH\34\204T\10\211H(\22\221\220"
-  "\70\10\221P$\42\241HDB\342 BbBH\2\0\201\363\32\320\361\305qp'\255HNL\352"
-  "\240\134R\134\362\240R\134\335\301\201\0\202\222\33\360\361\305\244PH\350\340@H\241\220\250<\200\334\301"
-  "\201\220\270\236\37P\0\206N%\17\322\305'}(x`\42#$\42Su\20\42\243#\33i\21+"
-  "\21U\42\212Dd$\64\222\240\20#\206\307'\360\361\305#%'\246\321\301A\304A\224\304\225\210\205"
-  "\234\205\210\214\205\42\32:\231A\12!\231#\23\42\11\261\3\206\360,\17\322\305\243PF\352\300JF"
-  "BjbB\244F\202F\344 \202BhD\202H\346`JD\225\210\252\203I\31\221\203\23I\1\214"
-  "\67!\20\322\305\244PJLDFHFHD\206VDRHl\311\350\314\301\230\376\354`L\15\0"
-  "\217\233\33\20\322\305&\17 yP\17'$)\42up '\256\360\340P\134w\0\217\260&\360\321"
-  "\305r`#.~P$.~`#\241PB\211\220\204\10\225\204\214\224\210\220\22\32\21\231\251)I"
-  "\0\217\330#\320\361\305\42r $%'%-.US&B!%\241D\210D\221B!A!\71"
-  "Z\221\3\2\221I%\360\321\305\360@JDTD\354\340D\377BFD\204\252dRDT\344\340D"
-  "TDT\344\340DT\2\0\225\360#\16\326\305!-q \42HJzp@$D$Dq\20A"
-  "$D$D$tp@Jh)\1\226M.\17\326\305'f!&\42q\241\215\210\204\205\14\321\220"
-  "\204\304\22\11\22\211\22\31!\221\203\11\21\31\241\23!\212\203:!\71!\71!\0\226\350(\360\321\305"
-  "\360@N\134\341\301\211\220\22!%\22\22$J(\224\10)\221\220 QB\241DH\211\220\10\211\244"
-  "\10\0\226\352 \20\322\305rP)xp\20!$EqP(z\60\17vP\256\352\200\134\321A\271"
-  "\10\0\227\34+\20\322\305rP)xp\20!$EqP(z\60\17(\362@Fh\344\246BF"
-  "D\342\200BD\215\224\310\225\210\214\4\0\227\62(\20\322\305rP)xp\20!$EqP(z"
-  "\60,fa#b!c\63&BAaJ\343BD\204\310\4\0\232l\32\357\321\305q@\255LJ"
-  "LJLJ\354\240Z\365\301\205\264Rb\21\0\236!*\20\322\305*-}q!#&A!&!"
-  "#\42!\42AC\242JFR\346 \204PDBNB\344\300X\226Z\4\0\237 (\16\332\305#"
-  "IS\42(\322DPDP\344\240\36\202\205\210\4\23\31%\24\24\42\22\24\7\61\62\7\21$&C"
-  "\2\237\231-\20\322\305%#)$($(yp %!+!\42'!\42'\241N\204PdP"
-  "FHFdHD\204HBD\344@\34\0\0";
+const uint8_t u8g2_font_wqy12_t_lunar[4419] U8G2_FONT_SECTION("u8g2_font_wqy12_t_lunar") = 
+  "\265\0\4\3\5\5\3\5\6\21\22\377\374\13\375\14\374\1\367\3\367\5\205 \6\0\60\246\0"
+  "!\11\302\375\245\360\300\210\0\42\11\305\270\246 \301\27\2#\36\211\21\246#!$!$!r"
+  "\20\42!$!$!$!r\20\42!$!$!\3$\25\250\361\245#Ec\241\202B\210\212\221\4\205\12\33*"
+  "\31\0%$\214\25\272\61$\42!#\42!\42#\241HB\325\204\250\304\224\204\32\21\11\31\21"
+  "\11\21\31\11\21\241\11\0&\33\213\25\266\63'!&!&!F78#B#!\42\61!R\42\63TA'\7\302"
+  "\270\226pP(\16\5\226\235#\242FDF\77\222\21R)\17\5\226\235 \244FHF\77\221\21Q\3*"
+  "\21(Q\246#&#\241\302\206\306B\33\61\31\0+\15l\25\272%\252\253\203*Q]\1,\10\203"
+  "\330\245`A\1-\6%p\232P.\6C\370\245`/\22\7\226\245\245HJ\221\224\42)ER\212\244"
+  "\244\0\60\16g\25\246\62#\241\206\337H\250\31\1\61\13f\25\246\42\63B\244\237\30"
+  "\62\15g\25\246Q!C#\245H\257\16\63\22h\21\246Q\42#'&%C\247\214F\244\4\0\64\25h\21"
+  "\246%5D#!\242BFBF\342 JL\5\0\65\22h\21\246p!\246\314dDNL\214F\244\4\0\66\25h\21"
+  "\246B#\42!&f2\42!\304HBD\206\4\0\67\22h\21\246p\20&%&%&%\246JL\10\0\70\23h\21"
+  "\246B#\242\67\64\42\22B\214$DdH\0\71\24h\21\246B#\42!\304HBd\304L\205\210\14\11"
+  "\0:\7\342\30\226 *;\7\2\371\225 J<\15J\371\265(6\265\335\344\244\344\2=\12\213T"
+  "\266p@\17w@>\13K\365\265 \272\313\261\35\2\77\17f\25\246A!\42\244F\221z\10\21\0@"
+  "\31i\25\262b\42#\42q!B!B!B!B!\42!A\42h\1A\30k\21\262\64\70'!&!%#$#$#s \42%!G'B"
+  "\22h\31\262p!\304\215\204\211\214\204\20\243\3\11\0C\20i\25\256c\42#!&\247C52\25"
+  "\0D\22i\31\266p\42$!$!\305G\22B\22'\0E\16h\31\256p0\246\331\205\230f\7\1F\15g\31"
+  "\252p \245\325\201\224\256\0G\23i\25\262c\42#!&\247\215\225\204\220\210\214\214"
+  "\1H\14h\31\262 \304\243\203\42\36\11I\10b\31\226\360A\0J\13\206\365\245\244\377F"
+  "\202\4\0K\27i\31\262 E$!#\242FB\210\252HDF\211\220\204\224\0L\11g\31\252 \245"
+  "\177uM\26k\31\276\60eus\20c\241\202B\5\311\10\311\10\35;\1N\22h\31\262\60ScbrA!A"
+  "q\342\246f\0O\24j\25\266C%\42#$!\306\63\11!\31\21)\32\0P\20h\31\256`\42#!\304"
+  "\215\204\211\230f\0Q\23\252\325\265C%\42#$!\306\63\11m$\246*\25R\22h\31\256p!"
+  "\304\321\201\204\210n$d$\204\4S\22h\25\252B#\42!&'G\247\214F\244\4\0T\13j\25\262"
+  "p0$\250\177\4U\15h\31\262 \304\77\222\20\221!\1V\31k\21\262 G'!%\42%\243HFHFJBLB"
+  "np\10\0W\36n\25\302 $D$D\244B\204D\11\211\22\22\31\22\42\22\42\22*!1!\31\0X\26K"
+  "\21\262 '!%\243JBnpNBJF\225\204\234\0Y\21j\21\262 F&!$#\42E'\250G\0Z\21i\25\256p"
+  " &'\246NL\235\230\330\201\0[\12\4\226\231`\242\377'\4\134\22\7\226\245 %&\245LJ"
+  "\231\224\62)eR\2]\12\4\222\231@\242\377'\6^\11f\370\256\42C!\42_\7+\224\265p@`\7"
+  "C\34\247 \42a\16\347\24\246Q!#%q\20C#ab\17g\25\246 \245\225\305\10\15\67\7\21\0c"
+  "\15\347\24\246Q!C\245\215D\5\0d\15g\25\246\245\213\203\220\32N&\14e\16\347\20"
+  "\242Q!Cs@%#Q\1f\15f\25\232B!\244\246DHo\0g\21h\261\245\65R\242OJ\344\16\204\210$"
+  ",\0h\15g\25\246 \245\225\305\10\15o\4i\10b\25\226 vpj\13\305\255\225#\17\243\277"
+  "\261\0k\21g\25\246 \245\23\11%44\22\42*d\4l\10b\25\226\360A\0m\24\353\24\272`"
+  "\261d\202F\204F\204F\204F\204FD\0n\13\347\24\246`1B\303\33\1o\14\347\24\246Q!"
+  "\303\33\211\12\0p\17G\265\245`1B\303\315A\204\224*\0q\15G\265\245q\20R\303\311"
+  "\204\225\6r\13\345\24\232p\20\42\243\33\0s\13\346\20\236q$E%t\1t\14%\25\236!#R!"
+  "\243\243\1u\12\347\24\246 \303'\23\6v\17\350\20\242 D$!\242\15\21\225\14\0w\25"
+  "\352\20\262 \42B\242\342 \344 \344 FDHD\4\0x\20\350\20\242 $!\42C%E#\42!$y\21H"
+  "\261\241 $!\242\15\21\225\230*\241)\0z\11\347\20\242p\244W\7{\16\7\226\245C\42"
+  "\245G3bSzF|\10\2\232\225\360\3\2}\20\7\226\245\60&\245gb#CR\272\31\2~\11H4\257"
+  "\301d\2\0\0\0\0,NY\0\260Q\254\0\374Y\4\1\10]\362\0\364e\345\1\34g*\1.s4\1Cz\313"
+  "\1\27\214\67\1\37\226\352\1\42\377\377!\3\27\256\65\306\61*!b\241\311\12!)a\275"
+  "\226\22\223\21,\1N\0\11\60\320\306\360@\0N\1\16\356\325\305\360LX\377SZ9\0N\3\25"
+  "\357\361\305&\255'UF\7\321\272\22\223\22\223\222;\10N\11\20\220\21\306qp\217\273"
+  "\203z\274;8\20N\21#\320\361\305r@)#)#)#)#)#u@($($($($($($sp N\31'\360\321\305"
+  "\360@N\134\341\301\211\220\22!%24\42\62\22\42\332H\210H\10I\210\210\212\210\212"
+  "\10\222H\212\0NY\23\316\365\305pP\253\77\226\225\224\220\224\220\24\71(N]\42\20"
+  "\322\305%\256\351\1\245\214\244\214\244\214\240\220\240\220\240\220\234\224\210"
+  "\214\224\210\62\21\11\301s\0N\214\15P1\306rP\217\77=8\20N\224\36\320\361\305qp'"
+  "\256\351\1\241\220\240\220\240\220\240\220\234\224\234\224\234\224\314\301\201\0"
+  "N\245\42\16\326\305%-\17up%\253HJH\352 DNDlDjFh\210pDjJ\202P\0QT(\20\322\305$.~"
+  "\20'%&%v`B\243HF\221\214\242\203\42\21\22\71\11B\21\11\61\31\11%BBe\7Qk#\357\325"
+  "\305()\42)\42)\42)\42)\42)#'$'$'\245LJNFPFRBV\0Qm!\360\361\305&\17 \17 .\17wp "
+  "\217NDTFPJNLJNHRDT\2\0Q\254!\20\322\305%.} \246\212HJD-\351\310\330\222\321)z"
+  "\200y\0Az\200y\0)\0R\6(\20\322\305)*\42*#($'&%(#*!q \42%#)#)#($($'%&C&%\6R\35*"
+  "\17\322\305\42.\17rp\20\242HFDFHDFHD\244DE\215\10\5\211\32\22\65\372\211\220\214"
+  "\204\10\21\221\10\0SA\20\20\322\305'\256w\7\7r\342\372;\0SH\30\20\322\305$\256"
+  "\372\200JDRFPH\134\335\301\201\234\270\336\1So0\16\326\305\63Hs \42!C\42!C\42!C"
+  "\42!C\42!C\42!C\42!C1!s\20a%\241JDPDNFLH\12\0V\333\37\256\365\305\360@D\11\211"
+  "\22\22%$JH\224P\310\210P\10\35\10V\222\36\34\220\12X\354\23\360\361\305+kt\256"
+  "\273\203\3\71q\275<(\1Y\4,\20\322\305#$($($X!(!1&\42A%\42\241\206B\211\204\4\211"
+  "\42\22I\31I\31A\22\71\221A\251\203q\0Y\17!\20\322\305qp'{0\246\354`L\331\301\230"
+  "\262\203\71\351\203)\42)\21\265\224$4\204\4Y'\34\20\322\305'\256\273\203\3\71qib"
+  "Z\21Q\21I!91)A\221\321\1Y)\35\360\321\305rP)\256\335\301\201\234\64\61\255\210"
+  "\250\210\244\220\234\230\224\240\310\350\0[P\24\360\321\305q`\255\361\264\334"
+  "\301\201\234\270\36S\13\2[\305'\20\322\305&\17 xp\20!KqP(z0&\242LD\331\301\230"
+  "\210\62\21e\7\203\42\222Brb2\0[\322+\20\322\305&\17 xp\20!\242\206\342\240LD\356"
+  "\240ND\352\340@H\235\304\210\224\220\210\310\230\310\324<\300<\200\24\0\134\17"
+  "\36\20\322\305'\256S\21e\42\62R\42B2\212dTI\10IQ\251\23\27\246\26\4]\362\26\315"
+  "\371\305p@\253\211\234\210\234\310\1\211\254\226,%\16\12]\363\33\315\371\305p@"
+  "\42'\42'\42'\42'\42'r@\42\253%K\211\203\2^t\37\20\322\305#.~P#$($'%y@%#)#)#vp ("
+  "\256\63\0^\232'\20\322\305'\17 xp\42.$xP\244DH\211\320\301\211\220\210\220\22"
+  "\241\203\32!2\31\21!\221\241\205\3^\377(\20\322\305$%'%'%'%'%sp $%'%'%'%'%'%'%'%"
+  "w '%\3`\312.\20\322\305#$(%'q0#>{pB\42$B\42$\241\344 HJND\202JDB\221\204\210\32"
+  "\32\21\31\31:!)\0b\12+\20\322\305(!+\42*xp\42$($($\243JDFJBHJBHlJLD\25\205*\21"
+  "\12\231\241\222\71\1b\14*\20\322\305I,!+wp\42%'%'%\42#%\42c!\42#F$F$'!\42\66\241"
+  "L\202BJ\246J\1e\345\20\352\335\305pP\306\263\203\63>;8\23f\16,\356\325\305w`!C"
+  "\42!C\42!C\42q`!C\42!C\42!C\42q`!C\42!#&$&$%C$%\1f\37\37\316\365\305r0$&t0$&t0"
+  "\250D\360\200DFLH\360`PX\354\340\0f%%\20\322\305'.xp(yP(xp \244NL\352\240dBHbH"
+  "\341A\240\220\240\220\340A\20\0f\221&\20\322\305s0\246\354`L\331\301\244\354\301"
+  "\244\210\320\301\201\330\354\201\24\225\314\304\201\234\224\334\201\234\224\14\0"
+  "g\10&\15\332\305s0#&#&#&#&s0#&#&#&s0#&#&\42'\42'!f(\1g\11&\20\322\305&.xp %.} '%"
+  "6%u@$!%#\42%w '%'%'C'$\4g\37.\17\322\305\242RD\302\342`D\13\21-DD,LT\210h!\42b!"
+  "\242\205\211\12\221\3\23)\11\31\21\21\32\11!\21#\25\0g*\36\20\322\305'\256\362"
+  "\240R\134\335\301\201\30\255\245\204:\21U2J\206\204\346\304\345\0kc\36\320\361"
+  "\305qp(\256\251\210\250\310\225\210\250\210\250\210\250\210\250\210\250\210\334"
+  "\301\201\0l4!\20\322\305'\256\215\244\214\314\201\204\340\241\4\245\4\241\210"
+  "\204\234\210*\31\215\204\252\204\251\5\1n\5+\20\322\305)'%xP\244J\350 FL\311\1"
+  "\215\270\304A\220\210\220\10\311A\220\210\220\222\203 \21!%\42\204\62\62\0n\341"
+  "\61\20\322\305'#$\243\352\300FDFD\36@\344\200BJBLFB\354\300DB\13\13\235H\34\220H"
+  "L\210\214H\310\211HHQ\211I\0r[\33\20\322\305'*\42*\42*\42z@$#($\256\356\340@N"
+  "\134\357\0r\327,\17\322\305(&\42!G!)r\20b%!1F\42Q!$\241\315\204&\24zQA\42\241"
+  "\221\234\220\234\4\25\215\234\10\0s*0\20\322\305)%\42#\42Bq #%!CD#q`#$(#8rC1#\42"
+  "a#%r%\42#%\42#Bs#$#\2s41\20\322\305\247D\342\206DFHDH\206\342\240\242B\260BPB"
+  "\302f\202B\210BF\205\304\301\214\204\214\230\204\10\225\204\10\23\11\21\65D\2u2"
+  "\34\354\331\305\360F\206F\206F\346\340@F\206F\206F\346\340@F\225\250\256\0u3\37"
+  "\14\332\305%\252\352\340F\206F\206F\346\340@F\206F\206F\346\340@F\225\250*\0vx%"
+  "\20\322\305(!t@*!\242\13!\242\61U\202\42\23\7\21s\342\202\7\207\322\245\62rSB"
+  "\203\42\0v}\24\14\332\305%\251\356\340\220\303\203\3A\36\36\34\10\12y\273)\20"
+  "\322\305&\17 wp \17DB&A!FBv0*xp\42#%\242\27\7\21\42j$D\4I$E\0y\313/\20\322\305$#"
+  "H\42U$($(B\42q@\42$B!4!AE#fAeA$!#!&\242LDFJBJ\210N\0y\315,\17\322\305\244\214F"
+  "\246JLJL\344\340`B\215\210\204\222\21\11%\24Z\34\134\34DHPH\211I\211I\211I\211I"
+  "\311\0z\313\37\360\361\305&\17 .\17yp\17-\246NHPHRDTDTB\36\356\340@\0\177\212\32"
+  "\20\322\305\244RFRD\354\340P\134\345A\245\270\272\203\3\71q\355\0\201J7\20\322"
+  "\305(\42S\242FBD\215\304A\205\22\65%j$\16*\324JH\34\204T\10\211H(\22\221\220\70"
+  "\10\221P$\42\241HDB\342 BbBH\2\0\201\363\32\320\361\305qp'\255HNL\352\240\134R"
+  "\134\362\240R\134\335\301\201\0\202\222\33\360\361\305\244PH\350\340@H\241\220"
+  "\250<\200\334\301\201\220\270\236\37P\0\206N%\17\322\305'}(x`\42#$\42Su\20\42"
+  "\243#\33i\21+\21U\42\212Dd$4\222\240\20#\206\307'\360\361\305#%'\246\321\301A"
+  "\304A\224\304\225\210\205\234\205\210\214\205\42\32:\231A\12!\231#\23\42\11\261"
+  "\3\206\360,\17\322\305\243PF\352\300JFBjbB\244F\202F\344 \202BhD\202H\346`JD\225"
+  "\210\252\203I\31\221\203\23I\1\214\67!\20\322\305\244PJLDFHFHD\206VDRHl\311\350"
+  "\314\301\230\376\354`L\15\0\217\233\33\20\322\305&\17 yP\17'$)\42up '\256\360"
+  "\340P\134w\0\217\260&\360\321\305r`#.~P$.~`#\241PB\211\220\204\10\225\204\214"
+  "\224\210\220\22\32\21\231\251)I\0\217\330#\320\361\305\42r $%'%-.US&B!%\241D\210"
+  "D\221B!A!9Z\221\3\2\221I%\360\321\305\360@JDTD\354\340D\377BFD\204\252dRDT\344"
+  "\340DTDT\344\340DT\2\0\225\360#\16\326\305!-q \42HJzp@$D$Dq\20A$D$D$tp@Jh)\1\226"
+  "M.\17\326\305'f!&\42q\241\215\210\204\205\14\321\220\204\304\22\11\22\211\22\31!"
+  "\221\203\11\21\31\241\23!\212\203:!9!9!\0\226\350(\360\321\305\360@N\134\341\301"
+  "\211\220\22!%\22\22$J(\224\10)\221\220 QB\241DH\211\220\10\211\244\10\0\226\352 "
+  "\20\322\305rP)xp\20!$EqP(z0\17vP\256\352\200\134\321A\271\10\0\227\34+\20\322"
+  "\305rP)xp\20!$EqP(z0\17(\362@Fh\344\246BFD\342\200BD\215\224\310\225\210\214\4\0"
+  "\227\62(\20\322\305rP)xp\20!$EqP(z0,fa#b!c3&BAaJ\343BD\204\310\4\0\232l\32\357"
+  "\321\305q@\255LJLJLJ\354\240Z\365\301\205\264Rb\21\0\236!*\20\322\305*-}q!#&A!&!"
+  "#\42!\42AC\242JFR\346 \204PDBNB\344\300X\226Z\4\0\237 (\16\332\305#IS\42(\322DPD"
+  "P\344\240\36\202\205\210\4\23\31%\24\24\42\22\24\7\61\62\7\21$&C\2\237\231-\20"
+  "\322\305%#)$($(yp %!+!\42'!\42'\241N\204PdPFHFdHD\204HBD\344@\34\0\0";
 
 /*
   Fontname: -Adobe-Helvetica-Bold-R-Normal--20-140-100-100-P-105-ISO10646-1
@@ -272,14 +267,15 @@ const uint8_t u8g2_font_wqy12_t_lunar[4560] U8G2_FONT_SECTION("u8g2_font_wqy12_t
 */
 const uint8_t u8g2_font_helvB14_tn[287] U8G2_FONT_SECTION("u8g2_font_helvB14_tn") = 
   "\22\0\3\3\4\4\2\5\5\11\21\0\375\16\374\16\374\0\0\0\0\1\2 \5\0\306\12*\17g\343"
-  "\274\230$\42\251\315$\242X\4\0+\14\210\307=\261\332\341 \23\253\1,\11c\267\212\203\204\22\2"
-  "-\7\65R\213\207\0.\7\63\303\212\203\0/\17\345\302:M#\231\322H&\32\311\324\0\60\17\331"
-  "B\275\341i\262\346o\223\245\343\14\0\61\12\326C\275\321\341 \333\77\62\21\331B\255\332ef\33O"
-  "\207\265\32u\371p \63\23\331B\255\332e\64\231\211\207\324\62\331f\242\334J\0\64\25\331B\335)"
-  "\261f\223\214&#\321d\64\71\34\250\343\25\0\65\25\331B\215C\344\20\31\217O\207\310\210<\266\231"
-  "\16%\23\0\66\24\331B-\323!\62+OF\207\10\311\330h\232\334J\0\67\20\331B\215\7\362t"
-  "y:\236\216\247\343U\0\70\22\331B\255\332e\346\66\271\325&kn\223[\11\0\71\24\331B\255\332"
-  "edl\64Q\16\241\311\270\66\71\204L\0:\11\243C\213\203\34z\20\0\0\0\4\377\377\0";
+  "\274\230$\42\251\315$\242X\4\0+\14\210\307=\261\332\341 \23\253\1,\11c\267\212"
+  "\203\204\22\2-\7\65R\213\207\0.\7\63\303\212\203\0/\17\345\302:M#\231\322H&\32"
+  "\311\324\0\60\17\331B\275\341i\262\346o\223\245\343\14\0\61\12\326C\275\321\341 "
+  "\333\77\62\21\331B\255\332ef\33O\207\265\32u\371p 3\23\331B\255\332e4\231\211"
+  "\207\324\62\331f\242\334J\0\64\25\331B\335)\261f\223\214&#\321d49\34\250\343\25"
+  "\0\65\25\331B\215C\344\20\31\217O\207\310\210<\266\231\16%\23\0\66\24\331B-\323!"
+  "2+OF\207\10\311\330h\232\334J\0\67\20\331B\215\7\362ty:\236\216\247\343U\0\70\22"
+  "\331B\255\332e\346\66\271\325&kn\223[\11\0\71\24\331B\255\332edl4Q\16\241\311"
+  "\270\66\71\204L\0:\11\243C\213\203\34z\20\0\0\0\4\377\377\0";
 
 /*
   Fontname: -Adobe-Helvetica-Bold-R-Normal--25-180-100-100-P-138-ISO10646-1
@@ -288,16 +284,15 @@ const uint8_t u8g2_font_helvB14_tn[287] U8G2_FONT_SECTION("u8g2_font_helvB14_tn"
   BBX Build Mode: 0
 */
 const uint8_t u8g2_font_helvB18_tn[389] U8G2_FONT_SECTION("u8g2_font_helvB18_tn") = 
-  "\22\0\4\3\4\5\3\5\5\15\26\0\375\23\373\23\373\0\0\0\0\1h \5\0\30-*\17x\312"
-  "\365\210\311HH\34\214\320\210h\1+\16\314\32\177\211\352\352\340\301\224\250\256\0,\12c\334.\34H"
-  "HP\0-\6\67h\61|.\7\63\14/\34\10/\22\67\13qi$\245HJ#)ER\212\244"
-  "T\1\60\33,\11\373X\35\304\220\220\14\215\14M\214\371g\23C#C#l\16\242l\0\61\14'"
-  "\15;\255\71\70 \332\377\3\62\33,\11\373T\35\310\314PLM\214\231M\16\16\322\61+\243c\70"
-  "y\360`\0\63\36,\11\373T\35\310,\231\232\230\232\230\232\34\34\253\273\34\235\64\263\242\230!\71\30"
-  "\262\1\64\33,\11\373\15\262k&\61\65\61%\62$\263\215\320\310\320\310\301\203\271\311M\0\65\35,"
-  "\11{\34\214\34\214Lny\20t \63C\71:\71ifu\20Cr e\3\66 ,\11;U"
-  "\35\210\320\214L\231Y\256 :\30)\241 \232\30s\66\61\64\302\346 \312\6\0\67\30,\11;|"
-  "\60H\270rprprpr\220pr\220pr\16\0\70\42,\11;\221\35\4\215\314\14\215\14\215"
-  "\14\215\14\315\214LY\35\304\14M\214y\66\61\64r\60d\3\71\37,\11\373\30\35\310\220P\20M"
-  "\214yvDARq@S\61\71i\65ARr U\4:\12\343\14/\34\310C\36\10\0\0\0"
-  "\4\377\377\0";
+  "\22\0\4\3\4\5\3\5\5\15\26\0\375\23\373\23\373\0\0\0\0\1h \5\0\30-*\17x\312\365"
+  "\210\311HH\34\214\320\210h\1+\16\314\32\177\211\352\352\340\301\224\250\256\0,"
+  "\12c\334.\34HHP\0-\6\67h1|.\7\63\14/\34\10/\22\67\13qi$\245HJ#)ER\212\244T\1\60"
+  "\33,\11\373X\35\304\220\220\14\215\14M\214\371g\23C#C#l\16\242l\0\61\14'\15;\255"
+  "\71\70 \332\377\3\62\33,\11\373T\35\310\314PLM\214\231M\16\16\322\61+\243c8y\360"
+  "`\0\63\36,\11\373T\35\310,\231\232\230\232\230\232\34\34\253\273\34\235\64\263"
+  "\242\230!9\30\262\1\64\33,\11\373\15\262k&151%2$\263\215\320\310\320\310\301\203"
+  "\271\311M\0\65\35,\11{\34\214\34\214Lny\20t 3C9:9ifu\20Cr e\3\66 ,\11;U\35\210"
+  "\320\214L\231Y\256 :\30)\241 \232\30s614\302\346 \312\6\0\67\30,\11;|0H\270rprpr"
+  "pr\220pr\220pr\16\0\70\42,\11;\221\35\4\215\314\14\215\14\215\14\215\14\315\214L"
+  "Y\35\304\14M\214y614r0d\3\71\37,\11\373\30\35\310\220P\20M\214yvDARq@S19i5ARr U"
+  "\4:\12\343\14/\34\310C\36\10\0\0\0\4\377\377\0";
@@ -37,6 +37,7 @@
 
 #include <stddef.h>
 #include "u8g2_font.h"
+#include "counters.h"
 
 static uint8_t u8g2_font_get_byte(const uint8_t *font, uint8_t offset)
 {
@@ -350,6 +351,7 @@ static int8_t u8g2_font_decode_glyph(u8g2_font_t *u8g2, const uint8_t *glyph_dat
     int8_t h;
     u8g2_font_decode_t *decode = &(u8g2->font_decode);
         
+    GUI_COUNT(glyph_decode);
     u8g2_font_setup_decode(u8g2, glyph_data);
     h = u8g2->font_decode.glyph_height;
     
@@ -364,6 +366,44 @@ static int8_t u8g2_font_decode_glyph(u8g2_font_t *u8g2, const uint8_t *glyph_dat
         decode->target_y = u8g2_add_vector_y(decode->target_y, x, -(h+y), decode->dir);
         //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
 
+        if ( u8g2->is_intersection != NULL )
+        {
+            int16_t x0, x1, y0, y1;
+            x0 = decode->target_x;
+            y0 = decode->target_y;
+            x1 = x0;
+            y1 = y0;
+            switch(decode->dir)
+            {
+                case 0:
+                    x1 += decode->glyph_width;
+                    y1 += h;
+                    break;
+                case 1:
+                    x0 -= h;
+                    x0++;   /* shift down, because of assymetric boundaries for the interseciton test */
+                    x1++;
+                    y1 += decode->glyph_width;
+                    break;
+                case 2:
+                    x0 -= decode->glyph_width;
+                    x0++;   /* shift down, because of assymetric boundaries for the interseciton test */
+                    x1++;
+                    y0 -= h;
+                    y0++;   /* shift down, because of assymetric boundaries for the interseciton test */
+                    y1++;
+                    break;
+                case 3:
+                    x1 += h;
+                    y0 -= decode->glyph_width;
+                    y0++;   /* shift down, because of assymetric boundaries for the interseciton test */
+                    y1++;
+                    break;
+            }
+            if ( u8g2->is_intersection(u8g2, x0, y0, x1, y1) == 0 )
+                return d;
+        }
+
      
         /* reset local x/y position */
         decode->x = 0;
@@ -400,6 +440,7 @@ const uint8_t *u8g2_font_get_glyph_data(u8g2_font_t *u8g2, uint16_t encoding)
 {
     const uint8_t *font = u8g2->font;
     font += 23;
+    GUI_COUNT(glyph_lookup);
 
     
     if ( encoding <= 255 )
@@ -142,6 +142,9 @@ typedef struct _u8g2_font_t
 
     void (*draw_hv_line)(struct _u8g2_font_t *u8g2, int16_t x, int16_t y,
                          int16_t len, uint8_t dir, uint16_t color);
+    /* optional, glyphs outside [x0, x1) x [y0, y1) are skipped without decoding */
+    uint8_t (*is_intersection)(struct _u8g2_font_t *u8g2, int16_t x0, int16_t y0,
+                               int16_t x1, int16_t y1);
 } u8g2_font_t;
 
 uint8_t u8g2_IsGlyph(u8g2_font_t *u8g2, uint16_t requested_encoding);
@@ -146,6 +146,22 @@ void DrawBitmap(uint8_t *black, uint8_t *color, uint16_t x, uint16_t y, uint16_t
     ReleaseDC(g_hwnd, hdc);
 }
 
+// gui_sink_t implementation: remember the window, draw the rows as they arrive
+static uint16_t g_window_x, g_window_y, g_window_w;
+
+static void SinkBegin(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    g_window_x = x;
+    g_window_y = y;
+    g_window_w = w;
+}
+
+static void SinkWrite(uint8_t *black, uint8_t *color, uint16_t h) {
+    DrawBitmap(black, color, g_window_x, g_window_y, g_window_w, h);
+    g_window_y += h;
+}
+
+static const gui_sink_t g_sink = {SinkBegin, SinkWrite, NULL};
+
 // Window procedure
 LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam) {
     switch (message) {
@@ -189,7 +205,9 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
             };
             
             // Call DrawGUI to render the interface, passing the BWR mode
-            DrawGUI(&data, DrawBitmap, g_display_mode);
+            // The window is cleared above, so always draw the whole frame
+            GUI_Invalidate();
+            DrawGUI(&data, &g_sink, g_display_mode);
             
             EndPaint(hwnd, &ps);
             return 0;
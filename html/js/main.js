@@ -1,7 +1,11 @@
 let bleDevice, gattServer;
-let epdService, epdCharacteristic;
+let epdService, epdCharacteristic, dataCharacteristic;
 let startTime, msgIndex, appVersion;
 let canvas, ctx, textDecoder;
+let notifyWaiter;
+let credits, creditWaiter; // flow control: bytes the tag can take, null without it
+let lastFrames = {}; // device id: the image last written to the controller RAM, for region writes
+let uploads = {}; // device id: the upload session not finished yet, resumed after reconnecting
 
 const EpdCmd = {
   SET_PINS:  0x00,
@@ -11,10 +15,26 @@ const EpdCmd = {
   SEND_DATA: 0x04,
   REFRESH:   0x05,
   SLEEP:     0x06,
+  LINK_INFO: 0x07, // v1.C
+  CREDIT:    0x08, // v1.D
+  BATCH:     0x09, // v2.0
 
   SET_TIME:  0x20,
+  LIST_WRITE: 0x21, // v2.2
+  LIST_SHOW:  0x22,
+  SLOT_SET:   0x23, // v2.3
 
-  WRITE_IMG: 0x30, // v1.6
+  WRITE_IMG:     0x30, // v1.6
+  WRITE_IMG_RLE: 0x31, // v1.A
+  WRITE_REGION:  0x32, // v1.B
+  REFRESH_REGION: 0x33,
+  UPLOAD_BEGIN:  0x34, // v1.F
+  UPLOAD_DATA:   0x35,
+  UPLOAD_STATUS: 0x36,
+
+  FONT_ERASE:  0x40, // v1.7
+  FONT_WRITE:  0x41,
+  FONT_COMMIT: 0x42,
 
   SET_CONFIG: 0x90,
   SYS_RESET:  0x91,
@@ -22,11 +42,20 @@ const EpdCmd = {
   CFG_ERASE:  0x99,
 };
 
+const UploadState = {
+  NONE:      0x00,
+  OPEN:      0x01,
+  DONE:      0x02,
+  CRC_ERROR: 0x03,
+};
+
 function resetVariables() {
   gattServer = null;
   epdService = null;
   epdCharacteristic = null;
+  dataCharacteristic = null;
   msgIndex = 0;
+  credits = null;
   document.getElementById("log").value = '';
 }
 
@@ -42,6 +71,13 @@ async function write(cmd, data, withResponse=true) {
     payload.push(...data)
   }
   addLog(bytes2hex(payload), '⇑');
+  // anything but image writes may change the controller RAM behind the remembered frame
+  if (bleDevice && ![EpdCmd.WRITE_IMG, EpdCmd.WRITE_IMG_RLE, EpdCmd.WRITE_REGION, EpdCmd.REFRESH,
+                     EpdCmd.REFRESH_REGION].includes(cmd))
+    delete lastFrames[bleDevice.id];
+  // every write but CREDIT costs its length (v1.E: and a byte of buffer header), wait for the tag to grant more
+  if (credits != null && cmd != EpdCmd.CREDIT &&
+      !await takeCredits(payload.length + (appVersion >= 0x1E ? 1 : 0))) return false;
   try {
     if (withResponse)
       await epdCharacteristic.writeValueWithResponse(Uint8Array.from(payload));
@@ -55,6 +91,51 @@ async function write(cmd, data, withResponse=true) {
   return true;
 }
 
+// commands as [cmd, ...data], as many as fit go into one BATCH write (v2.0), each must fit in a write with
+// the batch command and its length byte
+async function writeBatch(commands) {
+  if (appVersion < 0x20) {
+    for (const c of commands) {
+      if (!await write(c[0], c.slice(1))) return false;
+    }
+    return true;
+  }
+  const max = document.getElementById('mtusize').value - 1;
+  let frame = [];
+  for (const c of commands) {
+    if (frame.length > 0 && frame.length + 1 + c.length > max) {
+      if (!await write(EpdCmd.BATCH, frame)) return false;
+      frame = [];
+    }
+    frame.push(c.length, ...c);
+  }
+  return frame.length == 0 || await write(EpdCmd.BATCH, frame);
+}
+
+async function takeCredits(cost) {
+  while (credits < cost) {
+    if (!await waitCredits()) {
+      addLog("等待流控超时");
+      return false;
+    }
+  }
+  credits -= cost;
+  return true;
+}
+
+// session data on the data characteristic (v2.1): no header, costs its length and 2 bytes of buffer
+async function writeData(data) {
+  if (!dataCharacteristic || !await takeCredits(data.length + 2)) return false;
+  try {
+    await dataCharacteristic.writeValueWithoutResponse(Uint8Array.from(data));
+  } catch (e) {
+    console.error(e);
+    if (e.message) addLog("write: " + e.message);
+    return false;
+  }
+  return true;
+}
+
 async function epdWrite(cmd, data) {
   const chunkSize = document.getElementById('mtusize').value - 1;
   const interleavedCount = document.getElementById('interleavedcount').value;
@@ -68,7 +149,7 @@ async function epdWrite(cmd, data) {
   for (let i = 0; i < data.length; i += chunkSize) {
     let currentTime = (new Date().getTime() - startTime) / 1000.0;
     setStatus(`命令：0x${cmd.toString(16)}, 数据块: ${chunkIdx+1}/${count+1}, 总用时: ${currentTime}s`);
-    if (noReplyCount > 0) {
+    if (credits != null || noReplyCount > 0) {
       await write(EpdCmd.SEND_DATA, data.slice(i, i + chunkSize), false);
       noReplyCount--;
     } else {
@@ -79,8 +160,39 @@ async function epdWrite(cmd, data) {
   }
 }
 
+// PackBits: n < 128 is followed by n + 1 literal bytes, n > 128 repeats the next byte 257 - n times
+function packBits(data) {
+  const out = [];
+  let i = 0;
+  while (i < data.length) {
+    let run = 1;
+    while (run < 128 && i + run < data.length && data[i + run] === data[i]) run++;
+    if (run > 1) {
+      out.push(257 - run, data[i]);
+      i += run;
+      continue;
+    }
+    let n = 1;
+    while (n < 128 && i + n < data.length &&
+           !(i + n + 2 < data.length && data[i + n] === data[i + n + 1] && data[i + n] === data[i + n + 2]))
+      n++;
+    out.push(n - 1, ...data.slice(i, i + n));
+    i += n;
+  }
+  return out;
+}
+
 async function epdWriteImage(step = 'bw') {
-  const data = canvas2bytes(canvas, step);
+  let data = canvas2bytes(canvas, step);
+  let cmd = EpdCmd.WRITE_IMG;
+  if (appVersion >= 0x1A) {
+    const packed = packBits(data);
+    if (packed.length < data.length) {
+      addLog(`${step == 'bw' ? '黑白' : '红色'}数据压缩: ${data.length} -> ${packed.length} 字节`);
+      data = packed;
+      cmd = EpdCmd.WRITE_IMG_RLE;
+    }
+  }
   const chunkSize = document.getElementById('mtusize').value - 2;
   const interleavedCount = document.getElementById('interleavedcount').value;
   const count = Math.round(data.length / chunkSize);
@@ -94,20 +206,412 @@ async function epdWriteImage(step = 'bw') {
       (step == 'bw' ? 0x0F : 0x00) | ( i == 0 ? 0x00 : 0xF0),
       ...data.slice(i, i + chunkSize),
     ];
-    if (noReplyCount > 0) {
-      await write(EpdCmd.WRITE_IMG, payload, false);
+    if (credits != null || noReplyCount > 0) {
+      await write(cmd, payload, false);
       noReplyCount--;
     } else {
-      await write(EpdCmd.WRITE_IMG, payload, true);
+      await write(cmd, payload, true);
       noReplyCount = interleavedCount;
     }
     chunkIdx++;
   }
 }
 
+// Upload session: the planes as one stream with its CRC32, resumed at the offset the tag has written
+// when the link was lost. Returns true when the tag has all of it and the CRC matches.
+async function epdUpload(frame) {
+  const planes = frame.red ? [frame.bw, frame.red] : [frame.bw];
+  let data = [].concat(...planes);
+  let flags = frame.red ? 0x02 : 0x00;
+  const packed = [].concat(...planes.map(packBits));
+  if (packed.length < data.length) {
+    addLog(`数据压缩: ${data.length} -> ${packed.length} 字节`);
+    data = packed;
+    flags |= 0x01;
+  }
+  const crc = crc32(data);
+  let upload = uploads[bleDevice.id];
+  if (!upload || upload.crc != crc || upload.length != data.length || upload.flags != flags) {
+    upload = {id: crypto.getRandomValues(new Uint32Array(1))[0], crc: crc, length: data.length, flags: flags};
+    uploads[bleDevice.id] = upload;
+  }
+
+  let reply = await writeAndWait(EpdCmd.UPLOAD_BEGIN, [...u32Bytes(upload.id), ...u32Bytes(data.length),
+                                                       ...u32Bytes(crc), flags]);
+  if (!reply || reply[1] == UploadState.NONE) {
+    addLog("开始上传会话失败");
+    delete uploads[bleDevice.id];
+    return false;
+  }
+  let offset = getU32(reply, 6);
+  if (offset > 0) addLog(`从 ${offset}/${data.length} 字节处继续上传`);
+
+  // the data characteristic needs flow control, it has no write with response to pace it
+  const stream = dataCharacteristic != null && credits != null;
+  const chunkSize = document.getElementById('mtusize').value - (stream ? 0 : 5);
+  const interleavedCount = document.getElementById('interleavedcount').value;
+  let noReplyCount = interleavedCount;
+  while (offset < data.length) {
+    let currentTime = (new Date().getTime() - startTime) / 1000.0;
+    setStatus(`图片数据: ${offset}/${data.length}, 总用时: ${currentTime}s`);
+    let ok;
+    if (stream) {
+      ok = await writeData(data.slice(offset, offset + chunkSize));
+    } else {
+      const payload = [...u32Bytes(offset), ...data.slice(offset, offset + chunkSize)];
+      const withResponse = credits == null && noReplyCount <= 0;
+      noReplyCount = withResponse ? interleavedCount : noReplyCount - 1;
+      ok = await write(EpdCmd.UPLOAD_DATA, payload, withResponse);
+    }
+    if (!ok) {
+      addLog("上传中断，重新连接后继续");
+      return false;
+    }
+    offset += chunkSize;
+  }
+
+  reply = await writeAndWait(EpdCmd.UPLOAD_STATUS);
+  if (!reply || reply[1] != UploadState.DONE) {
+    if (reply && reply[1] == UploadState.CRC_ERROR) {
+      addLog("图片数据 CRC 校验失败！");
+      delete uploads[bleDevice.id];
+    } else {
+      addLog(`上传未完成: ${reply ? getU32(reply, 6) : '?'}/${data.length} 字节`);
+    }
+    return false;
+  }
+  delete uploads[bleDevice.id];
+  return true;
+}
+
+// PackBits data of a byte aligned rectangle, x, y, w, h follow the flag of the first write;
+// with a batch the writes are added to it instead, 2 bytes shorter
+async function epdWriteRegion(step, plane, r, batch = null) {
+  const rowBytes = canvas.width / 8;
+  const data = [];
+  for (let y = r.y; y < r.y + r.h; y++)
+    data.push(...plane.slice(y * rowBytes + r.x / 8, y * rowBytes + (r.x + r.w) / 8));
+  const packed = packBits(data);
+  const chunkSize = document.getElementById('mtusize').value - (batch ? 4 : 2);
+  const interleavedCount = document.getElementById('interleavedcount').value;
+  let noReplyCount = interleavedCount;
+
+  for (let i = 0; i == 0 || i < packed.length; ) {
+    const payload = [(step == 'bw' ? 0x0F : 0x00) | (i == 0 ? 0x00 : 0xF0)];
+    if (i == 0) {
+      for (const v of [r.x, r.y, r.w, r.h]) payload.push((v >> 8) & 0xFF, v & 0xFF);
+    }
+    const n = chunkSize + 1 - payload.length;
+    payload.push(...packed.slice(i, i + n));
+    i += n;
+    if (batch) {
+      batch.push([EpdCmd.WRITE_REGION, ...payload]);
+    } else if (credits != null || noReplyCount > 0) {
+      await write(EpdCmd.WRITE_REGION, payload, false);
+      noReplyCount--;
+    } else {
+      await write(EpdCmd.WRITE_REGION, payload, true);
+      noReplyCount = interleavedCount;
+    }
+  }
+}
+
+// Byte aligned rectangles covering the changed bytes: bands of rows, rows less than 8 apart are joined.
+// Returns null when a full upload is about as cheap.
+function diffRegions(last, frame) {
+  const rowBytes = canvas.width / 8;
+  const rows = frame.bw.length / rowBytes;
+  const regions = [];
+  let band = null, area = 0;
+
+  for (let y = 0; y < rows; y++) {
+    let min = -1, max = -1;
+    for (let x = 0; x < rowBytes; x++) {
+      const i = y * rowBytes + x;
+      if (last.bw[i] !== frame.bw[i] || (frame.red && last.red[i] !== frame.red[i])) {
+        if (min < 0) min = x;
+        max = x;
+      }
+    }
+    if (min < 0) continue;
+    if (band && y - band.end <= 8) {
+      band.min = Math.min(band.min, min);
+      band.max = Math.max(band.max, max);
+      band.end = y;
+    } else {
+      if (band) regions.push(band);
+      band = { start: y, end: y, min: min, max: max };
+    }
+  }
+  if (band) regions.push(band);
+
+  const rects = regions.map((b) => ({ x: b.min * 8, y: b.start, w: (b.max - b.min + 1) * 8, h: b.end - b.start + 1 }));
+  for (const r of rects) area += r.w / 8 * r.h;
+  return area * 2 > frame.bw.length ? null : rects;
+}
+
+function waitCredits(timeout = 10000) {
+  return new Promise((resolve) => {
+    const timer = setTimeout(() => {
+      creditWaiter = null;
+      resolve(false);
+    }, timeout);
+    creditWaiter = () => {
+      clearTimeout(timer);
+      creditWaiter = null;
+      resolve(true);
+    };
+  });
+}
+
+function waitNotify(cmd, timeout = 10000) {
+  return new Promise((resolve) => {
+    const timer = setTimeout(() => {
+      notifyWaiter = null;
+      resolve(null);
+    }, timeout);
+    notifyWaiter = {
+      cmd: cmd,
+      resolve: (data) => {
+        clearTimeout(timer);
+        notifyWaiter = null;
+        resolve(data);
+      }
+    };
+  });
+}
+
+async function writeAndWait(cmd, data) {
+  const reply = waitNotify(cmd);
+  if (!await write(cmd, data)) return null;
+  return await reply;
+}
+
+async function sendFontPack() {
+  const font_file = document.getElementById('font_file');
+  if (font_file.files.length == 0) {
+    alert('请选择字库文件！');
+    return;
+  }
+  if (appVersion < 0x17) {
+    addLog("固件版本过低，不支持上传字库");
+    return;
+  }
+
+  const data = new Uint8Array(await font_file.files[0].arrayBuffer());
+  const chunkSize = Math.floor((document.getElementById('mtusize').value - 5) / 4) * 4;
+  const status = document.getElementById("status");
+  startTime = new Date().getTime();
+  status.parentElement.style.display = "block";
+
+  setStatus('正在擦除字库...');
+  let reply = await writeAndWait(EpdCmd.FONT_ERASE);
+  if (!reply || reply[1] != 0) {
+    addLog("擦除字库失败！");
+    return;
+  }
+
+  // the first word is the magic, written by the commit command
+  for (let i = 4; i < data.length; i += chunkSize) {
+    setStatus(`字库: ${i}/${data.length}, 总用时: ${(new Date().getTime() - startTime) / 1000.0}s`);
+    const payload = [(i >> 24) & 0xFF, (i >> 16) & 0xFF, (i >> 8) & 0xFF, i & 0xFF, ...data.slice(i, i + chunkSize)];
+    reply = await writeAndWait(EpdCmd.FONT_WRITE, payload);
+    if (!reply || reply[1] != 0) {
+      addLog(`写入字库失败！偏移: ${i}`);
+      return;
+    }
+  }
+
+  const crc = crc32(data.slice(4));
+  reply = await writeAndWait(EpdCmd.FONT_COMMIT, [(crc >> 24) & 0xFF, (crc >> 16) & 0xFF, (crc >> 8) & 0xFF, crc & 0xFF]);
+  if (!reply || reply[1] != 0) {
+    addLog("字库校验失败！");
+    return;
+  }
+
+  const sendTime = (new Date().getTime() - startTime) / 1000.0;
+  addLog(`字库上传完成！耗时: ${sendTime}s`);
+  setStatus(`字库上传完成！耗时: ${sendTime}s`);
+}
+
+// EPD_perf.h: version, phase count, clock, reserved, then count/min/avg/max (us) per phase
+async function readPerf() {
+  if (appVersion < 0x18) {
+    addLog("固件版本过低，不支持性能统计");
+    return;
+  }
+
+  const names = ['BLE 写入', '图片写入', 'GUI 更新', '渲染', 'SPI 传输', 'BUSY 等待', '温度读取', '刷新', '空闲'];
+  const perfCharacteristic = await epdService.getCharacteristic('62750004-d828-918d-fb46-b6c11c675aec');
+  const data = await perfCharacteristic.readValue();
+  const count = data.getUint8(1);
+  addLog(`性能统计 (${data.getUint8(2) ? 'DWT' : 'RTC'} 计时, 次数 / 最短 / 平均 / 最长):`);
+  for (let i = 0; i < count && 4 + i * 16 + 16 <= data.byteLength; i++) {
+    const offset = 4 + i * 16;
+    const ms = (n) => (data.getUint32(offset + n, true) / 1000).toFixed(2);
+    addLog(`${names[i] || i}: ${data.getUint32(offset, true)} / ${ms(4)} / ${ms(8)} / ${ms(12)} ms`);
+  }
+}
+
+// EPD_trace.h: header and the last records, decoded with tools/trace_decode.py
+async function saveTrace() {
+  if (appVersion < 0x19) {
+    addLog("固件版本过低，不支持事件跟踪");
+    return;
+  }
+
+  const traceCharacteristic = await epdService.getCharacteristic('62750005-d828-918d-fb46-b6c11c675aec');
+  const data = await traceCharacteristic.readValue();
+  const count = data.getUint16(12, true);
+  const link = document.createElement('a');
+  const bytes = new Uint8Array(data.buffer, data.byteOffset, data.byteLength);
+  link.href = URL.createObjectURL(new Blob([bytes], { type: 'application/octet-stream' }));
+  link.download = `trace-${new Date().getTime()}.bin`;
+  link.click();
+  URL.revokeObjectURL(link.href);
+  addLog(`事件跟踪: ${count} 条记录 (共 ${data.getUint32(8, true)} 条), 已保存为 ${link.download}`);
+}
+
+// display list of GUI/GUI.h, drawn by the tag (v2.2)
+class DisplayList {
+  static Color = { BLACK: 0, WHITE: 1, RED: 2 };
+  static FILL = 0x04;
+  static Align = { LEFT: 0, CENTER: 1, RIGHT: 2 };
+  static NUMBER = 0x04;
+  static Ecc = { L: 0, M: 1 };
+  static NO_SLOT = 0xFF;
+
+  constructor() {
+    this.items = [];
+    this.bitmaps = [];
+  }
+
+  add(op, style, values, tail = []) {
+    const params = [style];
+    for (const v of values) params.push((v >> 8) & 0xFF, v & 0xFF);
+    params.push(...tail);
+    this.items.push([op, params.length, ...params]);
+    return this;
+  }
+
+  rect(x, y, w, h, color, fill = false) { return this.add(0x01, color | (fill ? DisplayList.FILL : 0), [x, y, w, h]); }
+  line(x0, y0, x1, y1, color) { return this.add(0x02, color, [x0, y0, x1, y1]); }
+  circle(x, y, r, color, fill = false) { return this.add(0x03, color | (fill ? DisplayList.FILL : 0), [x, y, r]); }
+  text(x, y, font, str, color) { return this.add(0x04, color, [x, y], [font, ...new TextEncoder().encode(str)]); }
+
+  // a value set later with epdSetSlots(), number slots show an integer with decimals (v2.3)
+  slot(x, y, w, h, font, slot, color, align = DisplayList.Align.LEFT, number = false, decimals = 0) {
+    return this.add(0x06, color, [x, y, w, h], [font, align | (number ? DisplayList.NUMBER : 0) | (decimals << 4), slot]);
+  }
+
+  // content is the text, or the value of a slot when given a slot number (v2.4)
+  qr(x, y, scale, ecc, content, color) {
+    return this.add(0x07, color, [x, y], [scale, ecc, ...DisplayList.content(content)]);
+  }
+  barcode(x, y, h, module, content, color) {
+    return this.add(0x08, color, [x, y, h], [module, ...DisplayList.content(content)]);
+  }
+  static content(content) {
+    return typeof content == 'number' ? [content] : [DisplayList.NO_SLOT, ...new TextEncoder().encode(content)];
+  }
+
+  // 1bpp rows padded to bytes, MSB first, 1 is drawn; the data goes after the items
+  bitmap(x, y, w, h, data, color) {
+    this.bitmaps.push({ item: this.items.length, data: data });
+    return this.add(0x05, color, [x, y, w, h, 0]);
+  }
+
+  bytes() {
+    let offset = this.items.reduce((n, item) => n + item.length, 1);
+    for (const b of this.bitmaps) {
+      const item = this.items[b.item];
+      item[11] = (offset >> 8) & 0xFF;
+      item[12] = offset & 0xFF;
+      offset += b.data.length;
+    }
+    return Uint8Array.from([...this.items.flat(), 0x00, ...this.bitmaps.flatMap(b => [...b.data])]);
+  }
+}
+
+async function epdShowList(data, save = false) {
+  const chunkSize = document.getElementById('mtusize').value - 3;
+  for (let i = 0; i < data.length; i += chunkSize) {
+    if (!await write(EpdCmd.LIST_WRITE, [(i >> 8) & 0xFF, i & 0xFF, ...data.slice(i, i + chunkSize)]))
+      return false;
+  }
+  const reply = await writeAndWait(EpdCmd.LIST_SHOW, [save ? 0x01 : 0x00]);
+  if (!reply || reply[1] != 0) {
+    addLog(`显示列表失败！长度: ${reply ? (reply[2] << 8) | reply[3] : '-'}`);
+    return false;
+  }
+  return true;
+}
+
+// values: {slot: text or number}, all in one write, only the changed slots are redrawn
+async function epdSetSlots(values, save = false) {
+  const data = [save ? 0x01 : 0x00];
+  for (const [slot, value] of Object.entries(values)) {
+    const bytes = typeof value == 'number'
+      ? [(value >> 24) & 0xFF, (value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF]
+      : [...new TextEncoder().encode(value)];
+    if (bytes.length > 31) {
+      addLog(`槽 ${slot} 的值超过 31 字节`);
+      return false;
+    }
+    data.push(parseInt(slot), bytes.length, ...bytes);
+  }
+  if (data.length > document.getElementById('mtusize').value - 1) {
+    addLog("槽的值超过一次写入的长度");
+    return false;
+  }
+  const reply = await writeAndWait(EpdCmd.SLOT_SET, data);
+  return reply && reply[1] == 0;
+}
+
+// "0=名称;1=#1299": text, or a number after #
+async function sendSlotValues() {
+  if (appVersion < 0x23) {
+    addLog("固件版本过低，不支持模板槽");
+    return;
+  }
+  const values = {};
+  for (const entry of document.getElementById('slot_values').value.split(';')) {
+    const i = entry.indexOf('=');
+    if (i < 1) continue;
+    const value = entry.substring(i + 1);
+    values[entry.substring(0, i).trim()] = value.startsWith('#') ? parseInt(value.substring(1)) : value;
+  }
+  if (await epdSetSlots(values, true))
+    addLog(`已更新 ${Object.keys(values).length} 个槽`);
+  else
+    addLog("更新槽失败！");
+}
+
+async function sendDisplayList() {
+  const list_file = document.getElementById('list_file');
+  if (list_file.files.length == 0) {
+    alert('请选择显示列表文件！');
+    return;
+  }
+  if (appVersion < 0x22) {
+    addLog("固件版本过低，不支持显示列表");
+    return;
+  }
+
+  const data = new Uint8Array(await list_file.files[0].arrayBuffer());
+  if (data.length > 512) {
+    addLog("显示列表超过 512 字节");
+    return;
+  }
+  if (await epdShowList(data, true))
+    addLog(`显示列表已发送并保存，${data.length} 字节`);
+}
+
 async function setDriver() {
-  await write(EpdCmd.SET_PINS, document.getElementById("epdpins").value);
-  await write(EpdCmd.INIT, document.getElementById("epddriver").value);
+  await writeBatch([
+    [EpdCmd.SET_PINS, ...hex2bytes(document.getElementById("epdpins").value)],
+    [EpdCmd.INIT, ...hex2bytes(document.getElementById("epddriver").value)],
+  ]);
 }
 
 async function syncTime(mode) {
@@ -158,13 +662,51 @@ async function sendimg() {
     } else {
       await epdWrite(driver === "04" ? 0x24 : 0x13, canvas2bytes(canvas, 'bw'));
     }
+    await write(EpdCmd.REFRESH);
   } else {
-    await epdWriteImage('bw');
-    if (mode.startsWith('bwr')) await epdWriteImage('red');
+    const frame = {
+      driver: driver,
+      bw: canvas2bytes(canvas, 'bw'),
+      red: mode.startsWith('bwr') ? canvas2bytes(canvas, 'red') : null,
+    };
+    const last = lastFrames[bleDevice.id];
+    const regions = appVersion >= 0x1B && last && last.driver === driver && !last.red === !frame.red &&
+                    last.bw.length === frame.bw.length ? diffRegions(last, frame) : null;
+    if (regions && regions.length == 0) {
+      addLog('图片没有变化');
+    } else if (regions) {
+      // small edits and the refresh go out in a few batch writes
+      const batch = appVersion >= 0x20 ? [] : null;
+      let x0 = canvas.width, y0 = canvas.height, x1 = 0, y1 = 0;
+      for (const r of regions) {
+        addLog(`局部更新: x=${r.x}, y=${r.y}, w=${r.w}, h=${r.h}`);
+        setStatus(`局部更新: ${regions.indexOf(r) + 1}/${regions.length}`);
+        await epdWriteRegion('bw', frame.bw, r, batch);
+        if (frame.red) await epdWriteRegion('red', frame.red, r, batch);
+        x0 = Math.min(x0, r.x);
+        y0 = Math.min(y0, r.y);
+        x1 = Math.max(x1, r.x + r.w);
+        y1 = Math.max(y1, r.y + r.h);
+      }
+      const w = x1 - x0, h = y1 - y0;
+      const refresh = [x0 >> 8, x0 & 0xFF, y0 >> 8, y0 & 0xFF, w >> 8, w & 0xFF, h >> 8, h & 0xFF];
+      if (batch)
+        await writeBatch([...batch, [EpdCmd.REFRESH_REGION, ...refresh]]);
+      else
+        await write(EpdCmd.REFRESH_REGION, refresh);
+    } else {
+      if (appVersion >= 0x1F) {
+        // the CRC is checked before the refresh, a broken upload keeps the screen as it is
+        if (!await epdUpload(frame)) return;
+      } else {
+        await epdWriteImage('bw');
+        if (frame.red) await epdWriteImage('red');
+      }
+      await write(EpdCmd.REFRESH);
+    }
+    lastFrames[bleDevice.id] = frame;
   }
 
-  await write(EpdCmd.REFRESH);
-
   const sendTime = (new Date().getTime() - startTime) / 1000.0;
   addLog(`发送完成！耗时: ${sendTime}s`);
   setStatus(`发送完成！耗时: ${sendTime}s`);
@@ -183,9 +725,16 @@ function updateButtonStatus() {
   document.getElementById("clearscreenbutton").disabled = status;
   document.getElementById("sendimgbutton").disabled = status;
   document.getElementById("setDriverbutton").disabled = status;
+  document.getElementById("sendfontbutton").disabled = status;
+  document.getElementById("sendlistbutton").disabled = status;
+  document.getElementById("sendslotbutton").disabled = status;
+  document.getElementById("perfbutton").disabled = status;
+  document.getElementById("tracebutton").disabled = status;
 }
 
 function disconnect() {
+  // the tag powers the panel down without a connection, its RAM is gone
+  if (bleDevice) delete lastFrames[bleDevice.id];
   updateButtonStatus();
   resetVariables();
   addLog('已断开连接.');
@@ -238,6 +787,16 @@ function handleNotify(value, idx) {
     if (data.length > 10) epdpins.value += bytes2hex(data.slice(10, 11));
     epddriver.value = bytes2hex(data.slice(7, 8));
     filterDitheringOptions();
+  } else if (data[0] == EpdCmd.LINK_INFO && data.length == 3) {
+    const mtu = (data[1] << 8) | data[2];
+    document.getElementById('mtusize').value = mtu - 3;
+    addLog(`MTU: ${mtu}`);
+  } else if (data[0] == EpdCmd.CREDIT && data.length == 3) {
+    credits = (credits || 0) + ((data[1] << 8) | data[2]);
+    if (creditWaiter) creditWaiter();
+    if (notifyWaiter && notifyWaiter.cmd == data[0]) notifyWaiter.resolve(data);
+  } else if (notifyWaiter && data[0] == notifyWaiter.cmd) {
+    notifyWaiter.resolve(data);
   } else {
     if (textDecoder == null) textDecoder = new TextDecoder();
     addLog(textDecoder.decode(data), '⇓');
@@ -272,6 +831,14 @@ async function connect() {
     appVersion = 0x15;
   }
 
+  if (appVersion >= 0x21) {
+    try {
+      dataCharacteristic = await epdService.getCharacteristic('62750006-d828-918d-fb46-b6c11c675aec');
+    } catch (e) {
+      console.error(e);
+    }
+  }
+
   try {
     await epdCharacteristic.startNotifications();
     epdCharacteristic.addEventListener('characteristicvaluechanged', (event) => {
@@ -282,10 +849,33 @@ async function connect() {
     if (e.message) addLog("startNotifications: " + e.message);
   }
 
-  await write(EpdCmd.INIT);
+  // with flow control the uploads need no write with response in between
+  if (appVersion >= 0x1D) {
+    if (await writeAndWait(EpdCmd.CREDIT)) {
+      addLog(`流控已开启，窗口 ${credits} 字节`);
+    } else {
+      credits = null;
+      addLog("流控开启失败，使用确认间隔");
+    }
+  }
+
+  // INIT resets the controller, an upload session still open on the tag is resumed instead
+  let resume = false;
+  if (appVersion >= 0x1F && uploads[bleDevice.id]) {
+    const reply = await writeAndWait(EpdCmd.UPLOAD_STATUS);
+    resume = reply != null && (reply[1] == UploadState.OPEN || reply[1] == UploadState.DONE) &&
+             getU32(reply, 2) == uploads[bleDevice.id].id;
+    if (!resume) delete uploads[bleDevice.id];
+  }
+  if (!resume) await write(EpdCmd.INIT);
 
   document.getElementById("connectbutton").innerHTML = '断开';
   updateButtonStatus();
+
+  if (resume) {
+    addLog("继续上传未完成的图片");
+    await sendimg();
+  }
 }
 
 function setStatus(statusText) {
@@ -338,6 +928,24 @@ function bytes2hex(data) {
     }, "");
 }
 
+function crc32(data) {
+  let crc = 0xFFFFFFFF;
+  for (let i = 0; i < data.length; i++) {
+    crc ^= data[i];
+    for (let j = 0; j < 8; j++)
+      crc = (crc >>> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return (~crc) >>> 0;
+}
+
+function u32Bytes(value) {
+  return [(value >>> 24) & 0xFF, (value >>> 16) & 0xFF, (value >>> 8) & 0xFF, value & 0xFF];
+}
+
+function getU32(data, offset) {
+  return ((data[offset] << 24) | (data[offset + 1] << 16) | (data[offset + 2] << 8) | data[offset + 3]) >>> 0;
+}
+
 function intToHex(intIn) {
   let stringOut = ("0000" + intIn.toString(16)).substr(-4)
   return stringOut.substring(2, 4) + stringOut.substring(0, 2);
@@ -36,6 +36,8 @@
 #include "nrf_drv_gpiote.h"
 #include "nrf_pwr_mgmt.h"
 #include "EPD_service.h"
+#include "EPD_perf.h"
+#include "EPD_trace.h"
 
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
@@ -72,6 +74,9 @@
 #define FIRST_CONN_PARAMS_UPDATE_DELAY   TIMER_TICKS(5000)                              /**< Time from initiating event (connect or start of notification) to first time sd_ble_gap_conn_param_update is called (5 seconds). */
 #define NEXT_CONN_PARAMS_UPDATE_DELAY    TIMER_TICKS(30000)                             /**< Time between each call to sd_ble_gap_conn_param_update after the first call (30 seconds). */
 #define MAX_CONN_PARAMS_UPDATE_COUNT     3                                              /**< Number of attempts before giving up the connection parameter negotiation. */
+#define BULK_MIN_CONN_INTERVAL           MSEC_TO_UNITS(7.5, UNIT_1_25_MS)               /**< Minimum connection interval during uploads (7.5 ms). */
+#define BULK_MAX_CONN_INTERVAL           MSEC_TO_UNITS(15, UNIT_1_25_MS)                /**< Maximum connection interval during uploads (15 ms). */
+#define BULK_IDLE_TIMEOUT                2                                              /**< Seconds without upload writes before the low power parameters are restored. */
 
 #define SCHED_MAX_EVENT_DATA_SIZE       EPD_GUI_SCHD_EVENT_DATA_SIZE                    /**< Maximum size of scheduler events. */
 #define SCHED_QUEUE_SIZE                10                                              /**< Maximum number of events in the scheduler queue. */
@@ -90,6 +95,8 @@ static ble_uuid_t                        m_adv_uuids[] = {{BLE_UUID_EPD_SVC, \
 
 BLE_EPD_DEF(m_epd);                                                                     /**< Structure to identify the EPD Service. */
 static uint32_t                          m_timestamp = 1735689600;                      /**< Current timestamp. */
+static bool                              m_bulk_mode = false;                           /**< Bulk transfer link parameters requested. */
+static uint8_t                           m_bulk_idle;                                   /**< Seconds since the last upload write. */
 APP_TIMER_DEF(m_clock_timer_id);                                                        /**< Clock timer. */
 
 /**@brief Callback function for asserts in the SoftDevice.
@@ -108,12 +115,20 @@ void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
     app_error_handler(DEAD_BEEF, line_num, p_file_name);
 }
 
+static void link_params_update(bool bulk);
+
 static void clock_timer_timeout_handler(void * p_context)
 {
     UNUSED_PARAMETER(p_context);
 
     m_timestamp++;
 
+    if (m_bulk_mode && ++m_bulk_idle >= BULK_IDLE_TIMEOUT)
+    {
+        m_bulk_mode = false;
+        link_params_update(false);
+    }
+
     ble_epd_on_timer(&m_epd, m_timestamp, false);
 }
 
@@ -259,6 +274,53 @@ static void conn_params_init(void)
 }
 
 
+/**@brief Function for requesting the bulk transfer or the low power link parameters.
+ *
+ * @details The bulk parameters stay inside the range of gap_params_init(), so the Connection
+ *          Parameters module accepts them. Errors are ignored, the central may refuse or
+ *          another procedure may still be running; the upload works either way.
+ */
+static void link_params_update(bool bulk)
+{
+    ble_gap_conn_params_t params;
+
+    if (m_conn_handle == BLE_CONN_HANDLE_INVALID) return;
+
+    params.min_conn_interval = bulk ? BULK_MIN_CONN_INTERVAL : MIN_CONN_INTERVAL;
+    params.max_conn_interval = bulk ? BULK_MAX_CONN_INTERVAL : MAX_CONN_INTERVAL;
+    params.slave_latency     = bulk ? 0 : SLAVE_LATENCY;
+    params.conn_sup_timeout  = CONN_SUP_TIMEOUT;
+#if defined(S112)
+    // 2M PHY is kept afterwards, it also saves power. DLE is negotiated by the SoftDevice itself.
+    if (bulk)
+    {
+        ble_gap_phys_t const phys =
+        {
+            .rx_phys = BLE_GAP_PHY_2MBPS,
+            .tx_phys = BLE_GAP_PHY_2MBPS,
+        };
+        (void)sd_ble_gap_phy_update(m_conn_handle, &phys);
+    }
+#endif
+    (void)sd_ble_gap_conn_param_update(m_conn_handle, &params);
+    NRF_LOG_DEBUG("link: %s parameters\n", bulk ? "bulk" : "low power");
+}
+
+
+/**@brief Function for keeping the bulk transfer link parameters while an upload is in progress.
+ *
+ * @details Called by the EPD service on every upload write, the low power parameters come
+ *          back BULK_IDLE_TIMEOUT seconds after the last one.
+ */
+void link_bulk_mode(void)
+{
+    m_bulk_idle = 0;
+    if (m_bulk_mode || m_conn_handle == BLE_CONN_HANDLE_INVALID) return;
+    m_bulk_mode = true;
+    link_params_update(true);
+}
+
+
 static void advertising_start(void)
 {
     NRF_LOG_INFO("advertising start\n");
@@ -333,6 +395,7 @@ static void on_ble_evt(ble_evt_t * p_ble_evt)
         case BLE_GAP_EVT_DISCONNECTED:
             NRF_LOG_INFO("DISCONNECTED\n");
             m_conn_handle = BLE_CONN_HANDLE_INVALID;
+            m_bulk_mode = false;
 #if !defined(S112)
             advertising_start();
 #endif
@@ -482,6 +545,7 @@ void gatt_evt_handler(nrf_ble_gatt_t * p_gatt, nrf_ble_gatt_evt_t const * p_evt)
     {
         m_epd.max_data_len = p_evt->params.att_mtu_effective - 3;
         NRF_LOG_INFO("Data len is set to 0x%X(%d)", m_epd.max_data_len, m_epd.max_data_len);
+        (void)ble_epd_link_notify(&m_epd);
     }
     NRF_LOG_DEBUG("ATT MTU exchange completed. central 0x%x peripheral 0x%x",
                   p_gatt->att_mtu_desired_central,
@@ -495,21 +559,27 @@ void gatt_init(void)
     APP_ERROR_CHECK(nrf_ble_gatt_init(&m_gatt, gatt_evt_handler));
     APP_ERROR_CHECK(nrf_ble_gatt_att_mtu_periph_set(&m_gatt, NRF_SDH_BLE_GATT_MAX_MTU_SIZE));
 }
-#else
-// Set BW Config to HIGH.
+#endif
+
+// Set BW Config to HIGH, or extend connection events past NRF_SDH_BLE_GAP_EVENT_LENGTH while there is data.
 static void ble_options_set(void)
 {
     ble_opt_t ble_opt;
 
     memset(&ble_opt, 0, sizeof(ble_opt));
 
+#if defined(S112)
+    ble_opt.common_opt.conn_evt_ext.enable = 1;
+
+    APP_ERROR_CHECK(sd_ble_opt_set(BLE_COMMON_OPT_CONN_EVT_EXT, &ble_opt));
+#else
     ble_opt.common_opt.conn_bw.role = BLE_GAP_ROLE_PERIPH;
     ble_opt.common_opt.conn_bw.conn_bw.conn_bw_rx = BLE_CONN_BW_HIGH;
     ble_opt.common_opt.conn_bw.conn_bw.conn_bw_tx = BLE_CONN_BW_HIGH;
 
     APP_ERROR_CHECK(sd_ble_opt_set(BLE_COMMON_OPT_CONN_BW, &ble_opt));
-}
 #endif
+}
 
 /**@brief Function for initializing the Advertising functionality.
  */
@@ -599,8 +669,13 @@ static void power_management_init(void)
  */
 static void idle_state_handle(void)
 {
+    epd_trace_flush();
     if (NRF_LOG_PROCESS() == false)
+    {
+        uint32_t start = epd_perf_idle_start();
         nrf_pwr_mgmt_run();
+        epd_perf_idle_end(start);
+    }
 }
 
 /**@brief Function for application main entry.
@@ -618,9 +693,8 @@ int main(void)
     gap_params_init();
 #if defined(S112)
     gatt_init();
-#else
-    ble_options_set();
 #endif
+    ble_options_set();
     services_init();
     advertising_init();
     conn_params_init();
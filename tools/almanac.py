@@ -0,0 +1,393 @@
+#!/usr/bin/env python3
+"""
+Almanac generator for GUI/almanac.c
+
+Computes the Chinese calendar (lunar new year, month lengths, leap month)
+and the dates of the 24 solar terms for every year of ALMANAC_FIRST_YEAR to
+ALMANAC_LAST_YEAR, and writes them as a compact flash table:
+
+    python3 tools/almanac.py
+    python3 tools/almanac.py --check
+
+The sun is taken from the abridged VSOP87 series and the new moons from
+Meeus, "Astronomical Algorithms" ch. 25/49. Dates are in Beijing time
+(UTC+8) as the published calendar. Events within a few minutes of midnight
+are listed as warnings; the few where the published calendar disagrees with
+the computation are fixed in NEW_MOON_FIXES.
+"""
+import argparse
+import datetime
+import math
+import os
+import sys
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+ALMANAC_C = os.path.join(ROOT, 'GUI', 'almanac.c')
+ALMANAC_H = os.path.join(ROOT, 'GUI', 'almanac.h')
+
+# the year before the first supported year is needed for January dates
+FIRST_YEAR = 1999
+LAST_YEAR = 2199
+
+CLOSE_MINUTES = 3   # warn about events this close to midnight
+
+# Computed Beijing date of a new moon -> date in the published calendar.
+# All of these are less than 3 minutes before midnight.
+NEW_MOON_FIXES = {
+    datetime.date(2057, 9, 28): datetime.date(2057, 9, 29),
+    datetime.date(2089, 9, 4): datetime.date(2089, 9, 5),
+    datetime.date(2097, 8, 7): datetime.date(2097, 8, 8),
+}
+
+EPOCH = datetime.date(1970, 1, 1)
+EPOCH_JD = 2440587.5  # 1970-01-01 00:00 UT
+
+# ---------------------------------------------------------------------------
+# Astronomy
+# ---------------------------------------------------------------------------
+
+# Earth heliocentric longitude and radius, VSOP87 as abridged in Meeus appendix III
+L0 = [(175347046,0,0),(3341656,4.6692568,6283.07585),(34894,4.6261,12566.1517),(3497,2.7441,5753.3849),
+(3418,2.8289,3.5231),(3136,3.6277,77713.7715),(2676,4.4181,7860.4194),(2343,6.1352,3930.2097),(1324,0.7425,11506.7698),
+(1273,2.0371,529.691),(1199,1.1096,1577.3435),(990,5.233,5884.927),(902,2.045,26.298),(857,3.508,398.149),
+(780,1.179,5223.694),(753,2.533,5507.553),(505,4.583,18849.228),(492,4.205,775.523),(357,2.92,0.067),
+(317,5.849,11790.629),(284,1.899,796.298),(271,0.315,10977.079),(243,0.345,5486.778),(206,4.806,2544.314),
+(205,1.869,5573.143),(202,2.458,6069.777),(156,0.833,213.299),(132,3.411,2942.463),(126,1.083,20.775),
+(115,0.645,0.98),(103,0.636,4694.003),(102,0.976,15720.839),(102,4.267,7.114),(99,6.21,2146.17),(98,0.68,155.42),
+(86,5.98,161000.69),(85,1.3,6275.96),(85,3.67,71430.7),(80,1.81,17260.15),(79,3.04,12036.46),(75,1.76,5088.63),
+(74,3.5,3154.69),(74,4.68,801.82),(70,0.83,9437.76),(62,3.98,8827.39),(61,1.82,7084.9),(57,2.78,6286.6),
+(56,4.39,14143.5),(56,3.47,6279.55),(52,0.19,12139.55),(52,1.33,1748.02),(51,0.28,5856.48),(49,0.49,1194.45),
+(41,5.37,8429.24),(41,2.4,19651.05),(39,6.17,10447.39),(37,6.04,10213.29),(37,2.57,1059.38),(36,1.71,2352.87),
+(36,1.78,6812.77),(33,0.59,17789.85),(30,0.44,83996.85),(30,2.74,1349.87),(25,3.16,4690.48)]
+L1 = [(628331966747,0,0),(206059,2.678235,6283.07585),(4303,2.6351,12566.1517),(425,1.59,3.523),(119,5.796,26.298),
+(109,2.966,1577.344),(93,2.59,18849.23),(72,1.14,529.69),(68,1.87,398.15),(67,4.41,5507.55),(59,2.89,5223.69),
+(56,2.17,155.42),(45,0.4,796.3),(36,0.47,775.52),(29,2.65,7.11),(21,5.34,0.98),(19,1.85,5486.78),(19,4.97,213.3),
+(17,2.99,6275.96),(16,0.03,2544.31),(16,1.43,2146.17),(15,1.21,10977.08),(12,2.83,1748.02),(12,3.26,5088.63),
+(12,5.27,1194.45),(12,2.08,4694),(11,0.77,553.57),(10,1.3,6286.6),(10,4.24,1349.87),(9,2.7,242.73),(9,5.64,951.72),
+(8,5.3,2352.87),(6,2.65,9437.76),(6,4.67,4690.48)]
+L2 = [(52919,0,0),(8720,1.0721,6283.0758),(309,0.867,12566.152),(27,0.05,3.52),(16,5.19,26.3),(16,3.68,155.42),
+(10,0.76,18849.23),(9,2.06,77713.77),(7,0.83,775.52),(5,4.66,1577.34),(4,1.03,7.11),(4,3.44,5573.14),(3,5.14,796.3),
+(3,6.05,5507.55),(3,1.19,242.73),(3,6.12,529.69),(3,0.31,398.15),(3,2.28,553.57),(2,4.38,5223.69),(2,3.75,0.98)]
+L3 = [(289,5.844,6283.076),(35,0,0),(17,5.49,12566.15),(3,5.2,155.42),(1,4.72,3.52),(1,5.3,18849.23),(1,5.97,242.73)]
+L4 = [(114,3.142,0),(8,4.13,6283.08),(1,3.84,12566.15)]
+L5 = [(1,3.14,0)]
+R0 = [(100013989,0,0),(1670700,3.0984635,6283.07585),(13956,3.05525,12566.1517),(3084,5.1985,77713.7715),
+(1628,1.1739,5753.3849),(1576,2.8469,7860.4194),(925,5.453,11506.77),(542,4.564,3930.21),(472,3.661,5884.927),
+(346,0.964,5507.553),(329,5.9,5223.694),(307,0.299,5573.143),(243,4.273,11790.629),(212,5.847,1577.344),
+(186,5.022,10977.079),(175,3.012,18849.228),(110,5.055,5486.778),(98,0.89,6069.78),(86,5.69,15720.84),
+(86,1.27,161000.69),(65,0.27,17260.15),(63,0.92,529.69),(57,2.01,83996.85),(56,5.24,71430.7),(49,3.25,2544.31),
+(47,2.58,775.52),(45,5.54,9437.76),(43,6.01,6275.96),(39,5.36,4694),(38,2.39,8827.39),(37,0.83,19651.05),
+(37,4.9,12139.55),(36,1.67,12036.46),(35,1.84,2942.46),(33,0.24,7084.9),(32,0.18,5088.63),(32,1.78,398.15),
+(28,1.21,6286.6),(28,1.9,6279.55),(26,4.59,10447.39)]
+R1 = [(103019,1.10749,6283.07585),(1721,1.0644,12566.1517),(702,3.142,0),(32,1.02,18849.23),(31,2.84,5507.55),
+(25,1.32,5223.69),(18,1.42,1577.34),(10,5.91,10977.08),(9,1.42,6275.96),(9,0.27,5486.78)]
+R2 = [(4359,5.7846,6283.0758),(124,5.579,12566.152),(12,3.14,0),(9,3.63,77713.77),(6,1.87,5573.14),(3,5.47,18849.23)]
+R3 = [(145,4.273,6283.076),(7,3.92,12566.15)]
+R4 = [(4,2.56,6283.08)]
+
+
+def series(terms, t):
+    """Sum of a VSOP87 series, t in Julian millennia."""
+    return sum(a * math.cos(b + c * t) for a, b, c in terms)
+
+
+def sun_longitude(jde):
+    """Apparent geocentric longitude of the sun in degrees."""
+    tau = (jde - 2451545.0) / 365250.0
+    L = (series(L0, tau) + series(L1, tau) * tau + series(L2, tau) * tau**2 + series(L3, tau) * tau**3 +
+         series(L4, tau) * tau**4 + series(L5, tau) * tau**5) / 1e8
+    R = (series(R0, tau) + series(R1, tau) * tau + series(R2, tau) * tau**2 + series(R3, tau) * tau**3 +
+         series(R4, tau) * tau**4) / 1e8
+    lon = math.degrees(L) + 180.0
+    T = tau * 10
+    # FK5 correction
+    lon -= 0.09033 / 3600
+    # nutation in longitude (low precision)
+    om = math.radians(125.04452 - 1934.136261 * T)
+    ls = math.radians(280.4665 + 36000.7698 * T)
+    lm = math.radians(218.3165 + 481267.8813 * T)
+    dpsi = -17.20 * math.sin(om) - 1.32 * math.sin(2 * ls) - 0.23 * math.sin(2 * lm) + 0.21 * math.sin(2 * om)
+    lon += dpsi / 3600
+    # aberration
+    lon -= 20.4898 / 3600 / R
+    return lon % 360.0
+
+
+def delta_t(year):
+    """TT - UT in seconds (Espenak & Meeus)."""
+    if year < 2005:
+        t = year - 2000
+        return 63.86 + 0.3345 * t - 0.060374 * t**2 + 0.0017275 * t**3 + 0.000651814 * t**4 + 0.00002373599 * t**5
+    if year < 2050:
+        t = year - 2000
+        return 62.92 + 0.32217 * t + 0.005589 * t**2
+    u = (year - 1820) / 100
+    if year < 2150:
+        return -20 + 32 * u * u - 0.5628 * (2150 - year)
+    return -20 + 32 * u * u
+
+
+def solar_term(jde, angle):
+    """JDE (TT) when the apparent solar longitude reaches angle, starting from a guess within a few days."""
+    for _ in range(20):
+        d = (angle - sun_longitude(jde) + 180) % 360 - 180
+        jde += d * 365.2422 / 360
+        if abs(d) < 1e-7:
+            break
+    return jde
+
+
+def new_moon(k):
+    """JDE (TT) of new moon number k, 0 is the one of 2000-01-06."""
+    T = k / 1236.85
+    jde = 2451550.09766 + 29.530588861 * k + 0.00015437 * T**2 - 0.000000150 * T**3 + 0.00000000073 * T**4
+    E = 1 - 0.002516 * T - 0.0000074 * T**2
+    r = math.radians
+    M = r(2.5534 + 29.10535670 * k - 0.0000014 * T**2 - 0.00000011 * T**3)
+    Mp = r(201.5643 + 385.81693528 * k + 0.0107582 * T**2 + 0.00001238 * T**3 - 0.000000058 * T**4)
+    F = r(160.7108 + 390.67050284 * k - 0.0016118 * T**2 - 0.00000227 * T**3 + 0.000000011 * T**4)
+    Om = r(124.7746 - 1.56375588 * k + 0.0020672 * T**2 + 0.00000215 * T**3)
+    s = math.sin
+    jde += (-0.40720 * s(Mp) + 0.17241 * E * s(M) + 0.01608 * s(2 * Mp) + 0.01039 * s(2 * F) +
+            0.00739 * E * s(Mp - M) - 0.00514 * E * s(Mp + M) + 0.00208 * E * E * s(2 * M) -
+            0.00111 * s(Mp - 2 * F) - 0.00057 * s(Mp + 2 * F) + 0.00056 * E * s(2 * Mp + M) -
+            0.00042 * s(3 * Mp) + 0.00042 * E * s(M + 2 * F) + 0.00038 * E * s(M - 2 * F) -
+            0.00024 * E * s(2 * Mp - M) - 0.00017 * s(Om) - 0.00007 * s(Mp + 2 * M) +
+            0.00004 * s(2 * Mp - 2 * F) + 0.00004 * s(3 * M) + 0.00003 * s(Mp + M - 2 * F) +
+            0.00003 * s(2 * Mp + 2 * F) - 0.00003 * s(Mp + M + 2 * F) + 0.00003 * s(Mp - M + 2 * F) -
+            0.00002 * s(Mp - M - 2 * F) - 0.00002 * s(3 * Mp + M) + 0.00002 * s(4 * Mp))
+    A = [(299.77, 0.107408, 0.000325), (251.88, 0.016321, 0.000165), (251.83, 26.651886, 0.000164),
+         (349.42, 36.412478, 0.000126), (84.66, 18.206239, 0.000110), (141.74, 53.303771, 0.000062),
+         (207.14, 2.453732, 0.000060), (154.84, 7.306860, 0.000056), (34.52, 27.261239, 0.000047),
+         (207.19, 0.121824, 0.000042), (291.34, 1.844379, 0.000040), (161.72, 24.198154, 0.000037),
+         (239.56, 25.513099, 0.000035), (331.55, 3.592518, 0.000023)]
+    for i, (a, b, c) in enumerate(A):
+        arg = a + b * k - (0.009173 * T * T if i == 0 else 0)
+        jde += c * math.sin(r(arg))
+    return jde
+
+
+def beijing_time(jde):
+    """Days since 1970-01-01 00:00 Beijing time of a TT instant."""
+    year = 2000 + (jde - 2451545.0) / 365.25
+    return jde - delta_t(year) / 86400 + 8 / 24 - EPOCH_JD
+
+
+
+# ---------------------------------------------------------------------------
+# Calendar
+# ---------------------------------------------------------------------------
+
+class AlmanacError(Exception):
+    pass
+
+
+def to_day(date):
+    return (date - EPOCH).days
+
+
+def to_date(day):
+    return EPOCH + datetime.timedelta(days=day)
+
+
+def check_midnight(what, t, notes):
+    minutes = (t - math.floor(t)) * 1440
+    if minutes < CLOSE_MINUTES or minutes > 1440 - CLOSE_MINUTES:
+        hh, mm = divmod(int(minutes), 60)
+        notes.append('%s %s %02d:%02d' % (what, to_date(math.floor(t)), hh, mm))
+
+
+def solar_terms(year, notes):
+    """Beijing dates (days since 1970) of the 24 solar terms of a year, 小寒 first."""
+    out = []
+    for i in range(24):
+        guess = datetime.date(year, i // 2 + 1, 5 if i % 2 == 0 else 20)
+        angle = (285 + 15 * i) % 360
+        t = beijing_time(solar_term(EPOCH_JD + to_day(guess), angle))
+        if abs(t - to_day(guess)) > 5:
+            raise AlmanacError('solar term %d of %d did not converge' % (i, year))
+        check_midnight('solar term %d' % i, t, notes)
+        out.append(math.floor(t))
+    return out
+
+
+def new_moons(first, last, notes):
+    """Beijing dates of all new moons from the year before first to the year after last."""
+    out = []
+    k = math.floor((first - 1 - 2000) * 12.3685)
+    while True:
+        t = beijing_time(new_moon(k))
+        day = math.floor(t)
+        fixed = NEW_MOON_FIXES.get(to_date(day))
+        if fixed is not None:
+            day = to_day(fixed)
+        else:
+            check_midnight('new moon', t, notes)
+        out.append(day)
+        if to_date(day).year > last + 1:
+            return out
+        k += 1
+
+
+def lunar_months(terms, moons, first, last):
+    """(start day, month number, leap) of every lunar month from month 11 of first - 1."""
+    zhongqi = sorted(t[i] for t in terms.values() for i in range(1, 24, 2))
+
+    def month11(year):
+        # the month containing the winter solstice (冬至) is month 11
+        return max(m for m in moons if m <= terms[year][23])
+
+    months = []
+    for year in range(first - 1, last + 1):
+        start, end = month11(year), month11(year + 1)
+        suei = [i for i, m in enumerate(moons) if start <= m < end]
+        leap = None
+        if len(suei) == 13:
+            # the first month without a major solar term (中气) is the leap month
+            for i in suei:
+                if not any(moons[i] <= z < moons[i + 1] for z in zhongqi):
+                    leap = i
+                    break
+            if leap is None:
+                raise AlmanacError('no leap month found after %d' % year)
+        number = 11
+        for i in suei:
+            if i == leap:
+                months.append((moons[i], number, True))
+                continue
+            if i != suei[0]:
+                number = number % 12 + 1
+            months.append((moons[i], number, False))
+    months.append((month11(last + 1), 11, False))
+    return months
+
+
+def lunar_years(months, first, last):
+    """{year: (month bits, leap month, new year day)} for the lunar years starting in first..last."""
+    years = {}
+    for i, (start, number, leap) in enumerate(months):
+        if number != 1 or leap or not first <= to_date(start).year <= last:
+            continue
+        bits, leap_month, n = 0, 0, 0
+        while True:
+            length = months[i + n + 1][0] - months[i + n][0]
+            if length not in (29, 30):
+                raise AlmanacError('lunar month of %d days at %s' % (length, to_date(months[i + n][0])))
+            if length == 30:
+                bits |= 1 << (12 - n)
+            if months[i + n][2]:
+                leap_month = months[i + n][1]
+            n += 1
+            if months[i + n][1] == 1 and not months[i + n][2]:
+                break
+        years[to_date(start).year] = (bits, leap_month, start)
+    return years
+
+
+def generate(first=FIRST_YEAR, last=LAST_YEAR):
+    """Returns the text of almanac.h and almanac.c, and the events close to midnight."""
+    notes = []
+    terms = {y: solar_terms(y, notes) for y in range(first - 1, last + 2)}
+    moons = new_moons(first, last, notes)
+    years = lunar_years(lunar_months(terms, moons, first, last), first, last)
+
+    base = [min(to_date(terms[y][i]).day for y in range(first, last + 1)) for i in range(24)]
+    rows = []
+    for y in range(first, last + 1):
+        if y not in years:
+            raise AlmanacError('no lunar new year in %d' % y)
+        bits, leap, start = years[y]
+        new_year = start - to_day(datetime.date(y, 1, 1))
+        packed = [0] * 6
+        for i in range(24):
+            delta = to_date(terms[y][i]).day - base[i]
+            if delta > 3:
+                raise AlmanacError('solar term %d of %d out of range' % (i, y))
+            packed[i // 4] |= delta << (i % 4 * 2)
+        rows.append('    {0x%04X, %2d, %2d, {%s}}, // %d' %
+                    (bits, leap, new_year, ', '.join('0x%02X' % b for b in packed), y))
+
+    header = HEADER_TEMPLATE % (first, last)
+    source = SOURCE_TEMPLATE % (', '.join('%d' % d for d in base), '\n'.join(rows))
+    return header, source, notes
+
+
+HEADER_TEMPLATE = '''\
+// Generated by tools/almanac.py, do not edit.
+#ifndef __ALMANAC_H
+#define __ALMANAC_H
+
+#include <stdint.h>
+
+#define ALMANAC_FIRST_YEAR %d
+#define ALMANAC_LAST_YEAR  %d
+
+/**
+ * 一个公历年的农历和节气数据
+ *
+ * months:   春节在本年的农历年各月大小, bit12 为正月, 1 为大月(30天), 闰月紧跟在同名月之后
+ * leap:     闰月月份, 0 为无闰月
+ * new_year: 春节是本年的第几天, 1月1日为 0
+ * jieqi:    24节气的日期, 第 i 个节气(小寒为 0)在 i / 2 + 1 月的
+ *           almanac_jieqi_base[i] + ((jieqi[i / 4] >> (i %% 4 * 2)) & 3) 日
+ */
+typedef struct
+{
+    uint16_t months;
+    uint8_t leap;
+    uint8_t new_year;
+    uint8_t jieqi[6];
+} almanac_year_t;
+
+extern const uint8_t almanac_jieqi_base[24];
+extern const almanac_year_t almanac[ALMANAC_LAST_YEAR - ALMANAC_FIRST_YEAR + 1];
+
+#endif
+'''
+
+SOURCE_TEMPLATE = '''\
+// Generated by tools/almanac.py, do not edit.
+#include "almanac.h"
+
+const uint8_t almanac_jieqi_base[24] = {%s};
+
+const almanac_year_t almanac[ALMANAC_LAST_YEAR - ALMANAC_FIRST_YEAR + 1] = {
+%s
+};
+'''
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--check', action='store_true', help='fail if GUI/almanac.c is out of date')
+    parser.add_argument('-v', '--verbose', action='store_true', help='list events close to midnight')
+    args = parser.parse_args()
+
+    try:
+        header, source, notes = generate()
+    except AlmanacError as e:
+        print('almanac: %s' % e, file=sys.stderr)
+        return 1
+
+    if args.verbose:
+        for note in notes:
+            print('almanac: close to midnight: %s' % note, file=sys.stderr)
+
+    outputs = [(ALMANAC_H, header), (ALMANAC_C, source)]
+    if args.check:
+        for path, text in outputs:
+            current = open(path, encoding='utf-8').read() if os.path.exists(path) else ''
+            if current != text:
+                print('almanac: %s is out of date, run tools/almanac.py' % os.path.relpath(path, ROOT),
+                      file=sys.stderr)
+                return 1
+        return 0
+
+    for path, text in outputs:
+        with open(path, 'w', encoding='utf-8', newline='\n') as f:
+            f.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,434 @@
+/*
+ * Host test for the QR code and Code 128 primitives in GUI/barcode.c and
+ * the byte wise rectangle fill of GUI/Adafruit_GFX.c they draw with
+ *
+ * QR codes are read back like a scanner would: function patterns, the
+ * format information against the table of the standard, the codewords in
+ * placement order, the Reed-Solomon syndromes of every block and the byte
+ * mode payload. Code 128 symbols are checked against known encodings and
+ * read back from the drawn bars.
+ *
+ *     make -C tools test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "barcode.h"
+
+int gui_page_height = 16;
+
+static int failures;
+
+#define CHECK(cond, ...)                        \
+    do {                                        \
+        if (!(cond)) {                          \
+            if (failures++ < 20) {              \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+                printf(__VA_ARGS__);            \
+                printf("\n");                   \
+            }                                   \
+        }                                       \
+    } while (0)
+
+/******************************************************************************
+ * Frame buffer, one byte per pixel: 0 white, 1 black, 2 red
+ ******************************************************************************/
+#define FB_W 320
+#define FB_H 120
+
+static uint8_t fb[FB_H][FB_W];
+
+static void fb_page(uint8_t *black, uint8_t *color, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    uint16_t stride = (w + 7) / 8;
+    for (uint16_t j = 0; j < h; j++) {
+        for (uint16_t i = 0; i < w; i++) {
+            uint8_t bit = 0x80 >> (i & 7);
+            uint16_t k = j * stride + i / 8;
+            fb[y + j][x + i] = !(black[k] & bit) ? 1 : (color && !(color[k] & bit)) ? 2 : 0;
+        }
+    }
+}
+
+typedef void (*draw_t)(Adafruit_GFX *gfx, void *arg);
+
+// draws into the window page by page like DrawGUI, the rest of fb keeps its content
+static void render(draw_t draw, void *arg, bool bwr, int16_t x, int16_t y, int16_t w, int16_t h, int16_t page)
+{
+    Adafruit_GFX gfx;
+    if (bwr)
+        GFX_begin_3c(&gfx, FB_W, FB_H, page * 2);
+    else
+        GFX_begin(&gfx, FB_W, FB_H, page);
+    GFX_setWindow(&gfx, x, y, w, h);
+    GFX_firstPage(&gfx);
+    do {
+        draw(&gfx, arg);
+    } while (GFX_nextPage(&gfx, fb_page));
+    GFX_end(&gfx);
+}
+
+/******************************************************************************
+ * Rectangle fill
+ ******************************************************************************/
+typedef struct {
+    int16_t x, y, w, h;
+    uint16_t color;
+} rect_t;
+
+static void draw_fill(Adafruit_GFX *gfx, void *arg)
+{
+    rect_t *r = arg;
+    GFX_fillRect(gfx, r->x, r->y, r->w, r->h, r->color);
+}
+
+static void draw_pixels(Adafruit_GFX *gfx, void *arg)
+{
+    rect_t *r = arg;
+    for (int16_t j = r->y; j < r->y + r->h; j++) {
+        for (int16_t i = r->x; i < r->x + r->w; i++)
+            GFX_drawPixel(gfx, i, j, r->color);
+    }
+}
+
+// the byte wise fill sets exactly the pixels GFX_drawPixel would, in any window and page
+static void test_fill(void)
+{
+    static const uint16_t colors[] = {GFX_BLACK, GFX_WHITE, GFX_RED};
+    static uint8_t expected[FB_H][FB_W];
+
+    srand(1);
+    for (int n = 0; n < 2000; n++) {
+        rect_t r = {rand() % 360 - 20, rand() % 150 - 15, rand() % 120, rand() % 60, colors[rand() % 3]};
+        int16_t wx = rand() % FB_W, wy = rand() % FB_H;
+        int16_t ww = 1 + rand() % (FB_W - wx), wh = 1 + rand() % (FB_H - wy), page = 1 + rand() % 20;
+        bool bwr = rand() % 2;
+
+        memset(fb, 0, sizeof(fb));
+        render(draw_pixels, &r, bwr, wx, wy, ww, wh, page);
+        memcpy(expected, fb, sizeof(fb));
+        memset(fb, 0, sizeof(fb));
+        render(draw_fill, &r, bwr, wx, wy, ww, wh, page);
+        CHECK(memcmp(expected, fb, sizeof(fb)) == 0, "fill %d,%d %dx%d color %04x, window %d,%d %dx%d, page %d%s",
+              r.x, r.y, r.w, r.h, r.color, wx, wy, ww, wh, page, bwr ? ", bwr" : "");
+    }
+}
+
+/******************************************************************************
+ * QR code
+ ******************************************************************************/
+static uint8_t gf_exp[512], gf_log[256];
+
+static void gf_init(void)
+{
+    uint16_t x = 1;
+    for (int i = 0; i < 255; i++) {
+        gf_exp[i] = gf_exp[i + 255] = x;
+        gf_log[x] = i;
+        x <<= 1;
+        if (x & 0x100) x ^= 0x11D;
+    }
+}
+
+static uint8_t gf_mul(uint8_t a, uint8_t b)
+{
+    return a && b ? gf_exp[gf_log[a] + gf_log[b]] : 0;
+}
+
+// format information of the standard (ISO/IEC 18004 table C.1), by level L/M and mask
+static const uint16_t format_table[2][8] = {
+    {0x77C4, 0x72F3, 0x7DAA, 0x789D, 0x662F, 0x6318, 0x6C41, 0x6976},
+    {0x5412, 0x5125, 0x5E7C, 0x5B4B, 0x45F9, 0x40CE, 0x4F97, 0x4AA0},
+};
+
+// codewords, EC codewords per block and blocks of versions 1-6, L and M
+static const uint8_t ec_table[6][2][3] = {
+    {{26, 7, 1}, {26, 10, 1}},   {{44, 10, 1}, {44, 16, 1}},  {{70, 15, 1}, {70, 26, 1}},
+    {{100, 20, 1}, {100, 18, 2}}, {{134, 26, 1}, {134, 24, 2}}, {{172, 18, 2}, {172, 16, 4}},
+};
+
+static bool reserved(uint8_t size, uint8_t x, uint8_t y)
+{
+    uint8_t a = size - 7;
+    if (x <= 7 && y <= 7) return true;                  // finders with separators
+    if (x >= size - 8 && y <= 7) return true;
+    if (x <= 7 && y >= size - 8) return true;
+    if ((y == 8 && (x <= 8 || x >= size - 8)) || (x == 8 && (y <= 8 || y >= size - 8))) return true; // format
+    if (x == 6 || y == 6) return true;                  // timing
+    if (size > 21 && abs(x - a) <= 2 && abs(y - a) <= 2) return true; // alignment
+    return false;
+}
+
+static bool mask_bit(uint8_t mask, int i, int j) // i row, j column
+{
+    switch (mask) {
+        case 0: return (i + j) % 2 == 0;
+        case 1: return i % 2 == 0;
+        case 2: return j % 3 == 0;
+        case 3: return (i + j) % 3 == 0;
+        case 4: return (i / 2 + j / 3) % 2 == 0;
+        case 5: return (i * j) % 2 + (i * j) % 3 == 0;
+        case 6: return ((i * j) % 2 + (i * j) % 3) % 2 == 0;
+        default: return ((i + j) % 2 + (i * j) % 3) % 2 == 0;
+    }
+}
+
+static bool finder_ok(const qr_code_t *qr, int cx, int cy)
+{
+    for (int dy = -3; dy <= 3; dy++) {
+        for (int dx = -3; dx <= 3; dx++) {
+            int d = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+            if (QR_GetModule(qr, cx + dx, cy + dy) != (d != 2)) return false;
+        }
+    }
+    return true;
+}
+
+static void check_qr(const qr_code_t *qr, const uint8_t *data, int len, qr_ecc_t ecc)
+{
+    uint8_t size = qr->size, version = (size - 17) / 4;
+    uint8_t codewords[172];
+
+    CHECK(version == QR_Version(len, ecc) && size == QR_SIZE(version), "qr len %d: size %d", len, size);
+    if (version < 1 || version > 6) return;
+
+    CHECK(finder_ok(qr, 3, 3) && finder_ok(qr, size - 4, 3) && finder_ok(qr, 3, size - 4),
+          "qr len %d: finder patterns", len);
+    for (int i = 8; i < size - 8; i++)
+        CHECK(QR_GetModule(qr, i, 6) == (i % 2 == 0) && QR_GetModule(qr, 6, i) == (i % 2 == 0),
+              "qr len %d: timing at %d", len, i);
+    CHECK(QR_GetModule(qr, 8, size - 8), "qr len %d: dark module", len);
+
+    // both copies of the format information
+    uint16_t f1 = 0, f2 = 0;
+    for (int i = 0; i < 15; i++) {
+        int x1 = i < 6 ? 8 : i < 8 ? 8 : i == 8 ? 7 : 14 - i, y1 = i < 6 ? i : i < 8 ? i + 1 : 8;
+        int x2 = i < 8 ? size - 1 - i : 8, y2 = i < 8 ? 8 : size - 15 + i;
+        f1 |= QR_GetModule(qr, x1, y1) << i;
+        f2 |= QR_GetModule(qr, x2, y2) << i;
+    }
+    int mask = -1;
+    for (int m = 0; m < 8; m++) {
+        if (format_table[ecc][m] == f1) mask = m;
+    }
+    CHECK(mask >= 0 && f1 == f2, "qr len %d: format information %04x %04x", len, f1, f2);
+    if (mask < 0) return;
+
+    // codewords: column pairs from the right, the direction turns at the edges
+    int bit = 0, total = ec_table[version - 1][ecc][0];
+    bool up = true;
+    memset(codewords, 0, sizeof(codewords));
+    for (int col = size - 1; col > 0; col -= 2, up = !up) {
+        if (col == 6) col = 5;
+        for (int k = 0; k < size; k++) {
+            int y = up ? size - 1 - k : k;
+            for (int x = col; x >= col - 1; x--) {
+                if (reserved(size, x, y)) continue;
+                if (bit < total * 8 && QR_GetModule(qr, x, y) ^ mask_bit(mask, y, x))
+                    codewords[bit / 8] |= 0x80 >> (bit % 8);
+                bit++;
+            }
+        }
+    }
+    CHECK(bit >= total * 8 && bit - total * 8 < 8, "qr len %d: %d data modules", len, bit);
+
+    int ec = ec_table[version - 1][ecc][1], blocks = ec_table[version - 1][ecc][2];
+    int dc = total - ec * blocks, per = dc / blocks;
+    uint8_t stream[172];
+    for (int b = 0; b < blocks; b++) {
+        uint8_t block[172];
+        for (int i = 0; i < per; i++)
+            block[i] = stream[b * per + i] = codewords[i * blocks + b];
+        for (int i = 0; i < ec; i++)
+            block[per + i] = codewords[dc + i * blocks + b];
+        for (int r = 0; r < ec; r++) {
+            uint8_t s = 0;
+            for (int i = 0; i < per + ec; i++)
+                s = gf_mul(s, gf_exp[r]) ^ block[i];
+            CHECK(s == 0, "qr len %d: block %d syndrome %d", len, b, r);
+        }
+    }
+
+    // byte mode, count, data, terminator, pad codewords
+    CHECK(stream[0] >> 4 == 4 && ((stream[0] & 0x0F) << 4 | stream[1] >> 4) == len, "qr len %d: header", len);
+    for (int i = 0; i < len; i++)
+        CHECK(((stream[i + 1] & 0x0F) << 4 | stream[i + 2] >> 4) == data[i], "qr len %d: byte %d", len, i);
+    CHECK((stream[len + 1] & 0x0F) == 0, "qr len %d: terminator", len);
+    for (int i = len + 2; i < dc; i++)
+        CHECK(stream[i] == ((i - len) % 2 ? 0x11 : 0xEC), "qr len %d: pad %d", len, i);
+}
+
+static void test_qr(void)
+{
+    static const struct {
+        uint16_t len;
+        qr_ecc_t ecc;
+        uint8_t version;
+    } capacity[] = {
+        {0, QR_ECC_L, 1}, {17, QR_ECC_L, 1}, {18, QR_ECC_L, 2}, {32, QR_ECC_L, 2}, {33, QR_ECC_L, 3},
+        {134, QR_ECC_L, 6}, {135, QR_ECC_L, 0}, {14, QR_ECC_M, 1}, {15, QR_ECC_M, 2}, {62, QR_ECC_M, 4},
+        {63, QR_ECC_M, 5}, {106, QR_ECC_M, 6}, {107, QR_ECC_M, 0},
+    };
+    uint8_t data[140];
+    qr_code_t qr;
+
+    for (size_t i = 0; i < sizeof(capacity) / sizeof(capacity[0]); i++)
+        CHECK(QR_Version(capacity[i].len, capacity[i].ecc) == capacity[i].version,
+              "qr capacity of %d bytes, level %d", capacity[i].len, capacity[i].ecc);
+
+    srand(2);
+    for (int len = 0; len <= 134; len++) {
+        for (int ecc = QR_ECC_L; ecc <= QR_ECC_M; ecc++) {
+            for (int i = 0; i < len; i++)
+                data[i] = len % 3 ? rand() : "https://example.com/p/"[i % 22];
+            bool ok = QR_Encode(&qr, data, len, ecc);
+            CHECK(ok == (QR_Version(len, ecc) != 0), "qr len %d level %d: encoded %d", len, ecc, ok);
+            if (ok)
+                check_qr(&qr, data, len, ecc);
+        }
+    }
+}
+
+typedef struct {
+    int16_t x, y;
+    uint8_t scale;
+    const char *text;
+    qr_ecc_t ecc;
+} qr_draw_t;
+
+static void draw_qr(Adafruit_GFX *gfx, void *arg)
+{
+    qr_draw_t *q = arg;
+    GFX_drawQRCode(gfx, q->x, q->y, q->scale, (const uint8_t *)q->text, strlen(q->text), q->ecc, GFX_RED);
+}
+
+// every module a scale x scale square, the same code after another one was drawn
+static void test_qr_draw(void)
+{
+    qr_draw_t draws[] = {
+        {5, 7, 3, "https://example.com/p/1299", QR_ECC_M},
+        {-4, 2, 2, "SKU 4006381333931", QR_ECC_L},
+        {5, 7, 3, "https://example.com/p/1299", QR_ECC_M},
+    };
+    qr_code_t qr;
+
+    for (size_t n = 0; n < sizeof(draws) / sizeof(draws[0]); n++) {
+        qr_draw_t *q = &draws[n];
+        QR_Encode(&qr, (const uint8_t *)q->text, strlen(q->text), q->ecc);
+        memset(fb, 0, sizeof(fb));
+        render(draw_qr, q, true, 0, 0, FB_W, FB_H, 13);
+        int wrong = 0;
+        for (int y = 0; y < FB_H; y++) {
+            for (int x = 0; x < FB_W; x++) {
+                int mx = (x - q->x) / q->scale, my = (y - q->y) / q->scale;
+                bool inside = x >= q->x && y >= q->y && mx < qr.size && my < qr.size;
+                wrong += fb[y][x] != (inside && QR_GetModule(&qr, mx, my) ? 2 : 0);
+            }
+        }
+        CHECK(wrong == 0, "qr draw %zu: %d wrong pixels", n, wrong);
+    }
+}
+
+/******************************************************************************
+ * Code 128
+ ******************************************************************************/
+static void test_code128(void)
+{
+    static const struct {
+        const char *text;
+        uint8_t count;
+        uint8_t symbols[16];
+    } cases[] = {
+        {"PJJ123C", 10, {104, 48, 42, 42, 17, 18, 19, 35, 55, 106}},
+        {"1234567890", 8, {105, 12, 34, 56, 78, 90, 85, 106}},
+        {"12", 4, {105, 12, 14, 106}},
+        {"123", 6, {104, 17, 18, 19, 8, 106}},
+        {"12345", 7, {105, 12, 34, 100, 21, 54, 106}},
+        {"AB123456", 9, {104, 33, 34, 99, 12, 34, 56, 26, 106}},
+        {"A1234567B", 11, {104, 33, 17, 99, 23, 45, 67, 100, 34, 99, 106}},
+    };
+    uint8_t symbols[CODE128_MAX_SYMBOLS];
+
+    // 3 bars and 3 spaces of 1-4 modules, 11 modules, an even number of bar modules
+    for (int s = 0; s < 106; s++) {
+        uint16_t p = CODE128_Pattern(s);
+        int runs = 0, bars = 0;
+        for (int b = 10; b >= 0; b--) {
+            runs += b == 10 || ((p >> b) & 1) != ((p >> (b + 1)) & 1);
+            bars += (p >> b) & 1;
+        }
+        CHECK(p >> 10 == 1 && (p & 1) == 0 && runs == 6 && bars % 2 == 0, "code128 pattern %d: %03x", s, p);
+        for (int t = 0; t < s; t++)
+            CHECK(CODE128_Pattern(t) != p, "code128 pattern %d equals %d", s, t);
+    }
+    CHECK(CODE128_Pattern(0) == 0x6CC && CODE128_Pattern(33) == 0x518 && CODE128_Pattern(104) == 0x690 &&
+          CODE128_Pattern(106) == 0x18EB, "code128 known patterns");
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint8_t count = CODE128_Encode((const uint8_t *)cases[i].text, strlen(cases[i].text), symbols);
+        CHECK(count == cases[i].count && memcmp(symbols, cases[i].symbols, count) == 0,
+              "code128 \"%s\": %d symbols", cases[i].text, count);
+    }
+    CHECK(CODE128_Encode((const uint8_t *)"\x1F", 1, symbols) == 0 &&
+          CODE128_Encode((const uint8_t *)"\xE5\xB9\xB4", 3, symbols) == 0 &&
+          CODE128_Encode((const uint8_t *)"", 0, symbols) == 0, "code128 unsupported text encoded");
+}
+
+typedef struct {
+    int16_t x, y;
+    uint8_t module;
+    int16_t h;
+    const char *text;
+} code128_draw_t;
+
+static void draw_code128(Adafruit_GFX *gfx, void *arg)
+{
+    code128_draw_t *c = arg;
+    GFX_drawCode128(gfx, c->x, c->y, c->module, c->h, (const uint8_t *)c->text, strlen(c->text), GFX_BLACK);
+}
+
+// the bars read back from the drawn rows are the patterns of the symbols
+static void test_code128_draw(void)
+{
+    code128_draw_t c = {3, 20, 2, 50, "Tag 8901234567"};
+    uint8_t symbols[CODE128_MAX_SYMBOLS];
+    uint8_t count = CODE128_Encode((const uint8_t *)c.text, strlen(c.text), symbols);
+    int modules = CODE128_MODULES(count);
+
+    memset(fb, 0, sizeof(fb));
+    if (modules * c.module + c.x > FB_W) {
+        CHECK(false, "code128 draw: %d modules do not fit", modules);
+        return;
+    }
+    render(draw_code128, &c, false, 0, 0, FB_W, FB_H, 7);
+    for (int y = 0; y < FB_H; y++) {
+        int m = 0, wrong = 0;
+        for (int s = 0; s < count; s++) {
+            int bits = symbols[s] == 106 ? 13 : 11;
+            for (int b = bits - 1; b >= 0; b--, m++) {
+                bool bar = y >= c.y && y < c.y + c.h && ((CODE128_Pattern(symbols[s]) >> b) & 1);
+                for (int k = 0; k < c.module; k++)
+                    wrong += fb[y][c.x + m * c.module + k] != bar;
+            }
+        }
+        for (int x = 0; x < FB_W; x++)
+            wrong += (x < c.x || x >= c.x + modules * c.module) && fb[y][x] != 0;
+        CHECK(wrong == 0, "code128 draw: %d wrong pixels in row %d", wrong, y);
+    }
+}
+
+int main(void)
+{
+    gf_init();
+    test_fill();
+    test_qr();
+    test_qr_draw();
+    test_code128();
+    test_code128_draw();
+    if (failures) {
+        printf("%d barcode checks failed\n", failures);
+        return 1;
+    }
+    printf("barcodes OK\n");
+    return 0;
+}
@@ -0,0 +1,2381 @@
+/*
+ * Host harness for the BLE command layer
+ *
+ * EPD/EPD_service.c and EPD_config.c are built unchanged (SDK 12 variant)
+ * against the stand-ins in tools/hal. The SoftDevice, FDS, the scheduler and
+ * the font store are implemented below, the EPD drivers run on the controller
+ * models of epd_sim.c. GATT writes are fed through ble_epd_on_ble_evt() like
+ * the SoftDevice does, the scheduler runs after each write like the main
+ * loop and executes the buffered write. Every write is accounted to its command: host time, simulated time
+ * on the device (SPI, delays and BUSY), panel bytes, flash operations and
+ * notifications.
+ *
+ * Without arguments the built-in sequences are run and checked:
+ *   - the web tool's image upload (EPD_CMD_WRITE_IMAGE, raw and PackBits
+ *     compressed) for every model at ATT MTU 23 (S130) and 247 (S112), the
+ *     panel must show the image
+ *   - region writes of an edited image and a region refresh
+ *   - clock and calendar updates through EPD_CMD_SET_TIME
+ *   - the link info notification and the bulk mode requests of uploads
+ *   - writes buffered while the main loop is busy, executed in order
+ *   - a display list drawn by the tag, an edit of it and the copy in flash
+ *   - a template with slots, a slot update redrawing only its slot
+ *   - an upload paced by flow control credits, with notifications failing
+ *     for a third of it
+ *   - a font pack upload with its notifications
+ *   - malformed writes, each on a freshly booted tag, against the expected
+ *     behavior
+ *   - the phase timing of the perf characteristic, read like the web tool
+ *   - the event trace, read from the trace characteristic and from RTT
+ *
+ * With files, each line is one write to the EPD characteristic as hex, so the
+ * log of the web tool can be replayed (timestamps and arrows are skipped).
+ * -t saves the event trace as streamed to RTT, for tools/trace_decode.py.
+ *
+ *     make -C tools test
+ *     tools/ble_harness -m 247 -d 3 -t trace.bin upload.log
+ *     make -C tools -B ble_harness CFLAGS="-g -O1 -I../GUI -fsanitize=address,undefined"
+ */
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "EPD_service.h"
+#include "EPD_perf.h"
+#include "EPD_trace.h"
+#include "app_scheduler.h"
+#include "fds.h"
+#include "GUI.h"
+#include "Lunar.h"
+#include "barcode.h"
+#include "fonts.h"
+#include "epd_sim.h"
+
+int gui_page_height = NRF51_PAGE_HEIGHT;
+uint16_t hal_att_mtu = 23;
+
+static int failures;
+
+#define CHECK(cond, ...)                        \
+    do {                                        \
+        if (!(cond)) {                          \
+            printf("FAIL ");                    \
+            printf(__VA_ARGS__);                \
+            printf("\n");                       \
+            failures++;                         \
+        }                                       \
+    } while (0)
+
+/******************************************************************************
+ * SoftDevice stand-in
+ ******************************************************************************/
+#define SD_MAX_CHARS 5
+
+typedef struct {
+    ble_gatts_char_handles_t handles;
+    uint16_t max_len;
+    bool is_var_len;
+    bool writable;
+    bool deferred_read;
+    uint16_t len;
+    uint8_t value[256];
+    uint8_t *user_value;    // BLE_GATTS_VLOC_USER
+} sd_char_t;
+
+static struct {
+    uint16_t last_handle;
+    sd_char_t chars[SD_MAX_CHARS];
+    uint8_t char_count;
+    uint32_t notifications;
+    uint8_t notify_data[256];
+    uint16_t notify_len;
+    struct {
+        uint8_t data[256];
+        uint16_t len;
+    } notify_log[4];           // the first notifications since boot
+    bool tx_full;              // notifications fail for want of TX buffers
+    sd_char_t *authorizing;    // read waiting for sd_ble_gatts_rw_authorize_reply()
+    bool authorized;
+} m_sd;
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const *p_vs_uuid, uint8_t *p_uuid_type)
+{
+    *p_uuid_type = BLE_UUID_TYPE_VENDOR_BEGIN;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const *p_uuid, uint16_t *p_handle)
+{
+    *p_handle = ++m_sd.last_handle;
+    return NRF_SUCCESS;
+}
+
+uint32_t characteristic_add(uint16_t service_handle, ble_add_char_params_t *p_char_props,
+                            ble_gatts_char_handles_t *p_char_handle)
+{
+    if (m_sd.char_count == SD_MAX_CHARS) return NRF_ERROR_NO_MEM;
+    if (p_char_props->init_len > p_char_props->max_len) return NRF_ERROR_INVALID_PARAM;
+
+    sd_char_t *c = &m_sd.chars[m_sd.char_count++];
+    memset(c, 0, sizeof(sd_char_t));
+    m_sd.last_handle++; // declaration
+    c->handles.value_handle = ++m_sd.last_handle;
+    if (p_char_props->char_props.notify || p_char_props->char_props.indicate)
+        c->handles.cccd_handle = ++m_sd.last_handle;
+    c->max_len = p_char_props->max_len;
+    c->is_var_len = p_char_props->is_var_len;
+    c->writable = p_char_props->char_props.write || p_char_props->char_props.write_wo_resp;
+    c->deferred_read = p_char_props->is_defered_read;
+    c->len = p_char_props->init_len;
+    if (p_char_props->is_value_user)
+        c->user_value = p_char_props->p_init_value;
+    else if (p_char_props->p_init_value)
+        memcpy(c->value, p_char_props->p_init_value, c->len);
+    *p_char_handle = c->handles;
+    return NRF_SUCCESS;
+}
+
+bool ble_srv_is_notification_enabled(uint8_t const *p_encoded_data)
+{
+    return (p_encoded_data[0] | (p_encoded_data[1] << 8)) & BLE_GATT_HVX_NOTIFICATION_ENABLED;
+}
+
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const *p_hvx_params)
+{
+    if (*p_hvx_params->p_len > hal_att_mtu - 3) return NRF_ERROR_INVALID_PARAM;
+    if (m_sd.tx_full) return BLE_ERROR_NO_TX_PACKETS;
+    m_sd.notify_len = *p_hvx_params->p_len;
+    memcpy(m_sd.notify_data, p_hvx_params->p_data, m_sd.notify_len);
+    if (m_sd.notifications < 4) {
+        m_sd.notify_log[m_sd.notifications].len = m_sd.notify_len;
+        memcpy(m_sd.notify_log[m_sd.notifications].data, p_hvx_params->p_data, m_sd.notify_len);
+    }
+    m_sd.notifications++;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_rw_authorize_reply(uint16_t conn_handle,
+                                         ble_gatts_rw_authorize_reply_params_t const *p_rw_authorize_reply_params)
+{
+    const ble_gatts_authorize_params_t *p = &p_rw_authorize_reply_params->params.read;
+    sd_char_t *c = m_sd.authorizing;
+
+    if (c == NULL || p_rw_authorize_reply_params->type != BLE_GATTS_AUTHORIZE_TYPE_READ)
+        return NRF_ERROR_INVALID_STATE;
+    if (p->update) {
+        if (p->offset + p->len > c->max_len) return NRF_ERROR_INVALID_PARAM;
+        memcpy((c->user_value ? c->user_value : c->value) + p->offset, p->p_data, p->len);
+        c->len = p->offset + p->len;
+    }
+    m_sd.authorizing = NULL;
+    m_sd.authorized = true;
+    return NRF_SUCCESS;
+}
+
+/******************************************************************************
+ * FDS stand-in, writes are queued and done by fds_process() from the main loop,
+ * reading the caller's data only then as the SDK does
+ ******************************************************************************/
+#define FDS_MAX_RECORDS 4
+#define FDS_MAX_WORDS   (sizeof(epd_list_t) / 4)
+#define FDS_MAX_CHUNKS  2
+#define FDS_QUEUE_SIZE  4
+
+static struct {
+    fds_cb_t cb;
+    uint32_t record_id;
+    uint32_t ops;   // writes, updates and deletes, each one costs flash wear
+    bool hold;      // queued operations wait, as while the radio keeps the flash busy
+    bool full;      // writes are refused until garbage collection ran
+    struct {
+        bool used;
+        fds_header_t header;
+        uint32_t data[FDS_MAX_WORDS];
+    } records[FDS_MAX_RECORDS];
+    struct {
+        fds_evt_id_t id;
+        uint16_t file_id;
+        uint16_t key;
+        uint32_t record_id;
+        uint32_t old_id;
+        fds_record_chunk_t chunks[FDS_MAX_CHUNKS];
+        uint16_t num_chunks;
+    } queue[FDS_QUEUE_SIZE];
+    uint8_t queued;
+} m_fds;
+
+static void fds_evt(fds_evt_id_t id, ret_code_t result)
+{
+    fds_evt_t evt = {id, result};
+    if (m_fds.cb) m_fds.cb(&evt);
+}
+
+ret_code_t fds_register(fds_cb_t cb)
+{
+    m_fds.cb = cb;
+    return NRF_SUCCESS;
+}
+
+ret_code_t fds_init(void)
+{
+    fds_evt(FDS_EVT_INIT, NRF_SUCCESS);
+    return NRF_SUCCESS;
+}
+
+ret_code_t fds_record_find(uint16_t file_id, uint16_t record_key, fds_record_desc_t *p_desc, fds_find_token_t *p_token)
+{
+    for (uint16_t i = p_token->page; i < FDS_MAX_RECORDS; i++) {
+        if (m_fds.records[i].used && m_fds.records[i].header.ic.file_id == file_id &&
+            m_fds.records[i].header.tl.record_key == record_key) {
+            p_token->page = i + 1;
+            memset(p_desc, 0, sizeof(fds_record_desc_t));
+            p_desc->record_id = m_fds.records[i].header.record_id;
+            p_desc->p_record = m_fds.records[i].data;
+            return NRF_SUCCESS;
+        }
+    }
+    return NRF_ERROR_NOT_FOUND;
+}
+
+static int fds_index(uint32_t record_id)
+{
+    for (int i = 0; i < FDS_MAX_RECORDS; i++) {
+        if (m_fds.records[i].used && m_fds.records[i].header.record_id == record_id)
+            return i;
+    }
+    return -1;
+}
+
+ret_code_t fds_record_open(fds_record_desc_t *p_desc, fds_flash_record_t *p_flash_record)
+{
+    int i = fds_index(p_desc->record_id);
+    if (i < 0) return NRF_ERROR_NOT_FOUND;
+    p_flash_record->p_header = &m_fds.records[i].header;
+    p_flash_record->p_data = m_fds.records[i].data;
+    p_desc->record_is_open = true;
+    return NRF_SUCCESS;
+}
+
+ret_code_t fds_record_close(fds_record_desc_t *p_desc)
+{
+    p_desc->record_is_open = false;
+    return NRF_SUCCESS;
+}
+
+// the chunk list is copied, the data is not
+static ret_code_t fds_queue(fds_evt_id_t id, fds_record_desc_t *p_desc, fds_record_t const *p_record, uint32_t old_id)
+{
+    uint16_t words = 0;
+
+    if (m_fds.queued == FDS_QUEUE_SIZE) return FDS_ERR_NO_SPACE_IN_QUEUES;
+    if (p_record == NULL) {
+        m_fds.queue[m_fds.queued++].id = id;
+        return NRF_SUCCESS;
+    }
+    for (uint16_t i = 0; i < p_record->data.num_chunks; i++)
+        words += p_record->data.p_chunks[i].length_words;
+    if (words > FDS_MAX_WORDS || p_record->data.num_chunks > FDS_MAX_CHUNKS) return NRF_ERROR_INVALID_LENGTH;
+    if (m_fds.full) return FDS_ERR_NO_SPACE_IN_FLASH;
+
+    m_fds.queue[m_fds.queued].id = id;
+    m_fds.queue[m_fds.queued].file_id = p_record->file_id;
+    m_fds.queue[m_fds.queued].key = p_record->key;
+    m_fds.queue[m_fds.queued].record_id = ++m_fds.record_id;
+    m_fds.queue[m_fds.queued].old_id = old_id;
+    m_fds.queue[m_fds.queued].num_chunks = p_record->data.num_chunks;
+    memcpy(m_fds.queue[m_fds.queued].chunks, p_record->data.p_chunks,
+           p_record->data.num_chunks * sizeof(fds_record_chunk_t));
+    m_fds.queued++;
+    if (p_desc) p_desc->record_id = m_fds.record_id;
+    return NRF_SUCCESS;
+}
+
+static ret_code_t fds_store(uint16_t n)
+{
+    uint16_t words = 0;
+
+    for (uint16_t i = 0; i < m_fds.queue[n].num_chunks; i++)
+        words += m_fds.queue[n].chunks[i].length_words;
+    for (int i = 0; i < FDS_MAX_RECORDS; i++) {
+        if (m_fds.records[i].used) continue;
+        uint8_t *p = (uint8_t *)m_fds.records[i].data;
+        m_fds.records[i].used = true;
+        m_fds.records[i].header.tl.record_key = m_fds.queue[n].key;
+        m_fds.records[i].header.tl.length_words = words;
+        m_fds.records[i].header.ic.file_id = m_fds.queue[n].file_id;
+        m_fds.records[i].header.record_id = m_fds.queue[n].record_id;
+        for (uint16_t j = 0; j < m_fds.queue[n].num_chunks; j++) {
+            memcpy(p, m_fds.queue[n].chunks[j].p_data, m_fds.queue[n].chunks[j].length_words * 4);
+            p += m_fds.queue[n].chunks[j].length_words * 4;
+        }
+        m_fds.ops++;
+        return NRF_SUCCESS;
+    }
+    return FDS_ERR_NO_SPACE_IN_FLASH;
+}
+
+ret_code_t fds_record_write(fds_record_desc_t *p_desc, fds_record_t const *p_record)
+{
+    return fds_queue(FDS_EVT_WRITE, p_desc, p_record, 0);
+}
+
+ret_code_t fds_record_update(fds_record_desc_t *p_desc, fds_record_t const *p_record)
+{
+    if (fds_index(p_desc->record_id) < 0) return NRF_ERROR_NOT_FOUND;
+    return fds_queue(FDS_EVT_UPDATE, p_desc, p_record, p_desc->record_id);
+}
+
+ret_code_t fds_record_delete(fds_record_desc_t *p_desc)
+{
+    int i = fds_index(p_desc->record_id);
+    if (i < 0) return NRF_ERROR_NOT_FOUND;
+    m_fds.records[i].used = false;
+    m_fds.ops++;
+    fds_evt(FDS_EVT_DEL_RECORD, NRF_SUCCESS);
+    return NRF_SUCCESS;
+}
+
+// deleted records take no space here, collecting them only ends a full flash
+ret_code_t fds_gc(void)
+{
+    return fds_queue(FDS_EVT_GC, NULL, NULL, 0);
+}
+
+// the flash operations done, in order, including the ones queued by the event handler
+static void fds_process(void)
+{
+    while (!m_fds.hold && m_fds.queued > 0) {
+        uint16_t n = FDS_QUEUE_SIZE - 1;
+        fds_evt_t evt = {m_fds.queue[0].id, NRF_SUCCESS};
+
+        if (evt.id == FDS_EVT_GC) {
+            m_fds.full = false;
+        } else {
+            int old = fds_index(m_fds.queue[0].old_id);
+            evt.result = fds_store(0);
+            if (evt.result == NRF_SUCCESS && old >= 0) m_fds.records[old].used = false;
+            evt.write.record_id = m_fds.queue[0].record_id;
+            evt.write.file_id = m_fds.queue[0].file_id;
+            evt.write.record_key = m_fds.queue[0].key;
+            evt.write.is_record_updated = old >= 0;
+        }
+        memmove(&m_fds.queue[0], &m_fds.queue[1], n * sizeof(m_fds.queue[0]));
+        m_fds.queued--;
+        if (m_fds.cb) m_fds.cb(&evt);
+    }
+}
+
+/******************************************************************************
+ * Scheduler stand-in
+ ******************************************************************************/
+#define SCHED_QUEUE_SIZE 8
+#define SCHED_EVENT_MAX  16
+
+static struct {
+    struct {
+        app_sched_event_handler_t handler;
+        uint16_t size;
+        uint64_t data[SCHED_EVENT_MAX / sizeof(uint64_t)];
+    } queue[SCHED_QUEUE_SIZE];
+    uint8_t count;
+} m_sched;
+
+uint32_t app_sched_event_put(void const *p_event_data, uint16_t event_size, app_sched_event_handler_t handler)
+{
+    if (event_size > SCHED_EVENT_MAX) return NRF_ERROR_INVALID_LENGTH;
+    if (m_sched.count == SCHED_QUEUE_SIZE) return NRF_ERROR_NO_MEM;
+    m_sched.queue[m_sched.count].handler = handler;
+    m_sched.queue[m_sched.count].size = event_size;
+    memcpy(m_sched.queue[m_sched.count].data, p_event_data, event_size);
+    m_sched.count++;
+    return NRF_SUCCESS;
+}
+
+static void sched_nop(void *p_event_data, uint16_t event_size)
+{
+    (void)p_event_data;
+    (void)event_size;
+}
+
+void app_sched_execute(void)
+{
+    for (uint8_t i = 0; i < m_sched.count; i++)
+        m_sched.queue[i].handler(m_sched.queue[i].data, m_sched.queue[i].size);
+    m_sched.count = 0;
+    epd_trace_flush(); // idle_state_handle() in main.c
+}
+
+/******************************************************************************
+ * Font store stand-in
+ *
+ * EPD_font.c keeps flash addresses in 32 bit integers and cannot run on a 64
+ * bit host, the same checks are done here on a RAM copy of the region. The
+ * results are reported from the main loop, like fstorage does.
+ ******************************************************************************/
+#define FONT_REGION_SIZE (1024 * 32)
+#define FONT_WRITE_MAX   244
+
+static struct {
+    epd_font_evt_handler_t handler;
+    uint8_t region[FONT_REGION_SIZE];
+    bool pending, success;
+    epd_font_evt_t evt;
+    uint32_t offset;
+} m_font;
+
+static uint32_t crc32(const uint8_t *data, uint32_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    while (size--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++)
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+    return ~crc;
+}
+
+static uint32_t font_start(epd_font_evt_t evt, uint32_t offset, bool success)
+{
+    m_font.pending = true;
+    m_font.evt = evt;
+    m_font.offset = offset;
+    m_font.success = success;
+    return NRF_SUCCESS;
+}
+
+static void font_process(void)
+{
+    if (!m_font.pending) return;
+    m_font.pending = false;
+    if (m_font.handler) m_font.handler(m_font.evt, m_font.offset, m_font.success);
+}
+
+void epd_font_init(epd_font_evt_handler_t handler)
+{
+    m_font.handler = handler;
+    m_font.pending = false;
+}
+
+uint32_t epd_font_size(void)
+{
+    return FONT_REGION_SIZE;
+}
+
+uint32_t epd_font_erase(void)
+{
+    if (m_font.pending) return NRF_ERROR_BUSY;
+    memset(m_font.region, 0xFF, FONT_REGION_SIZE);
+    return font_start(EPD_FONT_EVT_ERASED, 0, true);
+}
+
+uint32_t epd_font_write(uint32_t offset, uint8_t *data, uint16_t length)
+{
+    if (m_font.pending) return NRF_ERROR_BUSY;
+    if (length == 0 || length > FONT_WRITE_MAX || offset < sizeof(uint32_t) || (offset & 3) ||
+        offset + length > FONT_REGION_SIZE)
+        return NRF_ERROR_INVALID_PARAM;
+    // flash bits can only be cleared
+    for (uint16_t i = 0; i < length; i++)
+        m_font.region[offset + i] &= data[i];
+    return font_start(EPD_FONT_EVT_WRITTEN, offset, true);
+}
+
+uint32_t epd_font_commit(uint32_t crc)
+{
+    if (m_font.pending) return NRF_ERROR_BUSY;
+
+    const epd_font_header_t *header = (const epd_font_header_t *)m_font.region;
+    if (header->size > FONT_REGION_SIZE ||
+        header->size < sizeof(epd_font_header_t) + header->count * sizeof(epd_font_entry_t) ||
+        header->magic != 0xFFFFFFFF)
+        return NRF_ERROR_INVALID_DATA;
+    if (crc32(m_font.region + sizeof(uint32_t), header->size - sizeof(uint32_t)) != crc)
+        return NRF_ERROR_INVALID_DATA;
+    ((epd_font_header_t *)m_font.region)->magic = EPD_FONT_MAGIC;
+    return font_start(EPD_FONT_EVT_COMMITTED, 0, true);
+}
+
+const uint8_t *epd_font_get(uint8_t id)
+{
+    const epd_font_header_t *header = (const epd_font_header_t *)m_font.region;
+    const epd_font_entry_t *entries = (const epd_font_entry_t *)(header + 1);
+
+    if (header->magic != EPD_FONT_MAGIC) return NULL;
+    for (uint16_t i = 0; i < header->count; i++) {
+        if (entries[i].id == id && entries[i].offset < header->size)
+            return m_font.region + entries[i].offset;
+    }
+    return NULL;
+}
+
+/******************************************************************************
+ * main.c stand-ins
+ ******************************************************************************/
+BLE_EPD_DEF(m_epd);
+static uint32_t m_timestamp;
+static jmp_buf m_reset;
+static bool m_in_write;
+
+uint32_t timestamp(void)
+{
+    return m_timestamp;
+}
+
+void set_timestamp(uint32_t timestamp)
+{
+    m_timestamp = timestamp;
+}
+
+// system off, the tag wakes up with a reset
+void sleep_mode_enter(void)
+{
+    ble_epd_sleep_prepare(&m_epd);
+    if (!m_in_write) abort();
+    longjmp(m_reset, 2);
+}
+
+// the link parameters are not modeled, only the requests are counted
+static uint32_t m_bulk_requests;
+
+void link_bulk_mode(void)
+{
+    m_bulk_requests++;
+}
+
+void NVIC_SystemReset(void)
+{
+    if (!m_in_write) abort();
+    longjmp(m_reset, 1);
+}
+
+/******************************************************************************
+ * Harness
+ ******************************************************************************/
+typedef struct {
+    uint32_t count;
+    uint32_t rejected;      // refused by the SoftDevice, never seen by the service
+    uint32_t resets;
+    uint64_t payload;
+    double host_ns, host_max;
+    uint64_t sim_us, sim_max;
+    uint64_t panel_bytes;
+    uint32_t fds_ops;
+    uint32_t notifications;
+} cmd_stats_t;
+
+// result of one write
+typedef struct {
+    bool rejected;
+    int reset;              // 1: reset, 2: system off
+    double host_ns;
+    uint64_t sim_us;
+    uint32_t panel_bytes;
+    uint32_t fds_ops;
+    uint32_t notifications;
+} write_result_t;
+
+static cmd_stats_t m_stats[257];  // the last one counts empty writes
+static union {
+    ble_evt_t evt;
+    uint8_t buf[sizeof(ble_evt_t) + 256];
+} m_evt_buf;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static bool m_connected;
+
+static void ble_event(uint16_t evt_id, uint16_t handle, const uint8_t *data, uint16_t len)
+{
+    ble_evt_t *evt = &m_evt_buf.evt;
+
+    memset(&m_evt_buf, 0, sizeof(m_evt_buf));
+    evt->header.evt_id = evt_id;
+    if (evt_id == BLE_GATTS_EVT_WRITE) {
+        evt->evt.gatts_evt.conn_handle = 0;
+        evt->evt.gatts_evt.params.write.handle = handle;
+        evt->evt.gatts_evt.params.write.len = len;
+        memcpy(evt->evt.gatts_evt.params.write.data, data, len);
+    } else {
+        evt->evt.gap_evt.conn_handle = 0;
+    }
+    ble_epd_on_ble_evt(&m_epd, evt);
+}
+
+// connect and enable notifications like the web tool, the tag answers with its config
+static void connect(void)
+{
+    static const uint8_t cccd[] = {0x01, 0x00};
+
+    ble_event(BLE_GAP_EVT_CONNECTED, 0, NULL, 0);
+    m_connected = true;
+    ble_event(BLE_GATTS_EVT_WRITE, m_epd.char_handles.cccd_handle, cccd, sizeof(cccd));
+    app_sched_execute();
+}
+
+// RTT channel 1 as captured by a debugger
+static uint8_t *m_rtt;
+static uint32_t m_rtt_len, m_rtt_cap;
+
+static void rtt_drain(void)
+{
+    epd_trace_flush(); // the target is idle while the debugger reads
+    for (;;) {
+        if (m_rtt_cap - m_rtt_len < 256) {
+            m_rtt_cap = m_rtt_cap ? m_rtt_cap * 2 : 4096;
+            m_rtt = realloc(m_rtt, m_rtt_cap);
+            if (m_rtt == NULL) abort();
+        }
+        uint32_t n = epd_sim_rtt_read(1, m_rtt + m_rtt_len, m_rtt_cap - m_rtt_len);
+        if (n == 0) break;
+        m_rtt_len += n;
+    }
+}
+
+// power on or reset, as main() does. FDS, the font region and the panel survive.
+static void boot(void)
+{
+    // the driver counts its users across the reset, drop the connection's
+    if (m_connected) {
+        ble_event(BLE_GAP_EVT_DISCONNECTED, 0, NULL, 0);
+        app_sched_execute();
+    }
+    m_connected = false;
+    rtt_drain();
+    // queued flash operations are lost with the reset
+    m_fds.queued = 0;
+    m_fds.hold = false;
+    memset(&m_sd, 0, sizeof(m_sd));
+    memset(&m_sched, 0, sizeof(m_sched));
+    memset(&m_epd, 0, sizeof(ble_epd_t));
+    m_timestamp = 1735689600;
+    GUI_Invalidate();
+    APP_ERROR_CHECK(ble_epd_init(&m_epd));
+    fds_process();
+}
+
+// a new tag: empty flash, default config, controller on the default pins
+static void power_on(epd_sim_chip_t chip, bool bwr)
+{
+    memset(&m_fds, 0, sizeof(m_fds));
+    memset(m_font.region, 0xFF, FONT_REGION_SIZE);
+    boot();
+    epd_sim_attach(chip, &m_epd.config, 400, 300, bwr);
+    connect();
+}
+
+static write_result_t gatt_write(uint16_t handle, const uint8_t *data, uint16_t len)
+{
+    write_result_t r = {0};
+    sd_char_t *c = NULL;
+
+    for (uint8_t i = 0; i < m_sd.char_count; i++) {
+        if (m_sd.chars[i].handles.value_handle == handle || m_sd.chars[i].handles.cccd_handle == handle)
+            c = &m_sd.chars[i];
+    }
+    // the SoftDevice checks the length against the attribute, the service never sees these
+    if (c == NULL || (handle == c->handles.value_handle &&
+                      (!c->writable || len > c->max_len || (!c->is_var_len && len != c->max_len)))) {
+        r.rejected = true;
+        return r;
+    }
+
+    const epd_sim_stats_t *sim = epd_sim_stats();
+    uint64_t sim_start = sim->time_us;
+    uint32_t bytes_start = sim->bytes;
+    uint32_t fds_start = m_fds.ops;
+    uint32_t notify_start = m_sd.notifications;
+    double start = now_ns();
+
+    m_in_write = true;
+    r.reset = setjmp(m_reset);
+    if (r.reset == 0) {
+        ble_event(BLE_GATTS_EVT_WRITE, handle, data, len);
+        // main loop: scheduled GUI updates, then flash operations completing
+        app_sched_execute();
+        font_process();
+        fds_process();
+    }
+    m_in_write = false;
+
+    r.host_ns = now_ns() - start;
+    sim = epd_sim_stats();
+    r.sim_us = sim->time_us - sim_start;
+    r.panel_bytes = sim->bytes - bytes_start;
+    r.fds_ops = m_fds.ops - fds_start;
+    r.notifications = m_sd.notifications - notify_start;
+    if (r.reset) {
+        // the link is gone with the reset, the web tool connects again
+        boot();
+        connect();
+    }
+    return r;
+}
+
+static write_result_t epd_write(const uint8_t *data, uint16_t len)
+{
+    write_result_t r = gatt_write(m_epd.char_handles.value_handle, data, len);
+    cmd_stats_t *s = &m_stats[len > 0 ? data[0] : 256];
+
+    if (r.rejected) {
+        s->rejected++;
+        return r;
+    }
+    s->count++;
+    s->payload += len;
+    s->host_ns += r.host_ns;
+    if (r.host_ns > s->host_max) s->host_max = r.host_ns;
+    s->sim_us += r.sim_us;
+    if (r.sim_us > s->sim_max) s->sim_max = r.sim_us;
+    s->panel_bytes += r.panel_bytes;
+    s->fds_ops += r.fds_ops;
+    s->notifications += r.notifications;
+    if (r.reset) s->resets++;
+    return r;
+}
+
+static write_result_t epd_cmd(uint8_t cmd, const uint8_t *data, uint16_t len)
+{
+    uint8_t buf[256];
+    buf[0] = cmd;
+    if (len) memcpy(&buf[1], data, len);
+    return epd_write(buf, len + 1);
+}
+
+// Read and Read Blob requests of MTU - 1 bytes, until a short one ends the value
+static uint16_t gatt_read(uint16_t handle, uint8_t *data, uint16_t size)
+{
+    sd_char_t *c = NULL;
+    uint16_t offset = 0;
+
+    for (uint8_t i = 0; i < m_sd.char_count; i++) {
+        if (m_sd.chars[i].handles.value_handle == handle) c = &m_sd.chars[i];
+    }
+    if (c == NULL) return 0;
+    for (;;) {
+        if (c->deferred_read) {
+            ble_evt_t *evt = &m_evt_buf.evt;
+            memset(&m_evt_buf, 0, sizeof(m_evt_buf));
+            evt->header.evt_id = BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST;
+            evt->evt.gatts_evt.params.authorize_request.type = BLE_GATTS_AUTHORIZE_TYPE_READ;
+            evt->evt.gatts_evt.params.authorize_request.request.read.handle = handle;
+            evt->evt.gatts_evt.params.authorize_request.request.read.offset = offset;
+            m_sd.authorizing = c;
+            m_sd.authorized = false;
+            ble_epd_on_ble_evt(&m_epd, evt);
+            if (!m_sd.authorized) {
+                printf("FAIL read of handle %d at %d not authorized\n", handle, offset);
+                failures++;
+                m_sd.authorizing = NULL;
+                return 0;
+            }
+        }
+        uint16_t n = c->len - offset < hal_att_mtu - 1 ? c->len - offset : hal_att_mtu - 1;
+        if (offset + n > size) return 0;
+        memcpy(data + offset, (c->user_value ? c->user_value : c->value) + offset, n);
+        offset += n;
+        if (n < hal_att_mtu - 1) return offset;
+    }
+}
+
+static const char *cmd_name(uint8_t cmd)
+{
+    switch (cmd) {
+        case EPD_CMD_SET_PINS:      return "SET_PINS";
+        case EPD_CMD_INIT:          return "INIT";
+        case EPD_CMD_CLEAR:         return "CLEAR";
+        case EPD_CMD_SEND_COMMAND:  return "SEND_COMMAND";
+        case EPD_CMD_SEND_DATA:     return "SEND_DATA";
+        case EPD_CMD_REFRESH:       return "REFRESH";
+        case EPD_CMD_SLEEP:         return "SLEEP";
+        case EPD_CMD_LINK_INFO:     return "LINK_INFO";
+        case EPD_CMD_CREDIT:        return "CREDIT";
+        case EPD_CMD_BATCH:         return "BATCH";
+        case EPD_CMD_SET_TIME:      return "SET_TIME";
+        case EPD_CMD_LIST_WRITE:    return "LIST_WRITE";
+        case EPD_CMD_LIST_SHOW:     return "LIST_SHOW";
+        case EPD_CMD_SLOT_SET:      return "SLOT_SET";
+        case EPD_CMD_WRITE_IMAGE:   return "WRITE_IMAGE";
+        case EPD_CMD_WRITE_IMAGE_RLE: return "IMAGE_RLE";
+        case EPD_CMD_WRITE_REGION:  return "WRITE_REGION";
+        case EPD_CMD_REFRESH_REGION: return "REFR_REGION";
+        case EPD_CMD_UPLOAD_BEGIN:  return "UPLOAD_BEGIN";
+        case EPD_CMD_UPLOAD_DATA:   return "UPLOAD_DATA";
+        case EPD_CMD_UPLOAD_STATUS: return "UPLOAD_STAT";
+        case EPD_CMD_FONT_ERASE:    return "FONT_ERASE";
+        case EPD_CMD_FONT_WRITE:    return "FONT_WRITE";
+        case EPD_CMD_FONT_COMMIT:   return "FONT_COMMIT";
+        case EPD_CMD_SET_CONFIG:    return "SET_CONFIG";
+        case EPD_CMD_SYS_RESET:     return "SYS_RESET";
+        case EPD_CMD_SYS_SLEEP:     return "SYS_SLEEP";
+        case EPD_CMD_CFG_ERASE:     return "CFG_ERASE";
+        default:                    return NULL;
+    }
+}
+
+/******************************************************************************
+ * Image upload
+ ******************************************************************************/
+static const struct {
+    const char *name;
+    epd_model_id_t id;
+    epd_sim_chip_t chip;
+    bool bwr;
+} models[] = {
+    {"UC8176 BW",   EPD_UC8176_420_BW,   EPD_SIM_UC8176,  false},
+    {"UC8176 BWR",  EPD_UC8176_420_BWR,  EPD_SIM_UC8176,  true},
+    {"SSD1619 BWR", EPD_SSD1619_420_BWR, EPD_SIM_SSD1619, true},
+    {"SSD1619 BW",  EPD_SSD1619_420_BW,  EPD_SIM_SSD1619, false},
+};
+
+#define IMAGE_SIZE (400 / 8 * 300)
+
+static uint8_t m_black[IMAGE_SIZE], m_red[IMAGE_SIZE];
+
+// 1 = white / not red, MSB first, as canvas2bytes() in the web tool
+static void make_image(void)
+{
+    memset(m_black, 0xFF, IMAGE_SIZE);
+    memset(m_red, 0xFF, IMAGE_SIZE);
+    for (int y = 0; y < 300; y++) {
+        for (int x = 0; x < 400; x++) {
+            int dx = x - 200, dy = y - 150;
+            if ((x / 20 + y / 20) % 2)
+                m_black[y * 50 + x / 8] &= ~(0x80 >> (x & 7));
+            if (dx * dx + dy * dy < 90 * 90 && (x + y) % 3 == 0)
+                m_red[y * 50 + x / 8] &= ~(0x80 >> (x & 7));
+        }
+    }
+}
+
+static int compare_image(bool bwr)
+{
+    for (int y = 0; y < 300; y++) {
+        for (int x = 0; x < 400; x++) {
+            uint8_t bit = 0x80 >> (x & 7);
+            epd_sim_color_t expected = (bwr && !(m_red[y * 50 + x / 8] & bit)) ? EPD_SIM_RED :
+                                       (m_black[y * 50 + x / 8] & bit) ? EPD_SIM_WHITE : EPD_SIM_BLACK;
+            if (epd_sim_pixel(x, y) != expected) {
+                printf("  pixel %d,%d is %d, expected %d\n", x, y, epd_sim_pixel(x, y), expected);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+typedef struct {
+    uint32_t writes;
+    uint64_t payload;
+    double host_ns;
+    uint64_t sim_us;
+} upload_stats_t;
+
+// packBits() in html/js/main.js: literals end where a run of 3 starts, runs of 2 are kept as runs
+static uint32_t pack_bits(const uint8_t *data, uint32_t size, uint8_t *out)
+{
+    uint8_t *p = out;
+    uint32_t i = 0;
+
+    while (i < size) {
+        uint32_t run = 1;
+        while (run < 128 && i + run < size && data[i + run] == data[i]) run++;
+        if (run > 1) {
+            *p++ = 257 - run;
+            *p++ = data[i];
+            i += run;
+            continue;
+        }
+        uint32_t n = 1;
+        while (n < 128 && i + n < size &&
+               !(i + n + 2 < size && data[i + n] == data[i + n + 1] && data[i + n] == data[i + n + 2]))
+            n++;
+        *p++ = n - 1;
+        memcpy(p, &data[i], n);
+        p += n;
+        i += n;
+    }
+    return p - out;
+}
+
+// epdWriteImage() in html/js/main.js: flag byte, then mtusize - 2 bytes of the plane, PackBits compressed
+// with rle (the web tool only sends it compressed when that is smaller)
+static void upload_plane(const uint8_t *plane, bool black, uint16_t payload, bool rle, upload_stats_t *u)
+{
+    static uint8_t packed[IMAGE_SIZE + IMAGE_SIZE / 128 + 1];
+    uint16_t chunk = payload - 2;
+    uint32_t size = IMAGE_SIZE;
+    uint8_t buf[256];
+
+    if (rle) {
+        size = pack_bits(plane, IMAGE_SIZE, packed);
+        plane = packed;
+    }
+    for (uint32_t i = 0; i < size; i += chunk) {
+        uint16_t n = size - i < chunk ? size - i : chunk;
+        buf[0] = (black ? 0x0F : 0x00) | (i == 0 ? 0x00 : 0xF0);
+        memcpy(&buf[1], &plane[i], n);
+        write_result_t r = epd_cmd(rle ? EPD_CMD_WRITE_IMAGE_RLE : EPD_CMD_WRITE_IMAGE, buf, n + 1);
+        u->writes++;
+        u->payload += n + 2;
+        u->host_ns += r.host_ns;
+        u->sim_us += r.sim_us;
+    }
+}
+
+static void test_upload(int index, uint16_t mtu, bool rle)
+{
+    const char *name = models[index].name;
+    bool bwr = models[index].bwr;
+    uint8_t pins[] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10};   // the defaults of the nRF51 build
+    uint8_t id = models[index].id;
+    upload_stats_t u = {0};
+
+    hal_att_mtu = mtu;
+    power_on(models[index].chip, bwr);
+    CHECK(m_sd.notifications == 2 && m_sd.notify_log[0].len == sizeof(epd_config_t) &&
+          memcmp(m_sd.notify_log[0].data, &m_epd.config, sizeof(epd_config_t)) == 0,
+          "%s mtu %d: no config notification on connect", name, mtu);
+
+    // setDriver(), then sendimg()
+    epd_cmd(EPD_CMD_SET_PINS, pins, sizeof(pins));
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    epd_sim_reset_stats();
+    upload_plane(m_black, true, mtu - 3, rle, &u);
+    if (bwr) upload_plane(m_red, false, mtu - 3, rle, &u);
+    write_result_t r = epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    if (!compare_image(bwr)) {
+        printf("FAIL %s %s mtu %d: the panel does not show the uploaded image\n", name, rle ? "rle" : "raw", mtu);
+        failures++;
+    }
+
+    const epd_sim_stats_t *sim = epd_sim_stats();
+    printf("%-12s %-5s %4d %6u %7llu %6.1f%% %9.1f %9.1f %9.1f %8.1f\n", name, rle ? "rle" : "raw", mtu, u.writes,
+           (unsigned long long)u.payload, 100.0 * ((double)u.payload - IMAGE_SIZE * (bwr ? 2 : 1)) / u.payload,
+           u.host_ns / u.writes, u.sim_us / 1000.0, r.sim_us / 1000.0,
+           IMAGE_SIZE * (bwr ? 2 : 1) / (u.sim_us / 1e6) / 1024);
+    CHECK(sim->overflow == 0 && sim->busy_bytes == 0 && sim->ignored == 0,
+          "%s mtu %d: %u bytes past the window, %u while busy, %u ignored", name, mtu, sim->overflow,
+          sim->busy_bytes, sim->ignored);
+
+    // syncTime(): calendar, then clock; the tag draws them itself
+    uint8_t t[] = {0x67, 0x9A, 0x3E, 0xEC, 8, MODE_CALENDAR};
+    epd_cmd(EPD_CMD_SET_TIME, t, sizeof(t));
+    CHECK(m_epd.display_mode == MODE_CALENDAR && epd_sim_stats()->refreshes == 2, "%s mtu %d: calendar not drawn",
+          name, mtu);
+    t[5] = MODE_CLOCK;
+    epd_cmd(EPD_CMD_SET_TIME, t, sizeof(t));
+    for (int i = 0; i < 3; i++) {
+        m_timestamp += 60;
+        ble_epd_on_timer(&m_epd, m_timestamp, false);
+        app_sched_execute();
+    }
+    CHECK(epd_sim_stats()->refreshes == 6, "%s mtu %d: %u refreshes, expected 6", name, mtu,
+          epd_sim_stats()->refreshes);
+    CHECK(sim->overflow == 0 && sim->busy_bytes == 0 && sim->ignored == 0,
+          "%s mtu %d: GUI update: %u bytes past the window, %u while busy, %u ignored", name, mtu,
+          sim->overflow, sim->busy_bytes, sim->ignored);
+}
+
+// PackBits state across writes and the bound of the plane
+static void test_rle(void)
+{
+    uint8_t id = EPD_UC8176_420_BWR;
+    upload_stats_t u = {0};
+    uint8_t buf[256];
+    uint32_t panel = 0;
+
+    // every code split over two writes
+    hal_att_mtu = 23;
+    power_on(EPD_SIM_UC8176, true);
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    upload_plane(m_black, true, 3, true, &u);
+    upload_plane(m_red, false, 3, true, &u);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    CHECK(compare_image(true), "rle: the panel is wrong with 1 byte per write");
+
+    // runs past the end of the plane are dropped
+    epd_sim_reset_stats();
+    for (uint32_t i = 0; i < IMAGE_SIZE / 128 / 8 + 2; i++) {
+        buf[0] = 0x0F | (i == 0 ? 0x00 : 0xF0);
+        for (int k = 0; k < 8; k++) {
+            buf[1 + k * 2] = 0x81;
+            buf[2 + k * 2] = 0x00;
+        }
+        panel += epd_cmd(EPD_CMD_WRITE_IMAGE_RLE, buf, 17).panel_bytes;
+    }
+    CHECK(panel == IMAGE_SIZE + 1 && epd_sim_stats()->overflow == 0,
+          "rle: %u bytes sent to the panel, expected %u, %u past the window", panel, IMAGE_SIZE + 1,
+          epd_sim_stats()->overflow);
+}
+
+/******************************************************************************
+ * Region writes
+ ******************************************************************************/
+// epdWriteRegion() in html/js/main.js: x, y, w, h after the flag of the first write, PackBits data
+static uint32_t upload_region(const uint8_t *plane, bool black, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                              uint16_t payload)
+{
+    static uint8_t sub[IMAGE_SIZE], packed[IMAGE_SIZE + IMAGE_SIZE / 128 + 1];
+    uint8_t buf[256];
+    uint32_t panel = 0, i = 0;
+
+    for (uint16_t row = 0; row < h; row++)
+        memcpy(&sub[row * w / 8], &plane[(y + row) * 50 + x / 8], w / 8);
+    uint32_t size = pack_bits(sub, w / 8 * h, packed);
+    do {
+        uint8_t *p = buf;
+        *p++ = (black ? 0x0F : 0x00) | (i == 0 ? 0x00 : 0xF0);
+        if (i == 0) {
+            uint16_t r[] = {x, y, w, h};
+            for (int k = 0; k < 4; k++) {
+                *p++ = r[k] >> 8;
+                *p++ = r[k];
+            }
+        }
+        uint16_t chunk = payload - 1 - (p - buf);
+        uint16_t n = size - i < chunk ? size - i : chunk;
+        memcpy(p, &packed[i], n);
+        panel += epd_cmd(EPD_CMD_WRITE_REGION, buf, p - buf + n).panel_bytes;
+        i += n;
+    } while (i < size);
+    return panel;
+}
+
+static void refresh_region(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    uint8_t r[] = {x >> 8, x, y >> 8, y, w >> 8, w, h >> 8, h};
+    epd_cmd(EPD_CMD_REFRESH_REGION, r, sizeof(r));
+}
+
+// a full upload, then two edited rectangles, then a full upload again
+static void test_region(int index)
+{
+    const char *name = models[index].name;
+    bool bwr = models[index].bwr;
+    uint8_t id = models[index].id;
+    upload_stats_t u = {0};
+    uint32_t panel = 0;
+
+    hal_att_mtu = 247;
+    power_on(models[index].chip, bwr);
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    upload_plane(m_black, true, 244, true, &u);
+    if (bwr) upload_plane(m_red, false, 244, true, &u);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+
+    // a price changed: a box of text and a red mark
+    for (int y = 40; y < 72; y++) {
+        for (int x = 96; x < 160; x++) {
+            if ((x + y) % 5 == 0) m_black[y * 50 + x / 8] ^= 0x80 >> (x & 7);
+        }
+    }
+    for (int y = 200; y < 212; y++) m_red[y * 50 + 30] = 0x00;
+    epd_sim_reset_stats();
+    panel += upload_region(m_black, true, 96, 40, 64, 32, 244);
+    if (bwr) panel += upload_region(m_red, false, 96, 40, 64, 32, 244);
+    panel += upload_region(m_black, true, 240, 200, 8, 12, 244);
+    if (bwr) panel += upload_region(m_red, false, 240, 200, 8, 12, 244);
+    refresh_region(96, 40, 152, 172);
+    const epd_sim_stats_t *sim = epd_sim_stats();
+    CHECK(compare_image(bwr), "%s region: the panel does not show the edit", name);
+    CHECK(panel < 800 && sim->refreshes == 1 && sim->overflow == 0,
+          "%s region: %u bytes to the panel, %u refreshes, %u past the window", name, panel, sim->refreshes,
+          sim->overflow);
+    printf("%-12s region %5u panel bytes\n", name, panel);
+
+    // the full window is back for the next upload
+    make_image();
+    upload_plane(m_black, true, 244, false, &u);
+    if (bwr) upload_plane(m_red, false, 244, false, &u);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    CHECK(compare_image(bwr), "%s region: full upload after a region write is wrong", name);
+}
+
+/******************************************************************************
+ * Link info and bulk mode
+ ******************************************************************************/
+static void test_link(uint16_t mtu)
+{
+    uint8_t id = EPD_UC8176_420_BW;
+    uint8_t info[] = {EPD_CMD_LINK_INFO, mtu >> 8, mtu};
+    uint8_t t[] = {0x67, 0x9A, 0x3E, 0xEC, 8, MODE_CLOCK};
+    upload_stats_t u = {0};
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, false);
+    CHECK(m_sd.notify_log[1].len == sizeof(info) && memcmp(m_sd.notify_log[1].data, info, sizeof(info)) == 0,
+          "link mtu %d: no link info after the config", mtu);
+    m_sd.notify_len = 0;
+    epd_cmd(EPD_CMD_LINK_INFO, NULL, 0);
+    CHECK(m_sd.notify_len == sizeof(info) && memcmp(m_sd.notify_data, info, sizeof(info)) == 0,
+          "link mtu %d: LINK_INFO not answered", mtu);
+
+    // every upload write keeps the bulk mode, other commands do not start it
+    m_bulk_requests = 0;
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    epd_cmd(EPD_CMD_SET_TIME, t, sizeof(t));
+    CHECK(m_bulk_requests == 0, "link mtu %d: %u bulk requests without an upload", mtu, m_bulk_requests);
+    upload_plane(m_black, true, mtu - 3, true, &u);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    CHECK(m_bulk_requests == u.writes, "link mtu %d: %u bulk requests for %u upload writes", mtu, m_bulk_requests,
+          u.writes);
+}
+
+/******************************************************************************
+ * Ingress buffer
+ ******************************************************************************/
+// write as a BLE event only, the main loop is busy and runs later
+static void ingress_write(uint8_t cmd, uint32_t offset)
+{
+    uint8_t buf[256] = {cmd};
+    uint16_t n = IMAGE_SIZE - offset < 242 ? IMAGE_SIZE - offset : 242;
+
+    buf[1] = 0x0F | (offset == 0 ? 0x00 : 0xF0);
+    memcpy(&buf[2], &m_black[offset], n);
+    ble_event(BLE_GATTS_EVT_WRITE, m_epd.char_handles.value_handle, buf, cmd == EPD_CMD_REFRESH ? 1 : n + 2);
+}
+
+// a refresh and the start of an upload arrive before the main loop gets to them, they run in
+// order from the scheduler; a write that does not fit in the buffer is dropped as a whole
+static void test_ingress(void)
+{
+    uint8_t id = EPD_UC8176_420_BW;
+    uint32_t offset = 0, used = 2;
+    uint8_t buf[256];
+
+    hal_att_mtu = 247;
+    power_on(EPD_SIM_UC8176, false);
+    make_image();
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+
+    uint32_t bytes = epd_sim_stats()->bytes;
+    ingress_write(EPD_CMD_REFRESH, 0);
+    for (; used + 245 <= 1024; offset += 242, used += 245)
+        ingress_write(EPD_CMD_WRITE_IMAGE, offset);
+    ingress_write(EPD_CMD_WRITE_IMAGE, offset);
+    CHECK(epd_sim_stats()->bytes == bytes, "ingress: %u panel bytes sent from the BLE event",
+          epd_sim_stats()->bytes - bytes);
+    app_sched_execute();
+    CHECK(epd_sim_stats()->bytes > bytes, "ingress: buffered writes not executed");
+
+    // the client resends from the dropped write
+    for (; offset < IMAGE_SIZE; offset += 242) {
+        uint16_t n = IMAGE_SIZE - offset < 242 ? IMAGE_SIZE - offset : 242;
+        buf[0] = 0xFF;
+        memcpy(&buf[1], &m_black[offset], n);
+        epd_cmd(EPD_CMD_WRITE_IMAGE, buf, n + 1);
+    }
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    CHECK(compare_image(false), "ingress: image is wrong, buffered writes out of order or the dropped one executed");
+
+    // a write that cannot schedule its drain is dropped, not left in the buffer without one
+    uint8_t filler = 0;
+    while (app_sched_event_put(&filler, sizeof(filler), sched_nop) == NRF_SUCCESS)
+        ;
+    buf[0] = EPD_CMD_WRITE_IMAGE;
+    buf[1] = 0x0F;
+    for (uint16_t i = 0; i < 242; i++)
+        buf[2 + i] = ~m_black[i];
+    epd_sim_reset_stats();
+    ble_event(BLE_GATTS_EVT_WRITE, m_epd.char_handles.value_handle, buf, 244);
+    app_sched_execute();
+    ingress_write(EPD_CMD_REFRESH, 0);
+    app_sched_execute();
+    CHECK(epd_sim_stats()->refreshes == 1 && epd_sim_stats()->bytes < 100 && compare_image(false),
+          "ingress: write with the scheduler full was buffered and ran with the next one");
+}
+
+/******************************************************************************
+ * Flow control
+ ******************************************************************************/
+static int32_t m_credits;   // the web tool's credits
+
+static void credit_notified(uint32_t notifications)
+{
+    if (m_sd.notifications != notifications && m_sd.notify_len == 3 && m_sd.notify_data[0] == EPD_CMD_CREDIT)
+        m_credits += (m_sd.notify_data[1] << 8) | m_sd.notify_data[2];
+}
+
+static void credit_cmd(uint8_t cmd, const uint8_t *data, uint16_t len)
+{
+    uint32_t notifications = m_sd.notifications;
+    if (cmd != EPD_CMD_CREDIT) m_credits -= len + 2;     // command and record header
+    epd_cmd(cmd, data, len);
+    credit_notified(notifications);
+}
+
+// epdWriteImage() with credits: a write waits until the credits cover it and the record
+// header, a stalled notification goes out with the next TX complete event
+static void test_credit(uint16_t mtu)
+{
+    uint8_t id = EPD_UC8176_420_BW;
+    uint16_t chunk = mtu - 3 - 2;
+    uint32_t stalls = 0;
+    uint8_t buf[256];
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, false);
+    make_image();
+    m_credits = 0;
+    credit_cmd(EPD_CMD_CREDIT, NULL, 0);
+    CHECK(m_credits == 1024, "credit mtu %d: %d credits granted, expected the window", mtu, m_credits);
+    credit_cmd(EPD_CMD_INIT, &id, 1);
+
+    for (uint32_t i = 0; i < IMAGE_SIZE; i += chunk) {
+        uint16_t n = IMAGE_SIZE - i < chunk ? IMAGE_SIZE - i : chunk;
+        m_sd.tx_full = i >= IMAGE_SIZE / 3 && i < IMAGE_SIZE * 2 / 3;
+        while (m_credits < n + 3) {
+            uint32_t notifications = m_sd.notifications;
+            m_sd.tx_full = false;
+            ble_event(BLE_EVT_TX_COMPLETE, 0, NULL, 0);
+            credit_notified(notifications);
+            if (m_sd.notifications == notifications) break;
+            stalls++;
+        }
+        if (m_credits < n + 3) {
+            CHECK(false, "credit mtu %d: stalled at %u with %d credits", mtu, i, m_credits);
+            break;
+        }
+        buf[0] = 0x0F | (i == 0 ? 0x00 : 0xF0);
+        memcpy(&buf[1], &m_black[i], n);
+        credit_cmd(EPD_CMD_WRITE_IMAGE, buf, n + 1);
+        CHECK(m_credits >= 0, "credit mtu %d: %d credits at %u", mtu, m_credits, i);
+    }
+    m_sd.tx_full = false;
+    credit_cmd(EPD_CMD_REFRESH, NULL, 0);
+    credit_cmd(EPD_CMD_CREDIT, NULL, 0);
+    CHECK(m_credits == 1024, "credit mtu %d: %d credits after the upload, expected the window", mtu, m_credits);
+    CHECK(stalls > 0, "credit mtu %d: no grant waited for a TX complete", mtu);
+    CHECK(compare_image(false), "credit mtu %d: image is wrong", mtu);
+
+    // a new connection starts without flow control
+    ble_event(BLE_GAP_EVT_DISCONNECTED, 0, NULL, 0);
+    connect();
+    m_credits = 0;
+    credit_cmd(EPD_CMD_CREDIT, NULL, 0);
+    CHECK(m_credits == 1024, "credit mtu %d: %d credits granted after reconnecting", mtu, m_credits);
+}
+
+/******************************************************************************
+ * Batched commands
+ ******************************************************************************/
+// a WRITE_REGION command of a small region as a batch entry: length, command
+static uint16_t batch_region(uint8_t *out, const uint8_t *plane, bool black, uint16_t x, uint16_t y, uint16_t w,
+                             uint16_t h)
+{
+    uint8_t sub[64];
+    uint8_t *p = out + 1;
+    uint16_t r[] = {x, y, w, h};
+
+    for (uint16_t row = 0; row < h; row++)
+        memcpy(&sub[row * w / 8], &plane[(y + row) * 50 + x / 8], w / 8);
+    *p++ = EPD_CMD_WRITE_REGION;
+    *p++ = black ? 0x0F : 0x00;
+    for (int k = 0; k < 4; k++) {
+        *p++ = r[k] >> 8;
+        *p++ = r[k];
+    }
+    p += pack_bits(sub, w / 8 * h, p);
+    out[0] = p - out - 1;
+    return p - out;
+}
+
+// a small edit of both planes and its refresh in a single write
+static void test_batch(void)
+{
+    uint8_t id = EPD_UC8176_420_BWR;
+    uint8_t refresh[] = {9, EPD_CMD_REFRESH_REGION, 0, 240, 0, 200, 0, 8, 0, 12};
+    upload_stats_t u = {0};
+    uint8_t buf[256];
+    uint16_t n = 0;
+
+    hal_att_mtu = 247;
+    power_on(EPD_SIM_UC8176, true);
+    make_image();
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    upload_plane(m_black, true, 244, true, &u);
+    upload_plane(m_red, false, 244, true, &u);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+
+    for (int y = 200; y < 212; y++) {
+        m_black[y * 50 + 30] ^= 0x5A;
+        m_red[y * 50 + 30] = y % 2 ? 0x0F : 0xFF;
+    }
+    n += batch_region(&buf[n], m_black, true, 240, 200, 8, 12);
+    n += batch_region(&buf[n], m_red, false, 240, 200, 8, 12);
+    memcpy(&buf[n], refresh, sizeof(refresh));
+    n += sizeof(refresh);
+    epd_sim_reset_stats();
+    write_result_t r = epd_cmd(EPD_CMD_BATCH, buf, n);
+    CHECK(!r.rejected && epd_sim_stats()->refreshes == 1 && compare_image(true),
+          "batch: %u bytes of region writes and refresh not executed in order", n + 1);
+
+    // the batch is checked before anything runs
+    buf[n - sizeof(refresh)]++;
+    r = epd_cmd(EPD_CMD_BATCH, buf, n);
+    CHECK(r.panel_bytes == 0, "batch: %u panel bytes of a batch running past the write", r.panel_bytes);
+}
+
+/******************************************************************************
+ * Upload session
+ ******************************************************************************/
+static uint8_t m_stream[IMAGE_SIZE * 2 + IMAGE_SIZE / 64 + 2];
+
+// the notification of an upload command: state and committed offset, -1 without one
+static int32_t upload_cmd(uint8_t cmd, const uint8_t *data, uint16_t len, uint8_t *state)
+{
+    uint32_t notifications = m_sd.notifications;
+
+    epd_cmd(cmd, data, len);
+    if (m_sd.notifications == notifications || m_sd.notify_len != 10 || m_sd.notify_data[0] != cmd) return -1;
+    *state = m_sd.notify_data[1];
+    return (m_sd.notify_data[6] << 24) | (m_sd.notify_data[7] << 16) | (m_sd.notify_data[8] << 8) | m_sd.notify_data[9];
+}
+
+static int32_t upload_begin(uint32_t id, uint32_t size, uint32_t crc, uint8_t flags, uint8_t *state)
+{
+    uint8_t buf[13] = {id >> 24, id >> 16, id >> 8, id, size >> 24, size >> 16, size >> 8, size,
+                       crc >> 24, crc >> 16, crc >> 8, crc, flags};
+    return upload_cmd(EPD_CMD_UPLOAD_BEGIN, buf, sizeof(buf), state);
+}
+
+// epdUpload() in html/js/main.js: offset, then mtusize - 5 bytes of the stream, until end or the link is lost
+static void upload_send(uint32_t offset, uint32_t end, uint16_t mtu)
+{
+    uint16_t chunk = mtu - 3 - 5;
+    uint8_t buf[256];
+
+    for (; offset < end; offset += chunk) {
+        uint16_t n = end - offset < chunk ? end - offset : chunk;
+        buf[0] = offset >> 24;
+        buf[1] = offset >> 16;
+        buf[2] = offset >> 8;
+        buf[3] = offset;
+        memcpy(&buf[4], &m_stream[offset], n);
+        epd_cmd(EPD_CMD_UPLOAD_DATA, buf, n + 4);
+    }
+}
+
+static void link_lost(void)
+{
+    ble_event(BLE_GAP_EVT_DISCONNECTED, 0, NULL, 0);
+    app_sched_execute();
+    m_connected = false;
+}
+
+static void clock_tick(uint32_t seconds)
+{
+    while (seconds--) {
+        ble_epd_on_timer(&m_epd, ++m_timestamp, false);
+        app_sched_execute();
+    }
+}
+
+// a BWR upload broken off halfway resumes at the committed offset after reconnecting, the panel has
+// kept its power and ram; a session left alone is dropped, a wrong crc is reported
+static void test_resume(uint16_t mtu, bool rle)
+{
+    uint8_t pins[] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11};    // with an EN pin
+    uint8_t id = EPD_UC8176_420_BWR;
+    uint8_t flags = EPD_UPLOAD_FLAG_RED | (rle ? EPD_UPLOAD_FLAG_RLE : 0);
+    const char *codec = rle ? "rle" : "raw";
+    uint32_t size = 0;
+    uint8_t state = 0xFF;
+    int32_t offset;
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, true);
+    make_image();
+    epd_cmd(EPD_CMD_SET_PINS, pins, sizeof(pins));
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    if (rle) {
+        size = pack_bits(m_black, IMAGE_SIZE, m_stream);
+        size += pack_bits(m_red, IMAGE_SIZE, m_stream + size);
+    } else {
+        memcpy(m_stream, m_black, IMAGE_SIZE);
+        memcpy(m_stream + IMAGE_SIZE, m_red, IMAGE_SIZE);
+        size = IMAGE_SIZE * 2;
+    }
+    uint32_t crc = crc32(m_stream, size);
+
+    offset = upload_begin(0x1234, size, crc, flags, &state);
+    CHECK(offset == 0 && state == EPD_UPLOAD_OPEN, "resume %s mtu %d: begin answered %d, state %d", codec, mtu,
+          offset, state);
+    upload_send(0, size / 3, mtu);
+    link_lost();
+    clock_tick(EPD_UPLOAD_TIMEOUT / 2);
+    connect();
+
+    // connect() without INIT, the web tool asks first
+    offset = upload_cmd(EPD_CMD_UPLOAD_STATUS, NULL, 0, &state);
+    CHECK(state == EPD_UPLOAD_OPEN && offset > 0 && (uint32_t)offset <= size / 3,
+          "resume %s mtu %d: status %d at %d after reconnecting", codec, mtu, state, offset);
+    CHECK(upload_begin(0x1234, size, crc, flags, &state) == offset && state == EPD_UPLOAD_OPEN,
+          "resume %s mtu %d: begin of the same session did not resume", codec, mtu);
+    uint32_t bytes = epd_sim_stats()->bytes;
+    upload_send(0, 1, mtu);
+    CHECK(m_sd.notify_len == 10 && m_sd.notify_data[0] == EPD_CMD_UPLOAD_DATA && epd_sim_stats()->bytes == bytes,
+          "resume %s mtu %d: data off the committed offset not refused", codec, mtu);
+    upload_send(offset, size, mtu);
+    offset = upload_cmd(EPD_CMD_UPLOAD_STATUS, NULL, 0, &state);
+    CHECK(state == EPD_UPLOAD_DONE && (uint32_t)offset == size, "resume %s mtu %d: status %d at %d of %u", codec,
+          mtu, state, offset, size);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    CHECK(compare_image(true), "resume %s mtu %d: the panel does not show the uploaded image", codec, mtu);
+    CHECK(upload_cmd(EPD_CMD_UPLOAD_STATUS, NULL, 0, &state) == 0 && state == EPD_UPLOAD_NONE,
+          "resume %s mtu %d: session still open after the refresh", codec, mtu);
+
+    // nobody comes back: the session and the panel power go
+    upload_begin(0x5678, size, crc, flags, &state);
+    upload_send(0, size / 2, mtu);
+    link_lost();
+    clock_tick(EPD_UPLOAD_TIMEOUT);
+    connect();
+    CHECK(upload_cmd(EPD_CMD_UPLOAD_STATUS, NULL, 0, &state) == 0 && state == EPD_UPLOAD_NONE,
+          "resume %s mtu %d: session kept %d s without a connection", codec, mtu, EPD_UPLOAD_TIMEOUT);
+
+    // the crc is checked over the whole stream
+    upload_begin(0x9ABC, size, crc ^ 1, flags, &state);
+    upload_send(0, size, mtu);
+    offset = upload_cmd(EPD_CMD_UPLOAD_STATUS, NULL, 0, &state);
+    CHECK(state == EPD_UPLOAD_CRC_ERROR && (uint32_t)offset == size, "resume %s mtu %d: wrong crc not reported",
+          codec, mtu);
+
+    // any command that may use the controller gives the session up
+    epd_cmd(EPD_CMD_SLEEP, NULL, 0);
+    CHECK(upload_cmd(EPD_CMD_UPLOAD_STATUS, NULL, 0, &state) == 0 && state == EPD_UPLOAD_NONE,
+          "resume %s mtu %d: session kept over another command", codec, mtu);
+    if (!rle) {
+        CHECK(upload_begin(0x9ABC, IMAGE_SIZE, crc, flags, &state) == 0 && state == EPD_UPLOAD_NONE,
+              "resume mtu %d: raw session shorter than the planes opened", mtu);
+    }
+}
+
+// epdUpload() with the data characteristic: the stream only, mtusize bytes a write
+static void stream_send(uint32_t offset, uint32_t end, uint16_t mtu)
+{
+    uint16_t chunk = mtu - 3;
+
+    for (; offset < end; offset += chunk) {
+        uint16_t n = end - offset < chunk ? end - offset : chunk;
+        uint32_t notifications = m_sd.notifications;
+        m_credits -= n + 2;     // record header and the data mark
+        gatt_write(m_epd.data_handles.value_handle, &m_stream[offset], n);
+        credit_notified(notifications);
+    }
+}
+
+// the session data through the data characteristic, resumed after a lost link like test_resume()
+static void test_stream(uint16_t mtu)
+{
+    uint8_t pins[] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11};
+    uint8_t id = EPD_UC8176_420_BWR;
+    uint8_t flags = EPD_UPLOAD_FLAG_RED | EPD_UPLOAD_FLAG_RLE;
+    uint8_t state = 0xFF;
+    int32_t offset;
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, true);
+    make_image();
+    epd_cmd(EPD_CMD_SET_PINS, pins, sizeof(pins));
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    uint32_t size = pack_bits(m_black, IMAGE_SIZE, m_stream);
+    size += pack_bits(m_red, IMAGE_SIZE, m_stream + size);
+    uint32_t crc = crc32(m_stream, size);
+
+    // no session, nothing reaches the panel
+    uint32_t bytes = epd_sim_stats()->bytes;
+    stream_send(0, 100, mtu);
+    CHECK(epd_sim_stats()->bytes == bytes, "stream mtu %d: data without a session written", mtu);
+    CHECK(gatt_write(m_epd.data_handles.value_handle, m_stream, mtu - 2).rejected,
+          "stream mtu %d: data longer than the MTU accepted", mtu);
+
+    upload_begin(0x2468, size, crc, flags, &state);
+    stream_send(0, size / 3, mtu);
+    link_lost();
+    connect();
+    offset = upload_begin(0x2468, size, crc, flags, &state);
+    CHECK(state == EPD_UPLOAD_OPEN && (uint32_t)offset == size / 3, "stream mtu %d: resumed at %d of %u", mtu,
+          offset, size / 3);
+    stream_send(offset, size, mtu);
+    offset = upload_cmd(EPD_CMD_UPLOAD_STATUS, NULL, 0, &state);
+    CHECK(state == EPD_UPLOAD_DONE && (uint32_t)offset == size, "stream mtu %d: status %d at %d of %u", mtu, state,
+          offset, size);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    CHECK(compare_image(true), "stream mtu %d: the panel does not show the uploaded image", mtu);
+
+    // a data write costs its length and 2 bytes of buffer
+    m_credits = 0;
+    credit_cmd(EPD_CMD_CREDIT, NULL, 0);
+    stream_send(0, 2000, mtu);
+    credit_cmd(EPD_CMD_CREDIT, NULL, 0);
+    CHECK(m_credits == 1024, "stream mtu %d: %d credits after data writes, expected the window", mtu, m_credits);
+}
+
+/******************************************************************************
+ * Display list
+ ******************************************************************************/
+static uint8_t m_list[160];
+static uint16_t m_list_len;
+
+static uint16_t list_item(uint8_t op, uint8_t style, const int16_t *v, uint8_t n, const char *text)
+{
+    uint16_t start = m_list_len;
+    uint8_t *p = &m_list[start];
+
+    p[0] = op;
+    p[2] = style;
+    for (uint8_t i = 0; i < n; i++) {
+        p[3 + i * 2] = v[i] >> 8;
+        p[4 + i * 2] = v[i];
+    }
+    p[1] = 1 + n * 2;
+    if (text) {
+        p[p[1] + 2] = FONT_WQY12;
+        memcpy(&p[p[1] + 3], text, strlen(text));
+        p[1] += 1 + strlen(text);
+    }
+    m_list_len += 2 + p[1];
+    return start;
+}
+
+static void list_slot(const int16_t *box, uint8_t style, uint8_t font, uint8_t format, uint8_t slot)
+{
+    uint16_t start = list_item(LIST_SLOT, style, box, 4, NULL);
+    m_list[m_list_len++] = font;
+    m_list[m_list_len++] = format;
+    m_list[m_list_len++] = slot;
+    m_list[start + 1] += 3;
+}
+
+// QR code or barcode: the values, the size bytes and the slot, then the text
+static uint16_t list_code(uint8_t op, uint8_t style, const int16_t *v, uint8_t n, const uint8_t *bytes, uint8_t count,
+                          const char *text)
+{
+    uint16_t start = list_item(op, style, v, n, NULL);
+    memcpy(&m_list[m_list_len], bytes, count);
+    memcpy(&m_list[m_list_len + count], text, strlen(text));
+    m_list_len += count + strlen(text);
+    m_list[start + 1] += count + strlen(text);
+    return start;
+}
+
+// epdShowList() in html/js/main.js: offset, then mtusize - 6 bytes of the list, then LIST_SHOW
+static write_result_t list_send(uint16_t offset, uint16_t mtu, uint8_t flags)
+{
+    uint16_t chunk = mtu - 3 - 3;
+    uint8_t buf[256];
+
+    for (; offset < m_list_len; offset += chunk) {
+        uint16_t n = m_list_len - offset < chunk ? m_list_len - offset : chunk;
+        buf[0] = offset >> 8;
+        buf[1] = offset;
+        memcpy(&buf[2], &m_list[offset], n);
+        epd_cmd(EPD_CMD_LIST_WRITE, buf, n + 2);
+    }
+    return epd_cmd(EPD_CMD_LIST_SHOW, &flags, 1);
+}
+
+static int count_pixels(uint16_t x, uint16_t y, uint16_t w, uint16_t h, epd_sim_color_t color)
+{
+    int n = 0;
+    for (uint16_t j = y; j < y + h; j++) {
+        for (uint16_t i = x; i < x + w; i++)
+            n += epd_sim_pixel(i, j) == color;
+    }
+    return n;
+}
+
+// a few items drawn by the tag, one edited item redrawn alone, the saved list shown again after a reset
+static void test_list(uint16_t mtu)
+{
+    uint8_t id = EPD_UC8176_420_BWR;
+    static const uint8_t bitmap[] = {0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55,
+                                     0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55};
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, true);
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+
+    m_list_len = 0;
+    uint16_t box = list_item(LIST_RECT, LIST_FILL | 0, (int16_t[]){20, 20, 100, 40}, 4, NULL);
+    list_item(LIST_RECT, 2, (int16_t[]){140, 20, 80, 40}, 4, NULL);
+    list_item(LIST_LINE, 0, (int16_t[]){20, 80, 379, 80}, 4, NULL);
+    list_item(LIST_CIRCLE, LIST_FILL | 2, (int16_t[]){300, 200, 30}, 3, NULL);
+    list_item(LIST_TEXT, 0, (int16_t[]){20, 140}, 2, "Hi 年月日");
+    uint16_t bmp = list_item(LIST_BITMAP, 2, (int16_t[]){40, 180, 16, 8, 0}, 5, NULL);
+    m_list[m_list_len++] = LIST_END;
+    m_list[bmp + 11] = m_list_len >> 8;
+    m_list[bmp + 12] = m_list_len;
+    memcpy(&m_list[m_list_len], bitmap, sizeof(bitmap));
+    m_list_len += sizeof(bitmap);
+
+    epd_sim_reset_stats();
+    write_result_t r = list_send(0, mtu, EPD_LIST_FLAG_SAVE);
+    CHECK(m_sd.notify_len == 4 && m_sd.notify_data[0] == EPD_CMD_LIST_SHOW && m_sd.notify_data[1] == 0 &&
+          (m_sd.notify_data[2] << 8 | m_sd.notify_data[3]) == m_list_len && r.fds_ops == 1,
+          "list mtu %d: show not confirmed or not saved", mtu);
+    CHECK(m_epd.display_mode == MODE_LIST && epd_sim_stats()->refreshes == 1, "list mtu %d: not drawn", mtu);
+    CHECK(count_pixels(20, 20, 100, 40, EPD_SIM_BLACK) == 100 * 40, "list mtu %d: filled rectangle", mtu);
+    CHECK(count_pixels(140, 20, 80, 40, EPD_SIM_RED) == 2 * 80 + 2 * 38 &&
+          count_pixels(141, 21, 78, 38, EPD_SIM_WHITE) == 78 * 38, "list mtu %d: rectangle outline", mtu);
+    CHECK(count_pixels(20, 80, 360, 1, EPD_SIM_BLACK) == 360, "list mtu %d: line", mtu);
+    CHECK(epd_sim_pixel(300, 200) == EPD_SIM_RED && epd_sim_pixel(300, 229) == EPD_SIM_RED &&
+          epd_sim_pixel(300, 232) == EPD_SIM_WHITE, "list mtu %d: circle", mtu);
+    CHECK(count_pixels(20, 125, 80, 20, EPD_SIM_BLACK) > 40, "list mtu %d: text", mtu);
+    CHECK(count_pixels(40, 180, 16, 8, EPD_SIM_RED) == 64 && epd_sim_pixel(40, 180) == EPD_SIM_RED &&
+          epd_sim_pixel(41, 180) == EPD_SIM_WHITE, "list mtu %d: bitmap", mtu);
+    CHECK(count_pixels(0, 240, 400, 60, EPD_SIM_WHITE) == 400 * 60, "list mtu %d: background", mtu);
+
+    // only the edited rectangle goes to the panel again, the list is resent from the edit on
+    m_list[box + 2] = LIST_FILL | 2;
+    r = list_send(box, mtu, 0);
+    CHECK(r.fds_ops == 0 && r.panel_bytes < 2 * 120 / 8 * 40 + 200 && epd_sim_stats()->refreshes == 2 &&
+          count_pixels(20, 20, 100, 40, EPD_SIM_RED) == 100 * 40 && epd_sim_pixel(300, 200) == EPD_SIM_RED,
+          "list mtu %d: edit redrew %u panel bytes", mtu, r.panel_bytes);
+
+    // writes must continue the list, a gap or an overflow is refused with the current length
+    uint8_t gap[] = {(m_list_len + 1) >> 8, m_list_len + 1, 0};
+    r = epd_cmd(EPD_CMD_LIST_WRITE, gap, sizeof(gap));
+    CHECK(r.notifications == 1 && m_sd.notify_data[0] == EPD_CMD_LIST_WRITE && m_sd.notify_data[1] == 1 &&
+          (m_sd.notify_data[2] << 8 | m_sd.notify_data[3]) == m_list_len, "list mtu %d: gap not refused", mtu);
+
+    // the saved list is the one before the edit
+    epd_cmd(EPD_CMD_SYS_RESET, NULL, 0);
+    id = 0;
+    epd_cmd(EPD_CMD_LIST_SHOW, &id, 1);
+    CHECK(count_pixels(20, 20, 100, 40, EPD_SIM_BLACK) == 100 * 40 && epd_sim_pixel(300, 200) == EPD_SIM_RED,
+          "list mtu %d: saved list not shown after a reset", mtu);
+    epd_cmd(EPD_CMD_SLEEP, NULL, 0);
+}
+
+// the list is saved from a copy in the background: the status comes once it is in flash, the list is
+// written over meanwhile, a second save is refused until then, a full flash is collected and written again
+static void test_list_save(void)
+{
+    uint8_t id = EPD_UC8176_420_BWR;
+
+    hal_att_mtu = 247;
+    power_on(EPD_SIM_UC8176, true);
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+
+    m_list_len = 0;
+    uint16_t box = list_item(LIST_RECT, LIST_FILL | 0, (int16_t[]){20, 20, 100, 40}, 4, NULL);
+    m_list[m_list_len++] = LIST_END;
+    m_fds.hold = true;
+    write_result_t r = list_send(0, 247, EPD_LIST_FLAG_SAVE);
+    CHECK(r.notifications == 0 && m_fds.queued == 1, "list save: status sent before the record is written");
+
+    m_list[box + 2] = LIST_FILL | 2;
+    r = list_send(box, 247, EPD_LIST_FLAG_SAVE);
+    CHECK(r.notifications == 1 && m_sd.notify_data[0] == EPD_CMD_LIST_SHOW && m_sd.notify_data[1] == 1 &&
+          m_fds.queued == 1 && count_pixels(20, 20, 100, 40, EPD_SIM_RED) == 100 * 40,
+          "list save: second save not refused or the list not shown");
+
+    uint32_t notifications = m_sd.notifications;
+    m_fds.hold = false;
+    fds_process();
+    CHECK(m_sd.notifications == notifications + 1 && m_sd.notify_data[0] == EPD_CMD_LIST_SHOW &&
+          m_sd.notify_data[1] == 0, "list save: status not sent once written");
+    epd_cmd(EPD_CMD_SYS_RESET, NULL, 0);
+    id = 0;
+    epd_cmd(EPD_CMD_LIST_SHOW, &id, 1);
+    CHECK(count_pixels(20, 20, 100, 40, EPD_SIM_BLACK) == 100 * 40, "list save: record torn by a later write");
+
+    // no space: the status comes after garbage collection and the second write
+    list_send(0, 247, 0);
+    m_fds.full = true;
+    r = list_send(box, 247, EPD_LIST_FLAG_SAVE);
+    CHECK(r.notifications == 1 && m_sd.notify_data[1] == 0 && r.fds_ops == 1 && !m_fds.full,
+          "list save: not written after garbage collection");
+    epd_cmd(EPD_CMD_SYS_RESET, NULL, 0);
+    id = 0;
+    epd_cmd(EPD_CMD_LIST_SHOW, &id, 1);
+    CHECK(count_pixels(20, 20, 100, 40, EPD_SIM_RED) == 100 * 40, "list save: list lost with a full flash");
+    epd_cmd(EPD_CMD_SLEEP, NULL, 0);
+}
+
+// a template saved once, then slot values of a few bytes, each redrawing its own slot
+static void test_slots(uint16_t mtu)
+{
+    uint8_t id = EPD_UC8176_420_BWR;
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, true);
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+
+    m_list_len = 0;
+    list_item(LIST_RECT, 0, (int16_t[]){20, 100, 360, 120}, 4, NULL);
+    list_slot((int16_t[]){30, 110, 200, 24}, 0, FONT_WQY12, LIST_ALIGN_LEFT, 0);
+    list_slot((int16_t[]){200, 170, 170, 40}, 2, FONT_HELVB18, LIST_ALIGN_RIGHT | LIST_NUMBER | 2 << 4, 1);
+    m_list[m_list_len++] = LIST_END;
+    list_send(0, mtu, EPD_LIST_FLAG_SAVE);
+
+    uint8_t set[] = {EPD_LIST_FLAG_SAVE, 0, 9, 'H', 'i', ' ', 0xE5, 0xB9, 0xB4, 0xE6, 0x9C, 0x88, // "Hi 年月"
+                     1, 4, 0x00, 0x00, 0x05, 0x13};
+    write_result_t r = epd_cmd(EPD_CMD_SLOT_SET, set, sizeof(set));
+    CHECK(r.notifications == 1 && m_sd.notify_data[0] == EPD_CMD_SLOT_SET && m_sd.notify_data[1] == 0 &&
+          r.fds_ops == 1, "slots mtu %d: set not confirmed or not saved", mtu);
+    int name = count_pixels(30, 110, 200, 24, EPD_SIM_BLACK);
+    CHECK(name > 40 && count_pixels(300, 170, 70, 40, EPD_SIM_RED) > 40 &&
+          count_pixels(200, 170, 60, 40, EPD_SIM_RED) == 0, "slots mtu %d: values not drawn in their boxes", mtu);
+    CHECK(count_pixels(20, 100, 360, 1, EPD_SIM_BLACK) == 360, "slots mtu %d: template not drawn", mtu);
+
+    // a new price is 8 bytes over the air and only its box goes to the panel
+    uint8_t price[] = {0, 1, 4, 0xFF, 0xFF, 0xFF, 0x9C};
+    r = epd_cmd(EPD_CMD_SLOT_SET, price, sizeof(price));
+    CHECK(r.fds_ops == 0 && r.panel_bytes < 2 * 176 / 8 * 40 + 200 && m_sd.notify_data[1] == 0 &&
+          count_pixels(30, 110, 200, 24, EPD_SIM_BLACK) == name && count_pixels(300, 170, 70, 40, EPD_SIM_RED) > 40,
+          "slots mtu %d: price update redrew %u panel bytes", mtu, r.panel_bytes);
+
+    // a bad entry sets nothing
+    uint8_t bad[] = {0, 1, 4, 0, 0, 0, 1, LIST_SLOT_COUNT, 1, 'x'};
+    r = epd_cmd(EPD_CMD_SLOT_SET, bad, sizeof(bad));
+    CHECK(r.notifications == 1 && m_sd.notify_data[1] == 1 && r.panel_bytes == 0,
+          "slots mtu %d: bad slot not refused", mtu);
+
+    // the saved values come back with the template
+    epd_cmd(EPD_CMD_SYS_RESET, NULL, 0);
+    id = 0;
+    epd_cmd(EPD_CMD_LIST_SHOW, &id, 1);
+    CHECK(count_pixels(30, 110, 200, 24, EPD_SIM_BLACK) == name && count_pixels(300, 170, 70, 40, EPD_SIM_RED) > 40,
+          "slots mtu %d: saved values not shown after a reset", mtu);
+
+    // the values are saved from a copy, the status comes once they are in flash and a second save is
+    // refused with none of its values set
+    uint8_t wide[] = {EPD_LIST_FLAG_SAVE, 0, 4, 'W', 'W', 'W', 'W'};
+    uint8_t thin[] = {0, 0, 1, 'I'};
+    m_fds.hold = true;
+    r = epd_cmd(EPD_CMD_SLOT_SET, wide, sizeof(wide));
+    int drawn = count_pixels(30, 110, 200, 24, EPD_SIM_BLACK);
+    CHECK(r.notifications == 0 && drawn > 0, "slots mtu %d: status sent before the values are written", mtu);
+    r = epd_cmd(EPD_CMD_SLOT_SET, thin, sizeof(thin));
+    int thin_drawn = count_pixels(30, 110, 200, 24, EPD_SIM_BLACK);
+    CHECK(r.notifications == 1 && m_sd.notify_data[1] == 0 && thin_drawn < drawn,
+          "slots mtu %d: value not set while saving", mtu);
+    r = epd_cmd(EPD_CMD_SLOT_SET, wide, sizeof(wide));
+    CHECK(r.notifications == 1 && m_sd.notify_data[0] == EPD_CMD_SLOT_SET && m_sd.notify_data[1] == 1 &&
+          count_pixels(30, 110, 200, 24, EPD_SIM_BLACK) == thin_drawn,
+          "slots mtu %d: second save not refused or its values set", mtu);
+    uint32_t notifications = m_sd.notifications;
+    m_fds.hold = false;
+    fds_process();
+    CHECK(m_sd.notifications == notifications + 1 && m_sd.notify_data[0] == EPD_CMD_SLOT_SET &&
+          m_sd.notify_data[1] == 0, "slots mtu %d: status not sent once written", mtu);
+    epd_cmd(EPD_CMD_SYS_RESET, NULL, 0);
+    epd_cmd(EPD_CMD_LIST_SHOW, &id, 1);
+    CHECK(count_pixels(30, 110, 200, 24, EPD_SIM_BLACK) == drawn,
+          "slots mtu %d: saved values torn by a later set", mtu);
+    epd_cmd(EPD_CMD_SLEEP, NULL, 0);
+}
+
+// a QR code bound to a slot and a barcode: every module where it belongs, a new slot value redraws only the QR code
+static void test_codes(uint16_t mtu)
+{
+    uint8_t id = EPD_UC8176_420_BWR, symbols[CODE128_MAX_SYMBOLS];
+    static const char *urls[] = {"https://e.co/p1", "https://e.co/p2"};
+    const char *sku = "4006381333931";
+    qr_code_t qr;
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, true);
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+
+    m_list_len = 0;
+    list_code(LIST_QRCODE, 0, (int16_t[]){40, 40}, 2, (uint8_t[]){4, QR_ECC_L, 2}, 3, "");
+    list_code(LIST_BARCODE, 2, (int16_t[]){40, 200, 60}, 3, (uint8_t[]){2, LIST_NO_SLOT}, 2, sku);
+    list_code(LIST_QRCODE, 0, (int16_t[]){300, 40}, 2, (uint8_t[]){1, 2, LIST_NO_SLOT}, 3, "bad level");
+    m_list[m_list_len++] = LIST_END;
+    list_send(0, mtu, 0);
+
+    for (int n = 0; n < 2; n++) {
+        uint8_t set[3 + 15] = {0, 2, strlen(urls[n])};
+        memcpy(&set[3], urls[n], strlen(urls[n]));
+        write_result_t r = epd_cmd(EPD_CMD_SLOT_SET, set, sizeof(set));
+        QR_Encode(&qr, (const uint8_t *)urls[n], strlen(urls[n]), QR_ECC_L);
+        int wrong = 0;
+        for (int j = 0; j < qr.size * 4; j++) {
+            for (int i = 0; i < qr.size * 4; i++)
+                wrong += epd_sim_pixel(40 + i, 40 + j) != (QR_GetModule(&qr, i / 4, j / 4) ? EPD_SIM_BLACK : EPD_SIM_WHITE);
+        }
+        CHECK(qr.size == 21 && wrong == 0, "codes mtu %d: %d wrong pixels in QR code %d", mtu, wrong, n);
+        if (n > 0)
+            CHECK(r.panel_bytes < 2 * 88 / 8 * 84 + 200, "codes mtu %d: new slot value redrew %u panel bytes", mtu,
+                  r.panel_bytes);
+    }
+
+    uint8_t count = CODE128_Encode((const uint8_t *)sku, strlen(sku), symbols);
+    int wrong = 0, m = 0;
+    for (int s = 0; s < count; s++) {
+        for (int b = (symbols[s] == 106 ? 13 : 11) - 1; b >= 0; b--, m++) {
+            epd_sim_color_t color = (CODE128_Pattern(symbols[s]) >> b) & 1 ? EPD_SIM_RED : EPD_SIM_WHITE;
+            wrong += epd_sim_pixel(40 + m * 2, 200) != color || epd_sim_pixel(41 + m * 2, 259) != color;
+        }
+    }
+    CHECK(count > 0 && wrong == 0 && count_pixels(40, 199, 400 - 40, 1, EPD_SIM_WHITE) == 360 &&
+          count_pixels(40, 260, 400 - 40, 1, EPD_SIM_WHITE) == 360, "codes mtu %d: barcode, %d wrong modules", mtu, wrong);
+    CHECK(count_pixels(300, 40, 100, 100, EPD_SIM_WHITE) == 100 * 100, "codes mtu %d: bad level drawn", mtu);
+    epd_cmd(EPD_CMD_SLEEP, NULL, 0);
+}
+
+/******************************************************************************
+ * Font pack upload
+ ******************************************************************************/
+// sendFontPack() in html/js/main.js: erase, the pack from offset 4, then the crc, NULL if all confirmed
+static const char *font_send(const uint8_t *pack, uint32_t size, uint16_t mtu)
+{
+    uint16_t chunk = (mtu - 3 - 5) / 4 * 4;
+    uint8_t buf[256];
+
+    write_result_t r = epd_cmd(EPD_CMD_FONT_ERASE, NULL, 0);
+    if (r.notifications != 1 || m_sd.notify_data[0] != EPD_CMD_FONT_ERASE || m_sd.notify_data[1] != 0)
+        return "erase";
+    for (uint32_t i = 4; i < size; i += chunk) {
+        uint16_t n = size - i < chunk ? size - i : chunk;
+        buf[0] = i >> 24;
+        buf[1] = i >> 16;
+        buf[2] = i >> 8;
+        buf[3] = i;
+        memcpy(&buf[4], &pack[i], n);
+        r = epd_cmd(EPD_CMD_FONT_WRITE, buf, n + 4);
+        if (r.notifications != 1 || m_sd.notify_len != 6 || m_sd.notify_data[1] != 0)
+            return "write";
+    }
+    uint32_t crc = crc32(pack + 4, size - 4);
+    uint8_t c[] = {crc >> 24, crc >> 16, crc >> 8, crc};
+    r = epd_cmd(EPD_CMD_FONT_COMMIT, c, sizeof(c));
+    if (r.notifications != 1 || m_sd.notify_data[0] != EPD_CMD_FONT_COMMIT || m_sd.notify_data[1] != 0)
+        return "commit";
+    return NULL;
+}
+
+static void test_font(uint16_t mtu)
+{
+    static uint8_t pack[3000];
+    epd_font_header_t *header = (epd_font_header_t *)pack;
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, true);
+
+    for (uint32_t i = 0; i < sizeof(pack); i++)
+        pack[i] = i * 7;
+    header->magic = 0xFFFFFFFF;
+    header->count = 0;
+    header->size = sizeof(pack);
+
+    const char *step = font_send(pack, sizeof(pack), mtu);
+    CHECK(step == NULL, "font mtu %d: %s not confirmed", mtu, step);
+}
+
+// a pack of one user font
+static uint32_t font_pack(uint8_t *pack, const uint8_t *font, uint32_t size)
+{
+    epd_font_header_t *header = (epd_font_header_t *)pack;
+    epd_font_entry_t *entry = (epd_font_entry_t *)(header + 1);
+
+    memset(pack, 0, sizeof(epd_font_header_t) + sizeof(epd_font_entry_t));
+    header->magic = 0xFFFFFFFF;
+    header->count = 1;
+    header->size = sizeof(epd_font_header_t) + sizeof(epd_font_entry_t) + size;
+    entry->id = FONT_USER;
+    entry->offset = sizeof(epd_font_header_t) + sizeof(epd_font_entry_t);
+    memcpy(pack + entry->offset, font, size);
+    return header->size;
+}
+
+// text in a user font is redrawn when the pack under it is replaced or erased, the item bytes stay the same
+static void test_font_list(void)
+{
+    static uint8_t pack[1024];
+    uint8_t id = EPD_UC8176_420_BWR, flags = 0;
+
+    hal_att_mtu = 247;
+    power_on(EPD_SIM_UC8176, true);
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+
+    const char *step = font_send(pack, font_pack(pack, u8g2_font_helvB14_tn, 287), 247); // sizes in fonts.c
+    CHECK(step == NULL, "font list: %s not confirmed", step);
+    m_list_len = 0;
+    uint16_t text = list_item(LIST_TEXT, 0, (int16_t[]){20, 140}, 2, "0110");
+    m_list[text + 7] = FONT_USER;
+    m_list[m_list_len++] = LIST_END;
+    list_send(0, 247, 0);
+    int small = count_pixels(20, 100, 160, 50, EPD_SIM_BLACK);
+    CHECK(small > 40, "font list: text not drawn in the user font");
+
+    // the same font with the glyphs of 1 and 7 swapped, the text keeps its box
+    uint32_t size = font_pack(pack, u8g2_font_helvB14_tn, 287);
+    for (uint8_t *glyph = pack + size - 287 + 23; glyph[1] != 0; glyph += glyph[1]) {
+        if (glyph[0] == '1' || glyph[0] == '7')
+            glyph[0] ^= '1' ^ '7';
+    }
+    step = font_send(pack, size, 247);
+    CHECK(step == NULL, "font list: %s not confirmed", step);
+    epd_cmd(EPD_CMD_LIST_SHOW, &flags, 1);
+    int swapped = count_pixels(20, 100, 160, 50, EPD_SIM_BLACK);
+    CHECK(swapped > 0 && swapped != small, "font list: not redrawn with the new pack");
+
+    epd_cmd(EPD_CMD_FONT_ERASE, NULL, 0);
+    epd_cmd(EPD_CMD_LIST_SHOW, &flags, 1);
+    CHECK(count_pixels(20, 100, 160, 50, EPD_SIM_BLACK) == 0, "font list: text of an erased pack still shown");
+    epd_cmd(EPD_CMD_SLEEP, NULL, 0);
+}
+
+/******************************************************************************
+ * Malformed writes
+ ******************************************************************************/
+enum {
+    PRE_NONE,   // right after connecting
+    PRE_INIT,   // after EPD_CMD_INIT
+};
+
+enum {
+    X_REJECT = 1 << 0,  // refused by the SoftDevice
+    X_PANEL  = 1 << 1,  // bytes sent to the panel
+    X_FLASH  = 1 << 2,  // FDS record written or deleted
+    X_NOTIFY = 1 << 3,  // notification sent
+    X_RESET  = 1 << 4,  // reset or system off
+};
+
+typedef struct {
+    const char *name;
+    uint8_t pre;
+    uint8_t expect;
+    uint16_t len;
+    uint8_t data[16];
+} malformed_t;
+
+static const malformed_t malformed[] = {
+    {"empty write",                   PRE_INIT, 0,                 0,   {0}},
+    {"unknown command",               PRE_INIT, 0,                 4,   {0x7F, 1, 2, 3}},
+    {"write longer than the MTU",     PRE_INIT, X_REJECT,          245, {EPD_CMD_SEND_DATA}},
+    {"SET_PINS short",                PRE_INIT, 0,                 5,   {EPD_CMD_SET_PINS, 1, 2, 3, 4}},
+    {"SET_PINS out of range",         PRE_INIT, X_FLASH,           8,   {EPD_CMD_SET_PINS, 0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6}},
+    {"INIT unknown model",            PRE_INIT, X_PANEL | X_FLASH, 2,   {EPD_CMD_INIT, 0x7F}},
+    {"INIT same model again",         PRE_INIT, X_PANEL,           2,   {EPD_CMD_INIT, EPD_UC8176_420_BWR}},
+    {"CLEAR before INIT",             PRE_NONE, 0,                 1,   {EPD_CMD_CLEAR}},
+    {"REFRESH before INIT",           PRE_NONE, 0,                 1,   {EPD_CMD_REFRESH}},
+    {"SLEEP before INIT",             PRE_NONE, 0,                 1,   {EPD_CMD_SLEEP}},
+    {"WRITE_IMAGE before INIT",       PRE_NONE, 0,                 3,   {EPD_CMD_WRITE_IMAGE, 0x0F, 0x00}},
+    {"SEND_COMMAND short",            PRE_INIT, 0,                 1,   {EPD_CMD_SEND_COMMAND}},
+    {"SEND_DATA without data",        PRE_INIT, 0,                 1,   {EPD_CMD_SEND_DATA}},
+    {"SET_TIME short",                PRE_INIT, 0,                 4,   {EPD_CMD_SET_TIME, 0x67, 0x9A, 0x3E}},
+    {"SET_TIME unknown mode",         PRE_INIT, X_PANEL,           7,   {EPD_CMD_SET_TIME, 0x67, 0x9A, 0x3E, 0xEC, 8, 9}},
+    {"WRITE_IMAGE without data",      PRE_INIT, 0,                 2,   {EPD_CMD_WRITE_IMAGE, 0x0F}},
+    {"WRITE_IMAGE without ram begin", PRE_INIT, X_PANEL,           4,   {EPD_CMD_WRITE_IMAGE, 0xFF, 0x00, 0x00}},
+    {"WRITE_IMAGE_RLE before INIT",   PRE_NONE, 0,                 4,   {EPD_CMD_WRITE_IMAGE_RLE, 0x0F, 0x81, 0x00}},
+    {"WRITE_IMAGE_RLE no ram begin",  PRE_INIT, 0,                 4,   {EPD_CMD_WRITE_IMAGE_RLE, 0xFF, 0x81, 0x00}},
+    {"WRITE_IMAGE_RLE run without byte", PRE_INIT, X_PANEL,        3,   {EPD_CMD_WRITE_IMAGE_RLE, 0x0F, 0x81}},
+    {"WRITE_REGION unaligned",        PRE_INIT, 0,                 12,  {EPD_CMD_WRITE_REGION, 0x0F, 0, 4, 0, 0, 0, 8, 0, 1, 0x81, 0x00}},
+    {"WRITE_REGION past the screen",  PRE_INIT, 0,                 12,  {EPD_CMD_WRITE_REGION, 0x0F, 1, 0x88, 0, 0, 0, 16, 0, 1, 0x81, 0x00}},
+    {"WRITE_REGION no ram begin",     PRE_INIT, 0,                 4,   {EPD_CMD_WRITE_REGION, 0xFF, 0x81, 0x00}},
+    {"REFRESH_REGION short",          PRE_INIT, 0,                 5,   {EPD_CMD_REFRESH_REGION, 0, 0, 0, 8}},
+    {"REFRESH_REGION empty",          PRE_INIT, 0,                 9,   {EPD_CMD_REFRESH_REGION, 0, 0, 0, 0, 0, 8, 0, 0}},
+    {"FONT_WRITE short",              PRE_INIT, 0,                 5,   {EPD_CMD_FONT_WRITE, 0, 0, 0, 4}},
+    {"FONT_WRITE at offset 0",        PRE_INIT, X_NOTIFY,          6,   {EPD_CMD_FONT_WRITE, 0, 0, 0, 0, 1}},
+    {"FONT_WRITE unaligned",          PRE_INIT, X_NOTIFY,          6,   {EPD_CMD_FONT_WRITE, 0, 0, 0, 5, 1}},
+    {"FONT_WRITE past the region",    PRE_INIT, X_NOTIFY,          6,   {EPD_CMD_FONT_WRITE, 0, 0, 0x80, 0, 1}},
+    {"FONT_COMMIT short",             PRE_INIT, 0,                 3,   {EPD_CMD_FONT_COMMIT, 0, 0}},
+    {"FONT_COMMIT without pack",      PRE_INIT, X_NOTIFY,          5,   {EPD_CMD_FONT_COMMIT, 0, 0, 0, 0}},
+    {"BATCH empty",                   PRE_INIT, 0,                 1,   {EPD_CMD_BATCH}},
+    {"BATCH command of length 0",     PRE_INIT, 0,                 4,   {EPD_CMD_BATCH, 1, EPD_CMD_SLEEP, 0}},
+    {"BATCH past the write",          PRE_INIT, 0,                 4,   {EPD_CMD_BATCH, 1, EPD_CMD_SLEEP, 2}},
+    {"BATCH nested",                  PRE_INIT, 0,                 6,   {EPD_CMD_BATCH, 1, EPD_CMD_SLEEP, 2, EPD_CMD_BATCH, EPD_CMD_SLEEP}},
+    {"BATCH with CREDIT",             PRE_INIT, 0,                 5,   {EPD_CMD_BATCH, 1, EPD_CMD_CREDIT, 1, EPD_CMD_SLEEP}},
+    {"LIST_WRITE short",              PRE_INIT, 0,                 2,   {EPD_CMD_LIST_WRITE, 0}},
+    {"LIST_WRITE past the list",      PRE_INIT, X_NOTIFY,          4,   {EPD_CMD_LIST_WRITE, 0, 8, 1}},
+    {"LIST_WRITE past the buffer",    PRE_INIT, X_NOTIFY,          4,   {EPD_CMD_LIST_WRITE, 2, 0, 1}},
+    {"LIST_SHOW empty list",          PRE_INIT, X_PANEL | X_NOTIFY, 1,  {EPD_CMD_LIST_SHOW}},
+    {"SLOT_SET short",                PRE_INIT, 0,                 1,   {EPD_CMD_SLOT_SET}},
+    {"SLOT_SET slot out of range",    PRE_INIT, X_NOTIFY,          5,   {EPD_CMD_SLOT_SET, 0, LIST_SLOT_COUNT, 1, 'x'}},
+    {"SLOT_SET value too long",       PRE_INIT, X_NOTIFY,          4,   {EPD_CMD_SLOT_SET, 0, 0, LIST_SLOT_SIZE}},
+    {"SLOT_SET past the write",       PRE_INIT, X_NOTIFY,          5,   {EPD_CMD_SLOT_SET, 0, 0, 2, 'x'}},
+    {"SET_CONFIG empty",              PRE_INIT, 0,                 1,   {EPD_CMD_SET_CONFIG}},
+    {"SET_CONFIG longer than config", PRE_INIT, X_FLASH,           14,  {EPD_CMD_SET_CONFIG, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x03, 0x09, 0x03, 0xFF, 0xEE, 0xEE}},
+    {"SYS_RESET",                     PRE_INIT, X_RESET,           1,   {EPD_CMD_SYS_RESET}},
+    {"SYS_SLEEP",                     PRE_INIT, X_RESET,           1,   {EPD_CMD_SYS_SLEEP}},
+    {"CFG_ERASE",                     PRE_INIT, X_FLASH | X_RESET, 1,   {EPD_CMD_CFG_ERASE}},
+};
+
+static void test_malformed(void)
+{
+    uint8_t buf[256];
+
+    hal_att_mtu = 247;
+    printf("\n%-32s %3s %-8s %6s %5s %6s %5s\n", "malformed write", "len", "result", "panel", "flash", "notify",
+           "reset");
+    for (unsigned i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+        const malformed_t *m = &malformed[i];
+        uint8_t id = EPD_UC8176_420_BWR;
+        int len = m->len;
+
+        power_on(EPD_SIM_UC8176, true);
+        if (m->pre == PRE_INIT) epd_cmd(EPD_CMD_INIT, &id, 1);
+
+        memset(buf, 0, sizeof(buf));
+        memcpy(buf, m->data, sizeof(m->data));
+        write_result_t r = epd_write(buf, len);
+        uint8_t got = (r.rejected ? X_REJECT : 0) | (r.panel_bytes ? X_PANEL : 0) | (r.fds_ops ? X_FLASH : 0) |
+                      (r.notifications ? X_NOTIFY : 0) | (r.reset ? X_RESET : 0);
+        printf("%-32s %3d %-8s %6u %5u %6u %5s\n", m->name, len, r.rejected ? "rejected" : "handled",
+               r.panel_bytes, r.fds_ops, r.notifications, r.reset == 1 ? "reset" : r.reset == 2 ? "off" : "");
+        CHECK(got == m->expect, "%s: outcome 0x%02x, expected 0x%02x", m->name, got, m->expect);
+        CHECK(epd_sim_stats()->busy_bytes == 0, "%s: %u bytes sent while busy", m->name, epd_sim_stats()->busy_bytes);
+    }
+
+    // config survives a reset, CFG_ERASE falls back to the defaults
+    uint8_t cfg[] = {0x05, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x01, 0x07, 0xFF, 0xFF};
+    power_on(EPD_SIM_UC8176, true);
+    epd_cmd(EPD_CMD_SET_CONFIG, cfg, sizeof(cfg));
+    epd_cmd(EPD_CMD_SYS_RESET, NULL, 0);
+    CHECK(memcmp(&m_epd.config, cfg, sizeof(cfg)) == 0, "config lost over a reset");
+    epd_cmd(EPD_CMD_CFG_ERASE, NULL, 0);
+    CHECK(m_epd.config.mosi_pin == 0x0A && m_epd.config.model_id == 0x03, "CFG_ERASE did not restore the defaults");
+}
+
+/******************************************************************************
+ * Phase timing
+ ******************************************************************************/
+static const char *perf_names[EPD_PERF_COUNT] = {
+    "ON_WRITE", "WRITE_IMAGE", "GUI_UPDATE", "RENDER", "SPI", "BUSY", "TEMP", "REFRESH", "IDLE",
+};
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// readPerf() in html/js/main.js
+static int read_perf(uint32_t counts[EPD_PERF_COUNT], bool print)
+{
+    uint8_t data[256];
+    uint16_t len = gatt_read(m_epd.perf_handles.value_handle, data, sizeof(data));
+
+    if (len != EPD_PERF_DATA_SIZE || data[0] != EPD_PERF_VERSION || data[1] != EPD_PERF_COUNT) {
+        printf("FAIL perf mtu %d: %d bytes, version %d, %d phases\n", hal_att_mtu, len, data[0], data[1]);
+        failures++;
+        return 0;
+    }
+    if (print) printf("\n%-12s %6s %9s %9s %9s\n", "phase (sim)", "count", "min us", "avg us", "max us");
+    for (int i = 0; i < EPD_PERF_COUNT; i++) {
+        const uint8_t *p = &data[4 + i * 16];
+        counts[i] = get_u32(p);
+        CHECK(get_u32(p + 4) <= get_u32(p + 8) && get_u32(p + 8) <= get_u32(p + 12),
+              "perf %s: min %u avg %u max %u", perf_names[i], get_u32(p + 4), get_u32(p + 8), get_u32(p + 12));
+        if (print)
+            printf("%-12s %6u %9u %9u %9u\n", perf_names[i], counts[i], get_u32(p + 4), get_u32(p + 8),
+                   get_u32(p + 12));
+    }
+    return 1;
+}
+
+static void test_perf(uint16_t mtu)
+{
+    uint8_t id = EPD_UC8176_420_BWR;
+    uint8_t t[] = {0x67, 0x9A, 0x3E, 0xEC, 8, MODE_CLOCK};
+    uint32_t counts[EPD_PERF_COUNT];
+    upload_stats_t u = {0};
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_UC8176, true);
+    if (!read_perf(counts, false)) return;
+    for (int i = 0; i < EPD_PERF_COUNT; i++)
+        CHECK(counts[i] == 0, "perf mtu %d: %s counted %u times after boot", mtu, perf_names[i], counts[i]);
+
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    upload_plane(m_black, true, mtu - 3, false, &u);
+    upload_plane(m_red, false, mtu - 3, false, &u);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    epd_cmd(EPD_CMD_SET_TIME, t, sizeof(t));
+    m_timestamp += 60;
+    ble_epd_on_timer(&m_epd, m_timestamp, false);
+    app_sched_execute();
+
+    if (!read_perf(counts, mtu == 23)) return;
+    CHECK(counts[EPD_PERF_ON_WRITE] == u.writes + 3, "perf mtu %d: %u writes timed, expected %u", mtu,
+          counts[EPD_PERF_ON_WRITE], u.writes + 3);
+    CHECK(counts[EPD_PERF_WRITE_IMAGE] == u.writes, "perf mtu %d: %u image writes timed, expected %u", mtu,
+          counts[EPD_PERF_WRITE_IMAGE], u.writes);
+    CHECK(counts[EPD_PERF_GUI_UPDATE] == 2 && counts[EPD_PERF_RENDER] == 2 && counts[EPD_PERF_TEMP] == 2,
+          "perf mtu %d: %u GUI updates, %u renders, %u temperature reads, expected 2", mtu,
+          counts[EPD_PERF_GUI_UPDATE], counts[EPD_PERF_RENDER], counts[EPD_PERF_TEMP]);
+    CHECK(counts[EPD_PERF_REFRESH] == 3, "perf mtu %d: %u refreshes, expected 3", mtu, counts[EPD_PERF_REFRESH]);
+    CHECK(counts[EPD_PERF_SPI] > u.writes && counts[EPD_PERF_BUSY] > 0, "perf mtu %d: %u SPI transfers, %u BUSY waits",
+          mtu, counts[EPD_PERF_SPI], counts[EPD_PERF_BUSY]);
+}
+
+/******************************************************************************
+ * Event trace
+ ******************************************************************************/
+static void test_trace(uint16_t mtu)
+{
+    uint8_t id = EPD_SSD1619_420_BW;
+    uint8_t t[] = {0x67, 0x9A, 0x3E, 0xEC, 8, MODE_CALENDAR};
+    uint8_t data[EPD_TRACE_DATA_SIZE];
+    upload_stats_t u = {0};
+
+    hal_att_mtu = mtu;
+    power_on(EPD_SIM_SSD1619, false);
+    uint32_t rtt_start = m_rtt_len; // boot() drained what was there before
+
+    epd_cmd(EPD_CMD_INIT, &id, 1);
+    upload_plane(m_black, true, mtu - 3, false, &u);
+    epd_cmd(EPD_CMD_REFRESH, NULL, 0);
+    epd_cmd(EPD_CMD_SET_TIME, t, sizeof(t));
+    rtt_drain();
+
+    // RTT: a stream header, then every record since boot
+    const uint8_t *stream = m_rtt + rtt_start;
+    uint32_t stream_len = m_rtt_len - rtt_start;
+    if (stream_len < 16 || get_u32(stream) != EPD_TRACE_MAGIC || stream[4] != 0 ||
+        stream[5] != EPD_TRACE_VERSION || !(stream[7] & EPD_TRACE_FLAG_STREAM) || (stream_len - 16) % 8) {
+        printf("FAIL trace mtu %d: RTT stream of %u bytes without a header\n", mtu, stream_len);
+        failures++;
+        return;
+    }
+    const epd_trace_record_t *records = (const epd_trace_record_t *)(stream + 16);
+    uint32_t total = (stream_len - 16) / 8;
+    uint32_t writes = 0, spi = 0, refreshes = 0;
+    for (uint32_t i = 0; i < total; i++) {
+        if (records[i].id == EPD_TRACE_WRITE && records[i].a == EPD_CMD_WRITE_IMAGE) writes++;
+        if (records[i].id == EPD_TRACE_SPI_WRITE) spi++;
+        if (records[i].id == EPD_TRACE_REFRESH_BEGIN) refreshes++;
+        CHECK(i == 0 || ((records[i].time - records[i - 1].time) & 0xFFFFFF) < 0x800000,
+              "trace mtu %d: record %u goes back in time", mtu, i);
+    }
+    CHECK(records[0].id == EPD_TRACE_CONNECT, "trace mtu %d: first record %d, expected CONNECT", mtu, records[0].id);
+    CHECK(writes == u.writes && spi > u.writes && refreshes == 2,
+          "trace mtu %d: %u image writes, %u SPI transfers, %u refreshes", mtu, writes, spi, refreshes);
+    CHECK(records[total - 1].id == EPD_TRACE_GUI_END && records[total - 1].a == 1,
+          "trace mtu %d: last record %d, expected GUI_END", mtu, records[total - 1].id);
+
+    // the characteristic: the same last records
+    uint16_t len = gatt_read(m_epd.trace_handles.value_handle, data, sizeof(data));
+    uint16_t count = data[12] | (data[13] << 8);
+    CHECK(len == EPD_TRACE_DATA_SIZE && get_u32(data) == EPD_TRACE_MAGIC && !(data[7] & EPD_TRACE_FLAG_STREAM) &&
+          get_u32(data + 8) == total && count == EPD_TRACE_READ_MAX,
+          "trace mtu %d: read %d bytes, %u records of %u, RTT has %u", mtu, len, count, get_u32(data + 8), total);
+    CHECK(count <= total && memcmp(data + 16, &records[total - count], count * 8) == 0,
+          "trace mtu %d: the characteristic does not match the RTT stream", mtu);
+
+    // adding a record only fills the ring until half of it waits, a burst longer than the ring loses nothing
+    uint8_t rtt[EPD_TRACE_SIZE * 4 * 8];
+    for (uint32_t i = 0; i < EPD_TRACE_SIZE / 2 - 1; i++)
+        epd_trace_add(i, EPD_TRACE_TEMP, i, 0);
+    CHECK(epd_sim_rtt_read(1, rtt, sizeof(rtt)) == 0, "trace mtu %d: records sent to RTT when added", mtu);
+    for (uint32_t i = EPD_TRACE_SIZE / 2 - 1; i < EPD_TRACE_SIZE * 4; i++)
+        epd_trace_add(i, EPD_TRACE_TEMP, i, 0);
+    epd_trace_flush();
+    uint32_t n = epd_sim_rtt_read(1, rtt, sizeof(rtt)), lost = 0;
+    records = (const epd_trace_record_t *)rtt;
+    for (uint32_t i = 0; i < n / 8; i++)
+        lost += records[i].time != i;
+    CHECK(n == sizeof(rtt) && lost == 0, "trace mtu %d: burst flushed %u bytes, %u out of order", mtu, n, lost);
+}
+
+/******************************************************************************
+ * Replay
+ ******************************************************************************/
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// the last whitespace separated token that is all hex, e.g. "08:30:12 ⇑ 3000ff..."
+static int parse_line(char *line, uint8_t *data)
+{
+    int len = -1;
+
+    for (char *tok = strtok(line, " \t\r\n"); tok; tok = strtok(NULL, " \t\r\n")) {
+        size_t n = strlen(tok), i;
+        for (i = 0; i < n && hex_value(tok[i]) >= 0; i++)
+            ;
+        if (i != n || n % 2 || n / 2 > 255) continue;
+        for (i = 0; i < n / 2; i++)
+            data[i] = hex_value(tok[2 * i]) << 4 | hex_value(tok[2 * i + 1]);
+        len = n / 2;
+    }
+    return len;
+}
+
+static int replay(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[1024];
+    uint8_t data[256];
+    int lineno = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        if (line[0] == '#') continue;
+        int len = parse_line(line, data);
+        if (len < 0) continue;
+        write_result_t r = epd_write(data, len);
+        if (r.rejected) printf("%s:%d: write of %d bytes rejected, MTU %d\n", path, lineno, len, hal_att_mtu);
+        if (r.reset) printf("%s:%d: %s\n", path, lineno, r.reset == 1 ? "reset" : "system off");
+    }
+    fclose(f);
+    return 1;
+}
+
+/******************************************************************************/
+static void print_stats(void)
+{
+    printf("\n%-12s %6s %5s %8s %9s %9s %9s %9s %9s %5s %6s\n", "command", "writes", "rej", "payload",
+           "host ns", "host max", "device us", "dev max", "panel B", "flash", "notify");
+    for (int i = 0; i < 257; i++) {
+        cmd_stats_t *s = &m_stats[i];
+        char name[16];
+        if (s->count == 0 && s->rejected == 0) continue;
+        if (i == 256)
+            snprintf(name, sizeof(name), "(empty)");
+        else if (cmd_name(i))
+            snprintf(name, sizeof(name), "%s", cmd_name(i));
+        else
+            snprintf(name, sizeof(name), "0x%02X", i);
+        printf("%-12s %6u %5u %8llu %9.0f %9.0f %9.0f %9llu %9llu %5u %6u\n", name, s->count, s->rejected,
+               (unsigned long long)s->payload, s->count ? s->host_ns / s->count : 0, s->host_max,
+               s->count ? (double)s->sim_us / s->count : 0, (unsigned long long)s->sim_max,
+               (unsigned long long)s->panel_bytes, s->fds_ops, s->notifications);
+    }
+}
+
+static int save_trace(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+
+    rtt_drain();
+    if (f == NULL || fwrite(m_rtt, 1, m_rtt_len, f) != m_rtt_len) {
+        perror(path);
+        if (f) fclose(f);
+        return 0;
+    }
+    fclose(f);
+    return 1;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: ble_harness [-m MTU] [-d MODEL] [-p N|nrf51|nrf52] [-o panel.ppm] [-t trace.bin] [log...]\n"
+            "  -m MTU             ATT MTU of the link, 23 (S130) to 247 (S112) (23)\n"
+            "  -d MODEL           model id of the attached controller, see epd_model_id_t (1)\n"
+            "  -p N|nrf51|nrf52   GUI page height (nrf51)\n"
+            "  -o FILE            write the panel after the replay\n"
+            "  -t FILE            write the event trace streamed to RTT\n"
+            "without logs the built-in sequences are run and checked\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    int model = 0;
+    const char *output = NULL, *trace = NULL;
+    int i;
+
+    for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++) {
+        if (argv[i][2] != '\0' || i + 1 >= argc) usage();
+        const char *arg = argv[++i];
+        switch (argv[i - 1][1]) {
+            case 'm':
+                hal_att_mtu = atoi(arg);
+                if (hal_att_mtu < 23 || hal_att_mtu > 247) usage();
+                break;
+            case 'd':
+                for (model = 0; model < (int)(sizeof(models) / sizeof(models[0])); model++) {
+                    if (models[model].id == atoi(arg)) break;
+                }
+                if (model == sizeof(models) / sizeof(models[0])) usage();
+                break;
+            case 'p':
+                if (strcmp(arg, "nrf51") == 0)
+                    gui_page_height = NRF51_PAGE_HEIGHT;
+                else if (strcmp(arg, "nrf52") == 0)
+                    gui_page_height = NRF52_PAGE_HEIGHT;
+                else
+                    gui_page_height = atoi(arg);
+                if (gui_page_height < 2) usage();
+                break;
+            case 'o':
+                output = arg;
+                break;
+            case 't':
+                trace = arg;
+                break;
+            default:
+                usage();
+        }
+    }
+
+    if (i < argc) {
+        power_on(models[model].chip, models[model].bwr);
+        for (; i < argc; i++) {
+            if (!replay(argv[i])) return 1;
+        }
+        print_stats();
+        if (output && !epd_sim_save(output)) return 1;
+        if (trace && !save_trace(trace)) return 1;
+        return 0;
+    }
+
+    make_image();
+    printf("%-12s %-5s %4s %6s %7s %7s %9s %9s %9s %8s\n", "image upload", "codec", "mtu", "writes", "payload", "ovhd",
+           "host ns", "write ms", "refr ms", "KB/s");
+    for (unsigned m = 0; m < sizeof(models) / sizeof(models[0]); m++) {
+        test_upload(m, 23, false);
+        test_upload(m, 247, false);
+        test_upload(m, 23, true);
+        test_upload(m, 247, true);
+    }
+    test_rle();
+    for (unsigned m = 0; m < sizeof(models) / sizeof(models[0]); m++)
+        test_region(m);
+    test_link(23);
+    test_link(247);
+    test_ingress();
+    test_credit(23);
+    test_credit(247);
+    test_batch();
+    test_list(23);
+    test_list(247);
+    test_list_save();
+    test_slots(23);
+    test_slots(247);
+    test_codes(23);
+    test_codes(247);
+    test_resume(23, true);
+    test_resume(247, true);
+    test_resume(247, false);
+    test_stream(23);
+    test_stream(247);
+    test_font(23);
+    test_font(247);
+    test_font_list();
+    test_malformed();
+    test_perf(23);
+    test_perf(247);
+    test_trace(23);
+    test_trace(247);
+    print_stats();
+    if (trace && !save_trace(trace)) return 1;
+
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("command layer OK\n");
+    return 0;
+}
@@ -0,0 +1,670 @@
+/*
+ * Host model of the e-paper controllers, see epd_sim.h
+ *
+ * Busy times are nominal values, close to what the tags show but not taken
+ * from a particular panel. The controller RAM survives a reset and deep
+ * sleep, and is lost when the EN pin cuts the power.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "app_error.h"
+#include "nrf_delay.h"
+#include "nrf_drv_spi.h"
+#include "nrf_gpio.h"
+#include "SEGGER_RTT.h"
+#include "epd_sim.h"
+
+#define SIM_MAX_WIDTH  400
+#define SIM_MAX_HEIGHT 300
+
+#define BUSY_POWER_ON_US   50000
+#define BUSY_POWER_OFF_US  20000
+#define BUSY_TEMP_US       5000
+#define BUSY_RESET_US      10000
+#define BUSY_REFRESH_BW_US  3000000
+#define BUSY_REFRESH_BWR_US 15000000
+
+// UC8176 commands
+#define UC_PSR   0x00
+#define UC_POF   0x02
+#define UC_PON   0x04
+#define UC_DSLP  0x07
+#define UC_DTM1  0x10
+#define UC_DRF   0x12
+#define UC_DTM2  0x13
+#define UC_TSC   0x40
+#define UC_PTL   0x90
+#define UC_PTIN  0x91
+#define UC_PTOUT 0x92
+#define UC_PSR_BWR 0x10
+
+// SSD1619 commands
+#define SSD_DEEP_SLEEP      0x10
+#define SSD_DATA_MODE       0x11
+#define SSD_SW_RESET        0x12
+#define SSD_TSENSOR_READ    0x1B
+#define SSD_MASTER_ACTIVATE 0x20
+#define SSD_DISP_CTRL1      0x21
+#define SSD_DISP_CTRL2      0x22
+#define SSD_WRITE_RAM1      0x24
+#define SSD_WRITE_RAM2      0x26
+#define SSD_RAM_XPOS        0x44
+#define SSD_RAM_YPOS        0x45
+#define SSD_RAM_XCOUNT      0x4E
+#define SSD_RAM_YCOUNT      0x4F
+
+static NRF_GPIO_Type m_gpio;
+static NRF_ADC_Type m_adc;
+static NRF_RTC_Type m_rtc1;
+
+static struct {
+    epd_sim_chip_t chip;
+    epd_config_t cfg;
+    uint16_t width, height;
+    bool bwr;
+    int8_t temperature;
+    float voltage;
+
+    uint32_t out;               // GPIO output levels
+    bool spi_enabled;
+    uint32_t spi_frequency;
+    uint64_t now_us, start_us, busy_until;
+
+    // controller state
+    bool sleeping;
+    uint8_t cmd, nparam, param[16];
+    uint8_t read_value;
+    uint8_t plane;              // RAM written by data bytes, 0xFF if none
+    int16_t xs, xe, ys, ye;     // RAM window, x in bytes
+    int16_t x, y;               // address counter
+    bool window_done;           // address counter ran past the window
+    uint8_t entry;              // SSD1619 data entry mode
+    uint8_t ctrl1, ctrl2;       // SSD1619 display update control
+    uint8_t psr;                // UC8176 panel setting
+    bool power_on, partial;     // UC8176 PON and PTIN
+    int16_t ptl[4];             // UC8176 partial window, x in bytes
+
+    uint8_t ram[2][SIM_MAX_HEIGHT][SIM_MAX_WIDTH / 8];
+    uint8_t panel[SIM_MAX_HEIGHT][SIM_MAX_WIDTH];
+    epd_sim_stats_t stats;
+} sim;
+
+static bool sim_busy(void)
+{
+    return sim.now_us < sim.busy_until;
+}
+
+static void sim_set_busy(uint64_t us)
+{
+    sim.busy_until = sim.now_us + us;
+}
+
+static void sim_advance(uint64_t us)
+{
+    if (sim_busy())
+        sim.stats.busy_us += (sim.busy_until - sim.now_us < us) ? sim.busy_until - sim.now_us : us;
+    sim.now_us += us;
+}
+
+static void sim_full_window(void)
+{
+    sim.xs = 0;
+    sim.xe = (sim.width + 7) / 8 - 1;
+    sim.ys = 0;
+    sim.ye = sim.height - 1;
+    sim.x = sim.xs;
+    sim.y = sim.ys;
+    sim.window_done = false;
+}
+
+// registers after a reset or power up, the RAM is not touched
+static void sim_reset_registers(void)
+{
+    sim.sleeping = false;
+    sim.cmd = 0xFF;
+    sim.nparam = 0;
+    sim.plane = 0xFF;
+    sim.entry = 0x03;
+    sim.ctrl1 = 0;
+    sim.ctrl2 = 0;
+    sim.psr = 0;
+    sim.power_on = false;
+    sim.partial = false;
+    sim.busy_until = 0;
+    sim_full_window();
+}
+
+void epd_sim_attach(epd_sim_chip_t chip, const epd_config_t *cfg, uint16_t width, uint16_t height, bool bwr)
+{
+    memset(&sim, 0, sizeof(sim));
+    memset(&m_gpio, 0, sizeof(m_gpio));
+    sim.chip = chip;
+    sim.cfg = *cfg;
+    sim.width = width;
+    sim.height = height;
+    sim.bwr = bwr;
+    sim.temperature = 25;
+    sim.voltage = 3.0f;
+    sim_reset_registers();
+    memset(sim.ram, 0x55, sizeof(sim.ram)); // RAM content is undefined at power up
+    memset(sim.panel, EPD_SIM_WHITE, sizeof(sim.panel));
+}
+
+void epd_sim_set_temperature(int8_t value)
+{
+    sim.temperature = value;
+}
+
+void epd_sim_set_voltage(float value)
+{
+    sim.voltage = value;
+}
+
+const epd_sim_stats_t *epd_sim_stats(void)
+{
+    sim.stats.time_us = sim.now_us - sim.start_us;
+    return &sim.stats;
+}
+
+void epd_sim_reset_stats(void)
+{
+    memset(&sim.stats, 0, sizeof(sim.stats));
+    sim.start_us = sim.now_us;
+}
+
+epd_sim_color_t epd_sim_pixel(uint16_t x, uint16_t y)
+{
+    return (epd_sim_color_t)sim.panel[y][x];
+}
+
+bool epd_sim_save(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return false;
+    fprintf(f, "%s\n%d %d\n%s", sim.bwr ? "P6" : "P1", sim.width, sim.height, sim.bwr ? "255\n" : "");
+    for (uint16_t y = 0; y < sim.height; y++) {
+        for (uint16_t x = 0; x < sim.width; x++) {
+            static const uint8_t rgb[3][3] = {{0, 0, 0}, {255, 255, 255}, {255, 0, 0}};
+            if (sim.bwr)
+                fwrite(rgb[sim.panel[y][x]], 1, 3, f);
+            else
+                fputc(sim.panel[y][x] == EPD_SIM_BLACK ? '1' : '0', f);
+        }
+        if (!sim.bwr) fputc('\n', f);
+    }
+    return fclose(f) == 0;
+}
+
+static bool ram_bit(uint8_t plane, uint16_t x, uint16_t y)
+{
+    return sim.ram[plane][y][x / 8] & (0x80 >> (x & 7));
+}
+
+/******************************************************************************
+ * RAM address counter
+ ******************************************************************************/
+static void ram_write(uint8_t value)
+{
+    // UC8176 drops data past the window, the SSD1619 counter has wrapped and overwrites its start
+    if (sim.window_done)
+        sim.stats.overflow++;
+    if ((sim.window_done && sim.chip == EPD_SIM_UC8176) ||
+        sim.x < 0 || sim.x >= SIM_MAX_WIDTH / 8 || sim.y < 0 || sim.y >= SIM_MAX_HEIGHT)
+        return;
+    sim.ram[sim.plane][sim.y][sim.x] = value;
+
+    if (sim.chip == EPD_SIM_UC8176) {
+        if (sim.x < sim.xe) {
+            sim.x++;
+        } else {
+            sim.x = sim.xs;
+            if (sim.y < sim.ye)
+                sim.y++;
+            else
+                sim.window_done = true;
+        }
+        return;
+    }
+
+    // SSD1619: AM selects the direction that moves first, ID the sign of x and y,
+    // the counter wraps to the start of the window
+    int8_t dx = (sim.entry & 0x01) ? 1 : -1;
+    int8_t dy = (sim.entry & 0x02) ? 1 : -1;
+    if (sim.entry & 0x04) {
+        if (sim.y != sim.ye) {
+            sim.y += dy;
+        } else {
+            sim.y = sim.ys;
+            if (sim.x != sim.xe)
+                sim.x += dx;
+            else
+                sim.x = sim.xs, sim.window_done = true;
+        }
+    } else {
+        if (sim.x != sim.xe) {
+            sim.x += dx;
+        } else {
+            sim.x = sim.xs;
+            if (sim.y != sim.ye)
+                sim.y += dy;
+            else
+                sim.y = sim.ys, sim.window_done = true;
+        }
+    }
+}
+
+/******************************************************************************
+ * UC8176
+ ******************************************************************************/
+static void uc8176_refresh(void)
+{
+    int16_t x0 = 0, x1 = sim.width - 1, y0 = 0, y1 = sim.height - 1;
+
+    if (!sim.power_on) return; // no high voltage, nothing happens
+    if (sim.partial) {
+        x0 = sim.ptl[0] * 8;
+        x1 = sim.ptl[1] * 8 + 7;
+        y0 = sim.ptl[2];
+        y1 = sim.ptl[3];
+    }
+    for (int16_t y = y0; y <= y1 && y < sim.height; y++) {
+        for (int16_t x = x0; x <= x1 && x < sim.width; x++) {
+            if (!(sim.psr & UC_PSR_BWR) && sim.bwr && !ram_bit(1, x, y))
+                sim.panel[y][x] = EPD_SIM_RED;
+            else if (sim.psr & UC_PSR_BWR)
+                sim.panel[y][x] = ram_bit(1, x, y) ? EPD_SIM_WHITE : EPD_SIM_BLACK;
+            else
+                sim.panel[y][x] = ram_bit(0, x, y) ? EPD_SIM_WHITE : EPD_SIM_BLACK;
+        }
+    }
+    sim.stats.refreshes++;
+    sim_set_busy(sim.bwr ? BUSY_REFRESH_BWR_US : BUSY_REFRESH_BW_US);
+}
+
+static void uc8176_command(uint8_t cmd)
+{
+    sim.plane = 0xFF;
+    switch (cmd) {
+        case UC_POF:
+            sim.power_on = false;
+            sim_set_busy(BUSY_POWER_OFF_US);
+            break;
+        case UC_PON:
+            sim.power_on = true;
+            sim_set_busy(BUSY_POWER_ON_US);
+            break;
+        case UC_DTM1:
+        case UC_DTM2:
+            // the address counter restarts at the (partial) window for every transmission
+            sim.plane = (cmd == UC_DTM1) ? 0 : 1;
+            if (sim.partial) {
+                sim.xs = sim.ptl[0];
+                sim.xe = sim.ptl[1];
+                sim.ys = sim.ptl[2];
+                sim.ye = sim.ptl[3];
+                sim.x = sim.xs;
+                sim.y = sim.ys;
+                sim.window_done = false;
+            } else {
+                sim_full_window();
+            }
+            break;
+        case UC_DRF:
+            uc8176_refresh();
+            break;
+        case UC_TSC:
+            sim.read_value = sim.temperature;
+            sim_set_busy(BUSY_TEMP_US);
+            break;
+        case UC_PTIN:
+            sim.partial = true;
+            break;
+        case UC_PTOUT:
+            sim.partial = false;
+            break;
+        default:
+            break;
+    }
+}
+
+static void uc8176_data(uint8_t value)
+{
+    switch (sim.cmd) {
+        case UC_PSR:
+            if (sim.nparam == 1) sim.psr = value;
+            break;
+        case UC_DSLP:
+            if (value == 0xA5) sim.sleeping = true;
+            break;
+        case UC_DTM1:
+        case UC_DTM2:
+            ram_write(value);
+            break;
+        case UC_PTL:
+            if (sim.nparam == 8) {
+                sim.ptl[0] = ((sim.param[0] << 8) | sim.param[1]) / 8;
+                sim.ptl[1] = ((sim.param[2] << 8) | sim.param[3]) / 8;
+                sim.ptl[2] = (sim.param[4] << 8) | sim.param[5];
+                sim.ptl[3] = (sim.param[6] << 8) | sim.param[7];
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/******************************************************************************
+ * SSD1619
+ ******************************************************************************/
+static bool ssd1619_option(uint8_t option, bool bit)
+{
+    switch (option & 0x0C) {
+        case 0x04:
+            return false; // bypass as 0
+        case 0x08:
+            return !bit; // inverse
+        default:
+            return bit;
+    }
+}
+
+static void ssd1619_refresh(void)
+{
+    for (uint16_t y = 0; y < sim.height; y++) {
+        for (uint16_t x = 0; x < sim.width; x++) {
+            bool red = ssd1619_option(sim.ctrl1 >> 4, ram_bit(1, x, y));
+            bool white = ssd1619_option(sim.ctrl1, ram_bit(0, x, y));
+            if (sim.bwr && red)
+                sim.panel[y][x] = EPD_SIM_RED;
+            else
+                sim.panel[y][x] = white ? EPD_SIM_WHITE : EPD_SIM_BLACK;
+        }
+    }
+    sim.stats.refreshes++;
+}
+
+static void ssd1619_command(uint8_t cmd)
+{
+    sim.plane = 0xFF;
+    switch (cmd) {
+        case SSD_SW_RESET:
+            sim_reset_registers();
+            sim_set_busy(BUSY_RESET_US);
+            break;
+        case SSD_TSENSOR_READ:
+            sim.read_value = sim.temperature;
+            break;
+        case SSD_MASTER_ACTIVATE:
+            if (sim.ctrl2 & 0x04) { // display
+                ssd1619_refresh();
+                sim_set_busy(sim.bwr ? BUSY_REFRESH_BWR_US : BUSY_REFRESH_BW_US);
+            } else {
+                sim_set_busy(BUSY_TEMP_US);
+            }
+            break;
+        case SSD_WRITE_RAM1:
+        case SSD_WRITE_RAM2:
+            // writing continues at the address counter, it is not reset by the command
+            sim.plane = (cmd == SSD_WRITE_RAM1) ? 0 : 1;
+            sim.window_done = false;
+            break;
+        default:
+            break;
+    }
+}
+
+static void ssd1619_data(uint8_t value)
+{
+    switch (sim.cmd) {
+        case SSD_DEEP_SLEEP:
+            if (value != 0) sim.sleeping = true;
+            if (value == 0x03) memset(sim.ram, 0x55, sizeof(sim.ram)); // mode 2 does not keep RAM
+            break;
+        case SSD_DATA_MODE:
+            sim.entry = value & 0x07;
+            break;
+        case SSD_DISP_CTRL1:
+            if (sim.nparam == 1) sim.ctrl1 = value;
+            break;
+        case SSD_DISP_CTRL2:
+            sim.ctrl2 = value;
+            break;
+        case SSD_WRITE_RAM1:
+        case SSD_WRITE_RAM2:
+            ram_write(value);
+            break;
+        case SSD_RAM_XPOS:
+            if (sim.nparam == 2) {
+                sim.xs = sim.param[0];
+                sim.xe = sim.param[1];
+            }
+            break;
+        case SSD_RAM_YPOS:
+            if (sim.nparam == 4) {
+                sim.ys = sim.param[0] | (sim.param[1] << 8);
+                sim.ye = sim.param[2] | (sim.param[3] << 8);
+            }
+            break;
+        case SSD_RAM_XCOUNT:
+            sim.x = value;
+            sim.window_done = false;
+            break;
+        case SSD_RAM_YCOUNT:
+            if (sim.nparam == 2) {
+                sim.y = sim.param[0] | (sim.param[1] << 8);
+                sim.window_done = false;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/******************************************************************************
+ * Bus
+ ******************************************************************************/
+static bool pin_level(uint32_t pin)
+{
+    return pin < 32 && (sim.out & (1UL << pin));
+}
+
+static bool sim_powered(void)
+{
+    return sim.cfg.en_pin == 0xFF || pin_level(sim.cfg.en_pin);
+}
+
+static void sim_byte(bool data, uint8_t value)
+{
+    sim.stats.bytes++;
+    if (!sim_powered() || !pin_level(sim.cfg.rst_pin) || sim.sleeping) {
+        sim.stats.ignored++;
+        return;
+    }
+    if (sim_busy())
+        sim.stats.busy_bytes++;
+
+    if (!data) {
+        sim.stats.commands++;
+        sim.cmd = value;
+        sim.nparam = 0;
+        if (sim.chip == EPD_SIM_UC8176)
+            uc8176_command(value);
+        else
+            ssd1619_command(value);
+        return;
+    }
+    if (sim.nparam < sizeof(sim.param))
+        sim.param[sim.nparam] = value;
+    if (sim.nparam < 0xFF)
+        sim.nparam++;
+    if (sim.chip == EPD_SIM_UC8176)
+        uc8176_data(value);
+    else
+        ssd1619_data(value);
+}
+
+static void pin_changed(uint32_t pin, bool level)
+{
+    if (pin == sim.cfg.dc_pin) {
+        sim.stats.dc_toggles++;
+    } else if (pin == sim.cfg.rst_pin) {
+        if (level) { // leaving reset
+            sim_reset_registers();
+            if (sim.chip == EPD_SIM_SSD1619)
+                sim_set_busy(BUSY_RESET_US);
+        }
+    } else if (pin == sim.cfg.en_pin) {
+        sim_reset_registers();
+        if (!level)
+            memset(sim.ram, 0x55, sizeof(sim.ram));
+    }
+}
+
+/******************************************************************************
+ * SDK stand-ins
+ ******************************************************************************/
+NRF_GPIO_Type *nrf_gpio_pin_port_decode(uint32_t *p_pin)
+{
+    return &m_gpio;
+}
+
+void nrf_gpio_cfg_output(uint32_t pin)
+{
+    if (pin < 32) m_gpio.PIN_CNF[pin] = NRF_GPIO_PIN_DIR_OUTPUT << GPIO_PIN_CNF_DIR_Pos;
+}
+
+void nrf_gpio_cfg_input(uint32_t pin, nrf_gpio_pin_pull_t pull)
+{
+    if (pin < 32) m_gpio.PIN_CNF[pin] = NRF_GPIO_PIN_DIR_INPUT << GPIO_PIN_CNF_DIR_Pos;
+}
+
+void nrf_gpio_cfg_sense_input(uint32_t pin, nrf_gpio_pin_pull_t pull, nrf_gpio_pin_sense_t sense)
+{
+    nrf_gpio_cfg_input(pin, pull);
+}
+
+void nrf_gpio_cfg_default(uint32_t pin)
+{
+    if (pin < 32) m_gpio.PIN_CNF[pin] = 0;
+}
+
+void nrf_gpio_pin_write(uint32_t pin, uint32_t value)
+{
+    if (pin >= 32 || pin_level(pin) == (value != 0)) return;
+    if (value)
+        sim.out |= 1UL << pin;
+    else
+        sim.out &= ~(1UL << pin);
+    pin_changed(pin, value != 0);
+}
+
+uint32_t nrf_gpio_pin_read(uint32_t pin)
+{
+    if (pin == sim.cfg.busy_pin) {
+        bool busy = sim_powered() && sim_busy();
+        return (sim.chip == EPD_SIM_UC8176) ? !busy : busy; // UC8176 BUSY_N is low active
+    }
+    return pin_level(pin);
+}
+
+void nrf_gpio_pin_toggle(uint32_t pin)
+{
+    nrf_gpio_pin_write(pin, !pin_level(pin));
+}
+
+void nrf_delay_ms(uint32_t ms)
+{
+    sim_advance((uint64_t)ms * 1000);
+}
+
+void nrf_delay_us(uint32_t us)
+{
+    sim_advance(us);
+}
+
+uint32_t nrf_drv_spi_init(nrf_drv_spi_t const *p_instance, nrf_drv_spi_config_t const *p_config,
+                          nrf_drv_spi_handler_t handler)
+{
+    if (sim.spi_enabled) return 8; // NRF_ERROR_INVALID_STATE
+    sim.spi_enabled = true;
+    sim.spi_frequency = p_config->frequency;
+    return NRF_SUCCESS;
+}
+
+void nrf_drv_spi_uninit(nrf_drv_spi_t const *p_instance)
+{
+    sim.spi_enabled = false;
+}
+
+uint32_t nrf_drv_spi_transfer(nrf_drv_spi_t const *p_instance, uint8_t const *p_tx_buffer, uint8_t tx_buffer_length,
+                              uint8_t *p_rx_buffer, uint8_t rx_buffer_length)
+{
+    uint8_t len = tx_buffer_length > rx_buffer_length ? tx_buffer_length : rx_buffer_length;
+
+    if (!sim.spi_enabled) return 8; // NRF_ERROR_INVALID_STATE
+    sim.stats.transactions++;
+    for (uint8_t i = 0; i < tx_buffer_length; i++)
+        sim_byte(pin_level(sim.cfg.dc_pin), p_tx_buffer[i]);
+    for (uint8_t i = 0; i < rx_buffer_length; i++) {
+        p_rx_buffer[i] = sim.read_value;
+        sim.stats.reads++;
+    }
+    uint64_t us = (uint64_t)len * 8 * 1000000 / sim.spi_frequency;
+    sim.stats.spi_us += us;
+    sim_advance(us);
+    return NRF_SUCCESS;
+}
+
+void nrf_spi_pins_set(void *p_reg, uint32_t sck_pin, uint32_t mosi_pin, uint32_t miso_pin)
+{
+}
+
+NRF_ADC_Type *hal_adc(void)
+{
+    m_adc.EVENTS_END = 1;
+    m_adc.RESULT = (uint32_t)(sim.voltage / 3.6f * (1 << 10));
+    return &m_adc;
+}
+
+NRF_RTC_Type *hal_rtc1(void)
+{
+    m_rtc1.COUNTER = (uint32_t)(sim.now_us * 32768 / 1000000) & 0xFFFFFF;
+    return &m_rtc1;
+}
+
+// RTT up buffers, read by a debugger that keeps up with the target: nothing is skipped
+#define SIM_RTT_CHANNELS 2
+#define SIM_RTT_SIZE     (1 << 20)
+
+static struct {
+    bool configured;
+    uint32_t rd, wr;
+    uint8_t buf[SIM_RTT_SIZE];
+} m_rtt[SIM_RTT_CHANNELS];
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned BufferIndex, const char *sName, void *pBuffer, unsigned BufferSize,
+                              unsigned Flags)
+{
+    if (BufferIndex >= SIM_RTT_CHANNELS) return -1;
+    m_rtt[BufferIndex].configured = true;
+    return 0;
+}
+
+unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void *pBuffer, unsigned NumBytes)
+{
+    if (BufferIndex >= SIM_RTT_CHANNELS || !m_rtt[BufferIndex].configured) return 0;
+    if (NumBytes > SIM_RTT_SIZE - 1 - (m_rtt[BufferIndex].wr - m_rtt[BufferIndex].rd)) return 0;
+    for (unsigned i = 0; i < NumBytes; i++)
+        m_rtt[BufferIndex].buf[m_rtt[BufferIndex].wr++ % SIM_RTT_SIZE] = ((const uint8_t *)pBuffer)[i];
+    return NumBytes;
+}
+
+uint32_t epd_sim_rtt_read(unsigned channel, void *buf, uint32_t size)
+{
+    uint32_t n = 0;
+
+    if (channel >= SIM_RTT_CHANNELS) return 0;
+    while (n < size && m_rtt[channel].rd != m_rtt[channel].wr)
+        ((uint8_t *)buf)[n++] = m_rtt[channel].buf[m_rtt[channel].rd++ % SIM_RTT_SIZE];
+    return n;
+}
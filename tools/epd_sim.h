@@ -0,0 +1,61 @@
+/*
+ * Host model of the e-paper controllers, for testing the EPD drivers
+ *
+ * EPD/EPD_driver.c, UC8176.c and SSD1619.c are built unchanged against the
+ * SDK stand-ins in tools/hal. GPIO, SPI and delays end up here and feed a
+ * behavioral model of the attached controller: command decoding, RAM
+ * windows, address counters and data entry modes, partial windows, BUSY
+ * timing and the panel image after each refresh. Time is simulated, delays
+ * return at once, the RTC1 counter follows it. RTT up buffers are kept for
+ * reading back.
+ */
+#ifndef __EPD_SIM_H
+#define __EPD_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "EPD_config.h"
+
+typedef enum {
+    EPD_SIM_UC8176,
+    EPD_SIM_SSD1619,
+} epd_sim_chip_t;
+
+typedef enum {
+    EPD_SIM_BLACK = 0,
+    EPD_SIM_WHITE = 1,
+    EPD_SIM_RED = 2,
+} epd_sim_color_t;
+
+typedef struct {
+    uint32_t transactions;  // SPI transfers (CS low to high)
+    uint32_t bytes;         // bytes written, commands included
+    uint32_t commands;
+    uint32_t reads;         // bytes read back
+    uint32_t dc_toggles;
+    uint32_t refreshes;
+    uint32_t overflow;      // data bytes past the end of the RAM window
+    uint32_t ignored;       // bytes sent while the controller sleeps, is in reset or has no power
+    uint32_t busy_bytes;    // bytes sent while BUSY was asserted
+    uint64_t spi_us;        // time on the bus at the configured SPI clock
+    uint64_t busy_us;       // time spent waiting for BUSY
+    uint64_t time_us;       // simulated time
+} epd_sim_stats_t;
+
+// Attach a controller to the pins of cfg, with a panel of width x height
+void epd_sim_attach(epd_sim_chip_t chip, const epd_config_t *cfg, uint16_t width, uint16_t height, bool bwr);
+void epd_sim_set_temperature(int8_t value);
+void epd_sim_set_voltage(float value);
+
+const epd_sim_stats_t *epd_sim_stats(void);
+void epd_sim_reset_stats(void);
+
+// Panel pixel as shown after the last refresh
+epd_sim_color_t epd_sim_pixel(uint16_t x, uint16_t y);
+// Write the panel as PBM (black/white) or PPM (black/white/red)
+bool epd_sim_save(const char *path);
+
+// Read what the target wrote to an RTT up buffer, like a debugger does
+uint32_t epd_sim_rtt_read(unsigned channel, void *buf, uint32_t size);
+
+#endif
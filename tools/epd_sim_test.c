@@ -0,0 +1,176 @@
+/*
+ * Host test for the EPD drivers, run against the controller models in
+ * epd_sim.c
+ *
+ * Every model is cleared, then a series of calendar and clock frames is
+ * drawn through the driver's write_begin/write_rows/write_end and
+ * refreshed. The first frame is a full redraw, the following ones only
+ * update the changed regions. After each refresh the simulated panel must
+ * match the frame the GUI rendered. The bus statistics of each model are
+ * printed at the end.
+ *
+ *     make -C tools test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "EPD_driver.h"
+#include "GUI.h"
+#include "Lunar.h"
+#include "epd_sim.h"
+
+int gui_page_height = NRF51_PAGE_HEIGHT;
+
+static const struct {
+    const char *name;
+    epd_model_id_t id;
+    epd_sim_chip_t chip;
+    bool bwr;
+} models[] = {
+    {"UC8176 BW",   EPD_UC8176_420_BW,   EPD_SIM_UC8176,  false},
+    {"UC8176 BWR",  EPD_UC8176_420_BWR,  EPD_SIM_UC8176,  true},
+    {"SSD1619 BWR", EPD_SSD1619_420_BWR, EPD_SIM_SSD1619, true},
+    {"SSD1619 BW",  EPD_SSD1619_420_BW,  EPD_SIM_SSD1619, false},
+};
+
+static const epd_config_t config = {
+    .mosi_pin = 5,
+    .sclk_pin = 8,
+    .cs_pin = 9,
+    .dc_pin = 10,
+    .rst_pin = 11,
+    .busy_pin = 12,
+    .bs_pin = 13,
+    .led_pin = 0xFF,
+    .en_pin = 0xFF,
+};
+
+static int failures;
+
+/* The frame as the GUI intended it, composed from the pages it sends. */
+static uint8_t m_frame[300][400];
+static uint16_t m_x, m_y, m_w;
+static epd_driver_t *m_drv;
+
+static void SinkBegin(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    m_x = x;
+    m_y = y;
+    m_w = w;
+    m_drv->write_begin(x, y, w, h);
+}
+
+static void SinkWrite(uint8_t *black, uint8_t *color, uint16_t h)
+{
+    uint16_t wb = (m_w + 7) / 8;
+
+    for (uint16_t i = 0; i < h; i++) {
+        for (uint16_t j = 0; j < m_w; j++) {
+            uint8_t bit = 0x80 >> (j & 7);
+            if (color && !(color[i * wb + j / 8] & bit))
+                m_frame[m_y + i][m_x + j] = EPD_SIM_RED;
+            else
+                m_frame[m_y + i][m_x + j] = (black[i * wb + j / 8] & bit) ? EPD_SIM_WHITE : EPD_SIM_BLACK;
+        }
+    }
+    m_y += h;
+    m_drv->write_rows(black, color, h);
+}
+
+static void SinkEnd(void)
+{
+    if (m_drv->write_end) m_drv->write_end();
+}
+
+static const gui_sink_t sink = {SinkBegin, SinkWrite, SinkEnd};
+
+static int compare_panel(const char *name, const char *what, uint32_t timestamp)
+{
+    for (uint16_t y = 0; y < 300; y++) {
+        for (uint16_t x = 0; x < 400; x++) {
+            if (epd_sim_pixel(x, y) != m_frame[y][x]) {
+                if (failures++ < 20)
+                    printf("FAIL %s: %s %u: pixel %d,%d is %d, expected %d\n", name, what, timestamp, x, y,
+                           epd_sim_pixel(x, y), m_frame[y][x]);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void test_model(int index, int page_height)
+{
+    const char *name = models[index].name;
+    epd_model_t *epd;
+
+    gui_page_height = page_height;
+    epd_sim_attach(models[index].chip, &config, 400, 300, models[index].bwr);
+    EPD_GPIO_Load((epd_config_t *)&config);
+    EPD_GPIO_Init();
+    epd = epd_init(models[index].id);
+    m_drv = epd->drv;
+
+    epd->drv->clear();
+    memset(m_frame, EPD_SIM_WHITE, sizeof(m_frame));
+    compare_panel(name, "clear", 0);
+    epd_sim_reset_stats();
+
+    gui_data_t data = {
+        .bwr             = epd->bwr,
+        .width           = epd->width,
+        .height          = epd->height,
+        .temperature     = epd->drv->read_temp(),
+        .voltage         = EPD_ReadVoltage(),
+    };
+    uint32_t start = (uint32_t)days_from_civil(2025, 1, 27) * SEC_PER_DY + 23 * SEC_PER_HR + 57 * 60;
+    int frames = 0;
+
+    GUI_Invalidate();
+    for (display_mode_t mode = MODE_CALENDAR; mode <= MODE_CLOCK; mode++) {
+        // minutes and days rolling over, the first frame of each mode is a full redraw
+        for (int i = 0; i < 8; i++) {
+            data.timestamp = start + i * (mode == MODE_CLOCK ? 60 : SEC_PER_DY + 60);
+            if (DrawGUI(&data, &sink, mode)) {
+                epd->drv->refresh();
+                frames++;
+            }
+            compare_panel(name, mode == MODE_CLOCK ? "clock" : "calendar", data.timestamp);
+        }
+    }
+
+    // the controller keeps its RAM over deep sleep and reset, a partial update still works
+    epd->drv->sleep();
+    epd_init(models[index].id);
+    data.timestamp += 3600;
+    if (DrawGUI(&data, &sink, MODE_CLOCK))
+        epd->drv->refresh();
+    compare_panel(name, "after sleep", data.timestamp);
+
+    const epd_sim_stats_t *stats = epd_sim_stats();
+    printf("%-12s %4d %4d %7u %9u %8u %7u %6u %9.1f %9.1f\n", name, page_height, frames, stats->transactions,
+           stats->bytes, stats->commands, stats->dc_toggles, stats->overflow + stats->busy_bytes,
+           stats->spi_us / 1000.0, stats->busy_us / 1000.0);
+    if (stats->overflow || stats->busy_bytes || stats->ignored) {
+        printf("FAIL %s: %u bytes past the window, %u while busy, %u ignored\n", name, stats->overflow,
+               stats->busy_bytes, stats->ignored);
+        failures++;
+    }
+    EPD_GPIO_Uninit();
+}
+
+int main(void)
+{
+    printf("%-12s %4s %4s %7s %9s %8s %7s %6s %9s %9s\n", "", "page", "draw", "xfers", "bytes", "commands",
+           "dc", "errors", "spi ms", "busy ms");
+    for (unsigned i = 0; i < sizeof(models) / sizeof(models[0]); i++) {
+        test_model(i, NRF51_PAGE_HEIGHT);
+        test_model(i, NRF52_PAGE_HEIGHT);
+    }
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("all drivers OK\n");
+    return 0;
+}
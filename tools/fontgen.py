@@ -0,0 +1,606 @@
+#!/usr/bin/env python3
+"""
+Font subsetting tool for GUI/fonts.c
+
+Scans the string tables and format strings in GUI/*.c, picks exactly the
+glyphs the firmware can print, and writes GUI/fonts.c from the source fonts.
+
+Source fonts may be BDF files or u8g2 font arrays (.c). By default the fonts
+already in GUI/fonts.c are used as source, so a new glyph only needs a BDF
+(or a full u8g2 font) when it is not in the current subset:
+
+    python3 tools/fontgen.py
+    python3 tools/fontgen.py --source u8g2_font_wqy12_t_lunar=wenquanyi_12pt.bdf
+    python3 tools/fontgen.py --check
+
+The unicode lookup table is written with one entry every LUT_BLOCK glyphs,
+so u8g2_font_get_glyph_data() only walks a few records per CJK glyph.
+"""
+import argparse
+import os
+import re
+import sys
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+FONTS_C = os.path.join(ROOT, 'GUI', 'fonts.c')
+SCAN_DIR = os.path.join(ROOT, 'GUI')
+SCAN_SKIP = ('fonts.c',)
+
+LUT_BLOCK = 8   # glyphs per unicode lookup table entry
+
+ASCII = set(chr(c) for c in range(32, 128))
+
+# name, glyph selection
+#   'all'       keep every glyph of the source font
+#   'scan'      glyphs used by the string literals in GUI/*.c
+#   'ascii'     printable ASCII (32-127)
+FONTS = [
+    ('u8g2_font_wqy9_t_lunar',  ('ascii', 'scan')),
+    ('u8g2_font_wqy12_t_lunar', ('ascii', 'scan')),
+    ('u8g2_font_helvB14_tn',    ('all',)),
+    ('u8g2_font_helvB18_tn',    ('all',)),
+]
+
+
+class FontError(Exception):
+    pass
+
+# ---------------------------------------------------------------------------
+# C source helpers
+# ---------------------------------------------------------------------------
+
+C_ESCAPES = {'n': 10, 't': 9, 'r': 13, '\\': 92, '"': 34, "'": 39, '?': 63,
+             'a': 7, 'b': 8, 'f': 12, 'v': 11}
+
+
+def c_literal_bytes(lit):
+    out = bytearray()
+    i = 0
+    while i < len(lit):
+        c = lit[i]
+        if c != '\\':
+            out += c.encode('utf-8')
+            i += 1
+            continue
+        n = lit[i + 1]
+        if n in '01234567':
+            m = re.match(r'[0-7]{1,3}', lit[i + 1:]).group(0)
+            out.append(int(m, 8))
+            i += 1 + len(m)
+        elif n == 'x':
+            m = re.match(r'[0-9a-fA-F]+', lit[i + 2:]).group(0)
+            out.append(int(m, 16) & 0xFF)
+            i += 2 + len(m)
+        else:
+            out.append(C_ESCAPES[n])
+            i += 2
+    return bytes(out)
+
+
+def c_tokens(src):
+    """Yield ('str', literal) and ('code', text) chunks, dropping comments."""
+    i, n = 0, len(src)
+    code = []
+    while i < n:
+        c = src[i]
+        if src.startswith('//', i):
+            i = src.find('\n', i)
+            i = n if i < 0 else i
+        elif src.startswith('/*', i):
+            j = src.find('*/', i + 2)
+            i = n if j < 0 else j + 2
+            code.append(' ')
+        elif c == '"':
+            j = i + 1
+            while src[j] != '"':
+                j += 2 if src[j] == '\\' else 1
+            yield 'code', ''.join(code)
+            code = []
+            yield 'str', src[i + 1:j]
+            i = j + 1
+        elif c == "'":
+            j = i + 1
+            while src[j] != "'":
+                j += 2 if src[j] == '\\' else 1
+            code.append(src[i:j + 1])
+            i = j + 1
+        else:
+            code.append(c)
+            i += 1
+    yield 'code', ''.join(code)
+
+# ---------------------------------------------------------------------------
+# glyph scanner
+# ---------------------------------------------------------------------------
+
+PRINTF_SPEC = re.compile(r'%([-+ #0]*)(\d+|\*)?(\.(\d+|\*))?(hh|h|ll|l|z)?([diouxXfFeEgGcsp%])')
+PRINTF_CHARS = {
+    'd': '0123456789-', 'i': '0123456789-', 'u': '0123456789',
+    'o': '01234567', 'x': '0123456789abcdef', 'X': '0123456789ABCDEF',
+    'f': '0123456789.-', 'F': '0123456789.-', 'e': '0123456789.-+e',
+    'E': '0123456789.-+E', 'g': '0123456789.-+e', 'G': '0123456789.-+E',
+    'p': '0123456789abcdefx', '%': '%',
+    's': '', 'c': '',   # arguments are themselves literals and get scanned
+}
+
+
+def literal_glyphs(text):
+    glyphs = set()
+    if '%' in text:
+        for m in PRINTF_SPEC.finditer(text):
+            glyphs.update(PRINTF_CHARS[m.group(6)])
+            if m.group(1) and ' ' in m.group(1):
+                glyphs.add(' ')
+        text = PRINTF_SPEC.sub('', text)
+    glyphs.update(c for c in text if c >= ' ')
+    return glyphs
+
+
+def scan_glyphs(paths):
+    glyphs = set()
+    for path in paths:
+        src = open(path, encoding='utf-8-sig').read()
+        for kind, text in c_tokens(src):
+            if kind != 'str':
+                continue
+            try:
+                glyphs |= literal_glyphs(c_literal_bytes(text).decode('utf-8'))
+            except UnicodeDecodeError:
+                pass
+    return glyphs
+
+
+def scan_sources():
+    return sorted(os.path.join(SCAN_DIR, f) for f in os.listdir(SCAN_DIR)
+                  if f.endswith('.c') and f not in SCAN_SKIP)
+
+# ---------------------------------------------------------------------------
+# u8g2 font format
+# ---------------------------------------------------------------------------
+
+class BitReader:
+    def __init__(self, data):
+        self.data, self.pos = data, 0
+
+    def get(self, cnt):
+        v = 0
+        for k in range(cnt):
+            byte = self.data[self.pos >> 3] if (self.pos >> 3) < len(self.data) else 0
+            v |= ((byte >> (self.pos & 7)) & 1) << k
+            self.pos += 1
+        return v
+
+    def get_signed(self, cnt):
+        return self.get(cnt) - (1 << (cnt - 1))
+
+
+class BitWriter:
+    def __init__(self):
+        self.bits = []
+
+    def put(self, v, cnt):
+        for k in range(cnt):
+            self.bits.append((v >> k) & 1)
+
+    def put_signed(self, v, cnt):
+        self.put(v + (1 << (cnt - 1)), cnt)
+
+    def bytes(self):
+        out = bytearray((len(self.bits) + 7) // 8)
+        for i, b in enumerate(self.bits):
+            out[i >> 3] |= b << (i & 7)
+        return bytes(out)
+
+
+class Glyph:
+    def __init__(self, enc, w=0, h=0, x=0, y=0, dx=0, rows=None, data=None):
+        self.enc, self.w, self.h, self.x, self.y, self.dx = enc, w, h, x, y, dx
+        self.rows = rows        # list of h lists of w bits, or None
+        self.data = data        # encoded u8g2 glyph data, or None
+
+
+class Font:
+    def __init__(self, name):
+        self.name = name
+        self.header = None      # 23 byte u8g2 header (u8g2 sources only)
+        self.glyphs = {}
+        self.fontname = '(null)'
+        self.copyright = '(null)'
+        self.total = 0
+        self.ascent = None      # FONT_ASCENT / FONT_DESCENT of a BDF
+        self.descent = None
+
+
+def unsigned_bits(v):
+    return max(1, v.bit_length())
+
+
+def signed_bits(lo, hi):
+    n = 1
+    while not (-(1 << (n - 1)) <= lo and hi < (1 << (n - 1))):
+        n += 1
+    return n
+
+
+def read_u8g2(name, data):
+    font = Font(name)
+    font.header = bytes(data[:23])
+    bits = font.header[2:9]
+    uni = data[21] << 8 | data[22]
+    p = 23
+    while data[p + 1] != 0:
+        font.glyphs[data[p]] = Glyph(data[p], data=bytes(data[p + 2:p + data[p + 1]]))
+        p += data[p + 1]
+    lut = 23 + uni
+    p = lut
+    while True:
+        e = data[p + 2] << 8 | data[p + 3]
+        p += 4
+        if e == 0xFFFF:
+            break
+    p = lut + (data[lut] << 8 | data[lut + 1])
+    while True:
+        e = data[p] << 8 | data[p + 1]
+        if e == 0:
+            break
+        font.glyphs[e] = Glyph(e, data=bytes(data[p + 3:p + data[p + 2]]))
+        p += data[p + 2]
+    for g in font.glyphs.values():
+        decode_glyph(g, bits)
+    font.total = len(font.glyphs)
+    return font
+
+
+def decode_glyph(g, bits):
+    bits_0, bits_1, bits_w, bits_h, bits_x, bits_y, bits_dx = bits
+    r = BitReader(g.data)
+    g.w, g.h = r.get(bits_w), r.get(bits_h)
+    g.x, g.y, g.dx = r.get_signed(bits_x), r.get_signed(bits_y), r.get_signed(bits_dx)
+    pixels = []
+    if g.w > 0:
+        while True:
+            a, b = r.get(bits_0), r.get(bits_1)
+            while True:
+                pixels += [0] * a + [1] * b
+                if r.get(1) == 0:
+                    break
+            if len(pixels) >= g.w * g.h:
+                break
+    pixels = (pixels + [0] * (g.w * g.h))[:g.w * g.h]
+    g.rows = [pixels[i * g.w:(i + 1) * g.w] for i in range(g.h)]
+
+
+def rle_pairs(g, max_0, max_1):
+    pixels = [p for row in g.rows for p in row]
+    pairs = []
+    i, n = 0, len(pixels)
+    while i < n:
+        a = 0
+        while i < n and pixels[i] == 0 and a < max_0:
+            a += 1
+            i += 1
+        b = 0
+        if a == max_0 and i < n and pixels[i] == 0:
+            pairs.append((a, 0))
+            continue
+        while i < n and pixels[i] == 1 and b < max_1:
+            b += 1
+            i += 1
+        pairs.append((a, b))
+    return pairs
+
+
+def encode_glyph(g, bits):
+    bits_0, bits_1, bits_w, bits_h, bits_x, bits_y, bits_dx = bits
+    w = BitWriter()
+    gw, gh = (g.w, g.h) if g.w and g.h else (0, 0)
+    w.put(gw, bits_w)
+    w.put(gh, bits_h)
+    w.put_signed(g.x, bits_x)
+    w.put_signed(g.y, bits_y)
+    w.put_signed(g.dx, bits_dx)
+    if gw:
+        prev = None
+        for pair in rle_pairs(g, (1 << bits_0) - 1, (1 << bits_1) - 1):
+            if pair == prev:
+                w.put(1, 1)
+                continue
+            if prev is not None:
+                w.put(0, 1)
+            w.put(pair[0], bits_0)
+            w.put(pair[1], bits_1)
+            prev = pair
+        w.put(0, 1)
+    return w.bytes()
+
+
+def build_header(glyphs, font_ascent=None, font_descent=None):
+    """Calculate a u8g2 header for glyphs decoded from a BDF (BBX mode 0)."""
+    drawn = [g for g in glyphs if g.w and g.h]
+    bits_w = unsigned_bits(max([g.w for g in drawn] or [0]))
+    bits_h = unsigned_bits(max([g.h for g in drawn] or [0]))
+    bits_x = signed_bits(min([g.x for g in glyphs] or [0]), max([g.x for g in glyphs] or [0]))
+    bits_y = signed_bits(min([g.y for g in glyphs] or [0]), max([g.y for g in glyphs] or [0]))
+    bits_dx = signed_bits(min([g.dx for g in glyphs] or [0]), max([g.dx for g in glyphs] or [0]))
+    best = None
+    for bits_0 in range(2, 9):
+        for bits_1 in range(1, 9):
+            bits = (bits_0, bits_1, bits_w, bits_h, bits_x, bits_y, bits_dx)
+            size = sum(len(encode_glyph(g, bits)) for g in glyphs)
+            if best is None or size < best[0]:
+                best = (size, bits)
+    bits = best[1]
+
+    if drawn:
+        x0 = min(g.x for g in drawn)
+        y0 = min(g.y for g in drawn)
+        x1 = max(g.x + g.w for g in drawn)
+        y1 = max(g.y + g.h for g in drawn)
+    else:
+        x0 = y0 = x1 = y1 = 0
+    by_enc = {g.enc: g for g in glyphs}
+
+    def ascent(e, default=0):
+        g = by_enc.get(e)
+        return g.h + g.y if g else default
+
+    def descent(e, default=0):
+        g = by_enc.get(e)
+        return g.y if g else default
+
+    if font_ascent is None:
+        font_ascent = max([g.h + g.y for g in drawn] or [0])
+    if font_descent is None:
+        font_descent = min([g.y for g in drawn] or [0])
+    ascent_a = ascent(ord('A'), font_ascent)
+    descent_g = descent(ord('g'), font_descent)
+    header = bytes([
+        len(glyphs) & 0xFF, 0, bits[0], bits[1],
+        bits[2], bits[3], bits[4], bits[5], bits[6],
+        (x1 - x0) & 0xFF, (y1 - y0) & 0xFF, x0 & 0xFF, y0 & 0xFF,
+        ascent_a & 0xFF, descent_g & 0xFF,
+        ascent(ord('('), ascent_a) & 0xFF, descent(ord('('), descent_g) & 0xFF,
+        0, 0, 0, 0, 0, 0,
+    ])
+    return header
+
+
+def write_u8g2(header, glyphs):
+    """Serialize glyphs (sorted by encoding) with the given header."""
+    bits = header[2:9]
+    ascii_part = bytearray()
+    pos_upper_a = pos_lower_a = 0
+    for g in glyphs:
+        if g.enc > 255:
+            continue
+        if g.enc >= ord('A') and not pos_upper_a:
+            pos_upper_a = len(ascii_part)
+        if g.enc >= ord('a') and not pos_lower_a:
+            pos_lower_a = len(ascii_part)
+        data = g.data if g.data is not None else encode_glyph(g, bits)
+        if len(data) + 2 > 255:
+            raise FontError('glyph U+%04X too large' % g.enc)
+        ascii_part += bytes([g.enc, len(data) + 2]) + data
+    ascii_part += b'\0\0'
+
+    records = []
+    for g in glyphs:
+        if g.enc <= 255:
+            continue
+        data = g.data if g.data is not None else encode_glyph(g, bits)
+        if len(data) + 3 > 255:
+            raise FontError('glyph U+%04X too large' % g.enc)
+        records.append((g.enc, bytes([g.enc >> 8, g.enc & 0xFF, len(data) + 3]) + data))
+
+    blocks = [records[i:i + LUT_BLOCK] for i in range(0, len(records), LUT_BLOCK)] or [[]]
+    lut = bytearray()
+    lut_size = 4 * len(blocks)
+    prev_start, start = -lut_size, 0
+    for i, block in enumerate(blocks):
+        delta = start - prev_start
+        last = 0xFFFF if i == len(blocks) - 1 else block[-1][0]
+        lut += bytes([delta >> 8, delta & 0xFF, last >> 8, last & 0xFF])
+        prev_start = start
+        start += sum(len(r[1]) for r in block)
+    unicode_part = lut + b''.join(r[1] for r in records) + b'\0\0'
+
+    header = bytearray(header)
+    header[0] = len(glyphs) & 0xFF
+    header[17:19] = bytes([pos_upper_a >> 8, pos_upper_a & 0xFF])
+    header[19:21] = bytes([pos_lower_a >> 8, pos_lower_a & 0xFF])
+    header[21:23] = bytes([len(ascii_part) >> 8, len(ascii_part) & 0xFF])
+    out = bytes(header) + bytes(ascii_part) + bytes(unicode_part)
+    if len(out) > 0xFFFF:
+        raise FontError('font too large')
+    return out
+
+# ---------------------------------------------------------------------------
+# font sources
+# ---------------------------------------------------------------------------
+
+def read_c_fonts(path):
+    src = open(path, encoding='utf-8').read()
+    fonts = {}
+    pattern = re.compile(r'(/\*(?:(?!\*/).)*\*/)\s*const uint8_t (\w+)\[\d*\][^=]*=\s*((?:\s*"(?:[^"\\]|\\.)*")+)\s*;', re.S)
+    for m in pattern.finditer(src):
+        comment, name, body = m.group(1), m.group(2), m.group(3)
+        data = b''.join(c_literal_bytes(lit) for lit in re.findall(r'"((?:[^"\\]|\\.)*)"', body)) + b'\0'
+        font = read_u8g2(name, data)
+        for key, attr in (('Fontname', 'fontname'), ('Copyright', 'copyright')):
+            mm = re.search(key + r': (.*)', comment)
+            if mm:
+                setattr(font, attr, mm.group(1).strip())
+        mm = re.search(r'Glyphs: \d+/(\d+)', comment)
+        if mm:
+            font.total = int(mm.group(1))
+        fonts[name] = font
+    return fonts
+
+
+def read_bdf(name, path):
+    font = Font(name)
+    glyph = None
+    rows = None
+    for line in open(path, encoding='latin-1'):
+        parts = line.split()
+        if not parts:
+            continue
+        key = parts[0]
+        if rows is not None:
+            if key == 'ENDCHAR':
+                bits = []
+                for r in rows:
+                    v = int(r, 16) if r else 0
+                    nbits = len(r) * 4
+                    bits.append([(v >> (nbits - 1 - i)) & 1 for i in range(glyph.w)])
+                glyph.rows = bits[:glyph.h]
+                if glyph.enc >= 0:
+                    font.glyphs[glyph.enc] = glyph
+                rows = glyph = None
+            else:
+                rows.append(parts[0])
+        elif key == 'FONT':
+            font.fontname = line[5:].strip()
+        elif key == 'COPYRIGHT':
+            font.copyright = line[10:].strip().strip('"')
+        elif key == 'FONT_ASCENT':
+            font.ascent = int(parts[1])
+        elif key == 'FONT_DESCENT':
+            font.descent = -int(parts[1])
+        elif key == 'STARTCHAR':
+            glyph = Glyph(-1)
+        elif key == 'ENCODING':
+            glyph.enc = int(parts[-1])
+        elif key == 'DWIDTH':
+            glyph.dx = int(parts[1])
+        elif key == 'BBX':
+            glyph.w, glyph.h, glyph.x, glyph.y = (int(v) for v in parts[1:5])
+        elif key == 'BITMAP':
+            rows = []
+    font.total = len(font.glyphs)
+    return font
+
+
+def load_sources(overrides):
+    fonts = read_c_fonts(FONTS_C) if os.path.exists(FONTS_C) else {}
+    for name, path in overrides.items():
+        if path.endswith('.bdf'):
+            fonts[name] = read_bdf(name, path)
+        else:
+            found = read_c_fonts(path)
+            if name not in found:
+                if len(found) != 1:
+                    raise FontError('%s: font %s not found' % (path, name))
+                found = {name: list(found.values())[0]}
+            fonts[name] = found[name]
+    return fonts
+
+# ---------------------------------------------------------------------------
+# output
+# ---------------------------------------------------------------------------
+
+def c_escape(data, width=80):
+    lines, line = [], ''
+    prev_octal = False
+    for b in data:
+        c = chr(b)
+        if 32 <= b < 127 and c not in '"\\?' and not (prev_octal and c in '0123456789'):
+            s = c
+            prev_octal = False
+        else:
+            s = '\\%o' % b
+            prev_octal = True
+        if len(line) + len(s) > width:
+            lines.append(line)
+            line = ''
+        line += s
+    lines.append(line)
+    return lines
+
+
+def emit_font(font, glyphs, data):
+    out = ['/*']
+    out.append('  Fontname: %s' % font.fontname)
+    out.append('  Copyright: %s' % font.copyright)
+    out.append('  Glyphs: %d/%d' % (len(glyphs), font.total))
+    cjk = ''.join(chr(g.enc) for g in glyphs if g.enc > 255)
+    if cjk:
+        for i in range(0, len(cjk), 40):
+            out.append('  %s %s' % ('Unicode:' if i == 0 else '        ', cjk[i:i + 40]))
+    out.append('  BBX Build Mode: 0')
+    out.append('*/')
+    # the last zero byte of the font is the terminator of the string literal
+    body = c_escape(data[:-1])
+    out.append('const uint8_t %s[%d] U8G2_FONT_SECTION("%s") = ' % (font.name, len(data), font.name))
+    for i, line in enumerate(body):
+        out.append('  "%s"%s' % (line, ';' if i == len(body) - 1 else ''))
+    return '\n'.join(out)
+
+
+def generate(overrides):
+    sources = load_sources(overrides)
+    scanned = scan_glyphs(scan_sources())
+    parts = ['// Generated by tools/fontgen.py, do not edit.\n#include "fonts.h"\n']
+    missing = []
+    for name, selection in FONTS:
+        if name not in sources:
+            raise FontError('no source for %s' % name)
+        font = sources[name]
+        wanted = set()
+        if 'all' in selection:
+            wanted |= set(font.glyphs)
+        if 'ascii' in selection:
+            wanted |= set(ord(c) for c in ASCII) & set(font.glyphs)
+        if 'scan' in selection:
+            need = set(ord(c) for c in scanned)
+            missing += ['%s: U+%04X %s' % (name, e, chr(e)) for e in sorted(need - set(font.glyphs))]
+            wanted |= need & set(font.glyphs)
+        glyphs = [font.glyphs[e] for e in sorted(wanted)]
+        if font.header is None:
+            header = build_header(glyphs, font.ascent, font.descent)
+            for g in glyphs:
+                g.data = encode_glyph(g, header[2:9])
+        else:
+            header = font.header
+        data = write_u8g2(header, glyphs)
+        parts.append(emit_font(font, glyphs, data))
+    if missing:
+        print('fontgen: warning: glyphs missing from source fonts (use --source):\n  ' + '\n  '.join(missing),
+              file=sys.stderr)
+    return '\n\n'.join(parts) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--source', action='append', default=[], metavar='FONT=PATH',
+                        help='BDF file or u8g2 .c file to take FONT from')
+    parser.add_argument('--check', action='store_true', help='fail if GUI/fonts.c is out of date')
+    parser.add_argument('-o', '--output', default=FONTS_C)
+    args = parser.parse_args()
+
+    overrides = {}
+    for s in args.source:
+        name, _, path = s.partition('=')
+        overrides[name] = path
+
+    try:
+        text = generate(overrides)
+    except FontError as e:
+        print('fontgen: %s' % e, file=sys.stderr)
+        return 1
+
+    if args.check:
+        current = open(args.output, encoding='utf-8').read() if os.path.exists(args.output) else ''
+        if current != text:
+            print('fontgen: %s is out of date, run tools/fontgen.py' % os.path.relpath(args.output, ROOT),
+                  file=sys.stderr)
+            return 1
+        return 0
+
+    with open(args.output, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
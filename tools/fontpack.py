@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+Font pack builder for the flash font store (EPD/EPD_font.h)
+
+Each font is given as ID=PATH[:CHARS], where PATH is a BDF file or a u8g2
+font array (.c), and CHARS an optional UTF-8 text file with the glyphs to
+keep (printable ASCII is always kept). IDs must be in 0x10-0xFF, lower IDs
+are the built-in fonts.
+
+    python3 tools/fontpack.py -o fonts.bin 0x10=wenquanyi_12pt.bdf:price.txt
+
+The pack is uploaded with the web tool, fonts are then selectable by ID.
+"""
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import fontgen  # noqa: E402
+
+FONT_ID_MIN = 0x10
+
+
+def load_font(path):
+    if path.endswith('.bdf'):
+        return fontgen.read_bdf(os.path.basename(path), path)
+    fonts = fontgen.read_c_fonts(path)
+    if len(fonts) != 1:
+        raise fontgen.FontError('%s: expected exactly one font' % path)
+    return list(fonts.values())[0]
+
+
+def build_font(path, chars_path):
+    font = load_font(path)
+    if chars_path:
+        wanted = set(ord(c) for c in open(chars_path, encoding='utf-8').read() if c >= ' ')
+        wanted |= set(ord(c) for c in fontgen.ASCII)
+        missing = sorted(e for e in wanted - set(font.glyphs) if e > 127)
+        if missing:
+            print('fontpack: warning: %s: missing %s' % (path, ''.join(chr(e) for e in missing)), file=sys.stderr)
+        glyphs = [font.glyphs[e] for e in sorted(wanted & set(font.glyphs))]
+    else:
+        glyphs = [font.glyphs[e] for e in sorted(font.glyphs)]
+
+    if font.header is None:
+        header = fontgen.build_header(glyphs, font.ascent, font.descent)
+        for g in glyphs:
+            g.data = fontgen.encode_glyph(g, header[2:9])
+    else:
+        header = font.header
+    return fontgen.write_u8g2(header, glyphs) + b'\0'
+
+
+def build_pack(fonts):
+    """fonts: list of (id, u8g2 data). Returns the pack with an erased magic."""
+    offset = 12 + 8 * len(fonts)
+    entries, blobs = b'', b''
+    for font_id, data in fonts:
+        entries += struct.pack('<BxxxI', font_id, offset + len(blobs))
+        data += b'\0' * (-len(data) % 4)
+        blobs += data
+    size = offset + len(blobs)
+    return struct.pack('<IHHI', 0xFFFFFFFF, len(fonts), 0, size) + entries + blobs
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('fonts', nargs='+', metavar='ID=PATH[:CHARS]')
+    parser.add_argument('-o', '--output', required=True)
+    args = parser.parse_args()
+
+    fonts = []
+    try:
+        for spec in args.fonts:
+            font_id, _, path = spec.partition('=')
+            font_id = int(font_id, 0)
+            if not FONT_ID_MIN <= font_id <= 0xFF:
+                raise fontgen.FontError('font ID 0x%02x out of range' % font_id)
+            if any(font_id == f[0] for f in fonts):
+                raise fontgen.FontError('duplicate font ID 0x%02x' % font_id)
+            chars = None
+            if ':' in path and not os.path.exists(path):
+                path, chars = path.rsplit(':', 1)
+            fonts.append((font_id, build_font(path, chars)))
+    except (fontgen.FontError, OSError, ValueError) as e:
+        print('fontpack: %s' % e, file=sys.stderr)
+        return 1
+
+    pack = build_pack(fonts)
+    with open(args.output, 'wb') as f:
+        f.write(pack)
+    print('%s: %d fonts, %d bytes, crc32 %08x' % (args.output, len(fonts), len(pack), zlib.crc32(pack[4:])))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,212 @@
+/*
+ * Renderer benchmark for the GUI sources
+ *
+ * Draws a full calendar and clock frame for every day of 2000-2199, black/
+ * white and black/white/red, at the page heights of the nRF51 (4096 byte
+ * heap) and nRF52 (2048 byte heap) builds. The GUI is compiled with
+ * GUI_COUNTERS (GUI/counters.h), each frame records its wall time, the hot
+ * path counters and the bytes sent to the screen.
+ *
+ * The counters do not depend on the machine, their per frame maximum is
+ * checked against the limits below. Wall time is only checked with -t, as
+ * the average per frame in microseconds. -s N draws only every Nth day,
+ * make test checks every 13th, CI runs all of them.
+ *
+ *     make -C tools bench-gui
+ *     tools/gui_bench -o frames.csv -t 2000
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "GUI.h"
+#include "Lunar.h"
+#include "counters.h"
+
+#define FIRST_YEAR 2000
+#define LAST_YEAR  2199
+
+int gui_page_height;
+gui_counters_t gui_counters;
+
+typedef struct {
+    const char *name;
+    display_mode_t mode;
+    bool bwr;
+    int page_height;
+    // per frame limits: GFX_drawPixel, glyph lookups, glyph decodes, lunar days, bytes
+    uint32_t max_pixel, max_lookup, max_decode, max_lunar, max_bytes;
+} bench_config_t;
+
+static const bench_config_t configs[] = {
+    {"calendar bw nrf51",  MODE_CALENDAR, false, NRF51_PAGE_HEIGHT, 40000, 240, 240, 31, 15000},
+    {"calendar bw nrf52",  MODE_CALENDAR, false, NRF52_PAGE_HEIGHT, 57000, 370, 370, 31, 15000},
+    {"calendar bwr nrf51", MODE_CALENDAR, true,  NRF51_PAGE_HEIGHT, 57000, 330, 330, 31, 30000},
+    {"calendar bwr nrf52", MODE_CALENDAR, true,  NRF52_PAGE_HEIGHT, 76000, 530, 530, 31, 30000},
+    {"clock bw nrf51",     MODE_CLOCK,    false, NRF51_PAGE_HEIGHT, 22000, 45, 45, 31, 15000},
+    {"clock bw nrf52",     MODE_CLOCK,    false, NRF52_PAGE_HEIGHT, 29000, 80, 80, 31, 15000},
+    {"clock bwr nrf51",    MODE_CLOCK,    true,  NRF51_PAGE_HEIGHT, 27500, 70, 70, 31, 30000},
+    {"clock bwr nrf52",    MODE_CLOCK,    true,  NRF52_PAGE_HEIGHT, 36000, 120, 120, 31, 30000},
+};
+
+typedef struct {
+    uint64_t draw_pixel, hv_line, glyph_lookup, glyph_decode, lunar_day, lunar_month;
+} bench_sum_t;
+
+typedef struct {
+    uint32_t frames;
+    double time, max_time;
+    bench_sum_t sum;
+    gui_counters_t max;
+    uint64_t bytes;
+    uint32_t max_bytes;
+} bench_result_t;
+
+static uint32_t m_bytes;
+static uint16_t m_window_w;
+
+static void SinkBegin(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    m_window_w = w;
+}
+
+static void SinkWrite(uint8_t *black, uint8_t *color, uint16_t h)
+{
+    m_bytes += (m_window_w + 7) / 8 * h * (color ? 2 : 1);
+}
+
+static const gui_sink_t sink = {SinkBegin, SinkWrite, NULL};
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define ACCUMULATE(field)                                               \
+    do {                                                                \
+        r->sum.field += gui_counters.field;                             \
+        if (gui_counters.field > r->max.field) r->max.field = gui_counters.field; \
+    } while (0)
+
+static void run(const bench_config_t *cfg, int step, bench_result_t *r, FILE *csv)
+{
+    int32_t first = days_from_civil(FIRST_YEAR, 1, 1);
+    int32_t last = days_from_civil(LAST_YEAR + 1, 1, 1);
+    gui_data_t data = {
+        .bwr             = cfg->bwr,
+        .width           = 400,
+        .height          = 300,
+        .temperature     = 23,
+        .voltage         = 3.0f,
+    };
+
+    memset(r, 0, sizeof(bench_result_t));
+    gui_page_height = cfg->page_height;
+    for (int32_t days = first; days < last; days += step) {
+        // a different time of day for every frame, so all clock digits are drawn
+        data.timestamp = (uint32_t)days * SEC_PER_DY + (uint32_t)(days - first) * 617 % SEC_PER_DY;
+        data.voltage = 2.5f + (days % 18) / 10.0f;
+
+        memset(&gui_counters, 0, sizeof(gui_counters));
+        m_bytes = 0;
+        GUI_Invalidate();
+        double t = now();
+        DrawGUI(&data, &sink, cfg->mode);
+        t = now() - t;
+
+        r->frames++;
+        r->time += t;
+        if (t > r->max_time) r->max_time = t;
+        ACCUMULATE(draw_pixel);
+        ACCUMULATE(hv_line);
+        ACCUMULATE(glyph_lookup);
+        ACCUMULATE(glyph_decode);
+        ACCUMULATE(lunar_day);
+        ACCUMULATE(lunar_month);
+        r->bytes += m_bytes;
+        if (m_bytes > r->max_bytes) r->max_bytes = m_bytes;
+
+        if (csv) {
+            int32_t year;
+            uint8_t month, day;
+            civil_from_days(days, &year, &month, &day);
+            fprintf(csv, "%s,%04d-%02d-%02d,%u,%.0f,%u,%u,%u,%u,%u,%u,%u\n", cfg->name, year, month, day,
+                    data.timestamp, t * 1e9, gui_counters.draw_pixel, gui_counters.hv_line,
+                    gui_counters.glyph_lookup, gui_counters.glyph_decode, gui_counters.lunar_day,
+                    gui_counters.lunar_month, m_bytes);
+        }
+    }
+}
+
+#define CHECK_LIMIT(value, limit, what)                                         \
+    do {                                                                        \
+        if ((value) > (limit)) {                                                \
+            printf("FAIL %s: %s %u per frame, limit %u\n", cfg->name, what,     \
+                   (unsigned)(value), (unsigned)(limit));                       \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+int main(int argc, char **argv)
+{
+    FILE *csv = NULL;
+    double time_limit = 0;
+    int step = 1;
+    int failures = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            csv = fopen(argv[++i], "w");
+            if (csv == NULL) {
+                perror(argv[i]);
+                return 2;
+            }
+            fprintf(csv, "config,date,timestamp,ns,draw_pixel,hv_line,glyph_lookup,glyph_decode,"
+                         "lunar_day,lunar_month,bytes\n");
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            time_limit = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            step = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: gui_bench [-o frames.csv] [-t max_us_per_frame] [-s every_nth_day]\n");
+            return 2;
+        }
+    }
+
+    printf("%-20s %7s %9s %9s %9s %8s %8s %8s %6s %7s\n", "", "frames", "avg us", "max us", "pixels",
+           "hv lines", "lookups", "decodes", "lunar", "bytes");
+    for (unsigned i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+        const bench_config_t *cfg = &configs[i];
+        bench_result_t r;
+
+        run(cfg, step, &r, csv);
+        printf("%-20s %7u %9.1f %9.1f %9.0f %8.0f %8.0f %8.0f %6.2f %7.0f\n", cfg->name, r.frames,
+               r.time * 1e6 / r.frames, r.max_time * 1e6, (double)r.sum.draw_pixel / r.frames,
+               (double)r.sum.hv_line / r.frames, (double)r.sum.glyph_lookup / r.frames,
+               (double)r.sum.glyph_decode / r.frames, (double)r.sum.lunar_day / r.frames,
+               (double)r.bytes / r.frames);
+        printf("%-20s %7s %9s %9s %9u %8u %8u %8u %6u %7u\n", "  max per frame", "", "", "",
+               r.max.draw_pixel, r.max.hv_line, r.max.glyph_lookup, r.max.glyph_decode, r.max.lunar_day,
+               r.max_bytes);
+
+        CHECK_LIMIT(r.max.draw_pixel, cfg->max_pixel, "GFX_drawPixel calls");
+        CHECK_LIMIT(r.max.glyph_lookup, cfg->max_lookup, "glyph lookups");
+        CHECK_LIMIT(r.max.glyph_decode, cfg->max_decode, "glyph decodes");
+        CHECK_LIMIT(r.max.lunar_day, cfg->max_lunar, "lunar conversions");
+        CHECK_LIMIT(r.max_bytes, cfg->max_bytes, "bytes");
+        if (time_limit > 0 && r.time * 1e6 / r.frames > time_limit) {
+            printf("FAIL %s: %.1f us per frame, limit %.1f\n", cfg->name, r.time * 1e6 / r.frames, time_limit);
+            failures++;
+        }
+    }
+    if (csv) fclose(csv);
+
+    if (failures) {
+        printf("%d limits exceeded\n", failures);
+        return 1;
+    }
+    printf("all limits OK\n");
+    return 0;
+}
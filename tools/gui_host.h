@@ -0,0 +1,16 @@
+/*
+ * Force-included (-include gui_host.h) into the GUI sources by the host
+ * tools, so the page height can be chosen at run time. The firmware derives
+ * it from the heap size, see PAGE_HEIGHT in GUI/GUI.h.
+ */
+#ifndef __GUI_HOST_H
+#define __GUI_HOST_H
+
+#define HEAP_PAGE_HEIGHT(heap) (((heap) / 50) - 4)
+#define NRF51_PAGE_HEIGHT HEAP_PAGE_HEIGHT(4096)
+#define NRF52_PAGE_HEIGHT HEAP_PAGE_HEIGHT(2048)
+
+extern int gui_page_height;
+#define PAGE_HEIGHT gui_page_height
+
+#endif
@@ -0,0 +1,263 @@
+/*
+ * Headless renderer for the GUI sources, writes the frame as PBM or PPM
+ *
+ * The GUI is drawn through DrawGUI and the same GFX_nextPage paging as on
+ * the tags, the pages are composed into a panel sized frame buffer. With -f
+ * the first frame is drawn at another time and the requested one is an
+ * update of it, which renders only the changed regions. A display list
+ * (GUI.h) is read from a file as uploaded with EPD_CMD_LIST_WRITE, its slot
+ * values are given as text or as numbers like EPD_CMD_SLOT_SET sets them.
+ *
+ *     make -C tools gui_render
+ *     tools/gui_render -m clock -t "2025-01-29 08:30" -c -p nrf52 clock.ppm
+ *     tools/gui_render -l list.bin -S 0="Hi 年月" -N 1=1299 -c list.ppm
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "GUI.h"
+#include "Lunar.h"
+
+int gui_page_height = NRF51_PAGE_HEIGHT;
+
+static struct {
+    uint16_t width, height, stride;
+    uint8_t *black, *color;   // panel RAM layout, 0 = black / red
+    uint16_t x, y, w;         // window being written
+    uint32_t windows, pages, bytes;
+} fb;
+
+static void SinkBegin(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    fb.x = x;
+    fb.y = y;
+    fb.w = w;
+    fb.windows++;
+}
+
+static void SinkWrite(uint8_t *black, uint8_t *color, uint16_t h)
+{
+    uint16_t wb = (fb.w + 7) / 8;
+
+    if (fb.x + fb.w > fb.width || fb.y + h > fb.height) {
+        fprintf(stderr, "gui_render: page %d,%d %dx%d outside of the screen\n", fb.x, fb.y, fb.w, h);
+        exit(1);
+    }
+    for (uint16_t i = 0; i < h; i++) {
+        memcpy(&fb.black[(fb.y + i) * fb.stride + fb.x / 8], &black[i * wb], wb);
+        if (color)
+            memcpy(&fb.color[(fb.y + i) * fb.stride + fb.x / 8], &color[i * wb], wb);
+    }
+    fb.y += h;
+    fb.pages++;
+    fb.bytes += wb * h * (color ? 2 : 1);
+}
+
+static const gui_sink_t sink = {SinkBegin, SinkWrite, NULL};
+
+static int parse_time(const char *s, uint32_t *timestamp)
+{
+    int year, month, day, hour = 0, min = 0, sec = 0;
+    char *end;
+
+    if (strchr(s, '-') == NULL) {
+        unsigned long t = strtoul(s, &end, 0);
+        *timestamp = t;
+        return *end == '\0' && t <= UINT32_MAX;
+    }
+    if (sscanf(s, "%d-%d-%d%*1[ T]%d:%d:%d", &year, &month, &day, &hour, &min, &sec) < 3)
+        return 0;
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || min > 59 || sec > 59)
+        return 0;
+    *timestamp = (uint32_t)days_from_civil(year, month, day) * SEC_PER_DY + hour * SEC_PER_HR + min * 60 + sec;
+    return 1;
+}
+
+static int write_image(const char *path, bool bwr)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        perror(path);
+        return 0;
+    }
+    if (bwr) {
+        fprintf(f, "P6\n%d %d\n255\n", fb.width, fb.height);
+        for (uint16_t y = 0; y < fb.height; y++) {
+            for (uint16_t x = 0; x < fb.width; x++) {
+                uint8_t bit = 0x80 >> (x & 7);
+                static const uint8_t rgb[3][3] = {{0, 0, 0}, {255, 0, 0}, {255, 255, 255}};
+                int c = !(fb.color[y * fb.stride + x / 8] & bit) ? 1 : (fb.black[y * fb.stride + x / 8] & bit) ? 2 : 0;
+                fwrite(rgb[c], 1, 3, f);
+            }
+        }
+    } else {
+        // PBM uses 1 for black
+        fprintf(f, "P4\n%d %d\n", fb.width, fb.height);
+        for (uint32_t i = 0; i < (uint32_t)fb.stride * fb.height; i++)
+            fputc(~fb.black[i] & 0xFF, f);
+    }
+    return fclose(f) == 0;
+}
+
+static uint8_t *read_file(const char *path, uint16_t *length)
+{
+    static uint8_t buf[UINT16_MAX];
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        exit(1);
+    }
+    *length = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    return buf;
+}
+
+// N=VALUE of -S and -N, the value stored like EPD_CMD_SLOT_SET does
+static bool parse_slot(const char *arg, bool number, uint8_t *slots)
+{
+    char *end;
+    long slot = strtol(arg, &end, 10);
+    if (end == arg || *end != '=' || slot < 0 || slot >= LIST_SLOT_COUNT) return false;
+
+    uint8_t *p = &slots[slot * LIST_SLOT_SIZE];
+    const char *value = end + 1;
+    if (number) {
+        long n = strtol(value, &end, 10);
+        if (end == value || *end != '\0') return false;
+        p[0] = 4;
+        p[1] = (uint32_t)n >> 24;
+        p[2] = (uint32_t)n >> 16;
+        p[3] = (uint32_t)n >> 8;
+        p[4] = (uint32_t)n;
+        return true;
+    }
+    if (strlen(value) >= LIST_SLOT_SIZE) return false;
+    p[0] = strlen(value);
+    memcpy(&p[1], value, p[0]);
+    return true;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: gui_render [options] OUTPUT.pbm|OUTPUT.ppm\n"
+            "  -m calendar|clock   display mode (calendar)\n"
+            "  -l FILE             draw the display list in FILE\n"
+            "  -S N=TEXT           text value of slot N of the display list\n"
+            "  -N N=NUMBER         number value of slot N\n"
+            "  -t TIME             unix timestamp or YYYY-MM-DD[ HH:MM[:SS]] (2025-01-01)\n"
+            "  -f TIME             draw TIME first, then update it to -t\n"
+            "  -c                  black/white/red screen, written as PPM\n"
+            "  -p N|nrf51|nrf52    page height in rows, or that of a firmware build (nrf51)\n"
+            "  -s WxH              screen size (400x300)\n"
+            "  -T C                temperature (23)\n"
+            "  -v V                battery voltage (3.0)\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    display_mode_t mode = MODE_CALENDAR;
+    uint32_t timestamp = 1735689600, from = 0;
+    bool bwr = false, update = false;
+    int width = 400, height = 300;
+    int8_t temperature = 23;
+    float voltage = 3.0f;
+    const uint8_t *list = NULL;
+    uint16_t list_len = 0;
+    static uint8_t slots[LIST_SLOT_COUNT * LIST_SLOT_SIZE];
+    int i;
+
+    for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++) {
+        char opt = argv[i][1];
+        if (opt == 'c') {
+            bwr = true;
+            continue;
+        }
+        if (argv[i][2] != '\0' || i + 1 >= argc)
+            usage();
+        const char *arg = argv[++i];
+        switch (opt) {
+            case 'm':
+                if (strcmp(arg, "calendar") == 0)
+                    mode = MODE_CALENDAR;
+                else if (strcmp(arg, "clock") == 0)
+                    mode = MODE_CLOCK;
+                else
+                    usage();
+                break;
+            case 'l':
+                list = read_file(arg, &list_len);
+                mode = MODE_LIST;
+                break;
+            case 'S':
+            case 'N':
+                if (!parse_slot(arg, opt == 'N', slots)) usage();
+                break;
+            case 't':
+                if (!parse_time(arg, &timestamp)) usage();
+                break;
+            case 'f':
+                if (!parse_time(arg, &from)) usage();
+                update = true;
+                break;
+            case 'p':
+                if (strcmp(arg, "nrf51") == 0)
+                    gui_page_height = NRF51_PAGE_HEIGHT;
+                else if (strcmp(arg, "nrf52") == 0)
+                    gui_page_height = NRF52_PAGE_HEIGHT;
+                else
+                    gui_page_height = atoi(arg);
+                if (gui_page_height < 2) usage();
+                break;
+            case 's':
+                if (sscanf(arg, "%dx%d", &width, &height) != 2 || width < 8 || height < 8 ||
+                    width > 800 || height > 800)
+                    usage();
+                break;
+            case 'T':
+                temperature = atoi(arg);
+                break;
+            case 'v':
+                voltage = atof(arg);
+                break;
+            default:
+                usage();
+        }
+    }
+    if (i + 1 != argc)
+        usage();
+
+    fb.width = width;
+    fb.height = height;
+    fb.stride = (width + 7) / 8;
+    fb.black = malloc(fb.stride * height);
+    fb.color = malloc(fb.stride * height);
+    memset(fb.black, 0xFF, fb.stride * height);
+    memset(fb.color, 0xFF, fb.stride * height);
+
+    gui_data_t data = {
+        .bwr             = bwr,
+        .width           = width,
+        .height          = height,
+        .timestamp       = update ? from : timestamp,
+        .temperature     = temperature,
+        .voltage         = voltage,
+        .list            = list,
+        .list_len        = list_len,
+        .slots           = slots,
+    };
+    GUI_Invalidate();
+    if (update) {
+        DrawGUI(&data, &sink, mode);
+        data.timestamp = timestamp;
+        fb.windows = fb.pages = fb.bytes = 0;
+    }
+    DrawGUI(&data, &sink, mode);
+
+    if (!write_image(argv[i], bwr))
+        return 1;
+    printf("%s: %dx%d, page height %d, %u windows, %u pages, %u bytes\n", argv[i], width, height,
+           gui_page_height, fb.windows, fb.pages, fb.bytes);
+    return 0;
+}
@@ -0,0 +1,11 @@
+/* Host stand-in for SEGGER RTT, the up buffers are read back with epd_sim_rtt_read() */
+#ifndef __HAL_SEGGER_RTT_H
+#define __HAL_SEGGER_RTT_H
+
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP 0U
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned BufferIndex, const char *sName, void *pBuffer, unsigned BufferSize,
+                              unsigned Flags);
+unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void *pBuffer, unsigned NumBytes);
+
+#endif
@@ -0,0 +1,18 @@
+/* Host stand-in for the SDK error check, see nrf.h */
+#ifndef __HAL_APP_ERROR_H
+#define __HAL_APP_ERROR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "nrf_error.h"
+
+#define APP_ERROR_CHECK(err_code)                                                   \
+    do {                                                                            \
+        uint32_t _err = (err_code);                                                 \
+        if (_err != NRF_SUCCESS) {                                                  \
+            fprintf(stderr, "%s:%d: error 0x%x\n", __FILE__, __LINE__, (unsigned)_err); \
+            abort();                                                                \
+        }                                                                           \
+    } while (0)
+
+#endif
@@ -0,0 +1,12 @@
+/* Host stand-in for the SDK event scheduler, see nrf.h */
+#ifndef __HAL_APP_SCHEDULER_H
+#define __HAL_APP_SCHEDULER_H
+
+#include <stdint.h>
+
+typedef void (*app_sched_event_handler_t)(void *p_event_data, uint16_t event_size);
+
+uint32_t app_sched_event_put(void const *p_event_data, uint16_t event_size, app_sched_event_handler_t handler);
+void app_sched_execute(void);
+
+#endif
@@ -0,0 +1,17 @@
+/* Host stand-in for the SDK critical regions, the host build has no interrupts */
+#ifndef __HAL_APP_UTIL_PLATFORM_H
+#define __HAL_APP_UTIL_PLATFORM_H
+
+#include <stdint.h>
+
+#define CRITICAL_REGION_ENTER()
+#define CRITICAL_REGION_EXIT()
+
+#define APP_IRQ_PRIORITY_THREAD 4
+
+static inline uint8_t current_int_priority_get(void)
+{
+    return APP_IRQ_PRIORITY_THREAD;
+}
+
+#endif
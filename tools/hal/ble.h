@@ -0,0 +1,128 @@
+/*
+ * Host stand-in for the S130 SoftDevice API (SDK 12), see nrf.h
+ *
+ * The ATT MTU is a variable of the simulated link rather than the 23 bytes
+ * of S130, so the same build also covers the MTU of the S112 firmware.
+ */
+#ifndef __HAL_BLE_H
+#define __HAL_BLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nrf_error.h"
+
+extern uint16_t hal_att_mtu;
+#define GATT_MTU_SIZE_DEFAULT (hal_att_mtu)
+
+#define BLE_CONN_HANDLE_INVALID 0xFFFF
+#define BLE_ERROR_NO_TX_PACKETS (0x3000 + 0x004)
+
+#define BLE_EVT_TX_COMPLETE      0x01
+#define BLE_GAP_EVT_CONNECTED    0x10
+#define BLE_GAP_EVT_DISCONNECTED 0x11
+#define BLE_GATTS_EVT_WRITE      0x50
+#define BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST 0x51
+
+#define BLE_GATTS_SRVC_TYPE_PRIMARY 0x01
+#define BLE_GATT_HVX_NOTIFICATION   0x01
+#define BLE_UUID_TYPE_VENDOR_BEGIN  0x02
+
+#define BLE_GATT_HVX_NOTIFICATION_ENABLED 0x0001
+
+#define BLE_GATTS_AUTHORIZE_TYPE_READ 0x01
+#define BLE_GATT_STATUS_SUCCESS       0x0000
+
+typedef struct {
+    uint16_t uuid;
+    uint8_t type;
+} ble_uuid_t;
+
+typedef struct {
+    uint8_t uuid128[16];
+} ble_uuid128_t;
+
+typedef struct {
+    uint16_t value_handle;
+    uint16_t user_desc_handle;
+    uint16_t cccd_handle;
+    uint16_t sccd_handle;
+} ble_gatts_char_handles_t;
+
+typedef struct {
+    uint16_t handle;
+    uint8_t type;
+    uint16_t offset;
+    uint16_t *p_len;
+    uint8_t const *p_data;
+} ble_gatts_hvx_params_t;
+
+typedef struct {
+    uint16_t conn_handle;
+} ble_gap_evt_t;
+
+typedef struct {
+    uint16_t handle;
+    uint8_t op;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t data[1];    // variable length, up to the ATT MTU
+} ble_gatts_evt_write_t;
+
+typedef struct {
+    uint16_t handle;
+    ble_uuid_t uuid;
+    uint16_t offset;
+} ble_gatts_evt_read_t;
+
+typedef struct {
+    uint8_t type;
+    union {
+        ble_gatts_evt_read_t read;
+        ble_gatts_evt_write_t write;
+    } request;
+} ble_gatts_evt_rw_authorize_request_t;
+
+typedef struct {
+    uint16_t conn_handle;
+    union {
+        ble_gatts_evt_write_t write;
+        ble_gatts_evt_rw_authorize_request_t authorize_request;
+    } params;
+} ble_gatts_evt_t;
+
+typedef struct {
+    uint16_t gatt_status;
+    uint8_t update : 1;
+    uint16_t offset;
+    uint16_t len;
+    const uint8_t *p_data;
+} ble_gatts_authorize_params_t;
+
+typedef struct {
+    uint8_t type;
+    union {
+        ble_gatts_authorize_params_t read;
+        ble_gatts_authorize_params_t write;
+    } params;
+} ble_gatts_rw_authorize_reply_params_t;
+
+typedef struct {
+    uint16_t evt_id;
+    uint16_t evt_len;
+} ble_evt_hdr_t;
+
+typedef struct {
+    ble_evt_hdr_t header;
+    union {
+        ble_gap_evt_t gap_evt;
+        ble_gatts_evt_t gatts_evt;
+    } evt;
+} ble_evt_t;
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const *p_vs_uuid, uint8_t *p_uuid_type);
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const *p_uuid, uint16_t *p_handle);
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const *p_hvx_params);
+uint32_t sd_ble_gatts_rw_authorize_reply(uint16_t conn_handle,
+                                         ble_gatts_rw_authorize_reply_params_t const *p_rw_authorize_reply_params);
+
+#endif
@@ -0,0 +1,15 @@
+/* Host stand-in for the SDK common macros, see nrf.h */
+#ifndef __HAL_NORDIC_COMMON_H
+#define __HAL_NORDIC_COMMON_H
+
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) < (b) ? (b) : (a))
+#endif
+
+#define UNUSED_PARAMETER(X) ((void)(X))
+#define BYTES_TO_WORDS(n_bytes) (((n_bytes) + 3) >> 2)
+
+#endif
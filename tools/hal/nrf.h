@@ -0,0 +1,55 @@
+/*
+ * Host stand-in for the nRF5 SDK, used by tools/epd_sim.c to build the EPD
+ * drivers unchanged. Only what EPD/EPD_driver.c uses (nRF51 variant) is
+ * declared, the registers are backed by epd_sim.c. The SoftDevice, FDS and
+ * scheduler headers serve EPD/EPD_service.c and EPD_config.c in
+ * tools/ble_harness.c, which also implements them.
+ */
+#ifndef __HAL_NRF_H
+#define __HAL_NRF_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t PIN_CNF[32];
+} NRF_GPIO_Type;
+
+#define GPIO_PIN_CNF_DIR_Pos 0
+#define GPIO_PIN_CNF_DIR_Msk (0x1UL << GPIO_PIN_CNF_DIR_Pos)
+
+typedef struct {
+    volatile uint32_t ENABLE;
+    volatile uint32_t CONFIG;
+    volatile uint32_t TASKS_START;
+    volatile uint32_t TASKS_STOP;
+    volatile uint32_t EVENTS_END;
+    volatile uint32_t RESULT;
+} NRF_ADC_Type;
+
+#define ADC_CONFIG_RES_Pos 0
+#define ADC_CONFIG_RES_10bit 2
+#define ADC_CONFIG_INPSEL_Pos 2
+#define ADC_CONFIG_INPSEL_SupplyOneThirdPrescaling 6
+#define ADC_CONFIG_REFSEL_Pos 5
+#define ADC_CONFIG_REFSEL_VBG 0
+#define ADC_CONFIG_PSEL_Pos 8
+#define ADC_CONFIG_PSEL_Disabled 0
+#define ADC_CONFIG_EXTREFSEL_Pos 16
+#define ADC_CONFIG_EXTREFSEL_None 0
+
+// every access completes the conversion, see hal_adc() in epd_sim.c
+NRF_ADC_Type *hal_adc(void);
+#define NRF_ADC (hal_adc())
+
+typedef struct {
+    volatile uint32_t COUNTER;
+} NRF_RTC_Type;
+
+// 32768 Hz, follows the simulated time, see hal_rtc1() in epd_sim.c
+NRF_RTC_Type *hal_rtc1(void);
+#define NRF_RTC1 (hal_rtc1())
+
+// does not return, see ble_harness.c
+void NVIC_SystemReset(void);
+
+#endif
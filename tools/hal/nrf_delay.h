@@ -0,0 +1,10 @@
+/* Host stand-in for the SDK delay functions, they advance the simulated time */
+#ifndef __HAL_NRF_DELAY_H
+#define __HAL_NRF_DELAY_H
+
+#include <stdint.h>
+
+void nrf_delay_ms(uint32_t ms);
+void nrf_delay_us(uint32_t us);
+
+#endif
@@ -0,0 +1,43 @@
+/* Host stand-in for the SDK SPI master driver (nRF51 API), see nrf.h */
+#ifndef __HAL_NRF_DRV_SPI_H
+#define __HAL_NRF_DRV_SPI_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "nrf.h"
+
+#define NRF_SPI_PIN_NOT_CONNECTED 0xFF
+
+typedef struct {
+    void *p_registers;
+    uint8_t drv_inst_idx;
+} nrf_drv_spi_t;
+
+#define NRF_DRV_SPI_INSTANCE(id) {NULL, id}
+
+typedef struct {
+    uint8_t sck_pin;
+    uint8_t mosi_pin;
+    uint8_t miso_pin;
+    uint8_t ss_pin;
+    uint32_t frequency;
+} nrf_drv_spi_config_t;
+
+#define NRF_DRV_SPI_DEFAULT_CONFIG {                        \
+    .sck_pin   = NRF_SPI_PIN_NOT_CONNECTED,                 \
+    .mosi_pin  = NRF_SPI_PIN_NOT_CONNECTED,                 \
+    .miso_pin  = NRF_SPI_PIN_NOT_CONNECTED,                 \
+    .ss_pin    = NRF_SPI_PIN_NOT_CONNECTED,                 \
+    .frequency = 4000000,                                   \
+}
+
+typedef void (*nrf_drv_spi_handler_t)(void *p_event);
+
+uint32_t nrf_drv_spi_init(nrf_drv_spi_t const *p_instance, nrf_drv_spi_config_t const *p_config,
+                          nrf_drv_spi_handler_t handler);
+void nrf_drv_spi_uninit(nrf_drv_spi_t const *p_instance);
+uint32_t nrf_drv_spi_transfer(nrf_drv_spi_t const *p_instance, uint8_t const *p_tx_buffer, uint8_t tx_buffer_length,
+                              uint8_t *p_rx_buffer, uint8_t rx_buffer_length);
+void nrf_spi_pins_set(void *p_reg, uint32_t sck_pin, uint32_t mosi_pin, uint32_t miso_pin);
+
+#endif
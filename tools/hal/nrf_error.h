@@ -0,0 +1,17 @@
+/* Host stand-in for the SDK error codes, see nrf.h */
+#ifndef __HAL_NRF_ERROR_H
+#define __HAL_NRF_ERROR_H
+
+#define NRF_ERROR_BASE_NUM            0x0
+#define NRF_SUCCESS                   (NRF_ERROR_BASE_NUM + 0)
+#define NRF_ERROR_INTERNAL            (NRF_ERROR_BASE_NUM + 3)
+#define NRF_ERROR_NO_MEM              (NRF_ERROR_BASE_NUM + 4)
+#define NRF_ERROR_NOT_FOUND           (NRF_ERROR_BASE_NUM + 5)
+#define NRF_ERROR_INVALID_PARAM       (NRF_ERROR_BASE_NUM + 7)
+#define NRF_ERROR_INVALID_STATE       (NRF_ERROR_BASE_NUM + 8)
+#define NRF_ERROR_INVALID_LENGTH      (NRF_ERROR_BASE_NUM + 9)
+#define NRF_ERROR_INVALID_DATA        (NRF_ERROR_BASE_NUM + 11)
+#define NRF_ERROR_NULL                (NRF_ERROR_BASE_NUM + 14)
+#define NRF_ERROR_BUSY                (NRF_ERROR_BASE_NUM + 17)
+
+#endif
@@ -0,0 +1,34 @@
+/* Host stand-in for the SDK GPIO HAL, see nrf.h */
+#ifndef __HAL_NRF_GPIO_H
+#define __HAL_NRF_GPIO_H
+
+#include <stdint.h>
+#include "nrf.h"
+
+typedef enum {
+    NRF_GPIO_PIN_DIR_INPUT = 0,
+    NRF_GPIO_PIN_DIR_OUTPUT = 1,
+} nrf_gpio_pin_dir_t;
+
+typedef enum {
+    NRF_GPIO_PIN_NOPULL = 0,
+    NRF_GPIO_PIN_PULLDOWN = 1,
+    NRF_GPIO_PIN_PULLUP = 3,
+} nrf_gpio_pin_pull_t;
+
+typedef enum {
+    NRF_GPIO_PIN_NOSENSE = 0,
+    NRF_GPIO_PIN_SENSE_LOW = 3,
+    NRF_GPIO_PIN_SENSE_HIGH = 2,
+} nrf_gpio_pin_sense_t;
+
+NRF_GPIO_Type *nrf_gpio_pin_port_decode(uint32_t *p_pin);
+void nrf_gpio_cfg_output(uint32_t pin);
+void nrf_gpio_cfg_input(uint32_t pin, nrf_gpio_pin_pull_t pull);
+void nrf_gpio_cfg_sense_input(uint32_t pin, nrf_gpio_pin_pull_t pull, nrf_gpio_pin_sense_t sense);
+void nrf_gpio_cfg_default(uint32_t pin);
+void nrf_gpio_pin_write(uint32_t pin, uint32_t value);
+uint32_t nrf_gpio_pin_read(uint32_t pin);
+void nrf_gpio_pin_toggle(uint32_t pin);
+
+#endif
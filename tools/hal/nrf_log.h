@@ -0,0 +1,11 @@
+/* Host stand-in for the SDK logger, see nrf.h */
+#ifndef __HAL_NRF_LOG_H
+#define __HAL_NRF_LOG_H
+
+#define NRF_LOG_DEBUG(...)
+#define NRF_LOG_INFO(...)
+#define NRF_LOG_WARNING(...)
+#define NRF_LOG_ERROR(...)
+#define NRF_LOG_HEXDUMP_DEBUG(p_data, len)
+
+#endif
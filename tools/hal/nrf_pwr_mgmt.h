@@ -0,0 +1,5 @@
+/* Host stand-in for the SDK power management, only used by the S112 build */
+#ifndef __HAL_NRF_PWR_MGMT_H
+#define __HAL_NRF_PWR_MGMT_H
+
+#endif
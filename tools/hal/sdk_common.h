@@ -0,0 +1,16 @@
+/* Host stand-in for the SDK common header of SDK modules built from source, see nrf.h */
+#ifndef __HAL_SDK_COMMON_H
+#define __HAL_SDK_COMMON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "sdk_config.h"
+#include "sdk_macros.h"
+
+#define NRF_MODULE_ENABLED(module) (module ## _ENABLED)
+#define IS_POWER_OF_TWO(A)         (((A) != 0) && ((((A) - 1) & (A)) == 0))
+#define __INLINE                   inline
+
+#endif
@@ -0,0 +1,8 @@
+/* Host stand-in for the SDK configuration, only the SDK modules built from source are enabled */
+#ifndef __HAL_SDK_CONFIG_H
+#define __HAL_SDK_CONFIG_H
+
+#define APP_FIFO_ENABLED 1
+#define CRC32_ENABLED    1
+
+#endif
@@ -0,0 +1,10 @@
+/* Host stand-in for the SDK error type, see nrf.h */
+#ifndef __HAL_SDK_ERRORS_H
+#define __HAL_SDK_ERRORS_H
+
+#include <stdint.h>
+#include "nrf_error.h"
+
+typedef uint32_t ret_code_t;
+
+#endif
@@ -0,0 +1,21 @@
+/* Host stand-in for the SDK verification macros, see nrf.h */
+#ifndef __HAL_SDK_MACROS_H
+#define __HAL_SDK_MACROS_H
+
+#include "nordic_common.h"
+#include "sdk_errors.h"
+
+#define VERIFY_PARAM_NOT_NULL(param) \
+    do {                             \
+        if ((param) == NULL)         \
+            return NRF_ERROR_NULL;   \
+    } while (0)
+
+#define VERIFY_SUCCESS(statement)                   \
+    do {                                            \
+        uint32_t _err_code = (uint32_t)(statement); \
+        if (_err_code != NRF_SUCCESS)               \
+            return _err_code;                       \
+    } while (0)
+
+#endif
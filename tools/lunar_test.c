@@ -0,0 +1,401 @@
+/*
+ * Host test and benchmark for the date conversions in GUI/Lunar.c
+ *
+ * Every day of 2000-2199 (the range of the lunar tables) is checked against
+ * the C library (gmtime/timegm with a 64-bit time_t) and against the old
+ * loop based conversion, which is also used as the benchmark reference.
+ * The cached month calendar is checked against the per-day lunar functions,
+ * and the almanac against the tables it replaced and a list of published dates.
+ *
+ *     make -C tools test
+ *     make -C tools bench
+ */
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Lunar.h"
+
+#define FIRST_YEAR 2000
+#define LAST_YEAR  2199
+
+static int failures;
+
+#define CHECK(cond, ...)                        \
+    do {                                        \
+        if (!(cond)) {                          \
+            if (failures++ < 20) {              \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+                printf(__VA_ARGS__);            \
+                printf("\n");                   \
+            }                                   \
+        }                                       \
+    } while (0)
+
+/* The previous implementation: walk year by year, then month by month. */
+static const uint32_t ref_sec_per_yr[2] = {31536000, 31622400};
+static const uint32_t ref_sec_per_mt[2][12] = {
+    {2678400, 2419200, 2678400, 2592000, 2678400, 2592000,
+     2678400, 2678400, 2592000, 2678400, 2592000, 2678400},
+    {2678400, 2505600, 2678400, 2592000, 2678400, 2592000,
+     2678400, 2678400, 2592000, 2678400, 2592000, 2678400},
+};
+
+static void ref_transform(int64_t unix_time, struct devtm *result)
+{
+    int64_t ltime = unix_time;
+    int leapyr;
+
+    memset(result, 0, sizeof(struct devtm));
+    result->tm_year = EPOCH_YR;
+    while (ltime >= ref_sec_per_yr[is_leap(result->tm_year)])
+        ltime -= ref_sec_per_yr[is_leap(result->tm_year++)];
+    leapyr = is_leap(result->tm_year);
+    while (ltime >= ref_sec_per_mt[leapyr][result->tm_mon])
+        ltime -= ref_sec_per_mt[leapyr][result->tm_mon++];
+    result->tm_mday = ltime / SEC_PER_DY + 1;
+    ltime %= SEC_PER_DY;
+    result->tm_hour = ltime / SEC_PER_HR;
+    ltime %= SEC_PER_HR;
+    result->tm_min = ltime / 60;
+    result->tm_sec = ltime % 60;
+    result->tm_wday = day_of_week_get(result->tm_mon + 1, result->tm_mday, result->tm_year);
+    result->tm_year -= YEAR0;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void test_days(void)
+{
+    struct tm ref = {0};
+    int32_t days, year;
+    uint8_t month, day;
+
+    ref.tm_year = FIRST_YEAR - 1900;
+    ref.tm_mday = 1;
+    days = days_from_civil(FIRST_YEAR, 1, 1);
+    CHECK((time_t)days * SEC_PER_DY == timegm(&ref), "days_from_civil(%d-01-01)", FIRST_YEAR);
+
+    for (;; days++) {
+        time_t t = (time_t)days * SEC_PER_DY;
+        gmtime_r(&t, &ref);
+        if (ref.tm_year + 1900 > LAST_YEAR)
+            break;
+
+        civil_from_days(days, &year, &month, &day);
+        CHECK(year == ref.tm_year + 1900 && month == ref.tm_mon + 1 && day == ref.tm_mday,
+              "civil_from_days(%d) = %d-%d-%d", days, year, month, day);
+        CHECK(days_from_civil(ref.tm_year + 1900, ref.tm_mon + 1, ref.tm_mday) == days,
+              "days_from_civil(%d-%d-%d)", ref.tm_year + 1900, ref.tm_mon + 1, ref.tm_mday);
+        CHECK(day_of_week_get(month, day, year) == ref.tm_wday, "day_of_week_get(%d-%d-%d)", year, month, day);
+        if (day == 1) {
+            struct tm last = ref;
+            last.tm_mon++;
+            last.tm_mday = 0; // timegm normalizes to the last day of the month
+            timegm(&last);
+            CHECK(thisMonthMaxDays(year, month) == last.tm_mday, "thisMonthMaxDays(%d, %d)", year, month);
+            CHECK(get_last_day(year, month - 1) == last.tm_mday, "get_last_day(%d, %d)", year, month - 1);
+            CHECK(get_first_day_week(year, month) == ref.tm_wday, "get_first_day_week(%d, %d)", year, month);
+        }
+    }
+}
+
+static void test_transform(void)
+{
+    int64_t t, first, last;
+    struct devtm dt, rt;
+    struct tm ref;
+
+    first = (int64_t)days_from_civil(FIRST_YEAR, 1, 1) * SEC_PER_DY;
+    last = (int64_t)days_from_civil(LAST_YEAR + 1, 1, 1) * SEC_PER_DY;
+
+    // every day at a changing time of day, plus the seconds around midnight
+    for (t = first; t < last; t += SEC_PER_DY + 7) {
+        int64_t s[3] = {t, t - t % SEC_PER_DY, t - t % SEC_PER_DY - 1};
+        for (int i = 0; i < 3; i++) {
+            time_t tt = (time_t)s[i];
+            gmtime_r(&tt, &ref);
+            transformTime(s[i], &dt);
+            CHECK(dt.tm_year == ref.tm_year && dt.tm_mon == ref.tm_mon && dt.tm_mday == ref.tm_mday &&
+                  dt.tm_hour == ref.tm_hour && dt.tm_min == ref.tm_min && dt.tm_sec == ref.tm_sec &&
+                  dt.tm_wday == ref.tm_wday, "transformTime(%lld)", (long long)s[i]);
+            ref_transform(s[i], &rt);
+            CHECK(memcmp(&dt, &rt, sizeof(dt)) == 0, "transformTime(%lld) differs from reference", (long long)s[i]);
+
+            dt.tm_year += YEAR0;
+            dt.tm_mon += 1;
+            CHECK(transformTimeStruct(&dt) == s[i], "transformTimeStruct(%lld)", (long long)s[i]);
+        }
+    }
+}
+
+static void test_month(void)
+{
+    for (int year = FIRST_YEAR; year <= LAST_YEAR; year++) {
+        for (int month = 1; month <= 12; month++) {
+            const struct Lunar_Month *lm = LUNAR_GetMonth(year, month);
+            CHECK(lm->Days == thisMonthMaxDays(year, month), "LUNAR_GetMonth(%d, %d) days", year, month);
+            for (int day = 1; day <= lm->Days; day++) {
+                struct Lunar_Date a, b;
+                uint8_t JQdate;
+                LUNAR_SolarToLunar(&a, year, month, day);
+                LUNAR_GetDate(lm, day, &b);
+                CHECK(a.Year == b.Year && a.Month == b.Month && a.Date == b.Date && a.IsLeap == b.IsLeap,
+                      "LUNAR_GetDate(%d-%d-%d)", year, month, day);
+                int JQ = (GetJieQi(year, month, day, &JQdate) && JQdate == day) ? (month - 1) * 2 + (day >= 15)
+                                                                                : LUNAR_DAY_NO_JIEQI;
+                CHECK(lm->Day[day - 1].JieQi == JQ, "LUNAR_GetMonth(%d, %d) JieQi on %d", year, month, day);
+            }
+        }
+    }
+}
+
+/* The lunar month and solar term tables of the previous GUI/Lunar.c, frozen as
+ * a regression vector for the almanac: the months of 2000-2199 are the same,
+ * the solar terms of 2000-2050 (the only years of the old table) differ only
+ * in jieqi_moved[]. The lookups are the old ones, reduced to what is compared. */
+static const uint32_t ref_lunar_month_days[] = {
+    1997,
+    0x0000B26D, 0x0000125C, 0x0000192C, 0x00009A95, 0x00001A94, 0x00001B4A, 0x00004B55, 0x00000AD4, 0x0000F55B,
+    0x000004BA, 0x0000125A, 0x0000B92B, 0x0000152A, 0x00001694, 0x000096AA, 0x000015AA, 0x00012AB5, 0x00000974,
+    0x000014B6, 0x0000CA57, 0x00000A56, 0x00001526, 0x00008E95, 0x00000D54, 0x000015AA, 0x000049B5, 0x0000096C,
+    0x0000D4AE, 0x0000149C, 0x00001A4C, 0x0000BD26, 0x00001AA6, 0x00000B54, 0x00006D6A, 0x000012DA, 0x0001695D,
+    0x0000095A, 0x0000149A, 0x0000DA4B, 0x00001A4A, 0x00001AA4, 0x0000BB54, 0x000016B4, 0x00000ADA, 0x0000495B,
+    0x00000936, 0x0000F497, 0x00001496, 0x0000154A, 0x0000B6A5, 0x00000DA4, 0x000015B4, 0x00006AB6, 0x0000126E,
+    0x0001092F, 0x0000092E, 0x00000C96, 0x0000CD4A, 0x00001D4A, 0x00000D64, 0x0000956C, 0x0000155C, 0x0000125C,
+    0x0000792E, 0x0000192C, 0x0000FA95, 0x00001A94, 0x00001B4A, 0x0000AB55, 0x00000AD4, 0x000014DA, 0x00008A5D,
+    0x00000A5A, 0x0001152B, 0x0000152A, 0x00001694, 0x0000D6AA, 0x000015AA, 0x00000AB4, 0x000094BA, 0x000014B6,
+    0x00000A56, 0x00007527, 0x00000D26, 0x0000EE53, 0x00000D54, 0x000015AA, 0x0000A9B5, 0x0000096C, 0x000014AE,
+    0x00008A4E, 0x00001A4C, 0x00011D26, 0x00001AA4, 0x00001B54, 0x0000CD6A, 0x00000ADA, 0x0000095C, 0x0000949D,
+    0x0000149A, 0x00001A2A, 0x00005B25, 0x00001AA4, 0x0000FB52, 0x000016B4, 0x00000ABA, 0x0000A95B, 0x00000936,
+    0x00001496, 0x00009A4B, 0x0000154A, 0x000136A5, 0x00000DA4, 0x000015AC, 0x0000CAB6, 0x0000126E, 0x0000092E,
+    0x00008C97, 0x00000A96, 0x00000D4A, 0x00006DA5, 0x00000D54, 0x0000F56A, 0x0000155A, 0x00000A5C, 0x0000B92E,
+    0x0000152C, 0x00001A94, 0x00009D4A, 0x00001B2A, 0x00016B55, 0x00000AD4, 0x000014DA, 0x0000CA5D, 0x00000A5A,
+    0x0000151A, 0x0000BA95, 0x00001654, 0x000016AA, 0x00004AD5, 0x00000AB4, 0x0000F4BA, 0x000014B6, 0x00000A56,
+    0x0000B517, 0x00000D16, 0x00000E52, 0x000096AA, 0x00000D6A, 0x000165B5, 0x0000096C, 0x000014AE, 0x0000CA2E,
+    0x00001A2C, 0x00001D16, 0x0000AD52, 0x00001B52, 0x00000B6A, 0x0000656D, 0x0000055C, 0x0000F45D, 0x0000145A,
+    0x00001A2A, 0x0000DA95, 0x000016A4, 0x00001AD2, 0x00008B5A, 0x00000AB6, 0x0001455B, 0x000008B6, 0x00001456,
+    0x0000D52B, 0x0000152A, 0x00001694, 0x0000B6AA, 0x000015AA, 0x00000AB6, 0x000064B7, 0x000008AE, 0x0000EC57,
+    0x00000A56, 0x00000D2A, 0x0000CD95, 0x00000B54, 0x0000156A, 0x00008A6D, 0x0000095C, 0x000014AE, 0x00004A56,
+    0x00001A54, 0x0000DD2A, 0x00001AAA, 0x00000B54, 0x0000B56A, 0x000014DA, 0x0000095C, 0x000074AB, 0x0000149A,
+    0x0000FA4B, 0x00001652, 0x000016AA, 0x0000CAD5, 0x000005B4};
+static const uint32_t ref_solar_1_1[] = {
+    1997,
+    0x000F9C3C, 0x000F9E50, 0x000FA045, 0x000FA238, 0x000FA44C, 0x000FA641, 0x000FA836, 0x000FAA49, 0x000FAC3D,
+    0x000FAE52, 0x000FB047, 0x000FB23A, 0x000FB44E, 0x000FB643, 0x000FB837, 0x000FBA4A, 0x000FBC3F, 0x000FBE53,
+    0x000FC048, 0x000FC23C, 0x000FC450, 0x000FC645, 0x000FC839, 0x000FCA4C, 0x000FCC41, 0x000FCE36, 0x000FD04A,
+    0x000FD23D, 0x000FD451, 0x000FD646, 0x000FD83A, 0x000FDA4D, 0x000FDC43, 0x000FDE37, 0x000FE04B, 0x000FE23F,
+    0x000FE453, 0x000FE648, 0x000FE83C, 0x000FEA4F, 0x000FEC44, 0x000FEE38, 0x000FF04C, 0x000FF241, 0x000FF436,
+    0x000FF64A, 0x000FF83E, 0x000FFA51, 0x000FFC46, 0x000FFE3A, 0x0010004E, 0x00100242, 0x00100437, 0x0010064B,
+    0x00100841, 0x00100A53, 0x00100C48, 0x00100E3C, 0x0010104F, 0x00101244, 0x00101438, 0x0010164C, 0x00101842,
+    0x00101A35, 0x00101C49, 0x00101E3D, 0x00102051, 0x00102245, 0x0010243A, 0x0010264E, 0x00102843, 0x00102A37,
+    0x00102C4B, 0x00102E3F, 0x00103053, 0x00103247, 0x0010343B, 0x0010364F, 0x00103845, 0x00103A38, 0x00103C4C,
+    0x00103E42, 0x00104036, 0x00104249, 0x0010443D, 0x00104651, 0x00104846, 0x00104A3A, 0x00104C4E, 0x00104E43,
+    0x00105038, 0x0010524A, 0x0010543E, 0x00105652, 0x00105847, 0x00105A3B, 0x00105C4F, 0x00105E45, 0x00106039,
+    0x0010624C, 0x00106441, 0x00106635, 0x00106849, 0x00106A3D, 0x00106C51, 0x00106E47, 0x0010703C, 0x0010724F,
+    0x00107444, 0x00107638, 0x0010784C, 0x00107A3F, 0x00107C53, 0x00107E48, 0x0010803D, 0x00108250, 0x00108446,
+    0x0010863A, 0x0010884E, 0x00108A42, 0x00108C36, 0x00108E4A, 0x0010903E, 0x00109251, 0x00109447, 0x0010963B,
+    0x0010984F, 0x00109A43, 0x00109C37, 0x00109E4B, 0x0010A041, 0x0010A253, 0x0010A448, 0x0010A63D, 0x0010A851,
+    0x0010AA45, 0x0010AC39, 0x0010AE4D, 0x0010B042, 0x0010B236, 0x0010B44A, 0x0010B63E, 0x0010B852, 0x0010BA47,
+    0x0010BC3B, 0x0010BE4F, 0x0010C044, 0x0010C237, 0x0010C44B, 0x0010C641, 0x0010C854, 0x0010CA48, 0x0010CC3D,
+    0x0010CE50, 0x0010D045, 0x0010D239, 0x0010D44C, 0x0010D642, 0x0010D837, 0x0010DA4A, 0x0010DC3E, 0x0010DE52,
+    0x0010E047, 0x0010E23A, 0x0010E44E, 0x0010E643, 0x0010E838, 0x0010EA4B, 0x0010EC41, 0x0010EE54, 0x0010F049,
+    0x0010F23C, 0x0010F450, 0x0010F645, 0x0010F839, 0x0010FA4C, 0x0010FC42, 0x0010FE37, 0x0011004B, 0x0011023E,
+    0x00110452, 0x00110647, 0x0011083B, 0x00110A4E, 0x00110C43, 0x00110E38, 0x0011104C, 0x0011123F, 0x00111435,
+    0x00111648, 0x0011183C, 0x00111A4F, 0x00111C45, 0x00111E39, 0x0011204D, 0x00112242, 0x00112436, 0x0011264A,
+    0x0011283E, 0x00112A51, 0x00112C46, 0x00112E3B, 0x0011304F};
+
+// 3 bytes a year, one bit per solar term: one day off its base day
+static const uint8_t ref_jieqi_bits[51 * 3] = {
+    0x4E, 0xA6, 0x99, 0x9C, 0xA2, 0x98, 0x80, 0x00, 0x18, 0x00, 0x10, 0x24, // 2000
+    0x4E, 0xA6, 0x99, 0x9C, 0xA2, 0x98, 0x80, 0x82, 0x18, 0x00, 0x10, 0x24, // 2004
+    0x4E, 0xA6, 0xD9, 0x9E, 0xA2, 0x98, 0x80, 0x82, 0x18, 0x00, 0x10, 0x04, // 2008
+    0x4E, 0xE6, 0xD9, 0x9E, 0xA6, 0xA8, 0x80, 0x82, 0x18, 0x00, 0x10, 0x00, // 2012
+    0x0F, 0xE6, 0xD9, 0xBE, 0xA6, 0x98, 0x88, 0x82, 0x18, 0x80, 0x00, 0x00, // 2016
+    0x0F, 0xEF, 0xD9, 0xBE, 0xA6, 0x99, 0x8C, 0x82, 0x98, 0x80, 0x00, 0x00, // 2020
+    0x0F, 0xEF, 0xDB, 0xBE, 0xA6, 0x99, 0x9C, 0xA2, 0x98, 0x80, 0x00, 0x18, // 2024
+    0x0F, 0xEF, 0xDB, 0xBE, 0xA6, 0x99, 0x9C, 0xA2, 0x98, 0x80, 0x00, 0x18, // 2028
+    0x0F, 0xEF, 0xDB, 0xBE, 0xA2, 0x99, 0x8C, 0xA0, 0x98, 0x80, 0x82, 0x18, // 2032
+    0x0B, 0xEF, 0xDB, 0xBE, 0xA6, 0x99, 0x8C, 0xA2, 0x98, 0x80, 0x82, 0x18, // 2036
+    0x0F, 0xEF, 0xDB, 0xBE, 0xE6, 0xD9, 0x9E, 0xA2, 0x98, 0x80, 0x82, 0x18, // 2040
+    0x0F, 0xEF, 0xFB, 0xBF, 0xE6, 0xD9, 0x9E, 0xA6, 0x98, 0x80, 0x82, 0x18, // 2044
+    0x0F, 0xFF, 0xFF, 0xFC, 0xEF, 0xD9, 0xBE, 0xA6, 0x18, // 2048
+};
+static const uint8_t ref_jieqi_base[24] = {6, 20, 4, 19, 6, 21, 5, 20, 6, 21, 6, 21, 7, 23, 8, 23, 8, 23, 8, 24, 8, 22, 7, 22};
+
+static uint16_t ref_solar_to_int(uint16_t y, uint8_t m, uint8_t d)
+{
+    m = (m + 9) % 12;
+    y = y - m / 10;
+    return 365 * y + y / 4 - y / 100 + y / 400 + (m * 306 + 5) / 10 + (d - 1);
+}
+
+static void ref_solar_to_lunar(struct Lunar_Date *lunar, uint16_t year, uint8_t month, uint8_t day)
+{
+    uint16_t index = year - ref_solar_1_1[0];
+    uint32_t first, days;
+    uint8_t leap, m;
+    uint16_t offset;
+
+    if (ref_solar_1_1[index] > ((uint32_t)year << 9 | month << 5 | day))
+        index--;
+    first = ref_solar_1_1[index];
+    offset = ref_solar_to_int(year, month, day) - ref_solar_to_int(first >> 9 & 0xFFF, first >> 5 & 0xF, first & 0x1F) + 1;
+    days = ref_lunar_month_days[index];
+    leap = days >> 13 & 0xF;
+    for (m = 1; m < 14 && offset > (uint8_t)((days >> (13 - m) & 1) ? 30 : 29); m++)
+        offset -= (days >> (13 - m) & 1) ? 30 : 29;
+    lunar->IsLeap = leap != 0 && m == leap + 1;
+    lunar->Month = (leap != 0 && m > leap) ? m - 1 : m;
+    lunar->Date = offset;
+    lunar->Year = index + ref_solar_1_1[0];
+}
+
+// day of solar term JQ (0 = 小寒) in year, 2000-2050
+static uint8_t ref_jieqi_day(uint16_t year, uint8_t JQ)
+{
+    if (!((ref_jieqi_bits[(year - 2000) * 3 + JQ / 8] << (JQ % 8)) & 0x80))
+        return ref_jieqi_base[JQ];
+    if ((JQ == 1 || JQ == 11 || JQ == 18 || JQ == 21) && year < 2044)
+        return ref_jieqi_base[JQ] + 1;
+    return ref_jieqi_base[JQ] - 1;
+}
+
+/* Solar terms moved by the almanac, with the Beijing time tools/almanac.py computes
+ * for them (VSOP87 sun, none within 45 minutes of midnight). */
+static const struct {
+    uint16_t year;
+    uint8_t jieqi, day, ref_day;
+} jieqi_moved[] = {
+    {2013, 18, 8, 9},   // 寒露 10-08 10:58, 与公布的日期相同
+    {2013, 19, 23, 24}, // 霜降 10-23 14:09, 与公布的日期相同
+    {2033, 13, 22, 23}, // 大暑 07-22 19:52
+    {2034, 3, 18, 19},  // 雨水 02-18 22:30
+    {2034, 14, 7, 8},   // 立秋 08-07 18:08
+    {2036, 5, 20, 21},  // 春分 03-20 09:02
+    {2038, 3, 18, 19},  // 雨水 02-18 21:51
+    {2049, 6, 4, 5},    // 清明 04-04 16:14
+    {2049, 7, 19, 20},  // 谷雨 04-19 23:13
+    {2050, 16, 7, 8},   // 白露 09-07 18:00
+};
+
+static void test_previous(void)
+{
+    unsigned moved = 0;
+
+    for (int year = FIRST_YEAR; year <= LAST_YEAR; year++) {
+        for (int month = 1; month <= 12; month++) {
+            for (int day = 1; day <= thisMonthMaxDays(year, month); day++) {
+                struct Lunar_Date a, b;
+                LUNAR_SolarToLunar(&a, year, month, day);
+                ref_solar_to_lunar(&b, year, month, day);
+                CHECK(a.Year == b.Year && a.Month == b.Month && a.Date == b.Date && a.IsLeap == b.IsLeap,
+                      "LUNAR_SolarToLunar(%d-%d-%d) = %d-%s%d-%d, previously %d-%s%d-%d", year, month, day,
+                      a.Year, a.IsLeap ? "leap " : "", a.Month, a.Date, b.Year, b.IsLeap ? "leap " : "", b.Month, b.Date);
+            }
+            for (uint8_t JQ = (month - 1) * 2; year <= 2050 && JQ < month * 2; JQ++) {
+                uint8_t day, ref = ref_jieqi_day(year, JQ);
+                GetJieQi(year, month, JQ % 2 ? 15 : 1, &day);
+                if (day == ref)
+                    continue;
+                unsigned i = 0;
+                while (i < sizeof(jieqi_moved) / sizeof(jieqi_moved[0]) &&
+                       !(jieqi_moved[i].year == year && jieqi_moved[i].jieqi == JQ))
+                    i++;
+                CHECK(i < sizeof(jieqi_moved) / sizeof(jieqi_moved[0]) && jieqi_moved[i].day == day &&
+                      jieqi_moved[i].ref_day == ref, "GetJieQi(%d-%d) term %d on %d, previously %d", year, month, JQ, day, ref);
+                moved++;
+            }
+        }
+    }
+    CHECK(moved == sizeof(jieqi_moved) / sizeof(jieqi_moved[0]), "%u solar terms moved, %u listed", moved,
+          (unsigned)(sizeof(jieqi_moved) / sizeof(jieqi_moved[0])));
+}
+
+/* Published calendar dates, including events close to midnight. */
+static const struct {
+    uint16_t year;
+    uint8_t month, day;
+    uint16_t lunar_year;
+    uint8_t lunar_month, lunar_date, leap, jieqi;
+} known[] = {
+    {2000, 1, 1, 1999, 11, 25, 0, LUNAR_DAY_NO_JIEQI},
+    {2000, 2, 5, 2000, 1, 1, 0, LUNAR_DAY_NO_JIEQI},
+    {2008, 5, 21, 2008, 4, 17, 0, 9},    // 小满 00:01
+    {2013, 10, 8, 2013, 9, 4, 0, 18},    // 寒露, 2000-2050 的旧表是 9 日
+    {2020, 5, 23, 2020, 4, 1, 1, LUNAR_DAY_NO_JIEQI},
+    {2021, 12, 21, 2021, 11, 18, 0, 23}, // 冬至 23:59
+    {2023, 3, 22, 2023, 2, 1, 1, LUNAR_DAY_NO_JIEQI},
+    {2033, 12, 22, 2033, 11, 1, 1, LUNAR_DAY_NO_JIEQI},
+    {2034, 1, 20, 2033, 12, 1, 0, 1},    // 闰十一月之后, 大寒
+    {2057, 9, 29, 2057, 9, 1, 0, LUNAR_DAY_NO_JIEQI},
+    {2100, 2, 9, 2100, 1, 1, 0, LUNAR_DAY_NO_JIEQI},
+};
+
+static void test_known(void)
+{
+    struct Lunar_Date lunar;
+
+    for (unsigned i = 0; i < sizeof(known) / sizeof(known[0]); i++) {
+        uint8_t JQ = LUNAR_GetDay(days_from_civil(known[i].year, known[i].month, known[i].day), &lunar);
+        CHECK(lunar.Year == known[i].lunar_year && lunar.Month == known[i].lunar_month &&
+              lunar.Date == known[i].lunar_date && lunar.IsLeap == known[i].leap && JQ == known[i].jieqi,
+              "LUNAR_GetDay(%d-%d-%d) = %d-%s%d-%d, %d", known[i].year, known[i].month, known[i].day,
+              lunar.Year, lunar.IsLeap ? "leap " : "", lunar.Month, lunar.Date, JQ);
+    }
+    LUNAR_SolarToLunar(&lunar, 2199, 12, 31);
+    CHECK(lunar.Year == 2199 && lunar.Month == 11, "LUNAR_SolarToLunar(2199-12-31)");
+    LUNAR_SolarToLunar(&lunar, 1999, 12, 31);
+    CHECK(lunar.Year == 0 && lunar.Month == 0 && lunar.Date == 0, "LUNAR_SolarToLunar(1999-12-31) out of range");
+    LUNAR_SolarToLunar(&lunar, 2200, 1, 1);
+    CHECK(lunar.Year == 0 && lunar.Month == 0 && lunar.Date == 0, "LUNAR_SolarToLunar(2200-01-01) out of range");
+}
+
+static void benchmark(void)
+{
+    int64_t first = (int64_t)days_from_civil(FIRST_YEAR, 1, 1) * SEC_PER_DY;
+    int64_t last = (int64_t)days_from_civil(LAST_YEAR + 1, 1, 1) * SEC_PER_DY;
+    int64_t step = 3600 * 7 + 13;
+    volatile uint32_t sink = 0;
+    struct devtm dt;
+    double t0, t1, t2;
+    long n = 0;
+
+    t0 = now();
+    for (int64_t t = first; t < last; t += step, n++) {
+        transformTime(t, &dt);
+        sink += dt.tm_mday;
+    }
+    t1 = now();
+    for (int64_t t = first; t < last; t += step) {
+        ref_transform(t, &dt);
+        sink += dt.tm_mday;
+    }
+    t2 = now();
+
+    printf("transformTime: %ld calls, %.1f ns/call (loop reference %.1f ns/call)\n",
+           n, (t1 - t0) * 1e9 / n, (t2 - t1) * 1e9 / n);
+}
+
+int main(int argc, char **argv)
+{
+    test_days();
+    test_transform();
+    test_month();
+    test_previous();
+    test_known();
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("%d-%d: all date conversions OK\n", FIRST_YEAR, LAST_YEAR);
+    if (argc > 1 && strcmp(argv[1], "-b") == 0)
+        benchmark();
+    return 0;
+}
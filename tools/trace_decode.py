@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+Decoder for the binary event trace of the firmware (EPD/EPD_trace.h)
+
+Reads the RTT stream of up buffer 1 ("EPDTrace", e.g. saved with
+JLinkRTTLogger -RTTChannel 1) or a snapshot of the trace characteristic as
+saved by the web tool, and prints a timeline. A stream may hold several
+boots, each starts with a header.
+
+    JLinkRTTLogger -Device NRF51822_XXAA -If SWD -Speed 4000 -RTTChannel 1 trace.bin
+    python3 tools/trace_decode.py trace.bin
+    python3 tools/trace_decode.py -s trace.bin
+
+Times are relative to the first record. The RTC clock of nRF51 wraps after
+512 s and DWT of nRF52 after 67 s, longer gaps between two records are
+shown shorter than they were.
+"""
+import argparse
+import struct
+import sys
+
+MAGIC = 0x54445045
+FLAG_STREAM = 0x01
+
+CLOCKS = {
+    0: ('RTC', 1 << 24, 1e6 / 32768),   # ticks, wrap, us per tick
+    1: ('DWT', 1 << 32, 1 / 64.0),
+}
+
+EVENTS = {
+    1: 'CONNECT',
+    2: 'DISCONNECT',
+    3: 'WRITE',
+    4: 'WRITE_END',
+    5: 'SCHED',
+    6: 'GUI_BEGIN',
+    7: 'GUI_END',
+    8: 'SPI_WRITE',
+    9: 'SPI_READ',
+    10: 'BUSY',
+    11: 'REFRESH_BEGIN',
+    12: 'REFRESH_END',
+    13: 'TEMP',
+    14: 'FONT',
+    15: 'OVERRUN',
+    16: 'DATA',
+}
+
+MODES = {0: 'none', 1: 'calendar', 2: 'clock', 3: 'list'}
+FONT_EVENTS = {0: 'erased', 1: 'written', 2: 'committed'}
+
+
+class TraceError(Exception):
+    pass
+
+
+def parse(data):
+    """Returns a list of (clock, total, records), records as (time, id, a, b)."""
+    blocks = []
+    pos = 0
+    while pos + 16 <= len(data):
+        magic, zero, version, clock, flags, total, count = struct.unpack_from('<IBBBBIH', data, pos)
+        if magic != MAGIC or zero != 0:
+            raise TraceError('no header at offset %d' % pos)
+        if version != 1 or clock not in CLOCKS:
+            raise TraceError('unknown trace version %d, clock %d' % (version, clock))
+        pos += 16
+        records = []
+        while pos + 8 <= len(data) and (flags & FLAG_STREAM or len(records) < count):
+            time, event, a, b = struct.unpack_from('<IBBH', data, pos)
+            if event == 0 and time == MAGIC:
+                break   # the next boot
+            records.append((time, event, a, b))
+            pos += 8
+        if not flags & FLAG_STREAM:
+            pos = len(data)     # the rest of the characteristic is padding
+        blocks.append((clock, total, records))
+    return blocks
+
+
+def describe(event, a, b):
+    if event == 1:
+        return 'handle %d' % b
+    if event in (3, 4, 15):
+        return 'cmd 0x%02x' % a + (' len %d' % b if event != 4 else '')
+    if event in (5, 6):
+        return MODES.get(a, 'mode %d' % a)
+    if event == 7:
+        return 'redrawn' if a else 'unchanged'
+    if event in (8, 9):
+        return '%d bytes, %d us' % (a, b)
+    if event == 10:
+        return '%d ms' % b + (', timeout' if a else '')
+    if event == 13:
+        return '%d C' % (a - 256 if a > 127 else a)
+    if event == 14:
+        return '%s %s' % (FONT_EVENTS.get(a, a), 'ok' if b else 'failed')
+    if event == 16:
+        return 'len %d' % b
+    return ''
+
+
+def timeline(clock, records):
+    """Yields (us, record) with the clock unwrapped."""
+    _, wrap, scale = CLOCKS[clock]
+    ticks, last = 0, None
+    for r in records:
+        if last is not None:
+            ticks += (r[0] - last) % wrap
+        last = r[0]
+        yield ticks * scale, r
+
+
+def print_timeline(clock, records):
+    prev = 0
+    for us, (_, event, a, b) in timeline(clock, records):
+        name = EVENTS.get(event, 'EVENT_%d' % event)
+        print('%12.3f ms %+10.0f us  %-14s %s' % (us / 1000, us - prev, name, describe(event, a, b)))
+        prev = us
+
+
+def print_summary(clock, records):
+    spans = {}      # name: [count, total us, max us]
+    begin = {}
+    spi = [0, 0, 0]
+
+    def add(name, us):
+        s = spans.setdefault(name, [0, 0.0, 0.0])
+        s[0] += 1
+        s[1] += us
+        s[2] = max(s[2], us)
+
+    for us, (_, event, a, b) in timeline(clock, records):
+        if event in (3, 6, 11):
+            begin[event] = (us, a)
+        elif event in (4, 7, 12) and event - 1 in begin:
+            start, cmd = begin.pop(event - 1)
+            add('WRITE 0x%02x' % cmd if event == 4 else EVENTS[event - 1].split('_')[0], us - start)
+        elif event in (8, 9):
+            spi[0] += 1
+            spi[1] += a
+            spi[2] += b
+        elif event == 10:
+            add('BUSY', b * 1000.0)
+    print('%-14s %7s %12s %12s %12s' % ('', 'count', 'total ms', 'avg ms', 'max ms'))
+    for name in sorted(spans):
+        count, total, peak = spans[name]
+        print('%-14s %7d %12.3f %12.3f %12.3f' % (name, count, total / 1000, total / count / 1000, peak / 1000))
+    if spi[0]:
+        print('%-14s %7d %12.3f %12s %12s  %d bytes' % ('SPI', spi[0], spi[2] / 1000.0, '', '', spi[1]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('trace')
+    parser.add_argument('-s', '--summary', action='store_true', help='durations per phase instead of the timeline')
+    args = parser.parse_args()
+
+    try:
+        with open(args.trace, 'rb') as f:
+            blocks = parse(f.read())
+    except (TraceError, OSError) as e:
+        print('trace_decode: %s' % e, file=sys.stderr)
+        return 1
+
+    for n, (clock, total, records) in enumerate(blocks):
+        first = total - len(records) if total else 0
+        print('%s# boot %d, %s clock, %d records from #%d' % ('\n' if n else '', n + 1, CLOCKS[clock][0],
+                                                              len(records), first))
+        if args.summary:
+            print_summary(clock, records)
+        else:
+            print_timeline(clock, records)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())